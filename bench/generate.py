@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+
+"""
+Generators for synthetic C inputs that stress one dimension of the compiler
+each: number of functions, function length, scope depth, expression length,
+initializer length and number of globals. Only constructs the compiler
+supports are used, so every input compiles.
+
+Usage: generate.py [-h] [--scale SCALE | --size SIZE] [-o OUTPUT_DIR] [name ...]
+
+Example usage: bench/generate.py --scale 0.1 -o bin/bench/inputs long_function
+
+Each generator takes a size n; DEFAULT_SIZES gives the size used at scale 1.
+"""
+
+
+import sys
+import argparse
+from pathlib import Path
+from typing import Callable, Dict
+
+
+def many_functions(n: int) -> str:
+    """n small functions, each with a few locals, a branch and a loop"""
+    lines = []
+    for i in range(n):
+        lines.append(
+            f"int f{i}(int a, int b)\n"
+            "{\n"
+            "    int c = a + b;\n"
+            "    int i;\n"
+            "    for (i = 0; i < b; i++)\n"
+            "    {\n"
+            f"        c = c * {i % 7 + 2} - a;\n"
+            "    }\n"
+            "    if (c > a)\n"
+            "    {\n"
+            "        return c - b;\n"
+            "    }\n"
+            "    return c;\n"
+            "}\n"
+        )
+    return "\n".join(lines)
+
+
+def long_function(n: int) -> str:
+    """one function with n statements over a handful of locals"""
+    lines = ["int f(int a, int b)", "{", "    int x = a;", "    int y = b;", "    int z = 0;"]
+    for i in range(n):
+        kind = i % 4
+        if kind == 0:
+            lines.append(f"    x = x + {i % 100};")
+        elif kind == 1:
+            lines.append("    y = y ^ x;")
+        elif kind == 2:
+            lines.append("    z = z + x * y;")
+        else:
+            lines.append("    if (z > x) { z = z - y; }")
+    lines += ["    return x + y + z;", "}", ""]
+    return "\n".join(lines)
+
+
+def nested_scopes(n: int) -> str:
+    """n nested blocks, each declaring a local that shadows the one outside it"""
+    lines = ["int f(int a)", "{", "    int v = a;"]
+    for depth in range(n):
+        lines.append("{")
+        lines.append(f"int v = {depth} + a;")
+        lines.append("a = a + v;")
+    lines += ["}"] * n
+    lines += ["    return a;", "}", ""]
+    return "\n".join(lines)
+
+
+def long_expression(n: int) -> str:
+    """one left-associative chain of n additive operators, as deep as the AST gets"""
+    terms = ["a"]
+    for i in range(n):
+        terms.append("+" if i % 2 else "-")
+        terms.append("b" if i % 3 else str(i % 50))
+    return "int f(int a, int b)\n{\n    return " + " ".join(terms) + ";\n}\n"
+
+
+def big_initializer(n: int) -> str:
+    """a global array with n initializers, and a local one with n / 10"""
+    global_values = ", ".join(str(i % 1000) for i in range(n))
+    local_size = max(1, n // 10)
+    local_values = ", ".join(str(i % 1000) for i in range(local_size))
+    return (
+        f"int table[{n}] = {{{global_values}}};\n"
+        "\n"
+        "int f(int i)\n"
+        "{\n"
+        f"    int local[{local_size}] = {{{local_values}}};\n"
+        "    return table[i] + local[i];\n"
+        "}\n"
+    )
+
+
+def many_globals(n: int) -> str:
+    """n global variables, all read by one function"""
+    lines = [f"int g{i} = {i};" for i in range(n)]
+    lines += ["", "int f()", "{", "    int sum = 0;"]
+    lines += [f"    sum = sum + g{i};" for i in range(n)]
+    lines += ["    return sum;", "}", ""]
+    return "\n".join(lines)
+
+
+GENERATORS: Dict[str, Callable[[int], str]] = {
+    "many_functions": many_functions,
+    "long_function": long_function,
+    "nested_scopes": nested_scopes,
+    "long_expression": long_expression,
+    "big_initializer": big_initializer,
+    "many_globals": many_globals,
+}
+
+DEFAULT_SIZES: Dict[str, int] = {
+    "many_functions": 10000,
+    "long_function": 50000,
+    "nested_scopes": 1000,
+    "long_expression": 5000,
+    "big_initializer": 50000,
+    "many_globals": 5000,
+}
+
+
+def scaled_size(name: str, scale: float) -> int:
+    return max(1, int(DEFAULT_SIZES[name] * scale))
+
+
+def write_input(name: str, n: int, output_dir: Path) -> Path:
+    """Writes the input of generator name at size n and returns its path"""
+    output_dir.mkdir(parents=True, exist_ok=True)
+    path = output_dir.joinpath(f"{name}_{n}.c")
+    path.write_text(GENERATORS[name](n))
+    return path
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Write synthetic C inputs for the benchmarks.")
+    parser.add_argument(
+        "names",
+        nargs="*",
+        default=list(GENERATORS),
+        help="Generators to run, all of them by default: " + ", ".join(GENERATORS)
+    )
+    size = parser.add_mutually_exclusive_group()
+    size.add_argument(
+        "--scale",
+        type=float,
+        default=1.0,
+        help="Multiplies the default size of every input."
+    )
+    size.add_argument(
+        "--size",
+        type=int,
+        help="Size of every input, instead of a scaled default."
+    )
+    parser.add_argument(
+        "-o",
+        "--output-dir",
+        type=Path,
+        default=Path("bin/bench/inputs"),
+        help="Where to write the inputs, bin/bench/inputs by default."
+    )
+    args = parser.parse_args()
+
+    for name in args.names:
+        if name not in GENERATORS:
+            sys.exit(f"Unknown generator {name}, expected one of: " + ", ".join(GENERATORS))
+        n = args.size if args.size is not None else scaled_size(name, args.scale)
+        print(write_input(name, n, args.output_dir))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,313 @@
+#!/usr/bin/env python3
+
+"""
+Measures how compile time and memory scale with the size of the input. Every
+generator in generate.py is compiled at its scaled size n and at 2n; for each
+run the script records the time spent in each phase (from -ftrace), the wall
+time, the peak RSS and the size of the assembly written.
+
+The growth exponent log2(time(2n) / time(n)) is about 1 for a phase that is
+linear in its input and 2 for a quadratic one; any benchmark above
+--max-exponent is reported as superlinear.
+
+Usage: run.py [-h] [--compiler COMPILER] [--scale SCALE] [--repeat REPEAT]
+              [--baseline FILE] [--save-baseline FILE] [--tolerance TOLERANCE]
+              [--max-exponent MAX_EXPONENT] [name ...]
+
+Example usage: bench/run.py --scale 0.2 --baseline bench/baseline.json
+
+Exits with 1 if any benchmark fails to compile, is superlinear, or is slower
+or bigger than the baseline by more than the tolerance.
+"""
+
+
+import os
+import sys
+import json
+import math
+import time
+import argparse
+import statistics
+import subprocess
+from pathlib import Path
+from dataclasses import dataclass, asdict, field
+from typing import Dict, List, Optional
+
+import generate
+
+
+SCRIPT_LOCATION = Path(__file__).resolve().parent
+PROJECT_LOCATION = SCRIPT_LOCATION.joinpath("..").resolve()
+BENCH_FOLDER = PROJECT_LOCATION.joinpath("bin/bench").resolve()
+COMPILER_FILE = PROJECT_LOCATION.joinpath("bin/c_compiler").resolve()
+
+RUN_TIMEOUT_SECONDS = 600
+
+# a process that does nothing: its peak RSS is the floor under every measurement
+RSS_FLOOR_COMMAND = ["true"]
+
+# trace categories that make up code generation, see GenerateAssembly
+CODEGEN_PHASES = ("declarations", "codegen", "splice")
+
+# exponents of runs shorter than this are mostly noise and never flagged
+MIN_SCALING_SECONDS = 0.05
+
+
+@dataclass
+class Measurement:
+    """One input compiled --repeat times; times are medians, in seconds"""
+    name: str
+    size: int
+    wall: float
+    parse: float
+    resolve: float
+    codegen: float
+    peak_rss_kb: int
+    output_bytes: int
+    phases: Dict[str, float] = field(default_factory=dict)
+
+
+def read_trace(path: Path) -> Dict[str, float]:
+    """
+    Total seconds spent in each phase of a -ftrace file. TimeReport::WriteTrace
+    puts one event on each line, so the file is read a line at a time rather
+    than loaded whole, which would grow this process (see peak_rss_kb).
+    """
+    totals: Dict[str, float] = {}
+    with open(path) as trace:
+        for line in trace:
+            line = line.strip().rstrip(",")
+            if line.startswith("{\"name\""):
+                event = json.loads(line)
+                totals[event["cat"]] = totals.get(event["cat"], 0.0) + event["dur"] / 1e6
+    return totals
+
+
+def compile_once(compiler: Path, source: Path, work_dir: Path):
+    """Compiles source in batch mode, which skips the parser trace and AST dump"""
+    trace_path = work_dir.joinpath("trace.json")
+    output_dir = work_dir.joinpath("out")
+    command = [str(compiler), "-j", "1", f"-ftrace={trace_path}", "-d", str(output_dir), str(source)]
+
+    start = time.perf_counter()
+    process = subprocess.Popen(command, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    try:
+        stdout, stderr = process.communicate(timeout=RUN_TIMEOUT_SECONDS)
+    except subprocess.TimeoutExpired:
+        process.kill()
+        process.communicate()
+        raise RuntimeError(f"timed out after {RUN_TIMEOUT_SECONDS} s")
+    wall = time.perf_counter() - start
+    if process.returncode != 0:
+        # batch mode reports why a file failed on stdout; a crash only leaves stderr
+        lines = [line for line in stdout.decode(errors="replace").splitlines() if line.startswith("FAIL")]
+        lines = lines or stderr.decode(errors="replace").strip().splitlines()
+        raise RuntimeError(lines[-1] if lines else f"exit code {process.returncode}")
+
+    outputs = list(output_dir.rglob("*.s"))
+    output_bytes = sum(path.stat().st_size for path in outputs)
+    return wall, read_trace(trace_path), output_bytes
+
+
+def peak_rss_kb(command: List[str]) -> int:
+    """
+    Peak RSS of one run of command. Linux carries the RSS of the forking
+    process over into the child's peak, which is why inputs are generated in
+    a separate process: this one stays small, and RSS_FLOOR_COMMAND measures
+    what is left of it.
+    """
+    process = subprocess.Popen(command, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    _, _, rusage = os.wait4(process.pid, 0)
+    process.returncode = 0  # reaped by wait4, stops Popen from waiting again
+    return rusage.ru_maxrss  # kilobytes on Linux
+
+
+def generate_input(name: str, size: int) -> Path:
+    """Writes the input with generate.py in a child process, see peak_rss_kb"""
+    command = [sys.executable, str(SCRIPT_LOCATION.joinpath("generate.py")), "--size", str(size), "-o", str(BENCH_FOLDER.joinpath("inputs")), name]
+    result = subprocess.run(command, check=True, stdout=subprocess.PIPE, text=True)
+    return Path(result.stdout.strip())
+
+
+def measure(compiler: Path, name: str, size: int, repeat: int) -> Measurement:
+    work_dir = BENCH_FOLDER.joinpath("work", f"{name}_{size}")
+    work_dir.mkdir(parents=True, exist_ok=True)
+    source = generate_input(name, size)
+
+    walls: List[float] = []
+    phase_runs: List[Dict[str, float]] = []
+    output_bytes = 0
+    for _ in range(repeat):
+        wall, phases, output_bytes = compile_once(compiler, source, work_dir)
+        walls.append(wall)
+        phase_runs.append(phases)
+
+    phases = {
+        phase: statistics.median(run.get(phase, 0.0) for run in phase_runs)
+        for phase in sorted({phase for run in phase_runs for phase in run})
+    }
+    return Measurement(
+        name=name,
+        size=size,
+        wall=statistics.median(walls),
+        parse=phases.get("parse", 0.0),
+        resolve=phases.get("resolve", 0.0),
+        codegen=sum(phases.get(phase, 0.0) for phase in CODEGEN_PHASES),
+        peak_rss_kb=peak_rss_kb([str(compiler), "-j", "1", "-d", str(work_dir.joinpath("rss")), str(source)]),
+        output_bytes=output_bytes,
+        phases=phases,
+    )
+
+
+def growth_exponent(small: Measurement, large: Measurement) -> Optional[float]:
+    """log2 of how much longer the 2n input took, None if too short to tell"""
+    if large.wall < MIN_SCALING_SECONDS or small.wall <= 0:
+        return None
+    return math.log2(large.wall / small.wall)
+
+
+def print_table(results: List[Measurement], exponents: Dict[str, Optional[float]]):
+    header = f"{'benchmark':<18}{'n':>8}{'parse s':>10}{'resolve s':>11}{'codegen s':>11}{'wall s':>10}{'RSS MB':>9}{'output KB':>11}{'exp':>7}"
+    print(header)
+    print("-" * len(header))
+    for result in results:
+        exponent = exponents.get(result.name)
+        exponent_str = "" if exponent is None else f"{exponent:.2f}"
+        print(
+            f"{result.name:<18}{result.size:>8}{result.parse:>10.3f}{result.resolve:>11.3f}{result.codegen:>11.3f}"
+            f"{result.wall:>10.3f}{result.peak_rss_kb / 1024:>9.1f}{result.output_bytes / 1024:>11.1f}{exponent_str:>7}"
+        )
+
+
+def compare(results: List[Measurement], baseline_path: Path, tolerance: float) -> List[str]:
+    """Ratios against a baseline saved with --save-baseline; returns the regressions"""
+    with open(baseline_path) as baseline_file:
+        baseline = {(entry["name"], entry["size"]): entry for entry in json.load(baseline_file)["results"]}
+
+    regressions = []
+    print(f"\nCompared with {baseline_path} (ratio = now / baseline, tolerance {tolerance:.0%})")
+    for result in results:
+        entry = baseline.get((result.name, result.size))
+        if entry is None:
+            print(f"{result.name:<18}{result.size:>8}  not in baseline")
+            continue
+        ratios = {
+            "wall": result.wall / entry["wall"] if entry["wall"] > 0 else 1.0,
+            "RSS": result.peak_rss_kb / entry["peak_rss_kb"] if entry["peak_rss_kb"] > 0 else 1.0,
+            "output": result.output_bytes / entry["output_bytes"] if entry["output_bytes"] > 0 else 1.0,
+        }
+        worse = [metric for metric, ratio in ratios.items() if ratio > 1 + tolerance]
+        print(
+            f"{result.name:<18}{result.size:>8}"
+            + "".join(f"  {metric} {ratio:.2f}x" for metric, ratio in ratios.items())
+            + ("  REGRESSION" if worse else "")
+        )
+        regressions += [f"{result.name} n={result.size}: {metric} {ratios[metric]:.2f}x" for metric in worse]
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Benchmark compile time and memory on synthetic inputs.")
+    parser.add_argument(
+        "names",
+        nargs="*",
+        default=list(generate.GENERATORS),
+        help="Benchmarks to run, all of them by default: " + ", ".join(generate.GENERATORS)
+    )
+    parser.add_argument(
+        "--compiler",
+        type=Path,
+        default=COMPILER_FILE,
+        help="Compiler to benchmark, bin/c_compiler by default."
+    )
+    parser.add_argument(
+        "--scale",
+        type=float,
+        default=1.0,
+        help="Multiplies the default size of every input."
+    )
+    parser.add_argument(
+        "--repeat",
+        type=int,
+        default=3,
+        help="Compiles of each input; times are the median."
+    )
+    parser.add_argument(
+        "--baseline",
+        type=Path,
+        help="Results saved earlier with --save-baseline to compare against."
+    )
+    parser.add_argument(
+        "--save-baseline",
+        type=Path,
+        help="Where to save these results as a baseline."
+    )
+    parser.add_argument(
+        "--tolerance",
+        type=float,
+        default=0.25,
+        help="Slowdown or growth over the baseline that counts as a regression, 0.25 by default."
+    )
+    parser.add_argument(
+        "--max-exponent",
+        type=float,
+        default=1.5,
+        help="Growth exponent above which a benchmark is superlinear, 1.5 by default."
+    )
+    args = parser.parse_args()
+
+    if not args.compiler.exists():
+        sys.exit(f"{args.compiler} not found, build it with make first")
+    for name in args.names:
+        if name not in generate.GENERATORS:
+            sys.exit(f"Unknown benchmark {name}, expected one of: " + ", ".join(generate.GENERATORS))
+
+    results: List[Measurement] = []
+    exponents: Dict[str, Optional[float]] = {}
+    failures: List[str] = []
+    for name in args.names:
+        size = generate.scaled_size(name, args.scale)
+        try:
+            small = measure(args.compiler, name, size, args.repeat)
+            large = measure(args.compiler, name, 2 * size, args.repeat)
+        except RuntimeError as e:
+            failures.append(f"{name} failed: {e}")
+            continue
+        results += [small, large]
+        exponents[name] = growth_exponent(small, large)
+
+    rss_floor_kb = peak_rss_kb(RSS_FLOOR_COMMAND)
+    print_table(results, exponents)
+    print(f"\nRSS of a process that does nothing: {rss_floor_kb / 1024:.1f} MB")
+
+    BENCH_FOLDER.mkdir(parents=True, exist_ok=True)
+    document = {
+        "compiler": str(args.compiler),
+        "scale": args.scale,
+        "rss_floor_kb": rss_floor_kb,
+        "results": [asdict(result) for result in results],
+    }
+    for path in [BENCH_FOLDER.joinpath("results.json"), args.save_baseline]:
+        if path is not None:
+            with open(path, "w") as results_file:
+                json.dump(document, results_file, indent=2)
+    print(f"Results written to {BENCH_FOLDER.joinpath('results.json')}")
+
+    problems = failures
+    problems += [
+        f"{name}: superlinear, time grows as n^{exponent:.2f}"
+        for name, exponent in exponents.items()
+        if exponent is not None and exponent > args.max_exponent
+    ]
+    if args.baseline is not None:
+        problems += compare(results, args.baseline, args.tolerance)
+
+    if problems:
+        print()
+        for problem in problems:
+            print(problem)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
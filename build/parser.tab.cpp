@@ -0,0 +1,3122 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser.tab.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_IDENTIFIER = 3,                 /* IDENTIFIER  */
+  YYSYMBOL_INT_CONSTANT = 4,               /* INT_CONSTANT  */
+  YYSYMBOL_FLOAT_CONSTANT = 5,             /* FLOAT_CONSTANT  */
+  YYSYMBOL_STRING_LITERAL = 6,             /* STRING_LITERAL  */
+  YYSYMBOL_CHAR_LITERAL = 7,               /* CHAR_LITERAL  */
+  YYSYMBOL_PTR_OP = 8,                     /* PTR_OP  */
+  YYSYMBOL_INC_OP = 9,                     /* INC_OP  */
+  YYSYMBOL_DEC_OP = 10,                    /* DEC_OP  */
+  YYSYMBOL_LEFT_OP = 11,                   /* LEFT_OP  */
+  YYSYMBOL_RIGHT_OP = 12,                  /* RIGHT_OP  */
+  YYSYMBOL_LE_OP = 13,                     /* LE_OP  */
+  YYSYMBOL_GE_OP = 14,                     /* GE_OP  */
+  YYSYMBOL_EQ_OP = 15,                     /* EQ_OP  */
+  YYSYMBOL_NE_OP = 16,                     /* NE_OP  */
+  YYSYMBOL_AND_OP = 17,                    /* AND_OP  */
+  YYSYMBOL_OR_OP = 18,                     /* OR_OP  */
+  YYSYMBOL_MUL_ASSIGN = 19,                /* MUL_ASSIGN  */
+  YYSYMBOL_DIV_ASSIGN = 20,                /* DIV_ASSIGN  */
+  YYSYMBOL_MOD_ASSIGN = 21,                /* MOD_ASSIGN  */
+  YYSYMBOL_ADD_ASSIGN = 22,                /* ADD_ASSIGN  */
+  YYSYMBOL_SUB_ASSIGN = 23,                /* SUB_ASSIGN  */
+  YYSYMBOL_LEFT_ASSIGN = 24,               /* LEFT_ASSIGN  */
+  YYSYMBOL_RIGHT_ASSIGN = 25,              /* RIGHT_ASSIGN  */
+  YYSYMBOL_AND_ASSIGN = 26,                /* AND_ASSIGN  */
+  YYSYMBOL_XOR_ASSIGN = 27,                /* XOR_ASSIGN  */
+  YYSYMBOL_OR_ASSIGN = 28,                 /* OR_ASSIGN  */
+  YYSYMBOL_29_ = 29,                       /* '='  */
+  YYSYMBOL_TYPE_NAME = 30,                 /* TYPE_NAME  */
+  YYSYMBOL_TYPEDEF = 31,                   /* TYPEDEF  */
+  YYSYMBOL_EXTERN = 32,                    /* EXTERN  */
+  YYSYMBOL_STATIC = 33,                    /* STATIC  */
+  YYSYMBOL_AUTO = 34,                      /* AUTO  */
+  YYSYMBOL_REGISTER = 35,                  /* REGISTER  */
+  YYSYMBOL_SIZEOF = 36,                    /* SIZEOF  */
+  YYSYMBOL_CHAR = 37,                      /* CHAR  */
+  YYSYMBOL_SHORT = 38,                     /* SHORT  */
+  YYSYMBOL_INT = 39,                       /* INT  */
+  YYSYMBOL_LONG = 40,                      /* LONG  */
+  YYSYMBOL_SIGNED = 41,                    /* SIGNED  */
+  YYSYMBOL_UNSIGNED = 42,                  /* UNSIGNED  */
+  YYSYMBOL_FLOAT = 43,                     /* FLOAT  */
+  YYSYMBOL_DOUBLE = 44,                    /* DOUBLE  */
+  YYSYMBOL_CONST = 45,                     /* CONST  */
+  YYSYMBOL_VOLATILE = 46,                  /* VOLATILE  */
+  YYSYMBOL_VOID = 47,                      /* VOID  */
+  YYSYMBOL_STRUCT = 48,                    /* STRUCT  */
+  YYSYMBOL_UNION = 49,                     /* UNION  */
+  YYSYMBOL_ENUM = 50,                      /* ENUM  */
+  YYSYMBOL_ELLIPSIS = 51,                  /* ELLIPSIS  */
+  YYSYMBOL_CASE = 52,                      /* CASE  */
+  YYSYMBOL_DEFAULT = 53,                   /* DEFAULT  */
+  YYSYMBOL_IF = 54,                        /* IF  */
+  YYSYMBOL_ELSE = 55,                      /* ELSE  */
+  YYSYMBOL_SWITCH = 56,                    /* SWITCH  */
+  YYSYMBOL_WHILE = 57,                     /* WHILE  */
+  YYSYMBOL_DO = 58,                        /* DO  */
+  YYSYMBOL_FOR = 59,                       /* FOR  */
+  YYSYMBOL_GOTO = 60,                      /* GOTO  */
+  YYSYMBOL_CONTINUE = 61,                  /* CONTINUE  */
+  YYSYMBOL_BREAK = 62,                     /* BREAK  */
+  YYSYMBOL_RETURN = 63,                    /* RETURN  */
+  YYSYMBOL_UNKNOWN = 64,                   /* UNKNOWN  */
+  YYSYMBOL_NOELSE = 65,                    /* NOELSE  */
+  YYSYMBOL_66_ = 66,                       /* '?'  */
+  YYSYMBOL_67_ = 67,                       /* ':'  */
+  YYSYMBOL_68_ = 68,                       /* ';'  */
+  YYSYMBOL_69_ = 69,                       /* ','  */
+  YYSYMBOL_70_ = 70,                       /* '{'  */
+  YYSYMBOL_71_ = 71,                       /* '}'  */
+  YYSYMBOL_72_ = 72,                       /* '('  */
+  YYSYMBOL_73_ = 73,                       /* ')'  */
+  YYSYMBOL_74_ = 74,                       /* '['  */
+  YYSYMBOL_75_ = 75,                       /* ']'  */
+  YYSYMBOL_76_ = 76,                       /* '*'  */
+  YYSYMBOL_77_ = 77,                       /* '-'  */
+  YYSYMBOL_78_ = 78,                       /* '+'  */
+  YYSYMBOL_79_ = 79,                       /* '!'  */
+  YYSYMBOL_80_ = 80,                       /* '~'  */
+  YYSYMBOL_81_ = 81,                       /* '&'  */
+  YYSYMBOL_82_ = 82,                       /* '/'  */
+  YYSYMBOL_83_ = 83,                       /* '%'  */
+  YYSYMBOL_84_ = 84,                       /* '<'  */
+  YYSYMBOL_85_ = 85,                       /* '>'  */
+  YYSYMBOL_86_ = 86,                       /* '^'  */
+  YYSYMBOL_87_ = 87,                       /* '|'  */
+  YYSYMBOL_YYACCEPT = 88,                  /* $accept  */
+  YYSYMBOL_ROOT = 89,                      /* ROOT  */
+  YYSYMBOL_translation_unit = 90,          /* translation_unit  */
+  YYSYMBOL_external_declaration = 91,      /* external_declaration  */
+  YYSYMBOL_function_definition = 92,       /* function_definition  */
+  YYSYMBOL_declaration = 93,               /* declaration  */
+  YYSYMBOL_declaration_specifiers = 94,    /* declaration_specifiers  */
+  YYSYMBOL_type_specifier = 95,            /* type_specifier  */
+  YYSYMBOL_init_declarator_list = 96,      /* init_declarator_list  */
+  YYSYMBOL_init_declarator = 97,           /* init_declarator  */
+  YYSYMBOL_enum_declaration = 98,          /* enum_declaration  */
+  YYSYMBOL_enum_specifier = 99,            /* enum_specifier  */
+  YYSYMBOL_enumerator_list = 100,          /* enumerator_list  */
+  YYSYMBOL_enumerator = 101,               /* enumerator  */
+  YYSYMBOL_declarator = 102,               /* declarator  */
+  YYSYMBOL_direct_declarator = 103,        /* direct_declarator  */
+  YYSYMBOL_pointer = 104,                  /* pointer  */
+  YYSYMBOL_parameter_list = 105,           /* parameter_list  */
+  YYSYMBOL_parameter_declaration = 106,    /* parameter_declaration  */
+  YYSYMBOL_initializer = 107,              /* initializer  */
+  YYSYMBOL_initializer_list = 108,         /* initializer_list  */
+  YYSYMBOL_statement = 109,                /* statement  */
+  YYSYMBOL_labeled_statement = 110,        /* labeled_statement  */
+  YYSYMBOL_compound_statement = 111,       /* compound_statement  */
+  YYSYMBOL_statement_list = 112,           /* statement_list  */
+  YYSYMBOL_expression_statement = 113,     /* expression_statement  */
+  YYSYMBOL_selection_statement = 114,      /* selection_statement  */
+  YYSYMBOL_iteration_statement = 115,      /* iteration_statement  */
+  YYSYMBOL_jump_statement = 116,           /* jump_statement  */
+  YYSYMBOL_primary_expression = 117,       /* primary_expression  */
+  YYSYMBOL_postfix_expression = 118,       /* postfix_expression  */
+  YYSYMBOL_argument_expression_list = 119, /* argument_expression_list  */
+  YYSYMBOL_unary_expression = 120,         /* unary_expression  */
+  YYSYMBOL_cast_expression = 121,          /* cast_expression  */
+  YYSYMBOL_multiplicative_expression = 122, /* multiplicative_expression  */
+  YYSYMBOL_additive_expression = 123,      /* additive_expression  */
+  YYSYMBOL_shift_expression = 124,         /* shift_expression  */
+  YYSYMBOL_relational_expression = 125,    /* relational_expression  */
+  YYSYMBOL_equality_expression = 126,      /* equality_expression  */
+  YYSYMBOL_and_expression = 127,           /* and_expression  */
+  YYSYMBOL_exclusive_or_expression = 128,  /* exclusive_or_expression  */
+  YYSYMBOL_inclusive_or_expression = 129,  /* inclusive_or_expression  */
+  YYSYMBOL_logical_and_expression = 130,   /* logical_and_expression  */
+  YYSYMBOL_logical_or_expression = 131,    /* logical_or_expression  */
+  YYSYMBOL_conditional_expression = 132,   /* conditional_expression  */
+  YYSYMBOL_assignment_expression = 133,    /* assignment_expression  */
+  YYSYMBOL_assignment_operator = 134,      /* assignment_operator  */
+  YYSYMBOL_expression = 135                /* expression  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+/* Unqualified %code blocks.  */
+#line 47 "src/parser.y"
+
+	// a rule spans its first to its last symbol; an empty rule is an empty span where it was reduced
+	#define YYLLOC_DEFAULT(Current, Rhs, N)                                       \
+		do {                                                                      \
+			if (N) {                                                              \
+				(Current).begin = YYRHSLOC(Rhs, 1).begin;                         \
+				(Current).end = YYRHSLOC(Rhs, N).end;                             \
+			} else {                                                              \
+				(Current).begin = (Current).end = YYRHSLOC(Rhs, 0).end;           \
+			}                                                                     \
+		} while (0)
+
+	// Bison only grows its stacks itself when the location type is its own, so deep nesting would
+	// stop at the initial depth. They are grown here instead, up to YYMAXDEPTH; on failure the stack
+	// size is left alone, which makes yyparse give up.
+	#define yyoverflow(Message, States, StatesBytes, Values, ValuesBytes, Locations, LocationsBytes, StackSize) \
+		GrowStacks(*yyget_extra(scanner), Message, States, Values, Locations, \
+		           (StatesBytes) / sizeof(**(States)), StackSize, YYMAXDEPTH)
+
+	template <typename State, typename Value, typename Location, typename Size>
+	void GrowStacks(ParseState &state, const char *message, State **states, Value **values, Location **locations,
+	                size_t size, Size *stack_size, long max_depth)
+	{
+		if (*stack_size >= max_depth) {
+			state.error = std::string("Error: ") + message;
+			return;
+		}
+		*stack_size = std::min<Size>(2 * *stack_size, max_depth);
+		std::shared_ptr<State[]> grown_states(new State[*stack_size]);
+		std::shared_ptr<Value[]> grown_values(new Value[*stack_size]);
+		std::shared_ptr<Location[]> grown_locations(new Location[*stack_size]);
+		std::copy(*states, *states + size, grown_states.get());
+		std::copy(*values, *values + size, grown_values.get());
+		std::copy(*locations, *locations + size, grown_locations.get());
+		*states = grown_states.get();
+		*values = grown_values.get();
+		*locations = grown_locations.get();
+		// replaces (and frees) the previous stacks, which are no longer used
+		state.states = grown_states;
+		state.values = grown_values;
+		state.locations = grown_locations;
+	}
+
+#line 283 "build/parser.tab.cpp"
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+# define YYCOPY_NEEDED 1
+#endif /* 1 */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
+             && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+  YYLTYPE yyls_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
+      + 2 * YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  25
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   533
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  88
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  48
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  139
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  239
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   319
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    79,     2,     2,     2,    83,    81,     2,
+      72,    73,    76,    78,    69,    77,     2,    82,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,    67,    68,
+      84,    29,    85,    66,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,    74,     2,    75,    86,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    70,    87,    71,    80,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    30,    31,    32,    33,    34,    35,
+      36,    37,    38,    39,    40,    41,    42,    43,    44,    45,
+      46,    47,    48,    49,    50,    51,    52,    53,    54,    55,
+      56,    57,    58,    59,    60,    61,    62,    63,    64,    65
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   142,   142,   145,   146,   153,   154,   158,   161,   167,
+     170,   174,   178,   181,   184,   187,   190,   193,   199,   202,
+     209,   210,   214,   218,   219,   220,   224,   225,   229,   230,
+     234,   235,   239,   242,   245,   248,   251,   257,   258,   262,
+     263,   267,   273,   274,   279,   280,   284,   285,   286,   287,
+     288,   289,   290,   294,   297,   301,   302,   306,   307,   311,
+     312,   316,   319,   322,   328,   331,   337,   338,   339,   340,
+     344,   347,   351,   355,   358,   361,   365,   366,   367,   368,
+     369,   370,   374,   375,   379,   380,   383,   386,   389,   392,
+     395,   398,   401,   404,   407,   414,   419,   420,   423,   426,
+     432,   433,   434,   438,   439,   440,   444,   445,   446,   447,
+     448,   452,   453,   454,   458,   459,   463,   464,   468,   469,
+     473,   474,   480,   481,   487,   488,   494,   495,   502,   503,
+     504,   505,   506,   507,   508,   509,   510,   511,   512,   516
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  static const char *const yy_sname[] =
+  {
+  "end of file", "error", "invalid token", "IDENTIFIER", "INT_CONSTANT",
+  "FLOAT_CONSTANT", "STRING_LITERAL", "CHAR_LITERAL", "PTR_OP", "INC_OP",
+  "DEC_OP", "LEFT_OP", "RIGHT_OP", "LE_OP", "GE_OP", "EQ_OP", "NE_OP",
+  "AND_OP", "OR_OP", "MUL_ASSIGN", "DIV_ASSIGN", "MOD_ASSIGN",
+  "ADD_ASSIGN", "SUB_ASSIGN", "LEFT_ASSIGN", "RIGHT_ASSIGN", "AND_ASSIGN",
+  "XOR_ASSIGN", "OR_ASSIGN", "'='", "TYPE_NAME", "TYPEDEF", "EXTERN",
+  "STATIC", "AUTO", "REGISTER", "SIZEOF", "CHAR", "SHORT", "INT", "LONG",
+  "SIGNED", "UNSIGNED", "FLOAT", "DOUBLE", "CONST", "VOLATILE", "VOID",
+  "STRUCT", "UNION", "ENUM", "ELLIPSIS", "CASE", "DEFAULT", "IF", "ELSE",
+  "SWITCH", "WHILE", "DO", "FOR", "GOTO", "CONTINUE", "BREAK", "RETURN",
+  "UNKNOWN", "NOELSE", "'?'", "':'", "';'", "','", "'{'", "'}'", "'('",
+  "')'", "'['", "']'", "'*'", "'-'", "'+'", "'!'", "'~'", "'&'", "'/'",
+  "'%'", "'<'", "'>'", "'^'", "'|'", "$accept", "ROOT", "translation_unit",
+  "external_declaration", "function_definition", "declaration",
+  "declaration_specifiers", "type_specifier", "init_declarator_list",
+  "init_declarator", "enum_declaration", "enum_specifier",
+  "enumerator_list", "enumerator", "declarator", "direct_declarator",
+  "pointer", "parameter_list", "parameter_declaration", "initializer",
+  "initializer_list", "statement", "labeled_statement",
+  "compound_statement", "statement_list", "expression_statement",
+  "selection_statement", "iteration_statement", "jump_statement",
+  "primary_expression", "postfix_expression", "argument_expression_list",
+  "unary_expression", "cast_expression", "multiplicative_expression",
+  "additive_expression", "shift_expression", "relational_expression",
+  "equality_expression", "and_expression", "exclusive_or_expression",
+  "inclusive_or_expression", "logical_and_expression",
+  "logical_or_expression", "conditional_expression",
+  "assignment_expression", "assignment_operator", "expression", YY_NULLPTR
+  };
+  return yy_sname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-116)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-1)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+       9,  -116,  -116,  -116,  -116,  -116,  -116,  -116,    10,    -5,
+      76,     9,  -116,  -116,  -116,     7,  -116,  -116,    35,    41,
+     -51,    75,    62,   124,  -116,  -116,  -116,   -53,  -116,   -12,
+    -116,   193,  -116,   134,   136,   -51,   124,   106,   -22,  -116,
+    -116,     7,    21,  -116,  -116,  -116,  -116,  -116,  -116,   452,
+     452,    72,   452,    82,    78,    80,    85,    86,    91,    92,
+     215,  -116,  -116,   452,   452,   452,   452,   452,   452,   452,
+    -116,     7,  -116,  -116,  -116,   272,  -116,  -116,  -116,  -116,
+    -116,    57,   470,  -116,    -8,   -17,    83,    20,   102,    81,
+      77,    74,   147,     4,  -116,  -116,    97,  -116,     7,     8,
+    -116,  -116,  -116,    95,    45,   452,   124,  -116,  -116,   137,
+      21,  -116,  -116,  -116,  -116,   430,   112,   351,   452,   452,
+     452,   294,  -116,  -116,  -116,   114,   107,  -116,  -116,  -116,
+    -116,  -116,  -116,  -116,  -116,  -116,  -116,   373,   452,  -116,
+    -116,  -116,  -116,  -116,  -116,  -116,  -116,  -116,  -116,  -116,
+     452,   452,   452,   452,   452,   452,   452,   452,   452,   452,
+     452,   452,   452,   452,   452,   452,   452,   452,   452,   452,
+    -116,  -116,   439,  -116,  -116,  -116,  -116,  -116,  -116,    59,
+     113,   115,   351,  -116,   121,   128,   133,   294,  -116,  -116,
+    -116,    39,  -116,   110,  -116,  -116,  -116,  -116,    -8,    -8,
+     -17,   -17,    83,    83,    83,    83,    20,    20,   102,    81,
+      77,    74,   147,   120,  -116,    21,  -116,  -116,  -116,  -116,
+     351,   351,   351,   452,   452,  -116,  -116,   452,  -116,   154,
+    -116,  -116,   150,  -116,  -116,   351,   351,  -116,  -116
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_uint8 yydefact[] =
+{
+       0,    32,    16,    13,    17,    14,    15,    12,     0,    37,
+       0,     2,     3,     5,     6,     0,    11,    10,     0,     0,
+      31,     0,    25,     0,    38,     1,     4,     0,    18,    20,
+      22,     0,     8,     0,     0,    30,     0,    28,     0,    26,
+       9,     0,     0,     7,    70,    71,    72,    74,    73,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    59,    56,     0,     0,     0,     0,     0,     0,     0,
+      47,     0,    57,    52,    49,     0,    51,    48,    50,    46,
+      76,    84,    95,    96,   100,   103,   106,   111,   114,   116,
+     118,   120,   122,   124,   126,   139,     0,    33,     0,     0,
+      39,    35,    95,     0,     0,     0,     0,    24,    19,    20,
+       0,    21,    42,    85,    86,     0,     0,     0,     0,     0,
+       0,     0,    68,    69,    66,     0,     0,    92,    87,    88,
+      89,    90,    91,    55,    58,    79,    80,     0,     0,   129,
+     130,   131,   132,   133,   134,   135,   136,   137,   138,   128,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+      60,    41,     0,    34,    36,    23,    29,    27,    44,     0,
+       0,     0,     0,    54,     0,     0,     0,     0,    67,    75,
+      77,     0,    82,     0,   127,    97,    98,    99,   102,   101,
+     104,   105,   109,   110,   107,   108,   112,   113,   115,   117,
+     119,   121,   123,     0,    40,     0,    43,    94,    93,    53,
+       0,     0,     0,     0,     0,    78,    81,     0,    45,    61,
+      63,    64,     0,    83,   125,     0,     0,    62,    65
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -116,  -116,  -116,   199,  -116,    43,     3,   111,  -116,   186,
+    -116,  -116,   192,   125,    -6,   212,   225,  -116,    66,  -105,
+    -116,   -67,  -116,    26,  -116,  -115,  -116,  -116,  -116,  -116,
+    -116,  -116,   -31,   -27,   -21,   -20,   -38,   -15,    84,    79,
+      73,    90,    94,  -116,   -32,   -41,  -116,   -56
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
+{
+       0,    10,    11,    12,    13,    70,    71,    16,    27,    28,
+      17,    18,    38,    39,    19,    20,    21,    99,   100,   111,
+     179,    72,    73,    74,    75,    76,    77,    78,    79,    80,
+      81,   191,   102,    83,    84,    85,    86,    87,    88,    89,
+      90,    91,    92,    93,    94,    95,   150,    96
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_uint8 yytable[] =
+{
+      82,   112,   103,    15,   125,   178,   187,   126,   134,    29,
+       1,    82,     1,    22,    15,    40,    41,    42,   113,   114,
+     116,    33,   168,    34,    44,    45,    46,    47,    48,    82,
+      49,    50,    82,   158,   159,   109,    98,   127,   128,   129,
+     130,   131,   132,    14,    82,    32,     2,   106,     3,   107,
+     183,     4,     5,     6,    14,    43,     7,    51,    31,     8,
+     154,   155,   184,   185,   186,   109,   135,   136,   151,   112,
+     169,     9,   223,   176,   152,   153,    25,   172,     1,    82,
+      23,   173,   193,     9,   181,     9,    82,    82,    82,    82,
+      82,   110,   171,    63,   156,   157,   192,    64,    65,    66,
+      67,    68,    69,    30,   160,   161,    82,    82,   224,   194,
+     228,    31,   225,   213,   106,   219,   175,   162,   163,    82,
+     202,   203,   204,   205,   195,   196,   197,    37,   215,   137,
+     216,   138,    36,   198,   199,   105,   200,   201,    82,    44,
+      45,    46,    47,    48,   115,    49,    50,   206,   207,   117,
+     118,    82,   119,   229,   230,   231,    82,   120,   121,   122,
+     123,   166,   164,   165,   167,   170,    42,   232,   237,   238,
+     174,     2,    51,     3,   112,    98,     4,     5,     6,   182,
+     189,     7,   188,   233,    82,   226,   217,   227,   218,    82,
+      82,    82,    82,    82,   220,   234,    44,    45,    46,    47,
+      48,   221,    49,    50,    82,    82,   222,    97,    63,   235,
+      26,   101,    64,    65,    66,    67,    68,    69,    44,    45,
+      46,    47,    48,   236,    49,    50,   180,   108,   104,    51,
+       2,   177,     3,    35,    24,     4,     5,     6,   214,   210,
+       7,     0,     0,     8,   209,    52,    53,    54,   208,    55,
+      56,    51,    57,     0,    58,    59,    60,   211,     0,     0,
+       0,    61,   212,    31,    62,    63,     0,     0,     0,    64,
+      65,    66,    67,    68,    69,    44,    45,    46,    47,    48,
+       0,    49,    50,   124,     0,     0,     0,    63,     0,     0,
+       0,    64,    65,    66,    67,    68,    69,    44,    45,    46,
+      47,    48,     0,    49,    50,     0,     0,     0,    51,     2,
+       0,     3,     0,     0,     4,     5,     6,     0,     0,     7,
+       0,     0,     8,     0,    52,    53,    54,     0,    55,    56,
+      51,    57,     0,    58,    59,    60,     0,     0,     0,     0,
+      61,     0,    31,   133,    63,     0,     0,     0,    64,    65,
+      66,    67,    68,    69,    44,    45,    46,    47,    48,     0,
+      49,    50,    61,     0,     0,     0,    63,     0,     0,     0,
+      64,    65,    66,    67,    68,    69,    44,    45,    46,    47,
+      48,     0,    49,    50,     0,     0,     0,    51,     2,     0,
+       3,     0,     0,     4,     5,     6,     0,     0,     7,     0,
+       0,     8,     0,    52,    53,    54,     0,    55,    56,    51,
+      57,     0,    58,    59,    60,     0,     0,     0,     0,    61,
+       0,    31,     0,    63,     0,     0,     0,    64,    65,    66,
+      67,    68,    69,    44,    45,    46,    47,    48,     0,    49,
+      50,     0,     0,     0,     0,    63,   190,     0,     0,    64,
+      65,    66,    67,    68,    69,    44,    45,    46,    47,    48,
+       0,    49,    50,     0,     0,     0,    51,     2,     0,     3,
+       0,     0,     4,     5,     6,     0,     2,     7,     3,     0,
+       0,     4,     5,     6,     0,     0,     7,     0,    51,   139,
+     140,   141,   142,   143,   144,   145,   146,   147,   148,   149,
+       0,     0,    63,     0,     0,     0,    64,    65,    66,    67,
+      68,    69,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,    63,     0,     0,     0,    64,    65,
+      66,    67,    68,    69
+};
+
+static const yytype_int16 yycheck[] =
+{
+      31,    42,    34,     0,    60,   110,   121,    63,    75,    15,
+       3,    42,     3,     3,    11,    68,    69,    29,    49,    50,
+      52,    72,    18,    74,     3,     4,     5,     6,     7,    60,
+       9,    10,    63,    13,    14,    41,    33,    64,    65,    66,
+      67,    68,    69,     0,    75,    19,    37,    69,    39,    71,
+     117,    42,    43,    44,    11,    29,    47,    36,    70,    50,
+      77,    78,   118,   119,   120,    71,     9,    10,    76,   110,
+      66,    76,   187,   105,    82,    83,     0,    69,     3,   110,
+      70,    73,   138,    76,   115,    76,   117,   118,   119,   120,
+     121,    70,    98,    72,    11,    12,   137,    76,    77,    78,
+      79,    80,    81,    68,    84,    85,   137,   138,    69,   150,
+     215,    70,    73,   169,    69,   182,    71,    15,    16,   150,
+     158,   159,   160,   161,   151,   152,   153,     3,    69,    72,
+      71,    74,    70,   154,   155,    29,   156,   157,   169,     3,
+       4,     5,     6,     7,    72,     9,    10,   162,   163,    67,
+      72,   182,    72,   220,   221,   222,   187,    72,    72,    68,
+      68,    87,    81,    86,    17,    68,    29,   223,   235,   236,
+      75,    37,    36,    39,   215,   172,    42,    43,    44,    67,
+      73,    47,    68,   224,   215,    75,    73,    67,    73,   220,
+     221,   222,   223,   224,    73,   227,     3,     4,     5,     6,
+       7,    73,     9,    10,   235,   236,    73,    73,    72,    55,
+      11,    75,    76,    77,    78,    79,    80,    81,     3,     4,
+       5,     6,     7,    73,     9,    10,   115,    41,    36,    36,
+      37,   106,    39,    21,     9,    42,    43,    44,   172,   166,
+      47,    -1,    -1,    50,   165,    52,    53,    54,   164,    56,
+      57,    36,    59,    -1,    61,    62,    63,   167,    -1,    -1,
+      -1,    68,   168,    70,    71,    72,    -1,    -1,    -1,    76,
+      77,    78,    79,    80,    81,     3,     4,     5,     6,     7,
+      -1,     9,    10,    68,    -1,    -1,    -1,    72,    -1,    -1,
+      -1,    76,    77,    78,    79,    80,    81,     3,     4,     5,
+       6,     7,    -1,     9,    10,    -1,    -1,    -1,    36,    37,
+      -1,    39,    -1,    -1,    42,    43,    44,    -1,    -1,    47,
+      -1,    -1,    50,    -1,    52,    53,    54,    -1,    56,    57,
+      36,    59,    -1,    61,    62,    63,    -1,    -1,    -1,    -1,
+      68,    -1,    70,    71,    72,    -1,    -1,    -1,    76,    77,
+      78,    79,    80,    81,     3,     4,     5,     6,     7,    -1,
+       9,    10,    68,    -1,    -1,    -1,    72,    -1,    -1,    -1,
+      76,    77,    78,    79,    80,    81,     3,     4,     5,     6,
+       7,    -1,     9,    10,    -1,    -1,    -1,    36,    37,    -1,
+      39,    -1,    -1,    42,    43,    44,    -1,    -1,    47,    -1,
+      -1,    50,    -1,    52,    53,    54,    -1,    56,    57,    36,
+      59,    -1,    61,    62,    63,    -1,    -1,    -1,    -1,    68,
+      -1,    70,    -1,    72,    -1,    -1,    -1,    76,    77,    78,
+      79,    80,    81,     3,     4,     5,     6,     7,    -1,     9,
+      10,    -1,    -1,    -1,    -1,    72,    73,    -1,    -1,    76,
+      77,    78,    79,    80,    81,     3,     4,     5,     6,     7,
+      -1,     9,    10,    -1,    -1,    -1,    36,    37,    -1,    39,
+      -1,    -1,    42,    43,    44,    -1,    37,    47,    39,    -1,
+      -1,    42,    43,    44,    -1,    -1,    47,    -1,    36,    19,
+      20,    21,    22,    23,    24,    25,    26,    27,    28,    29,
+      -1,    -1,    72,    -1,    -1,    -1,    76,    77,    78,    79,
+      80,    81,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    72,    -1,    -1,    -1,    76,    77,
+      78,    79,    80,    81
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_uint8 yystos[] =
+{
+       0,     3,    37,    39,    42,    43,    44,    47,    50,    76,
+      89,    90,    91,    92,    93,    94,    95,    98,    99,   102,
+     103,   104,     3,    70,   104,     0,    91,    96,    97,   102,
+      68,    70,   111,    72,    74,   103,    70,     3,   100,   101,
+      68,    69,    29,   111,     3,     4,     5,     6,     7,     9,
+      10,    36,    52,    53,    54,    56,    57,    59,    61,    62,
+      63,    68,    71,    72,    76,    77,    78,    79,    80,    81,
+      93,    94,   109,   110,   111,   112,   113,   114,   115,   116,
+     117,   118,   120,   121,   122,   123,   124,   125,   126,   127,
+     128,   129,   130,   131,   132,   133,   135,    73,    94,   105,
+     106,    75,   120,   132,   100,    29,    69,    71,    97,   102,
+      70,   107,   133,   120,   120,    72,   132,    67,    72,    72,
+      72,    72,    68,    68,    68,   135,   135,   121,   121,   121,
+     121,   121,   121,    71,   109,     9,    10,    72,    74,    19,
+      20,    21,    22,    23,    24,    25,    26,    27,    28,    29,
+     134,    76,    82,    83,    77,    78,    11,    12,    13,    14,
+      84,    85,    15,    16,    81,    86,    87,    17,    18,    66,
+      68,   102,    69,    73,    75,    71,   132,   101,   107,   108,
+      95,   120,    67,   109,   135,   135,   135,   113,    68,    73,
+      73,   119,   133,   135,   133,   121,   121,   121,   122,   122,
+     123,   123,   124,   124,   124,   124,   125,   125,   126,   127,
+     128,   129,   130,   135,   106,    69,    71,    73,    73,   109,
+      73,    73,    73,   113,    69,    73,    75,    67,   107,   109,
+     109,   109,   135,   133,   132,    55,    73,   109,   109
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_uint8 yyr1[] =
+{
+       0,    88,    89,    90,    90,    91,    91,    92,    92,    93,
+      93,    94,    95,    95,    95,    95,    95,    95,    96,    96,
+      97,    97,    98,    99,    99,    99,   100,   100,   101,   101,
+     102,   102,   103,   103,   103,   103,   103,   104,   104,   105,
+     105,   106,   107,   107,   108,   108,   109,   109,   109,   109,
+     109,   109,   109,   110,   110,   111,   111,   112,   112,   113,
+     113,   114,   114,   114,   115,   115,   116,   116,   116,   116,
+     117,   117,   117,   117,   117,   117,   118,   118,   118,   118,
+     118,   118,   119,   119,   120,   120,   120,   120,   120,   120,
+     120,   120,   120,   120,   120,   121,   122,   122,   122,   122,
+     123,   123,   123,   124,   124,   124,   125,   125,   125,   125,
+     125,   126,   126,   126,   127,   127,   128,   128,   129,   129,
+     130,   130,   131,   131,   132,   132,   133,   133,   134,   134,
+     134,   134,   134,   134,   134,   134,   134,   134,   134,   135
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     1,     2,     1,     1,     3,     2,     3,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     3,
+       1,     3,     2,     5,     4,     2,     1,     3,     1,     3,
+       2,     1,     1,     3,     4,     3,     4,     1,     2,     1,
+       3,     2,     1,     3,     1,     3,     1,     1,     1,     1,
+       1,     1,     1,     4,     3,     3,     2,     1,     2,     1,
+       2,     5,     7,     5,     5,     7,     2,     3,     2,     2,
+       1,     1,     1,     1,     1,     3,     1,     3,     4,     2,
+       2,     4,     1,     3,     1,     2,     2,     2,     2,     2,
+       2,     2,     2,     4,     4,     1,     1,     3,     3,     3,
+       1,     3,     3,     1,     3,     3,     1,     3,     3,     3,
+       3,     1,     3,     3,     1,     3,     1,     3,     1,     3,
+       1,     3,     1,     3,     1,     5,     1,     3,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        YY_LAC_DISCARD ("YYBACKUP");                              \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, scanner, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
+   If N is 0, then set CURRENT to the empty location which ends
+   the previous symbol: RHS[0] (always defined).  */
+
+#ifndef YYLLOC_DEFAULT
+# define YYLLOC_DEFAULT(Current, Rhs, N)                                \
+    do                                                                  \
+      if (N)                                                            \
+        {                                                               \
+          (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;        \
+          (Current).first_column = YYRHSLOC (Rhs, 1).first_column;      \
+          (Current).last_line    = YYRHSLOC (Rhs, N).last_line;         \
+          (Current).last_column  = YYRHSLOC (Rhs, N).last_column;       \
+        }                                                               \
+      else                                                              \
+        {                                                               \
+          (Current).first_line   = (Current).last_line   =              \
+            YYRHSLOC (Rhs, 0).last_line;                                \
+          (Current).first_column = (Current).last_column =              \
+            YYRHSLOC (Rhs, 0).last_column;                              \
+        }                                                               \
+    while (0)
+#endif
+
+#define YYRHSLOC(Rhs, K) ((Rhs)[K])
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+/* YYLOCATION_PRINT -- Print the location on the stream.
+   This macro was not mandated originally: define only if we know
+   we won't break user code: when these are the locations we know.  */
+
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+
+/* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
+
+YY_ATTRIBUTE_UNUSED
+static int
+yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
+{
+  int res = 0;
+  int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
+  if (0 <= yylocp->first_line)
+    {
+      res += YYFPRINTF (yyo, "%d", yylocp->first_line);
+      if (0 <= yylocp->first_column)
+        res += YYFPRINTF (yyo, ".%d", yylocp->first_column);
+    }
+  if (0 <= yylocp->last_line)
+    {
+      if (yylocp->first_line < yylocp->last_line)
+        {
+          res += YYFPRINTF (yyo, "-%d", yylocp->last_line);
+          if (0 <= end_col)
+            res += YYFPRINTF (yyo, ".%d", end_col);
+        }
+      else if (0 <= end_col && yylocp->first_column < end_col)
+        res += YYFPRINTF (yyo, "-%d", end_col);
+    }
+  return res;
+}
+
+#   define YYLOCATION_PRINT  yy_location_print_
+
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, Location, scanner); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, yyscan_t scanner)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (scanner);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, yyscan_t scanner)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, scanner);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, yyscan_t scanner)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), scanner);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, scanner); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+/* Given a state stack such that *YYBOTTOM is its bottom, such that
+   *YYTOP is either its top or is YYTOP_EMPTY to indicate an empty
+   stack, and such that *YYCAPACITY is the maximum number of elements it
+   can hold without a reallocation, make sure there is enough room to
+   store YYADD more elements.  If not, allocate a new stack using
+   YYSTACK_ALLOC, copy the existing elements, and adjust *YYBOTTOM,
+   *YYTOP, and *YYCAPACITY to reflect the new capacity and memory
+   location.  If *YYBOTTOM != YYBOTTOM_NO_FREE, then free the old stack
+   using YYSTACK_FREE.  Return 0 if successful or if no reallocation is
+   required.  Return YYENOMEM if memory is exhausted.  */
+static int
+yy_lac_stack_realloc (YYPTRDIFF_T *yycapacity, YYPTRDIFF_T yyadd,
+#if YYDEBUG
+                      char const *yydebug_prefix,
+                      char const *yydebug_suffix,
+#endif
+                      yy_state_t **yybottom,
+                      yy_state_t *yybottom_no_free,
+                      yy_state_t **yytop, yy_state_t *yytop_empty)
+{
+  YYPTRDIFF_T yysize_old =
+    *yytop == yytop_empty ? 0 : *yytop - *yybottom + 1;
+  YYPTRDIFF_T yysize_new = yysize_old + yyadd;
+  if (*yycapacity < yysize_new)
+    {
+      YYPTRDIFF_T yyalloc = 2 * yysize_new;
+      yy_state_t *yybottom_new;
+      /* Use YYMAXDEPTH for maximum stack size given that the stack
+         should never need to grow larger than the main state stack
+         needs to grow without LAC.  */
+      if (YYMAXDEPTH < yysize_new)
+        {
+          YYDPRINTF ((stderr, "%smax size exceeded%s", yydebug_prefix,
+                      yydebug_suffix));
+          return YYENOMEM;
+        }
+      if (YYMAXDEPTH < yyalloc)
+        yyalloc = YYMAXDEPTH;
+      yybottom_new =
+        YY_CAST (yy_state_t *,
+                 YYSTACK_ALLOC (YY_CAST (YYSIZE_T,
+                                         yyalloc * YYSIZEOF (*yybottom_new))));
+      if (!yybottom_new)
+        {
+          YYDPRINTF ((stderr, "%srealloc failed%s", yydebug_prefix,
+                      yydebug_suffix));
+          return YYENOMEM;
+        }
+      if (*yytop != yytop_empty)
+        {
+          YYCOPY (yybottom_new, *yybottom, yysize_old);
+          *yytop = yybottom_new + (yysize_old - 1);
+        }
+      if (*yybottom != yybottom_no_free)
+        YYSTACK_FREE (*yybottom);
+      *yybottom = yybottom_new;
+      *yycapacity = yyalloc;
+    }
+  return 0;
+}
+
+/* Establish the initial context for the current lookahead if no initial
+   context is currently established.
+
+   We define a context as a snapshot of the parser stacks.  We define
+   the initial context for a lookahead as the context in which the
+   parser initially examines that lookahead in order to select a
+   syntactic action.  Thus, if the lookahead eventually proves
+   syntactically unacceptable (possibly in a later context reached via a
+   series of reductions), the initial context can be used to determine
+   the exact set of tokens that would be syntactically acceptable in the
+   lookahead's place.  Moreover, it is the context after which any
+   further semantic actions would be erroneous because they would be
+   determined by a syntactically unacceptable token.
+
+   YY_LAC_ESTABLISH should be invoked when a reduction is about to be
+   performed in an inconsistent state (which, for the purposes of LAC,
+   includes consistent states that don't know they're consistent because
+   their default reductions have been disabled).  Iff there is a
+   lookahead token, it should also be invoked before reporting a syntax
+   error.  This latter case is for the sake of the debugging output.
+
+   For parse.lac=full, the implementation of YY_LAC_ESTABLISH is as
+   follows.  If no initial context is currently established for the
+   current lookahead, then check if that lookahead can eventually be
+   shifted if syntactic actions continue from the current context.
+   Report a syntax error if it cannot.  */
+#define YY_LAC_ESTABLISH                                                \
+do {                                                                    \
+  if (!yy_lac_established)                                              \
+    {                                                                   \
+      YYDPRINTF ((stderr,                                               \
+                  "LAC: initial context established for %s\n",          \
+                  yysymbol_name (yytoken)));                            \
+      yy_lac_established = 1;                                           \
+      switch (yy_lac (yyesa, &yyes, &yyes_capacity, yyssp, yytoken))    \
+        {                                                               \
+        case YYENOMEM:                                                  \
+          YYNOMEM;                                                      \
+        case 1:                                                         \
+          goto yyerrlab;                                                \
+        }                                                               \
+    }                                                                   \
+} while (0)
+
+/* Discard any previous initial lookahead context because of Event,
+   which may be a lookahead change or an invalidation of the currently
+   established initial context for the current lookahead.
+
+   The most common example of a lookahead change is a shift.  An example
+   of both cases is syntax error recovery.  That is, a syntax error
+   occurs when the lookahead is syntactically erroneous for the
+   currently established initial context, so error recovery manipulates
+   the parser stacks to try to find a new initial context in which the
+   current lookahead is syntactically acceptable.  If it fails to find
+   such a context, it discards the lookahead.  */
+#if YYDEBUG
+# define YY_LAC_DISCARD(Event)                                           \
+do {                                                                     \
+  if (yy_lac_established)                                                \
+    {                                                                    \
+      YYDPRINTF ((stderr, "LAC: initial context discarded due to "       \
+                  Event "\n"));                                          \
+      yy_lac_established = 0;                                            \
+    }                                                                    \
+} while (0)
+#else
+# define YY_LAC_DISCARD(Event) yy_lac_established = 0
+#endif
+
+/* Given the stack whose top is *YYSSP, return 0 iff YYTOKEN can
+   eventually (after perhaps some reductions) be shifted, return 1 if
+   not, or return YYENOMEM if memory is exhausted.  As preconditions and
+   postconditions: *YYES_CAPACITY is the allocated size of the array to
+   which *YYES points, and either *YYES = YYESA or *YYES points to an
+   array allocated with YYSTACK_ALLOC.  yy_lac may overwrite the
+   contents of either array, alter *YYES and *YYES_CAPACITY, and free
+   any old *YYES other than YYESA.  */
+static int
+yy_lac (yy_state_t *yyesa, yy_state_t **yyes,
+        YYPTRDIFF_T *yyes_capacity, yy_state_t *yyssp, yysymbol_kind_t yytoken)
+{
+  yy_state_t *yyes_prev = yyssp;
+  yy_state_t *yyesp = yyes_prev;
+  /* Reduce until we encounter a shift and thereby accept the token.  */
+  YYDPRINTF ((stderr, "LAC: checking lookahead %s:", yysymbol_name (yytoken)));
+  if (yytoken == YYSYMBOL_YYUNDEF)
+    {
+      YYDPRINTF ((stderr, " Always Err\n"));
+      return 1;
+    }
+  while (1)
+    {
+      int yyrule = yypact[+*yyesp];
+      if (yypact_value_is_default (yyrule)
+          || (yyrule += yytoken) < 0 || YYLAST < yyrule
+          || yycheck[yyrule] != yytoken)
+        {
+          /* Use the default action.  */
+          yyrule = yydefact[+*yyesp];
+          if (yyrule == 0)
+            {
+              YYDPRINTF ((stderr, " Err\n"));
+              return 1;
+            }
+        }
+      else
+        {
+          /* Use the action from yytable.  */
+          yyrule = yytable[yyrule];
+          if (yytable_value_is_error (yyrule))
+            {
+              YYDPRINTF ((stderr, " Err\n"));
+              return 1;
+            }
+          if (0 < yyrule)
+            {
+              YYDPRINTF ((stderr, " S%d\n", yyrule));
+              return 0;
+            }
+          yyrule = -yyrule;
+        }
+      /* By now we know we have to simulate a reduce.  */
+      YYDPRINTF ((stderr, " R%d", yyrule - 1));
+      {
+        /* Pop the corresponding number of values from the stack.  */
+        YYPTRDIFF_T yylen = yyr2[yyrule];
+        /* First pop from the LAC stack as many tokens as possible.  */
+        if (yyesp != yyes_prev)
+          {
+            YYPTRDIFF_T yysize = yyesp - *yyes + 1;
+            if (yylen < yysize)
+              {
+                yyesp -= yylen;
+                yylen = 0;
+              }
+            else
+              {
+                yyesp = yyes_prev;
+                yylen -= yysize;
+              }
+          }
+        /* Only afterwards look at the main stack.  */
+        if (yylen)
+          yyesp = yyes_prev -= yylen;
+      }
+      /* Push the resulting state of the reduction.  */
+      {
+        yy_state_fast_t yystate;
+        {
+          const int yylhs = yyr1[yyrule] - YYNTOKENS;
+          const int yyi = yypgoto[yylhs] + *yyesp;
+          yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyesp
+                     ? yytable[yyi]
+                     : yydefgoto[yylhs]);
+        }
+        if (yyesp == yyes_prev)
+          {
+            yyesp = *yyes;
+            YY_IGNORE_USELESS_CAST_BEGIN
+            *yyesp = YY_CAST (yy_state_t, yystate);
+            YY_IGNORE_USELESS_CAST_END
+          }
+        else
+          {
+            if (yy_lac_stack_realloc (yyes_capacity, 1,
+#if YYDEBUG
+                                      " (", ")",
+#endif
+                                      yyes, yyesa, &yyesp, yyes_prev))
+              {
+                YYDPRINTF ((stderr, "\n"));
+                return YYENOMEM;
+              }
+            YY_IGNORE_USELESS_CAST_BEGIN
+            *++yyesp = YY_CAST (yy_state_t, yystate);
+            YY_IGNORE_USELESS_CAST_END
+          }
+        YYDPRINTF ((stderr, " G%d", yystate));
+      }
+    }
+}
+
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yy_state_t *yyesa;
+  yy_state_t **yyes;
+  YYPTRDIFF_T *yyes_capacity;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+
+  int yyx;
+  for (yyx = 0; yyx < YYNTOKENS; ++yyx)
+    {
+      yysymbol_kind_t yysym = YY_CAST (yysymbol_kind_t, yyx);
+      if (yysym != YYSYMBOL_YYerror && yysym != YYSYMBOL_YYUNDEF)
+        switch (yy_lac (yyctx->yyesa, yyctx->yyes, yyctx->yyes_capacity, yyctx->yyssp, yysym))
+          {
+          case YYENOMEM:
+            return YYENOMEM;
+          case 1:
+            continue;
+          default:
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = yysym;
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
+/* Return the length of YYSTR.  */
+static YYPTRDIFF_T
+yystrlen (const char *yystr)
+{
+  YYPTRDIFF_T yylen;
+  for (yylen = 0; yystr[yylen]; yylen++)
+    continue;
+  return yylen;
+}
+# endif
+#endif
+
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
+/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
+   YYDEST.  */
+static char *
+yystpcpy (char *yydest, const char *yysrc)
+{
+  char *yyd = yydest;
+  const char *yys = yysrc;
+
+  while ((*yyd++ = *yys++) != '\0')
+    continue;
+
+  return yyd - 1;
+}
+# endif
+#endif
+
+
+
+static int
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  /* There are many possibilities here to consider:
+     - If this state is a consistent state with a default action, then
+       the only way this function was invoked is if the default action
+       is an error action.  In that case, don't check for expected
+       tokens because there are none.
+     - The only way there can be no lookahead present (in yychar) is if
+       this state is a consistent state with a default action.  Thus,
+       detecting the absence of a lookahead is sufficient to determine
+       that there is no unexpected or expected token to report.  In that
+       case, just report a simple "syntax error".
+     - Don't assume there isn't a lookahead just because this state is a
+       consistent state with a default action.  There might have been a
+       previous inconsistent state, consistent state with a non-default
+       action, or user semantic action that manipulated yychar.
+       In the first two cases, it might appear that the current syntax
+       error should have been detected in the previous state when yy_lac
+       was invoked.  However, at that time, there might have been a
+       different syntax error that discarded a different initial context
+       during error recovery, leaving behind the current lookahead.
+  */
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      YYDPRINTF ((stderr, "Constructing syntax error message\n"));
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else if (yyn == 0)
+        YYDPRINTF ((stderr, "No expected tokens.\n"));
+      else
+        yycount += yyn;
+    }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.  In order to see if a particular token T is a
+   valid looakhead, invoke yy_lac (YYESA, YYES, YYES_CAPACITY, YYSSP, T).
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store or if
+   yy_lac returned YYENOMEM.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
+
+  switch (yycount)
+    {
+#define YYCASE_(N, S)                       \
+      case N:                               \
+        yyformat = S;                       \
+        break
+    default: /* Avoid compiler warnings. */
+      YYCASE_(0, YY_("syntax error"));
+      YYCASE_(1, YY_("syntax error, unexpected %s"));
+      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
+      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+    }
+
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
+  {
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yystrlen (yysymbol_name (yyarg[yyi]));
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
+  }
+
+  if (*yymsg_alloc < yysize)
+    {
+      *yymsg_alloc = 2 * yysize;
+      if (! (yysize <= *yymsg_alloc
+             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
+        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
+      return -1;
+    }
+
+  /* Avoid sprintf, as that infringes on the user's name space.
+     Don't have undefined behavior even if the translation
+     produced a string with the wrong number of "%s"s.  */
+  {
+    char *yyp = *yymsg;
+    int yyi = 0;
+    while ((*yyp = *yyformat) != '\0')
+      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
+        {
+          yyp = yystpcpy (yyp, yysymbol_name (yyarg[yyi++]));
+          yyformat += 2;
+        }
+      else
+        {
+          ++yyp;
+          ++yyformat;
+        }
+  }
+  return 0;
+}
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, yyscan_t scanner)
+{
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (scanner);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (yyscan_t scanner)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+/* Location data for the lookahead symbol.  */
+static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+YYLTYPE yylloc = yyloc_default;
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+    /* The location stack: array, bottom, top.  */
+    YYLTYPE yylsa[YYINITDEPTH];
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
+
+    yy_state_t yyesa[20];
+    yy_state_t *yyes = yyesa;
+    YYPTRDIFF_T yyes_capacity = 20 < YYMAXDEPTH ? 20 : YYMAXDEPTH;
+
+  /* Whether LAC context is established.  A Boolean.  */
+  int yy_lac_established = 0;
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+  YYLTYPE yyloc;
+
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+  /* Buffer for error messages, and its allocated size.  */
+  char yymsgbuf[128];
+  char *yymsg = yymsgbuf;
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  yylsp[0] = yylloc;
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+        YYLTYPE *yyls1 = yyls;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+        yyls = yyls1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        YYSTACK_RELOCATE (yyls_alloc, yyls);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+      yylsp = yyls + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, &yylloc, scanner);
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    {
+      YY_LAC_ESTABLISH;
+      goto yydefault;
+    }
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      YY_LAC_ESTABLISH;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+  *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  YY_LAC_DISCARD ("shift");
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+  /* Default location. */
+  YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
+  YY_REDUCE_PRINT (yyn);
+  {
+    int yychar_backup = yychar;
+    switch (yyn)
+      {
+  case 2: /* ROOT: translation_unit  */
+#line 142 "src/parser.y"
+                           { yyget_extra(scanner)->root = new TranslationUnit(NodePtr((yyvsp[0].node_list))); }
+#line 2059 "build/parser.tab.cpp"
+    break;
+
+  case 3: /* translation_unit: external_declaration  */
+#line 145 "src/parser.y"
+                               { (yyval.node_list) = new NodeList(NodePtr((yyvsp[0].node))); }
+#line 2065 "build/parser.tab.cpp"
+    break;
+
+  case 4: /* translation_unit: translation_unit external_declaration  */
+#line 146 "src/parser.y"
+                                                {
+		(yyvsp[-1].node_list)->PushBack(NodePtr((yyvsp[0].node)));
+		(yyval.node_list) = (yyvsp[-1].node_list);
+	}
+#line 2074 "build/parser.tab.cpp"
+    break;
+
+  case 5: /* external_declaration: function_definition  */
+#line 153 "src/parser.y"
+                              { (yyval.node) = (yyvsp[0].node); }
+#line 2080 "build/parser.tab.cpp"
+    break;
+
+  case 6: /* external_declaration: declaration  */
+#line 154 "src/parser.y"
+                      { (yyval.node) = (yyvsp[0].node); }
+#line 2086 "build/parser.tab.cpp"
+    break;
+
+  case 7: /* function_definition: declaration_specifiers declarator compound_statement  */
+#line 158 "src/parser.y"
+                                                               {
+		(yyval.node) = new FunctionDefinition((yyvsp[-2].type_specifier), NodePtr((yyvsp[-1].node)), NodePtr((yyvsp[0].node)), (yyloc), (yylsp[0]));
+	}
+#line 2094 "build/parser.tab.cpp"
+    break;
+
+  case 8: /* function_definition: declarator compound_statement  */
+#line 161 "src/parser.y"
+                                        {
+		(yyval.node) = new FunctionDefinition(TypeSpecifier::INT, NodePtr((yyvsp[-1].node)), NodePtr((yyvsp[0].node)), (yyloc), (yylsp[0]));
+	}
+#line 2102 "build/parser.tab.cpp"
+    break;
+
+  case 9: /* declaration: declaration_specifiers init_declarator_list ';'  */
+#line 167 "src/parser.y"
+                                                          {
+		(yyval.node) = new Declaration((yyvsp[-2].type_specifier), NodePtr((yyvsp[-1].node_list)));
+	}
+#line 2110 "build/parser.tab.cpp"
+    break;
+
+  case 10: /* declaration: enum_declaration  */
+#line 170 "src/parser.y"
+                       { (yyval.node) = (yyvsp[0].node); }
+#line 2116 "build/parser.tab.cpp"
+    break;
+
+  case 11: /* declaration_specifiers: type_specifier  */
+#line 174 "src/parser.y"
+                         { (yyval.type_specifier) = (yyvsp[0].type_specifier); }
+#line 2122 "build/parser.tab.cpp"
+    break;
+
+  case 12: /* type_specifier: VOID  */
+#line 178 "src/parser.y"
+               {
+		(yyval.type_specifier) = TypeSpecifier::VOID;
+	}
+#line 2130 "build/parser.tab.cpp"
+    break;
+
+  case 13: /* type_specifier: INT  */
+#line 181 "src/parser.y"
+              {
+		(yyval.type_specifier) = TypeSpecifier::INT;
+	}
+#line 2138 "build/parser.tab.cpp"
+    break;
+
+  case 14: /* type_specifier: FLOAT  */
+#line 184 "src/parser.y"
+            {
+        (yyval.type_specifier) = TypeSpecifier::FLOAT;
+    }
+#line 2146 "build/parser.tab.cpp"
+    break;
+
+  case 15: /* type_specifier: DOUBLE  */
+#line 187 "src/parser.y"
+             {
+        (yyval.type_specifier) = TypeSpecifier::DOUBLE;
+    }
+#line 2154 "build/parser.tab.cpp"
+    break;
+
+  case 16: /* type_specifier: CHAR  */
+#line 190 "src/parser.y"
+               {
+		(yyval.type_specifier) = TypeSpecifier::CHAR;
+	}
+#line 2162 "build/parser.tab.cpp"
+    break;
+
+  case 17: /* type_specifier: UNSIGNED  */
+#line 193 "src/parser.y"
+                   {
+		(yyval.type_specifier) = TypeSpecifier::UNSIGNED;
+	}
+#line 2170 "build/parser.tab.cpp"
+    break;
+
+  case 18: /* init_declarator_list: init_declarator  */
+#line 199 "src/parser.y"
+                          {
+		(yyval.node_list) = new NodeList(NodePtr((yyvsp[0].node)));
+	}
+#line 2178 "build/parser.tab.cpp"
+    break;
+
+  case 19: /* init_declarator_list: init_declarator_list ',' init_declarator  */
+#line 202 "src/parser.y"
+                                                   {
+		(yyvsp[-2].node_list)->PushBack(NodePtr((yyvsp[0].node)));
+		(yyval.node_list) = (yyvsp[-2].node_list);
+	}
+#line 2187 "build/parser.tab.cpp"
+    break;
+
+  case 20: /* init_declarator: declarator  */
+#line 209 "src/parser.y"
+                     {(yyval.node) = new InitDeclarator(NodePtr((yyvsp[0].node)), nullptr);}
+#line 2193 "build/parser.tab.cpp"
+    break;
+
+  case 21: /* init_declarator: declarator '=' initializer  */
+#line 210 "src/parser.y"
+                                 { (yyval.node) = new InitDeclarator(NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node))); }
+#line 2199 "build/parser.tab.cpp"
+    break;
+
+  case 22: /* enum_declaration: enum_specifier ';'  */
+#line 214 "src/parser.y"
+                         { (yyval.node) = (yyvsp[-1].node); }
+#line 2205 "build/parser.tab.cpp"
+    break;
+
+  case 23: /* enum_specifier: ENUM IDENTIFIER '{' enumerator_list '}'  */
+#line 218 "src/parser.y"
+                                              { (yyval.node) = new EnumDeclaration((yyvsp[-3].symbol), NodePtr((yyvsp[-1].node_list))); }
+#line 2211 "build/parser.tab.cpp"
+    break;
+
+  case 24: /* enum_specifier: ENUM '{' enumerator_list '}'  */
+#line 219 "src/parser.y"
+                                   { (yyval.node) = new EnumDeclaration(SymbolId::EMPTY, NodePtr((yyvsp[-1].node_list))); }
+#line 2217 "build/parser.tab.cpp"
+    break;
+
+  case 25: /* enum_specifier: ENUM IDENTIFIER  */
+#line 220 "src/parser.y"
+                      { (yyval.node) = new EnumDeclaration((yyvsp[0].symbol), nullptr); }
+#line 2223 "build/parser.tab.cpp"
+    break;
+
+  case 26: /* enumerator_list: enumerator  */
+#line 224 "src/parser.y"
+                 { (yyval.node_list) = new NodeList(NodePtr((yyvsp[0].node))); }
+#line 2229 "build/parser.tab.cpp"
+    break;
+
+  case 27: /* enumerator_list: enumerator_list ',' enumerator  */
+#line 225 "src/parser.y"
+                                     { (yyvsp[-2].node_list)->PushBack(NodePtr((yyvsp[0].node))); (yyval.node_list) = (yyvsp[-2].node_list); }
+#line 2235 "build/parser.tab.cpp"
+    break;
+
+  case 28: /* enumerator: IDENTIFIER  */
+#line 229 "src/parser.y"
+                 { (yyval.node) = new Enumerator((yyvsp[0].symbol), nullptr); }
+#line 2241 "build/parser.tab.cpp"
+    break;
+
+  case 29: /* enumerator: IDENTIFIER '=' conditional_expression  */
+#line 230 "src/parser.y"
+                                            { (yyval.node) = new Enumerator((yyvsp[-2].symbol), NodePtr((yyvsp[0].node))); }
+#line 2247 "build/parser.tab.cpp"
+    break;
+
+  case 30: /* declarator: pointer direct_declarator  */
+#line 234 "src/parser.y"
+                                    {(yyval.node) = new PointerDeclarator((yyvsp[-1].number_int), NodePtr((yyvsp[0].node)));}
+#line 2253 "build/parser.tab.cpp"
+    break;
+
+  case 32: /* direct_declarator: IDENTIFIER  */
+#line 239 "src/parser.y"
+                     {
+		(yyval.node) = new Identifier((yyvsp[0].symbol));
+	}
+#line 2261 "build/parser.tab.cpp"
+    break;
+
+  case 33: /* direct_declarator: direct_declarator '(' ')'  */
+#line 242 "src/parser.y"
+                                    {
+		(yyval.node) = new DirectDeclarator(NodePtr((yyvsp[-2].node)), nullptr);
+	}
+#line 2269 "build/parser.tab.cpp"
+    break;
+
+  case 34: /* direct_declarator: direct_declarator '(' parameter_list ')'  */
+#line 245 "src/parser.y"
+                                                   {
+		(yyval.node) = new DirectDeclarator(NodePtr((yyvsp[-3].node)), NodePtr((yyvsp[-1].node_list)));
+	}
+#line 2277 "build/parser.tab.cpp"
+    break;
+
+  case 35: /* direct_declarator: direct_declarator '[' ']'  */
+#line 248 "src/parser.y"
+                                    {
+		(yyval.node) = new ArrayDeclarator(NodePtr((yyvsp[-2].node)), nullptr);
+	}
+#line 2285 "build/parser.tab.cpp"
+    break;
+
+  case 36: /* direct_declarator: direct_declarator '[' conditional_expression ']'  */
+#line 251 "src/parser.y"
+                                                           {
+		(yyval.node) = new ArrayDeclarator(NodePtr((yyvsp[-3].node)), NodePtr((yyvsp[-1].node)));
+	}
+#line 2293 "build/parser.tab.cpp"
+    break;
+
+  case 37: /* pointer: '*'  */
+#line 257 "src/parser.y"
+              { (yyval.number_int) = 1;}
+#line 2299 "build/parser.tab.cpp"
+    break;
+
+  case 38: /* pointer: '*' pointer  */
+#line 258 "src/parser.y"
+                      { (yyval.number_int) = (yyvsp[0].number_int) + 1; }
+#line 2305 "build/parser.tab.cpp"
+    break;
+
+  case 39: /* parameter_list: parameter_declaration  */
+#line 262 "src/parser.y"
+                                {(yyval.node_list) = new NodeList(NodePtr((yyvsp[0].node)));}
+#line 2311 "build/parser.tab.cpp"
+    break;
+
+  case 40: /* parameter_list: parameter_list ',' parameter_declaration  */
+#line 263 "src/parser.y"
+                                                   {(yyvsp[-2].node_list)->PushBack(NodePtr((yyvsp[0].node))); (yyval.node_list) = (yyvsp[-2].node_list);}
+#line 2317 "build/parser.tab.cpp"
+    break;
+
+  case 41: /* parameter_declaration: declaration_specifiers declarator  */
+#line 267 "src/parser.y"
+                                            { (yyval.node) = new ParameterDeclaration((yyvsp[-1].type_specifier), NodePtr((yyvsp[0].node))); }
+#line 2323 "build/parser.tab.cpp"
+    break;
+
+  case 42: /* initializer: assignment_expression  */
+#line 273 "src/parser.y"
+                                { (yyval.node) = (yyvsp[0].node); }
+#line 2329 "build/parser.tab.cpp"
+    break;
+
+  case 43: /* initializer: '{' initializer_list '}'  */
+#line 274 "src/parser.y"
+                                   { (yyval.node) = (yyvsp[-1].node_list); }
+#line 2335 "build/parser.tab.cpp"
+    break;
+
+  case 44: /* initializer_list: initializer  */
+#line 279 "src/parser.y"
+                      { (yyval.node_list) = new NodeList(NodePtr((yyvsp[0].node))); }
+#line 2341 "build/parser.tab.cpp"
+    break;
+
+  case 45: /* initializer_list: initializer_list ',' initializer  */
+#line 280 "src/parser.y"
+                                           { (yyvsp[-2].node_list)->PushBack(NodePtr((yyvsp[0].node))); (yyval.node_list)=(yyvsp[-2].node_list); }
+#line 2347 "build/parser.tab.cpp"
+    break;
+
+  case 53: /* labeled_statement: CASE conditional_expression ':' statement  */
+#line 294 "src/parser.y"
+                                                    { NodeList *statement = new NodeList(NodePtr((yyvsp[0].node)));
+												  (yyval.node) = new CaseStatement(NodePtr((yyvsp[-2].node)), NodePtr(new Scope(std::move(*statement))));
+												  delete statement; }
+#line 2355 "build/parser.tab.cpp"
+    break;
+
+  case 54: /* labeled_statement: DEFAULT ':' statement  */
+#line 297 "src/parser.y"
+                                { (yyval.node) = new DefaultStatement(NodePtr((yyvsp[0].node))); }
+#line 2361 "build/parser.tab.cpp"
+    break;
+
+  case 55: /* compound_statement: '{' statement_list '}'  */
+#line 301 "src/parser.y"
+                             { (yyval.node) = new Scope(std::move(*(yyvsp[-1].node_list))); delete (yyvsp[-1].node_list); }
+#line 2367 "build/parser.tab.cpp"
+    break;
+
+  case 56: /* compound_statement: '{' '}'  */
+#line 302 "src/parser.y"
+                  { (yyval.node) = new NodeList(nullptr); }
+#line 2373 "build/parser.tab.cpp"
+    break;
+
+  case 57: /* statement_list: statement  */
+#line 306 "src/parser.y"
+                    { (yyval.node_list) = new NodeList(NodePtr((yyvsp[0].node))); }
+#line 2379 "build/parser.tab.cpp"
+    break;
+
+  case 58: /* statement_list: statement_list statement  */
+#line 307 "src/parser.y"
+                                   { (yyvsp[-1].node_list)->PushBack(NodePtr((yyvsp[0].node))); (yyval.node_list)=(yyvsp[-1].node_list); }
+#line 2385 "build/parser.tab.cpp"
+    break;
+
+  case 59: /* expression_statement: ';'  */
+#line 311 "src/parser.y"
+              { (yyval.node) = nullptr; }
+#line 2391 "build/parser.tab.cpp"
+    break;
+
+  case 60: /* expression_statement: expression ';'  */
+#line 312 "src/parser.y"
+                         { (yyval.node) = (yyvsp[-1].node); }
+#line 2397 "build/parser.tab.cpp"
+    break;
+
+  case 61: /* selection_statement: IF '(' expression ')' statement  */
+#line 316 "src/parser.y"
+                                          {
+		(yyval.node) = new IfStatement(NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)), NodePtr(nullptr));
+	}
+#line 2405 "build/parser.tab.cpp"
+    break;
+
+  case 62: /* selection_statement: IF '(' expression ')' statement ELSE statement  */
+#line 319 "src/parser.y"
+                                                         {
+		(yyval.node) = new IfStatement(NodePtr((yyvsp[-4].node)), NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));
+	}
+#line 2413 "build/parser.tab.cpp"
+    break;
+
+  case 63: /* selection_statement: SWITCH '(' expression ')' statement  */
+#line 322 "src/parser.y"
+                                              {
+		(yyval.node) = new SwitchStatement(NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));
+	}
+#line 2421 "build/parser.tab.cpp"
+    break;
+
+  case 64: /* iteration_statement: WHILE '(' expression ')' statement  */
+#line 328 "src/parser.y"
+                                             {
+		(yyval.node) = new WhileLoop(NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));
+	}
+#line 2429 "build/parser.tab.cpp"
+    break;
+
+  case 65: /* iteration_statement: FOR '(' expression_statement expression_statement expression ')' statement  */
+#line 331 "src/parser.y"
+                                                                                     {
+		(yyval.node) = new ForStatement(NodePtr((yyvsp[-4].node)), NodePtr((yyvsp[-3].node)), NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));
+	}
+#line 2437 "build/parser.tab.cpp"
+    break;
+
+  case 66: /* jump_statement: RETURN ';'  */
+#line 337 "src/parser.y"
+                                         { (yyval.node) = new ReturnStatement(nullptr);	}
+#line 2443 "build/parser.tab.cpp"
+    break;
+
+  case 67: /* jump_statement: RETURN expression ';'  */
+#line 338 "src/parser.y"
+                                 { (yyval.node) = new ReturnStatement(NodePtr((yyvsp[-1].node))); }
+#line 2449 "build/parser.tab.cpp"
+    break;
+
+  case 68: /* jump_statement: CONTINUE ';'  */
+#line 339 "src/parser.y"
+                                         { (yyval.node) = new ContinueStatement(); }
+#line 2455 "build/parser.tab.cpp"
+    break;
+
+  case 69: /* jump_statement: BREAK ';'  */
+#line 340 "src/parser.y"
+                                         { (yyval.node) = new BreakStatement(); }
+#line 2461 "build/parser.tab.cpp"
+    break;
+
+  case 70: /* primary_expression: IDENTIFIER  */
+#line 344 "src/parser.y"
+                     {
+		(yyval.node) = new Identifier((yyvsp[0].symbol));
+	}
+#line 2469 "build/parser.tab.cpp"
+    break;
+
+  case 71: /* primary_expression: INT_CONSTANT  */
+#line 347 "src/parser.y"
+                       {
+		std::string raw_str = yyget_text(scanner);
+		(yyval.node) = new IntConstant((yyvsp[0].number_int), raw_str);
+	}
+#line 2478 "build/parser.tab.cpp"
+    break;
+
+  case 72: /* primary_expression: FLOAT_CONSTANT  */
+#line 351 "src/parser.y"
+                     {
+		std::string raw_str = yyget_text(scanner);
+        (yyval.node) = new FloatConstant((yyvsp[0].number_float), raw_str);
+    }
+#line 2487 "build/parser.tab.cpp"
+    break;
+
+  case 73: /* primary_expression: CHAR_LITERAL  */
+#line 355 "src/parser.y"
+                       {
+		(yyval.node) = new CharLiteral((yyvsp[0].symbol));
+	}
+#line 2495 "build/parser.tab.cpp"
+    break;
+
+  case 74: /* primary_expression: STRING_LITERAL  */
+#line 358 "src/parser.y"
+                         {
+		(yyval.node) = new StringLiteral((yyvsp[0].symbol));
+	}
+#line 2503 "build/parser.tab.cpp"
+    break;
+
+  case 75: /* primary_expression: '(' expression ')'  */
+#line 361 "src/parser.y"
+                             {(yyval.node) = (yyvsp[-1].node);}
+#line 2509 "build/parser.tab.cpp"
+    break;
+
+  case 77: /* postfix_expression: postfix_expression '(' ')'  */
+#line 366 "src/parser.y"
+                                 {(yyval.node) = new FunctionCall(NodePtr((yyvsp[-2].node)), nullptr);}
+#line 2515 "build/parser.tab.cpp"
+    break;
+
+  case 78: /* postfix_expression: postfix_expression '(' argument_expression_list ')'  */
+#line 367 "src/parser.y"
+                                                          {(yyval.node) = new FunctionCall(NodePtr((yyvsp[-3].node)), NodePtr((yyvsp[-1].node_list)));}
+#line 2521 "build/parser.tab.cpp"
+    break;
+
+  case 79: /* postfix_expression: postfix_expression INC_OP  */
+#line 368 "src/parser.y"
+                                    {(yyval.node) = new PostIncAndDecOp('+', NodePtr((yyvsp[-1].node)));}
+#line 2527 "build/parser.tab.cpp"
+    break;
+
+  case 80: /* postfix_expression: postfix_expression DEC_OP  */
+#line 369 "src/parser.y"
+                                    {(yyval.node) = new PostIncAndDecOp('-', NodePtr((yyvsp[-1].node)));}
+#line 2533 "build/parser.tab.cpp"
+    break;
+
+  case 81: /* postfix_expression: postfix_expression '[' expression ']'  */
+#line 370 "src/parser.y"
+                                                {(yyval.node) = new ArrayIndex(NodePtr((yyvsp[-3].node)), NodePtr((yyvsp[-1].node)));}
+#line 2539 "build/parser.tab.cpp"
+    break;
+
+  case 82: /* argument_expression_list: assignment_expression  */
+#line 374 "src/parser.y"
+                                { (yyval.node_list) = new NodeList(NodePtr((yyvsp[0].node))); }
+#line 2545 "build/parser.tab.cpp"
+    break;
+
+  case 83: /* argument_expression_list: argument_expression_list ',' assignment_expression  */
+#line 375 "src/parser.y"
+                                                             { (yyvsp[-2].node_list)->PushBack(NodePtr((yyvsp[0].node))); (yyval.node_list) = (yyvsp[-2].node_list); }
+#line 2551 "build/parser.tab.cpp"
+    break;
+
+  case 85: /* unary_expression: INC_OP unary_expression  */
+#line 380 "src/parser.y"
+                                  {
+		(yyval.node) = new PreIncAndDecOp('+', NodePtr((yyvsp[0].node)));
+	}
+#line 2559 "build/parser.tab.cpp"
+    break;
+
+  case 86: /* unary_expression: DEC_OP unary_expression  */
+#line 383 "src/parser.y"
+                                  {
+		(yyval.node) = new PreIncAndDecOp('-', NodePtr((yyvsp[0].node)));
+	}
+#line 2567 "build/parser.tab.cpp"
+    break;
+
+  case 87: /* unary_expression: '-' cast_expression  */
+#line 386 "src/parser.y"
+                              {
+		(yyval.node) = new UnaryMinusOp(NodePtr((yyvsp[0].node)));
+    }
+#line 2575 "build/parser.tab.cpp"
+    break;
+
+  case 88: /* unary_expression: '+' cast_expression  */
+#line 389 "src/parser.y"
+                          {
+        (yyval.node) = new UnaryPlusOp(NodePtr((yyvsp[0].node)));
+    }
+#line 2583 "build/parser.tab.cpp"
+    break;
+
+  case 89: /* unary_expression: '!' cast_expression  */
+#line 392 "src/parser.y"
+                          {
+        (yyval.node) = new UnaryLogicalNotOp(NodePtr((yyvsp[0].node)));
+    }
+#line 2591 "build/parser.tab.cpp"
+    break;
+
+  case 90: /* unary_expression: '~' cast_expression  */
+#line 395 "src/parser.y"
+                          {
+        (yyval.node) = new UnaryBitwiseNotOp(NodePtr((yyvsp[0].node)));
+    }
+#line 2599 "build/parser.tab.cpp"
+    break;
+
+  case 91: /* unary_expression: '&' cast_expression  */
+#line 398 "src/parser.y"
+                              {
+		(yyval.node) = new UnaryAddressOp(NodePtr((yyvsp[0].node)));
+	}
+#line 2607 "build/parser.tab.cpp"
+    break;
+
+  case 92: /* unary_expression: '*' cast_expression  */
+#line 401 "src/parser.y"
+                              {
+		(yyval.node) = new UnaryDereferenceOp(NodePtr((yyvsp[0].node)));
+	}
+#line 2615 "build/parser.tab.cpp"
+    break;
+
+  case 93: /* unary_expression: SIZEOF '(' unary_expression ')'  */
+#line 404 "src/parser.y"
+                                          {
+		(yyval.node) = new SizeOfVar(NodePtr((yyvsp[-1].node)));
+	}
+#line 2623 "build/parser.tab.cpp"
+    break;
+
+  case 94: /* unary_expression: SIZEOF '(' type_specifier ')'  */
+#line 407 "src/parser.y"
+                                        {
+		(yyval.node) = new SizeOfType((yyvsp[-1].type_specifier));
+	}
+#line 2631 "build/parser.tab.cpp"
+    break;
+
+  case 97: /* multiplicative_expression: multiplicative_expression '*' cast_expression  */
+#line 420 "src/parser.y"
+                                                        {
+		(yyval.node) = new BinaryOp('*', NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));
+	}
+#line 2639 "build/parser.tab.cpp"
+    break;
+
+  case 98: /* multiplicative_expression: multiplicative_expression '/' cast_expression  */
+#line 423 "src/parser.y"
+                                                        {
+		(yyval.node) = new BinaryOp('/', NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));
+	}
+#line 2647 "build/parser.tab.cpp"
+    break;
+
+  case 99: /* multiplicative_expression: multiplicative_expression '%' cast_expression  */
+#line 426 "src/parser.y"
+                                                        {
+		(yyval.node) = new BinaryOp('%', NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));
+	}
+#line 2655 "build/parser.tab.cpp"
+    break;
+
+  case 101: /* additive_expression: additive_expression '+' multiplicative_expression  */
+#line 433 "src/parser.y"
+                                                            {(yyval.node) = new BinaryOp('+', NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));}
+#line 2661 "build/parser.tab.cpp"
+    break;
+
+  case 102: /* additive_expression: additive_expression '-' multiplicative_expression  */
+#line 434 "src/parser.y"
+                                                            {(yyval.node) = new BinaryOp('-', NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));}
+#line 2667 "build/parser.tab.cpp"
+    break;
+
+  case 104: /* shift_expression: shift_expression LEFT_OP additive_expression  */
+#line 439 "src/parser.y"
+                                                       {(yyval.node) = new BinaryOp('l', NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));}
+#line 2673 "build/parser.tab.cpp"
+    break;
+
+  case 105: /* shift_expression: shift_expression RIGHT_OP additive_expression  */
+#line 440 "src/parser.y"
+                                                        {(yyval.node) = new BinaryOp('r', NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));}
+#line 2679 "build/parser.tab.cpp"
+    break;
+
+  case 107: /* relational_expression: relational_expression '<' shift_expression  */
+#line 445 "src/parser.y"
+                                                     {(yyval.node) = new LessThan(NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));}
+#line 2685 "build/parser.tab.cpp"
+    break;
+
+  case 108: /* relational_expression: relational_expression '>' shift_expression  */
+#line 446 "src/parser.y"
+                                                     {(yyval.node) = new GreaterThan(NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));}
+#line 2691 "build/parser.tab.cpp"
+    break;
+
+  case 109: /* relational_expression: relational_expression LE_OP shift_expression  */
+#line 447 "src/parser.y"
+                                                       {(yyval.node) = new LessThanEqual(NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));}
+#line 2697 "build/parser.tab.cpp"
+    break;
+
+  case 110: /* relational_expression: relational_expression GE_OP shift_expression  */
+#line 448 "src/parser.y"
+                                                       {(yyval.node) = new GreaterThanEqual(NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));}
+#line 2703 "build/parser.tab.cpp"
+    break;
+
+  case 112: /* equality_expression: equality_expression EQ_OP relational_expression  */
+#line 453 "src/parser.y"
+                                                          {(yyval.node) = new Equal(NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));}
+#line 2709 "build/parser.tab.cpp"
+    break;
+
+  case 113: /* equality_expression: equality_expression NE_OP relational_expression  */
+#line 454 "src/parser.y"
+                                                          {(yyval.node) = new NotEqual(NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));}
+#line 2715 "build/parser.tab.cpp"
+    break;
+
+  case 115: /* and_expression: and_expression '&' equality_expression  */
+#line 459 "src/parser.y"
+                                                 {(yyval.node) =new BinaryOp('&', NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));}
+#line 2721 "build/parser.tab.cpp"
+    break;
+
+  case 117: /* exclusive_or_expression: exclusive_or_expression '^' and_expression  */
+#line 464 "src/parser.y"
+                                                     {(yyval.node) = new BinaryOp('^', NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));}
+#line 2727 "build/parser.tab.cpp"
+    break;
+
+  case 119: /* inclusive_or_expression: inclusive_or_expression '|' exclusive_or_expression  */
+#line 469 "src/parser.y"
+                                                              {(yyval.node) = new BinaryOp('|', NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));}
+#line 2733 "build/parser.tab.cpp"
+    break;
+
+  case 121: /* logical_and_expression: logical_and_expression AND_OP inclusive_or_expression  */
+#line 474 "src/parser.y"
+                                                                {
+		(yyval.node) = new LogicalAnd(NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));
+	}
+#line 2741 "build/parser.tab.cpp"
+    break;
+
+  case 123: /* logical_or_expression: logical_or_expression OR_OP logical_and_expression  */
+#line 481 "src/parser.y"
+                                                             {
+		(yyval.node) = new LogicalOr(NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));
+	}
+#line 2749 "build/parser.tab.cpp"
+    break;
+
+  case 125: /* conditional_expression: logical_or_expression '?' expression ':' conditional_expression  */
+#line 488 "src/parser.y"
+                                                                          {
+		(yyval.node) = new IfStatement(NodePtr((yyvsp[-4].node)), NodePtr((yyvsp[-2].node)), NodePtr((yyvsp[0].node)));
+	}
+#line 2757 "build/parser.tab.cpp"
+    break;
+
+  case 127: /* assignment_expression: unary_expression assignment_operator assignment_expression  */
+#line 495 "src/parser.y"
+                                                                     {
+		(yyval.node) = new Assignment(NodePtr((yyvsp[-2].node)), *(yyvsp[-1].string), NodePtr((yyvsp[0].node)));
+		delete (yyvsp[-1].string);
+	}
+#line 2766 "build/parser.tab.cpp"
+    break;
+
+  case 128: /* assignment_operator: '='  */
+#line 502 "src/parser.y"
+                        {(yyval.string) = new std::string("=");}
+#line 2772 "build/parser.tab.cpp"
+    break;
+
+  case 129: /* assignment_operator: MUL_ASSIGN  */
+#line 503 "src/parser.y"
+                        {(yyval.string) = new std::string("*=");}
+#line 2778 "build/parser.tab.cpp"
+    break;
+
+  case 130: /* assignment_operator: DIV_ASSIGN  */
+#line 504 "src/parser.y"
+                        {(yyval.string) = new std::string("/=");}
+#line 2784 "build/parser.tab.cpp"
+    break;
+
+  case 131: /* assignment_operator: MOD_ASSIGN  */
+#line 505 "src/parser.y"
+                        {(yyval.string) = new std::string("%=");}
+#line 2790 "build/parser.tab.cpp"
+    break;
+
+  case 132: /* assignment_operator: ADD_ASSIGN  */
+#line 506 "src/parser.y"
+                        {(yyval.string) = new std::string("+=");}
+#line 2796 "build/parser.tab.cpp"
+    break;
+
+  case 133: /* assignment_operator: SUB_ASSIGN  */
+#line 507 "src/parser.y"
+                        {(yyval.string) = new std::string("-=");}
+#line 2802 "build/parser.tab.cpp"
+    break;
+
+  case 134: /* assignment_operator: LEFT_ASSIGN  */
+#line 508 "src/parser.y"
+                        {(yyval.string) = new std::string("<<=");}
+#line 2808 "build/parser.tab.cpp"
+    break;
+
+  case 135: /* assignment_operator: RIGHT_ASSIGN  */
+#line 509 "src/parser.y"
+                        {(yyval.string) = new std::string(">>=");}
+#line 2814 "build/parser.tab.cpp"
+    break;
+
+  case 136: /* assignment_operator: AND_ASSIGN  */
+#line 510 "src/parser.y"
+                        {(yyval.string) = new std::string("&=");}
+#line 2820 "build/parser.tab.cpp"
+    break;
+
+  case 137: /* assignment_operator: XOR_ASSIGN  */
+#line 511 "src/parser.y"
+                        {(yyval.string) = new std::string("^=");}
+#line 2826 "build/parser.tab.cpp"
+    break;
+
+  case 138: /* assignment_operator: OR_ASSIGN  */
+#line 512 "src/parser.y"
+                        {(yyval.string) = new std::string("|=");}
+#line 2832 "build/parser.tab.cpp"
+    break;
+
+
+#line 2836 "build/parser.tab.cpp"
+
+        default: break;
+      }
+    if (yychar_backup != yychar)
+      YY_LAC_DISCARD ("yychar change");
+  }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+  *++yylsp = yyloc;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      {
+        yypcontext_t yyctx
+          = {yyssp, yyesa, &yyes, &yyes_capacity, yytoken, &yylloc};
+        char const *yymsgp = YY_("syntax error");
+        int yysyntax_error_status;
+        if (yychar != YYEMPTY)
+          YY_LAC_ESTABLISH;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+        if (yysyntax_error_status == 0)
+          yymsgp = yymsg;
+        else if (yysyntax_error_status == -1)
+          {
+            if (yymsg != yymsgbuf)
+              YYSTACK_FREE (yymsg);
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
+              {
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
+              }
+            else
+              {
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
+              }
+          }
+        yyerror (&yylloc, scanner, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
+      }
+    }
+
+  yyerror_range[1] = yylloc;
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, &yylloc, scanner);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+      yyerror_range[1] = *yylsp;
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, scanner);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  /* If the stack popping above didn't lose the initial context for the
+     current lookahead token, the shift below will for sure.  */
+  YY_LAC_DISCARD ("error recovery");
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  yyerror_range[2] = yylloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (&yylloc, scanner, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, &yylloc, scanner);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, scanner);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+  if (yyes != yyesa)
+    YYSTACK_FREE (yyes);
+  if (yymsg != yymsgbuf)
+    YYSTACK_FREE (yymsg);
+  return yyresult;
+}
+
+#line 519 "src/parser.y"
+
+
+#include <sstream>
+#include <stdexcept>
+
+#include "source_file.hpp"
+
+void yyerror (YYLTYPE *location, yyscan_t scanner, const char *s)
+{
+  (void)location;
+  // recorded rather than printed, so that a bad file ends its parse and not the process
+  std::ostringstream message;
+  message << "Error: " << s << " at line " << yyget_lineno(scanner);
+  message << " near '" << yyget_text(scanner) << "'";
+  yyget_extra(scanner)->error = message.str();
+}
+
+NodePtr ParseAST(std::string file_name)
+{
+  // regular files are lexed straight from a mapping of the file, anything else is streamed
+  SourceFile source(file_name);
+
+  ParseState state;
+  if (yylex_init_extra(&state, &state.scanner) != 0) {
+    throw std::runtime_error("Couldn't create a scanner for " + file_name);
+  }
+  if (source.IsMapped()) {
+    ScanBuffer(source.Data(), source.Size(), state.scanner);
+  } else {
+    yyset_in(source.Stream(), state.scanner);
+  }
+
+  int status = yyparse(state.scanner);
+
+  yylex_destroy(state.scanner);
+
+  if (status != 0) {
+    throw std::runtime_error(state.error.empty() ? "Error: parsing failed" : state.error);
+  }
+
+  return NodePtr(state.root);
+}
+
+void SetParserTrace(bool trace)
+{
+  yydebug = trace;
+}
@@ -0,0 +1,198 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_BUILD_PARSER_TAB_HPP_INCLUDED
+# define YY_YY_BUILD_PARSER_TAB_HPP_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 1
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+/* "%code requires" blocks.  */
+#line 8 "src/parser.y"
+
+    #include "ast.hpp"
+    #include "source_file.hpp"
+    #include <algorithm>
+    #include <memory>
+
+	using namespace ast;
+
+	#ifndef YY_TYPEDEF_YY_SCANNER_T
+	#define YY_TYPEDEF_YY_SCANNER_T
+	typedef void* yyscan_t;
+	#endif
+
+	// State of one parse, reached from the scanner through yyextra. Nothing is shared between
+	// parses, so several files can be parsed at once on different threads.
+	struct ParseState {
+		yyscan_t scanner = nullptr;
+		Node* root = nullptr;  // set once the whole translation unit has been reduced
+		std::string error;     // message of the syntax error that ended the parse
+		size_t offset = 0;     // bytes scanned so far; locations are byte offsets into the source
+		// the parser stacks once they outgrow the ones yyparse starts with, freed with the parse
+		std::shared_ptr<void> states, values, locations;
+	};
+
+	int yylex_init_extra(ParseState* extra, yyscan_t* scanner);
+	int yylex_destroy(yyscan_t scanner);
+	void yyset_in(FILE* in, yyscan_t scanner);
+	ParseState* yyget_extra(yyscan_t scanner);
+	char* yyget_text(yyscan_t scanner);
+	int yyget_lineno(yyscan_t scanner);
+	void ScanBuffer(char *buffer, size_t size, yyscan_t scanner);
+
+
+#line 83 "build/parser.tab.hpp"
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    IDENTIFIER = 258,              /* IDENTIFIER  */
+    INT_CONSTANT = 259,            /* INT_CONSTANT  */
+    FLOAT_CONSTANT = 260,          /* FLOAT_CONSTANT  */
+    STRING_LITERAL = 261,          /* STRING_LITERAL  */
+    CHAR_LITERAL = 262,            /* CHAR_LITERAL  */
+    PTR_OP = 263,                  /* PTR_OP  */
+    INC_OP = 264,                  /* INC_OP  */
+    DEC_OP = 265,                  /* DEC_OP  */
+    LEFT_OP = 266,                 /* LEFT_OP  */
+    RIGHT_OP = 267,                /* RIGHT_OP  */
+    LE_OP = 268,                   /* LE_OP  */
+    GE_OP = 269,                   /* GE_OP  */
+    EQ_OP = 270,                   /* EQ_OP  */
+    NE_OP = 271,                   /* NE_OP  */
+    AND_OP = 272,                  /* AND_OP  */
+    OR_OP = 273,                   /* OR_OP  */
+    MUL_ASSIGN = 274,              /* MUL_ASSIGN  */
+    DIV_ASSIGN = 275,              /* DIV_ASSIGN  */
+    MOD_ASSIGN = 276,              /* MOD_ASSIGN  */
+    ADD_ASSIGN = 277,              /* ADD_ASSIGN  */
+    SUB_ASSIGN = 278,              /* SUB_ASSIGN  */
+    LEFT_ASSIGN = 279,             /* LEFT_ASSIGN  */
+    RIGHT_ASSIGN = 280,            /* RIGHT_ASSIGN  */
+    AND_ASSIGN = 281,              /* AND_ASSIGN  */
+    XOR_ASSIGN = 282,              /* XOR_ASSIGN  */
+    OR_ASSIGN = 283,               /* OR_ASSIGN  */
+    TYPE_NAME = 284,               /* TYPE_NAME  */
+    TYPEDEF = 285,                 /* TYPEDEF  */
+    EXTERN = 286,                  /* EXTERN  */
+    STATIC = 287,                  /* STATIC  */
+    AUTO = 288,                    /* AUTO  */
+    REGISTER = 289,                /* REGISTER  */
+    SIZEOF = 290,                  /* SIZEOF  */
+    CHAR = 291,                    /* CHAR  */
+    SHORT = 292,                   /* SHORT  */
+    INT = 293,                     /* INT  */
+    LONG = 294,                    /* LONG  */
+    SIGNED = 295,                  /* SIGNED  */
+    UNSIGNED = 296,                /* UNSIGNED  */
+    FLOAT = 297,                   /* FLOAT  */
+    DOUBLE = 298,                  /* DOUBLE  */
+    CONST = 299,                   /* CONST  */
+    VOLATILE = 300,                /* VOLATILE  */
+    VOID = 301,                    /* VOID  */
+    STRUCT = 302,                  /* STRUCT  */
+    UNION = 303,                   /* UNION  */
+    ENUM = 304,                    /* ENUM  */
+    ELLIPSIS = 305,                /* ELLIPSIS  */
+    CASE = 306,                    /* CASE  */
+    DEFAULT = 307,                 /* DEFAULT  */
+    IF = 308,                      /* IF  */
+    ELSE = 309,                    /* ELSE  */
+    SWITCH = 310,                  /* SWITCH  */
+    WHILE = 311,                   /* WHILE  */
+    DO = 312,                      /* DO  */
+    FOR = 313,                     /* FOR  */
+    GOTO = 314,                    /* GOTO  */
+    CONTINUE = 315,                /* CONTINUE  */
+    BREAK = 316,                   /* BREAK  */
+    RETURN = 317,                  /* RETURN  */
+    UNKNOWN = 318,                 /* UNKNOWN  */
+    NOELSE = 319                   /* NOELSE  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 98 "src/parser.y"
+
+  Node*				    node;
+  NodeList*			  node_list;
+  int          		number_int;
+  double       		number_float;
+  std::string*		string; // assignment operator
+  SymbolId		    symbol; // interned identifier or literal
+  TypeSpecifier 	type_specifier;
+  yytokentype  		token;
+
+#line 175 "build/parser.tab.hpp"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+/* Location type.  */
+typedef SourceSpan YYLTYPE;
+
+
+
+
+int yyparse (yyscan_t scanner);
+
+/* "%code provides" blocks.  */
+#line 42 "src/parser.y"
+
+	int yylex(YYSTYPE* yylval_param, YYLTYPE* yylloc_param, yyscan_t scanner);
+	void yyerror(YYLTYPE* location, yyscan_t scanner, const char*);
+
+#line 197 "build/parser.tab.hpp"
+
+#endif /* !YY_YY_BUILD_PARSER_TAB_HPP_INCLUDED  */
@@ -0,0 +1,11 @@
+int g[4];
+double h[3];
+
+int f()
+{
+    g[0]=3;
+    g[3]=g[0]*5;
+    h[2]=0.5;
+    h[1]=h[2]*3;
+    return g[3];
+}
@@ -0,0 +1,11 @@
+extern int g[4];
+extern double h[3];
+
+int f();
+
+int main()
+{
+    g[1]=7;
+    g[2]=9;
+    return !(f()==15 && g[0]==3 && g[1]==7 && g[2]==9 && g[3]==15 && h[1]==1.5 && h[2]==0.5);
+}
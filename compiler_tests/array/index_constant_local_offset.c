@@ -0,0 +1,14 @@
+int f()
+{
+    int x[4];
+    double d[3];
+    x[0]=1;
+    x[3]=8;
+    x[1+1]=x[0]+x[3];
+    d[2]=2.5;
+    d[0]=d[2]*2;
+    if(d[0]==5.0){
+        return x[2]*10;
+    }
+    return 0;
+}
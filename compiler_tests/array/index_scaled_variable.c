@@ -0,0 +1,40 @@
+int f(int n)
+{
+    double d[5];
+    int w[5];
+    int i;
+    int acc;
+    double x;
+    double dacc;
+    x=0.0;
+    for(i=0; i<n; i++){
+        d[i]=x;
+        w[i]=i*3;
+        x=x+1.0;
+    }
+    acc=0;
+    dacc=0.0;
+    for(i=0; i<n; i++){
+        dacc=dacc+d[n-1-i];
+        acc=acc+w[i];
+    }
+    if(dacc==10.0){
+        acc=acc+100;
+    }
+    return acc;
+}
+
+char g(int n)
+{
+    char c[5];
+    char acc;
+    int i;
+    for(i=0; i<n; i++){
+        c[i]=i*2;
+    }
+    acc=0;
+    for(i=0; i<n; i++){
+        acc=acc+c[n-1-i]*(i+1);
+    }
+    return acc;
+}
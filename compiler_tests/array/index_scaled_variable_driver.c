@@ -0,0 +1,7 @@
+int f(int n);
+char g(int n);
+
+int main()
+{
+    return !(f(5)==130 && g(5)==40);
+}
@@ -0,0 +1,21 @@
+int f(double x)
+{
+    int r;
+    r=0;
+    if(x*1.0!=x*1.0){
+        r=r+1;
+    }
+    if((0.0/0.0)!=(0.0/0.0)){
+        r=r+2;
+    }
+    if(!((0.0/0.0)==(0.0/0.0))){
+        r=r+4;
+    }
+    if(!(x<0.0) && !(x>=0.0)){
+        r=r+8;
+    }
+    if(x+0.0!=x){
+        r=r+16;
+    }
+    return r;
+}
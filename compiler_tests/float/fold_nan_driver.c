@@ -0,0 +1,8 @@
+int f(double x);
+
+int main()
+{
+    double zero;
+    zero=0.0;
+    return !(f(zero/zero)==31);
+}
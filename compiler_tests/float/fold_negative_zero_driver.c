@@ -0,0 +1,6 @@
+int f(double x);
+
+int main()
+{
+    return !(f(-0.0)==31);
+}
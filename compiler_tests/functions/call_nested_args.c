@@ -0,0 +1,6 @@
+int g(int x, int y);
+
+int f(int x)
+{
+    return g(g(x,1)+x, g(x+1,2))+x;
+}
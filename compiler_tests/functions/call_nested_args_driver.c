@@ -0,0 +1,11 @@
+int f(int x);
+
+int g(int x, int y)
+{
+    return x*10+y;
+}
+
+int main()
+{
+    return !(f(3)==385);
+}
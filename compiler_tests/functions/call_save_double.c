@@ -0,0 +1,6 @@
+double h(double x);
+
+double f(double x)
+{
+    return x*3.0+h(x)+x;
+}
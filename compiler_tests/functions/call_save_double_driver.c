@@ -0,0 +1,13 @@
+double f(double x);
+
+double h(double x)
+{
+    return x/7.0;
+}
+
+int main()
+{
+    double x;
+    x=1.0000000001;
+    return !(f(x)==x*3.0+x/7.0+x);
+}
@@ -0,0 +1,6 @@
+int g(int x);
+
+int f(int x)
+{
+    return x*2+g(x)+g(x+1)*3+x;
+}
@@ -0,0 +1,11 @@
+int f(int x);
+
+int g(int x)
+{
+    return x*x;
+}
+
+int main()
+{
+    return !(f(5)==148);
+}
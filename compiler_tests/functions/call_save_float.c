@@ -0,0 +1,6 @@
+float h(float x);
+
+float f(float x)
+{
+    return x*3.0f+h(x)+x;
+}
@@ -0,0 +1,13 @@
+float f(float x);
+
+float h(float x)
+{
+    return x/7.0f;
+}
+
+int main()
+{
+    float x;
+    x=1.1f;
+    return !(f(x)==x*3.0f+x/7.0f+x);
+}
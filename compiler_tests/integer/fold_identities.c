@@ -0,0 +1,39 @@
+int f(int x)
+{
+    int r;
+    r=0;
+    if(x*1==x){
+        r=r+1;
+    }
+    if(x%1==0){
+        r=r+2;
+    }
+    if(1*x==x){
+        r=r+4;
+    }
+    if(x/1==x){
+        r=r+8;
+    }
+    if((x|0)==x){
+        r=r+16;
+    }
+    if((x&-1)==x){
+        r=r+32;
+    }
+    if((x^0)==x){
+        r=r+64;
+    }
+    if((x<<0)==x){
+        r=r+128;
+    }
+    if(x+0-0==x){
+        r=r+256;
+    }
+    if(x*0==0){
+        r=r+512;
+    }
+    if((x&0)==0){
+        r=r+1024;
+    }
+    return r;
+}
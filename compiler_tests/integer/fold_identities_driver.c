@@ -0,0 +1,6 @@
+int f(int x);
+
+int main()
+{
+    return !(f(-7)==2047 && f(12345)==2047);
+}
@@ -0,0 +1,21 @@
+int f(int x)
+{
+    int r;
+    r=0;
+    if(x*-1==x){
+        r=r+1;
+    }
+    if((-2147483647-1)/-1==x){
+        r=r+2;
+    }
+    if(x%-1==0){
+        r=r+4;
+    }
+    if(x-(-2147483647-1)==0){
+        r=r+8;
+    }
+    if(-x==x){
+        r=r+16;
+    }
+    return r;
+}
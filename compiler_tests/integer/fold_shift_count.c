@@ -0,0 +1,18 @@
+int f(int x, int n)
+{
+    int r;
+    r=0;
+    if((x<<33)==(x<<n)){
+        r=r+1;
+    }
+    if((x>>32)==(x>>(n-1))){
+        r=r+2;
+    }
+    if((1<<33)==2){
+        r=r+4;
+    }
+    if((-8>>34)==-2){
+        r=r+8;
+    }
+    return r;
+}
@@ -0,0 +1,6 @@
+int f(int x, int n);
+
+int main()
+{
+    return !(f(3,33)==15 && f(-5,33)==15);
+}
@@ -0,0 +1,18 @@
+int g(int x);
+double h(double x);
+
+int f(int n)
+{
+    int a;
+    int b;
+    double d;
+    int i;
+    a=n*3;
+    b=n+1;
+    d=0.25;
+    for(i=0; i<n; i++){
+        a=a+g(i);
+        d=d+h(d);
+    }
+    return a+b+(d==4.0);
+}
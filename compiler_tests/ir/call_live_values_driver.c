@@ -0,0 +1,16 @@
+int f(int n);
+
+int g(int x)
+{
+    return x*2;
+}
+
+double h(double x)
+{
+    return x;
+}
+
+int main()
+{
+    return !(f(4)==30);
+}
@@ -0,0 +1,19 @@
+int calls;
+
+int g(int x)
+{
+    calls=calls+x;
+    return x;
+}
+
+int f(int n)
+{
+    int unused;
+    int i;
+    unused=n*7;
+    for(i=0; i<n; i++){
+        unused=g(i)+unused;
+    }
+    g(100);
+    return n;
+}
@@ -0,0 +1,8 @@
+extern int calls;
+
+int f(int n);
+
+int main()
+{
+    return !(f(4)==4 && calls==106);
+}
@@ -0,0 +1,14 @@
+void set(int *p, int v)
+{
+    *p=v;
+}
+
+int f()
+{
+    int x;
+    int y;
+    x=1;
+    y=2;
+    set(&x, 10);
+    return x+y;
+}
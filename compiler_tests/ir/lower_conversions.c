@@ -0,0 +1,9 @@
+double f(int n, double x)
+{
+    double d;
+    d=x+1;
+    if(n > 1){
+        d=d*2;
+    }
+    return d;
+}
@@ -0,0 +1,6 @@
+double f(int n, double x);
+
+int main()
+{
+    return !(f(2,1.5)==5.0 && f(1,0.1)==1.1);
+}
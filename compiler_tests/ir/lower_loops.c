@@ -0,0 +1,21 @@
+int f(int n)
+{
+    int i;
+    int j;
+    int acc;
+    acc=0;
+    for(i=0; i<n; i++){
+        if(i==3){
+            continue;
+        }
+        j=0;
+        while(1){
+            if(j>=i){
+                break;
+            }
+            acc=acc+j;
+            j++;
+        }
+    }
+    return acc;
+}
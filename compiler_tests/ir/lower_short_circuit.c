@@ -0,0 +1,20 @@
+int calls;
+
+int g(int x)
+{
+    calls++;
+    return x;
+}
+
+int f(int a, int b)
+{
+    int r;
+    r=0;
+    if(g(a) && g(b)){
+        r=r+1;
+    }
+    if(g(a) || g(b)){
+        r=r+2;
+    }
+    return r;
+}
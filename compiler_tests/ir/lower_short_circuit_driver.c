@@ -0,0 +1,16 @@
+extern int calls;
+
+int f(int a, int b);
+
+int main()
+{
+    if(f(0,1)!=2 || calls!=3){
+        return 1;
+    }
+    calls=0;
+    if(f(1,0)!=2 || calls!=3){
+        return 1;
+    }
+    calls=0;
+    return !(f(0,0)==0 && calls==3);
+}
@@ -0,0 +1,15 @@
+int f(int x)
+{
+    int r;
+    r=0;
+    switch(x){
+        case 1:
+            r=10;
+        case 2:
+            r=r+20;
+            break;
+        default:
+            r=-1;
+    }
+    return r;
+}
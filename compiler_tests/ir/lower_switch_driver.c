@@ -0,0 +1,6 @@
+int f(int x);
+
+int main()
+{
+    return !(f(1)==30 && f(2)==20 && f(3)==-1);
+}
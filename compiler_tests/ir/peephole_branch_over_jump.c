@@ -0,0 +1,10 @@
+int f(int x)
+{
+    if(x<3){
+        x=x+1;
+    }
+    else{
+        x=x-1;
+    }
+    return x;
+}
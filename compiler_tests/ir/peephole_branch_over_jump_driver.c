@@ -0,0 +1,6 @@
+int f(int x);
+
+int main()
+{
+    return !(f(1)==2 && f(3)==2 && f(10)==9);
+}
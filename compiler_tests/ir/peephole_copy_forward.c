@@ -0,0 +1,8 @@
+int g(int x);
+
+int f(int x)
+{
+    int y;
+    y=x;
+    return g(y)+y;
+}
@@ -0,0 +1,8 @@
+int f(int x, int y)
+{
+    int t;
+    t=x;
+    x=y;
+    y=t;
+    return x-y;
+}
@@ -0,0 +1,10 @@
+int f(int x)
+{
+    int a;
+    int b;
+    int c;
+    a=x+4;
+    b=a-5;
+    c=b^12;
+    return c|1;
+}
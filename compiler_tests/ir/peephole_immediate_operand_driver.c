@@ -0,0 +1,6 @@
+int f(int x);
+
+int main()
+{
+    return !(f(10)==((9^12)|1) && f(-3)==((-4^12)|1));
+}
@@ -0,0 +1,6 @@
+int f(int x);
+
+int main()
+{
+    return !(f(-4)==4 && f(6)==6);
+}
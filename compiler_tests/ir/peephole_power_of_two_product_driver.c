@@ -0,0 +1,6 @@
+int f(int x, int y);
+
+int main()
+{
+    return !(f(3,-2)==-8 && f(-1,1)==8);
+}
@@ -0,0 +1,8 @@
+int f(int a, int b)
+{
+    int t;
+    char c;
+    t=a<b;
+    c=t;
+    return c;
+}
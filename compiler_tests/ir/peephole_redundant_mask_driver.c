@@ -0,0 +1,6 @@
+int f(int a, int b);
+
+int main()
+{
+    return !(f(1,2)==1 && f(2,1)==0 && f(-1,-1)==0);
+}
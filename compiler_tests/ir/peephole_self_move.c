@@ -0,0 +1,6 @@
+int g(int x);
+
+int f(int x)
+{
+    return g(x);
+}
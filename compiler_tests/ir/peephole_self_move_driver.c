@@ -0,0 +1,11 @@
+int f(int x);
+
+int g(int x)
+{
+    return x*3;
+}
+
+int main()
+{
+    return !(f(7)==21);
+}
@@ -0,0 +1,9 @@
+void g(int *p);
+
+int f(int x)
+{
+    int y;
+    g(&y);
+    y=x;
+    return y+1;
+}
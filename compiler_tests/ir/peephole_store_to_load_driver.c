@@ -0,0 +1,11 @@
+int f(int x);
+
+void g(int *p)
+{
+    *p=99;
+}
+
+int main()
+{
+    return !(f(5)==6);
+}
@@ -0,0 +1,6 @@
+int f(int *p)
+{
+    *p=0;
+    p[2]=0;
+    return 1;
+}
@@ -0,0 +1,10 @@
+int f(int *p);
+
+int main()
+{
+    int x[3];
+    x[0]=5;
+    x[1]=6;
+    x[2]=7;
+    return !(f(x)==1 && x[0]==0 && x[1]==6 && x[2]==0);
+}
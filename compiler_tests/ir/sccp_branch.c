@@ -0,0 +1,20 @@
+int g();
+
+int f(int n)
+{
+    int x;
+    int y;
+    int i;
+    x=3;
+    y=0;
+    for(i=0; i<n; i++){
+        if(x>2){
+            y=y+x;
+        }
+        else{
+            y=g();
+        }
+        x=3;
+    }
+    return y;
+}
@@ -0,0 +1,11 @@
+int f(int n);
+
+int g()
+{
+    return 100;
+}
+
+int main()
+{
+    return !(f(4)==12);
+}
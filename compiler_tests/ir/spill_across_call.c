@@ -0,0 +1,55 @@
+int g(int x);
+
+int f(int x)
+{
+    int v0;
+    int v1;
+    int v2;
+    int v3;
+    int v4;
+    int v5;
+    int v6;
+    int v7;
+    int v8;
+    int v9;
+    int v10;
+    int v11;
+    int v12;
+    int v13;
+    int v14;
+    int v15;
+    v0=g(x+0);
+    v1=g(x+1);
+    v2=g(x+2);
+    v3=g(x+3);
+    v4=g(x+4);
+    v5=g(x+5);
+    v6=g(x+6);
+    v7=g(x+7);
+    v8=g(x+8);
+    v9=g(x+9);
+    v10=g(x+10);
+    v11=g(x+11);
+    v12=g(x+12);
+    v13=g(x+13);
+    v14=g(x+14);
+    v15=g(x+15);
+    x=g(0);
+    x=x+v0*1;
+    x=x+v1*2;
+    x=x+v2*3;
+    x=x+v3*4;
+    x=x+v4*5;
+    x=x+v5*6;
+    x=x+v6*7;
+    x=x+v7*8;
+    x=x+v8*9;
+    x=x+v9*10;
+    x=x+v10*11;
+    x=x+v11*12;
+    x=x+v12*13;
+    x=x+v13*14;
+    x=x+v14*15;
+    x=x+v15*16;
+    return x;
+}
@@ -0,0 +1,11 @@
+int f(int x);
+
+int g(int x)
+{
+    return x+1;
+}
+
+int main()
+{
+    return !(f(1)==1633);
+}
@@ -0,0 +1,53 @@
+double f(double x)
+{
+    double v0;
+    double v1;
+    double v2;
+    double v3;
+    double v4;
+    double v5;
+    double v6;
+    double v7;
+    double v8;
+    double v9;
+    double v10;
+    double v11;
+    double v12;
+    double v13;
+    double v14;
+    double v15;
+    v0=x*1;
+    v1=x*2;
+    v2=x*3;
+    v3=x*4;
+    v4=x*5;
+    v5=x*6;
+    v6=x*7;
+    v7=x*8;
+    v8=x*9;
+    v9=x*10;
+    v10=x*11;
+    v11=x*12;
+    v12=x*13;
+    v13=x*14;
+    v14=x*15;
+    v15=x*16;
+    x=0;
+    x=x+v0*v15;
+    x=x+v1*v14;
+    x=x+v2*v13;
+    x=x+v3*v12;
+    x=x+v4*v11;
+    x=x+v5*v10;
+    x=x+v6*v9;
+    x=x+v7*v8;
+    x=x+v8*v7;
+    x=x+v9*v6;
+    x=x+v10*v5;
+    x=x+v11*v4;
+    x=x+v12*v3;
+    x=x+v13*v2;
+    x=x+v14*v1;
+    x=x+v15*v0;
+    return x;
+}
@@ -0,0 +1,6 @@
+double f(double x);
+
+int main()
+{
+    return !(f(0.5)==204.0);
+}
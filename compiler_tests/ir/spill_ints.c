@@ -0,0 +1,77 @@
+int f(int x)
+{
+    int v0;
+    int v1;
+    int v2;
+    int v3;
+    int v4;
+    int v5;
+    int v6;
+    int v7;
+    int v8;
+    int v9;
+    int v10;
+    int v11;
+    int v12;
+    int v13;
+    int v14;
+    int v15;
+    int v16;
+    int v17;
+    int v18;
+    int v19;
+    int v20;
+    int v21;
+    int v22;
+    int v23;
+    v0=x+0;
+    v1=x+1;
+    v2=x+2;
+    v3=x+3;
+    v4=x+4;
+    v5=x+5;
+    v6=x+6;
+    v7=x+7;
+    v8=x+8;
+    v9=x+9;
+    v10=x+10;
+    v11=x+11;
+    v12=x+12;
+    v13=x+13;
+    v14=x+14;
+    v15=x+15;
+    v16=x+16;
+    v17=x+17;
+    v18=x+18;
+    v19=x+19;
+    v20=x+20;
+    v21=x+21;
+    v22=x+22;
+    v23=x+23;
+    x=0;
+    x=x+v0*v23;
+    x=x+v1*v22;
+    x=x+v2*v21;
+    x=x+v3*v20;
+    x=x+v4*v19;
+    x=x+v5*v18;
+    x=x+v6*v17;
+    x=x+v7*v16;
+    x=x+v8*v15;
+    x=x+v9*v14;
+    x=x+v10*v13;
+    x=x+v11*v12;
+    x=x+v12*v11;
+    x=x+v13*v10;
+    x=x+v14*v9;
+    x=x+v15*v8;
+    x=x+v16*v7;
+    x=x+v17*v6;
+    x=x+v18*v5;
+    x=x+v19*v4;
+    x=x+v20*v3;
+    x=x+v21*v2;
+    x=x+v22*v1;
+    x=x+v23*v0;
+    return x;
+}
@@ -0,0 +1,13 @@
+int f(int n)
+{
+    int a;
+    int b;
+    int i;
+    a=0;
+    b=1;
+    for(i=0; i<n; i++){
+        b=a+b;
+        a=b-a;
+    }
+    return a;
+}
@@ -0,0 +1,18 @@
+int f(int n)
+{
+    int a;
+    int b;
+    int c;
+    int t;
+    a=1;
+    b=2;
+    c=3;
+    while(n>0){
+        t=a;
+        a=b;
+        b=c;
+        c=t;
+        n--;
+    }
+    return a*100+b*10+c;
+}
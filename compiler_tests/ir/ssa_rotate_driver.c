@@ -0,0 +1,6 @@
+int f(int n);
+
+int main()
+{
+    return !(f(1)==231 && f(2)==312 && f(3)==123);
+}
@@ -0,0 +1,15 @@
+int f(int n)
+{
+    int a;
+    int b;
+    int t;
+    int i;
+    a=1;
+    b=2;
+    for(i=0; i<n; i++){
+        t=a;
+        a=b;
+        b=t;
+    }
+    return a*10+b;
+}
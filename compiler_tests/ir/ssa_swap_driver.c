@@ -0,0 +1,6 @@
+int f(int n);
+
+int main()
+{
+    return !(f(3)==21 && f(4)==12);
+}
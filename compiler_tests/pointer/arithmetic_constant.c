@@ -0,0 +1,13 @@
+int f(int *p, double *q)
+{
+    int *r;
+    int *s;
+    r=p+3;
+    r=r-1;
+    s=p+1000;
+    q=q+2;
+    if(*q==3.0){
+        return *r+*s;
+    }
+    return 0;
+}
@@ -0,0 +1,12 @@
+int f(int *p, double *q);
+
+int x[1001];
+
+int main()
+{
+    double d[3];
+    x[2]=5;
+    x[1000]=40;
+    d[2]=3.0;
+    return !(f(x,d)==45);
+}
@@ -7,6 +7,7 @@
 // ------- Node and Context -------
 #include "ast_node.hpp"
 #include "ast_context.hpp"
+#include "ast_resolver.hpp"
 
 // ------- Expressions -------
 #include "ast_identifier.hpp"
@@ -55,5 +56,11 @@
 // ------- Sizeof -------
 #include "ast_sizeof.hpp"
 
+// Parses file_name and returns the root of its AST. Throws std::runtime_error if the file
+// can't be opened or has a syntax error. Any number of files may be parsed at once on different threads.
 ast::NodePtr
 ParseAST(std::string file_name);
+
+// Turns the parser trace on stderr on or off for every parse. The switch is shared by all parses, so it
+// is set once, before any thread starts parsing.
+void SetParserTrace(bool trace);
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace ast
+{
+    // Bump-pointer arena for AST storage.
+    // Allocation is a pointer increment within a chunk; individual frees are no-ops and every chunk
+    // is released at once when the arena is destroyed, i.e. after the translation unit is compiled.
+    class AstArena
+    {
+    private:
+        static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+        std::vector<char *> chunks_;
+        std::vector<char *> large_chunks_; // dedicated chunks of oversized requests
+        size_t n_used_chunks_ = 0;         // chunks_ past this were released by Reset and are reused first
+        char *cursor_ = nullptr;
+        char *limit_ = nullptr;
+        size_t bytes_allocated_ = 0;
+
+        void *AllocateSlow(size_t size, size_t align);
+
+    public:
+        AstArena() = default;
+        ~AstArena();
+
+        AstArena(const AstArena &) = delete;
+        AstArena &operator=(const AstArena &) = delete;
+
+        void *Allocate(size_t size, size_t align = alignof(std::max_align_t))
+        {
+            size_t padding = (align - reinterpret_cast<size_t>(cursor_) % align) % align;
+            if (cursor_ == nullptr || size + padding > static_cast<size_t>(limit_ - cursor_))
+            {
+                return AllocateSlow(size, align);
+            }
+            void *result = cursor_ + padding;
+            cursor_ += padding + size;
+            bytes_allocated_ += size;
+            return result;
+        }
+
+        // Releases everything allocated so far, keeping the chunks for the next translation unit.
+        // Every node allocated from the arena must have been destroyed.
+        void Reset();
+
+        size_t BytesAllocated() const { return bytes_allocated_; }
+        size_t ChunkCount() const { return n_used_chunks_ + large_chunks_.size(); }
+
+        // arena that Node::operator new and NodeList storage draw from on this thread, or nullptr
+        static AstArena *Current();
+        static void SetCurrent(AstArena *arena);
+    };
+
+    // Makes an arena current for the lifetime of the scope (e.g. while the parser runs).
+    class ArenaScope
+    {
+    private:
+        AstArena *previous_;
+
+    public:
+        explicit ArenaScope(AstArena &arena) : previous_(AstArena::Current()) { AstArena::SetCurrent(&arena); }
+        ~ArenaScope() { AstArena::SetCurrent(previous_); }
+
+        ArenaScope(const ArenaScope &) = delete;
+        ArenaScope &operator=(const ArenaScope &) = delete;
+    };
+
+    // std allocator over an AstArena, falling back to the heap when no arena was current at construction.
+    template <typename T>
+    class ArenaAllocator
+    {
+    private:
+        AstArena *arena_;
+
+        template <typename U>
+        friend class ArenaAllocator;
+
+    public:
+        using value_type = T;
+
+        ArenaAllocator() : arena_(AstArena::Current()) {}
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U> &other) : arena_(other.arena_) {}
+
+        T *allocate(size_t n)
+        {
+            if (arena_ == nullptr)
+            {
+                return static_cast<T *>(::operator new(n * sizeof(T)));
+            }
+            return static_cast<T *>(arena_->Allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *ptr, size_t n)
+        {
+            (void)n;
+            if (arena_ == nullptr)
+            {
+                ::operator delete(ptr);
+            }
+        }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U> &other) const { return arena_ == other.arena_; }
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U> &other) const { return arena_ != other.arena_; }
+    };
+
+} // namespace ast
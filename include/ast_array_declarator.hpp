@@ -13,13 +13,15 @@ namespace ast
         ArrayDeclarator(NodePtr identifier, NodePtr size)
             : identifier_(std::move(identifier)), size_(std::move(size)) {}
 
-        std::string GetID() const override;
+        SymbolId GetID() const override;
+        const Binding *GetBinding() const override;
         bool IsFunction() const override;
         bool IsArray() const override;
         int GetArraySize(Context &context) const override;
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        void Resolve(Resolver &resolver) const override;
     };
 
 } // namespace ast
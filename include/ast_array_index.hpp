@@ -1,8 +1,13 @@
 #pragma once
+#include <string>
+
 #include "ast_node.hpp"
 
 namespace ast
 {
+    // reg *= element_size, with a shift when the size is a power of two
+    void EmitElementScale(AsmWriter &stream, Context &context, int reg, int element_size);
+
     class ArrayIndex : public Node
     {
     private:
@@ -13,16 +18,23 @@ namespace ast
         ArrayIndex(NodePtr arrayid, NodePtr index)
             : array_id_(std::move(arrayid)), index_(std::move(index)) {}
 
-        std::string GetID() const override;
+        SymbolId GetID() const override;
+        const Binding *GetBinding() const override;
         bool IsFunction() const override;
         TypeSpecifier GetType(Context &context) const override;
         bool IsPointer(Context &context, const bool has_been_declared) const override;
         bool IsArray() const override;
         int GetPointerDepth() const override;
-        void EmitIndexOffset(std::ostream &stream, Context &context, int destReg) const;
+        // Emits what the address of the element needs and returns it as the memory operand of a load
+        // or store, e.g. "-20(s0)", "%lo(a+8)(a1)" or "0(a1)". A constant index is folded into the
+        // offset. addrReg is the register the operand may use, another one is taken if needed.
+        std::string EmitElementAddress(AsmWriter &stream, Context &context, int addrReg) const;
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        void Resolve(Resolver &resolver) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
+        Place LowerPlace(Lowering &lowering) const override;
     };
 
 } // namespace ast
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "ast_register.hpp"
+#include "ast_symbol.hpp"
+#include "ast_type_specifier.hpp"
+
+namespace ast
+{
+    // In-memory sink for generated assembly.
+    // Text accumulates in one growable buffer (integers are formatted with std::to_chars) and is
+    // written out with a single write at the end, instead of flushing an ofstream on every line.
+    // In compact mode, section switches are only emitted when the section actually changes and all
+    // .globl directives are folded into one line at the end of the output. Chunks generated apart
+    // (e.g. on other threads) keep their leading section switch pending until they are spliced in.
+    class AsmWriter
+    {
+    private:
+        static constexpr size_t INITIAL_CAPACITY = 1 << 20;
+
+        std::string buffer_;
+        bool compact_;
+        bool is_chunk_ = false;
+        std::string section_;              // section currently switched to (compact mode)
+        std::string entry_section_;        // pending leading section switch of a chunk (compact mode)
+        std::vector<std::string> globals_; // deferred .globl symbols (compact mode)
+
+    public:
+        explicit AsmWriter(bool compact = false, size_t capacity = INITIAL_CAPACITY) : compact_(compact) { buffer_.reserve(capacity); }
+
+        // a writer for output that is generated separately and later passed to Splice
+        static AsmWriter Chunk(const AsmWriter &parent);
+
+        AsmWriter &operator<<(std::string_view text)
+        {
+            buffer_.append(text);
+            return *this;
+        }
+        AsmWriter &operator<<(const char *text) { return *this << std::string_view(text); }
+        AsmWriter &operator<<(const std::string &text) { return *this << std::string_view(text); }
+        AsmWriter &operator<<(SymbolId id) { return *this << std::string_view(Spelling(id)); }
+        AsmWriter &operator<<(Reg reg) { return *this << RegisterName(reg); }
+
+        AsmWriter &operator<<(char c)
+        {
+            buffer_.push_back(c);
+            return *this;
+        }
+
+        template <typename Integer, typename = std::enable_if_t<std::is_integral_v<Integer> && !std::is_same_v<Integer, char> && !std::is_same_v<Integer, bool>>>
+        AsmWriter &operator<<(Integer value)
+        {
+            char digits[24];
+            auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            buffer_.append(digits, result.ptr);
+            return *this;
+        }
+
+        AsmWriter &operator<<(const AsmWriter &other) { return *this << other.View(); }
+
+        // appends a chunk, resolving its pending section switch against the current section
+        void Splice(const AsmWriter &chunk);
+
+        // A chunk as bytes, pending section switch and deferred globals included, for caching.
+        // Deserialize consumes one serialized chunk from the front of data and returns false if it
+        // doesn't start with one.
+        void Serialize(std::string &out) const;
+        static bool Deserialize(std::string_view &data, AsmWriter &chunk);
+
+        // directive helpers that compact mode can elide or batch
+        void Section(std::string_view directive);
+        void Global(std::string_view symbol);
+
+        bool IsCompact() const { return compact_; }
+        std::string_view View() const { return buffer_; }
+        size_t Size() const { return buffer_.size(); }
+        void Clear() { buffer_.clear(); } // keeps the capacity for reuse
+
+        // emits anything deferred by compact mode; call once after the last instruction
+        void Finish();
+        // throws std::runtime_error if the file cannot be written
+        void WriteToFile(const std::string &path) const;
+    };
+
+} // namespace ast
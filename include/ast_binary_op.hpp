@@ -1,20 +1,21 @@
 #pragma once
 
 #include "ast_node.hpp"
-#include "functional"
 
 namespace ast
 {
     class BinaryOp : public Node
     {
     private:
-        std::any HandleIntOperation(TypeSpecifier type) const;
-        template <typename T>
-        std::any HandleFloatOperation(TypeSpecifier type) const;
-        template <typename T, typename Op>
-        std::any EvalOperation(TypeSpecifier type, Op op) const;
+        friend struct LeftChain;
 
-        std::string GetOperatorString(TypeSpecifier type) const;
+        // see LeftChain
+        std::optional<ConstValue> FoldOperation(ConstValue lhs, Context &context) const;
+        void EmitOperation(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const;
+        // destReg holds the other operand; the value is the right one unless the operator commutes
+        void EmitConstantOperation(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type, ConstValue value) const;
+        void EmitRegisterOperation(AsmWriter &stream, Context &context, int destReg, int srcReg, TypeSpecifier type) const;
+        bool IsCommutative() const;
 
     protected:
         const char op_symbol_;
@@ -28,11 +29,15 @@ namespace ast
             : op_symbol_(op_symbol),
               expression1_(std::move(expression1)),
               expression2_(std::move(expression2)) {}
+        ~BinaryOp() override { LeftChain::Unlink<BinaryOp>(expression1_); }
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
-        std::any GetValue(TypeSpecifier type) const override;
+        void Resolve(Resolver &resolver) const override;
+        ConstValue Evaluate(Context &context) const override;
+        bool IsConstant(Context &context) const override;
         TypeSpecifier GetType(Context &context) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
 } // namespace ast
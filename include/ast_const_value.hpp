@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "ast_type_specifier.hpp"
+
+namespace ast
+{
+    // Value of a constant expression, for global initializers, enumerators, array sizes and case labels.
+    // Integers are kept after C's integer promotions, so char and enumeration constants are INT, and the
+    // usual arithmetic conversions pick the type of each operation. The value is held inline, so
+    // evaluating a constant expression never allocates.
+    class ConstValue
+    {
+    public:
+        // DO NOT REORDER: ranked for the usual arithmetic conversions
+        enum class Kind : uint8_t
+        {
+            INT,
+            UNSIGNED,
+            FLOAT,
+            DOUBLE
+        };
+
+    private:
+        Kind kind_;
+        union
+        {
+            int32_t i;
+            uint32_t u;
+            float f;
+            double d;
+        } value_;
+
+        explicit ConstValue(Kind kind) : kind_(kind), value_{} {}
+
+    public:
+        static ConstValue Int(int32_t value);
+        static ConstValue Unsigned(uint32_t value);
+        static ConstValue Float(float value);
+        static ConstValue Double(double value);
+        static ConstValue Bool(bool value) { return Int(value ? 1 : 0); }
+
+        Kind GetKind() const { return kind_; }
+        bool IsInteger() const { return kind_ == Kind::INT || kind_ == Kind::UNSIGNED; }
+        bool IsTrue() const; // compares unequal to 0
+
+        // converted as by a C cast; floating point values the integer type can't hold saturate as
+        // fcvt does, NaN to the largest value
+        int32_t AsInt() const;
+        uint32_t AsUnsigned() const;
+        float AsFloat() const;
+        double AsDouble() const;
+        ConstValue ConvertTo(Kind kind) const;
+    };
+
+    // op is the C spelling of the operator. Integer arithmetic wraps like the generated code and shift
+    // counts use their low 5 bits as sll/sra do. Throws std::runtime_error for operands the operator
+    // doesn't take and for division by zero. && and || are evaluated by LogicalOp, which short-circuits.
+    ConstValue EvaluateUnary(std::string_view op, ConstValue operand);
+    ConstValue EvaluateBinary(std::string_view op, ConstValue lhs, ConstValue rhs);
+
+    // whether the evaluation returns rather than throws, for folding expressions that aren't
+    // required to be constant
+    bool CanEvaluateUnary(std::string_view op, ConstValue operand);
+    bool CanEvaluateBinary(std::string_view op, ConstValue lhs, ConstValue rhs);
+
+    ConstValue::Kind KindOf(TypeSpecifier type); // of a value held in a register of type, pointers are INT
+
+} // namespace ast
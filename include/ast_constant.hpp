@@ -13,10 +13,12 @@ namespace ast
     public:
         IntConstant(int value, std::string raw_str) : value_(value), raw_str_(raw_str) {}
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
-        std::any GetValue(TypeSpecifier type) const override;
+        ConstValue Evaluate(Context &context) const override;
+        bool IsConstant(Context &context) const override;
         TypeSpecifier GetType(Context &context) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
     class FloatConstant : public Node
@@ -27,43 +29,52 @@ namespace ast
 
     public:
         FloatConstant(double value, std::string raw_str) : value_(value), raw_str_(raw_str) {}
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
-        std::any GetValue(TypeSpecifier type) const override;
+        ConstValue Evaluate(Context &context) const override;
+        bool IsConstant(Context &context) const override;
         TypeSpecifier GetType(Context &context) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
+    // Loads value, converted to type as by a C cast, into destReg. Floating point values come from
+    // the literal pool with the exact bits of the converted value. Folded expressions use it too.
+    void EmitConstant(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type, ConstValue value);
+
     int EscapedCharMap(std::string s);
 
     class CharLiteral : public Node
     {
     private:
-        std::string raw_str_;
+        SymbolId raw_str_;
         int value_;
 
         void Char2Int();
 
     public:
-        CharLiteral(std::string raw_str) : raw_str_(raw_str) { Char2Int(); }
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        CharLiteral(SymbolId raw_str) : raw_str_(raw_str) { Char2Int(); }
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
-        std::any GetValue(TypeSpecifier type) const override;
+        ConstValue Evaluate(Context &context) const override;
+        bool IsConstant(Context &context) const override;
         TypeSpecifier GetType(Context &context) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
     class StringLiteral : public Node
     {
     private:
-        std::string raw_str_;
+        SymbolId raw_str_;
 
     public:
-        StringLiteral(std::string raw_str) : raw_str_(raw_str) {}
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        StringLiteral(SymbolId raw_str) : raw_str_(raw_str) {}
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
-        std::string GetID() const override;
+        SymbolId GetID() const override;
 
         int GetArraySize(Context &context) const override;
         TypeSpecifier GetType(Context &context) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
 } // namespace ast
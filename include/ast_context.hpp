@@ -1,4 +1,6 @@
 #pragma once
+#include <cstdint>
+#include <iostream>
 #include <sstream>
 #include <map>
 #include <string>
@@ -6,18 +8,25 @@
 #include <set>
 #include <stack>
 #include <vector>
+#include "ast_register.hpp"
 #include "ast_type_specifier.hpp"
+#include "ast_scoped_table.hpp"
+#include "ast_symbol.hpp"
+
+class FunctionCache; // compile_cache.hpp
 
 namespace ast
 {
     extern const int DEFAULT_STACK_SIZE;
     extern const int WORD_SIZE;
     extern const int MAX_REGISTER_PARAM;
-    extern const std::string RESERVED_VARIABLE_PREFIX;
+    extern const char RESERVED_VARIABLE_PREFIX[];
+
+    using RegisterMask = uint64_t; // bit i set for register i
 
     struct FunctionVariable
     {
-        std::string name;
+        SymbolId name;
         TypeSpecifier type;
         bool is_pointer;
         int pointer_depth;
@@ -28,7 +37,7 @@ namespace ast
 
     struct GlobalVariable
     {
-        std::string name;
+        SymbolId name;
         TypeSpecifier type;
         bool is_pointer;
         int pointer_depth;
@@ -36,9 +45,37 @@ namespace ast
         int array_size;
     };
 
+    // What an identifier names, filled in by the resolve pass (see ast_resolver.hpp). Bindings are
+    // owned by the node that declares them; identifiers keep a pointer to theirs.
+    struct Binding
+    {
+        enum class Kind
+        {
+            ENUM,
+            LOCAL,
+            GLOBAL
+        };
+
+        Kind kind;
+        SymbolId name;
+        TypeSpecifier type; // INT for enumerators
+        bool is_pointer = false;
+        int pointer_depth = 0;
+        bool is_array = false;
+        int value = 0;  // enumerators only
+        int offset = 0; // locals only, set when the declaration is generated
+    };
+
+    const Binding &RequireBinding(const Binding *binding); // throws if the identifier was never declared
+    inline const Binding *LocalBinding(const Binding *binding) // nullptr unless binding is a local variable
+    {
+        return (binding != nullptr && binding->kind == Binding::Kind::LOCAL) ? binding : nullptr;
+    }
+    int GetPointerOffset(const Binding *binding, int pointer_depth); // bytes one step of the pointer moves
+
     struct ParamInfo
     {
-        std::string name;
+        SymbolId name;
         TypeSpecifier type;
         bool is_pointer;
         int pointer_depth;
@@ -46,9 +83,10 @@ namespace ast
 
     struct FunctionInfo
     {
-        std::string name;
+        SymbolId name;
         std::vector<ParamInfo> params;
         TypeSpecifier return_type;
+        size_t order = 0; // how many functions were declared before it
     };
 
     struct LiteralConstant
@@ -70,25 +108,21 @@ namespace ast
     class FunctionContext
     {
     private:
-        // using a struct to make it easy to replicate for each scope
-        struct Scope
-        {
-            int scope_pointer_;
-            std::unordered_map<std::string, FunctionVariable> variable_table_;
-        };
-        const std::string name_;                 // Identifier of current function
-        std::stack<Scope> variable_table_stack_; // stack for each scope
+        const SymbolId name_;                                    // Identifier of current function
+        ScopedTable<SymbolId, FunctionVariable> variable_table_; // variables of every open scope
+        std::vector<int> scope_pointer_stack_;                   // stack pointer offset on entry to each scope
         int stack_pointer_offset_;
         int stack_size_;
+        std::vector<int> call_save_slots_; // offsets of the slots registers are saved to around calls
+        size_t call_save_depth_ = 0;       // slots taken by the calls being generated, innermost last
+        int call_save_floor_ = 0;          // lowest call save slot, which scopes never give back
 
     public:
         // initially offset stack by 8 because ra and s0 are stored in the first word and second word
-        FunctionContext(std::string name)
+        FunctionContext(SymbolId name)
             : name_(name), stack_pointer_offset_(-WORD_SIZE * 3), stack_size_(DEFAULT_STACK_SIZE)
         {
-            Scope initial_frame;
-            initial_frame.scope_pointer_ = stack_pointer_offset_;
-            variable_table_stack_.push(initial_frame);
+            scope_pointer_stack_.push_back(stack_pointer_offset_);
         };
 
         // deal with variables in function scope
@@ -99,68 +133,141 @@ namespace ast
         void EnterScope();
         void ExitScope();
 
-        void AddFunctionVariable(const std::string &name, const TypeSpecifier type, const bool is_pointer, const int pointer_depth = 0);
+        int AddFunctionVariable(SymbolId name, const TypeSpecifier type, const bool is_pointer, const int pointer_depth = 0); // returns the stack offset
         void AllocateStackSpaceForParams(const std::vector<ParamInfo>);
-        void AcceptParamFromStack(const std::string &name, const TypeSpecifier type, const bool is_pointer, const int pointer_depth, const int offset);
+        void AcceptParamFromStack(SymbolId name, const TypeSpecifier type, const bool is_pointer, const int pointer_depth, const int offset);
 
-        bool VariableInLocalScope(const std::string &name) const;                // verify that this variable name is defined in local scope
-        FunctionVariable GetFunctionVariableInfo(const std::string &name) const; // get function info including stack offset for function variable
+        const FunctionVariable *FindVariable(SymbolId name) const; // innermost visible variable, nullptr if not declared
         int GetStackSize() const;
 
+        // ---- call save slots ----
+        // 8-byte slots shared by every call site of the function. A call takes slots on top of those
+        // of the calls it is nested in (e.g. in their arguments) and releases them once it returns.
+        int AcquireCallSaveSlot(); // returns the stack offset
+        void ReleaseCallSaveSlots(size_t count);
+
         // ---- array management ----
-        void AddArray(const std::string &name, int size, TypeSpecifier type);
+        int AddArray(SymbolId name, int size, TypeSpecifier type); // returns the stack offset
 
         void PrintFunctionContext(std::ostream &stream) const; // for debugging
 
     }; // namespace ast
 
+    class ThreadPool;
+    class TimeReport;
+
+    // Declarations visible to the whole translation unit: global variables and functions.
+    // It is filled by a sequential pre-pass over the external declarations and only read while
+    // function bodies are generated, so any number of functions can share it.
+    class GlobalContext
+    {
+    private:
+        std::unordered_map<SymbolId, GlobalVariable> global_variable_table_; // Set of declared global variables
+        std::unordered_map<SymbolId, FunctionInfo> function_info_table_;     // Set of declared functions and their types
+
+    public:
+        void AddVariable(const GlobalVariable &var) { global_variable_table_[var.name] = var; }
+        void AddFunction(FunctionInfo fun)
+        {
+            fun.order = function_info_table_.size();
+            function_info_table_[fun.name] = fun;
+        }
+        size_t FunctionCount() const { return function_info_table_.size(); }
+
+        const GlobalVariable *FindVariable(SymbolId name) const;
+        const FunctionInfo *FindFunction(SymbolId name) const;
+
+        void PrintVariables(std::ostream &stream) const; // for debugging
+    };
+
     class Context
     {
     private:
-        const std::map<std::string, int> register_map_; // Static map declaration
-        std::set<int> unused_registers_;                // Set of unused registers
-        std::set<int> used_registers_;                  // Set of used registers
-        std::map<std::string, int> CreateRegisterMap(); // build register_map_ and unused_registers_ at the start
-        std::set<int> InitializeUnusedRegisters();
-
-        std::unordered_map<std::string, GlobalVariable> global_variable_table_; // Set of declared global variables
-        std::unordered_map<std::string, FunctionInfo> function_info_table_;     // Set of declared functions and their types
-        std::stack<FunctionContext> function_context_stack_;                    // Stack of function contexts
+        RegisterMask unused_registers_;                         // Allocatable registers not in use
+        RegisterMask used_registers_ = 0;                       // Registers in use
+        RegisterMask dead_registers_ = 0;                       // Registers in use whose value nothing reads yet
+        RegisterMask single_registers_ = 0;                     // Float registers holding a float rather than a double
+
+        const GlobalContext &globals_;   // translation unit declarations, read-only while in a function
+        GlobalContext *global_writes_;   // where global-scope declarations go, nullptr inside a function
+        GlobalContext locals_;           // declarations made inside a function body (e.g. a prototype)
+        const std::string label_prefix_; // "." at global scope, ".<function>." for a function body
+        const size_t visible_functions_; // global functions declared before the body, as C scoping sees them
+        int label_counter_ = 0;
+        ThreadPool *thread_pool_ = nullptr;
+        FunctionCache *function_cache_ = nullptr;
+        std::ostream *diagnostics_ = &std::cerr;
+        TimeReport *time_report_ = nullptr;
+        bool use_ir_ = false;
+        bool dump_ir_ = false;
+
+        std::stack<FunctionContext> function_context_stack_; // Stack of function contexts
         std::vector<LiteralConstant> literal_constants_;
 
         std::stack<LoopContext> loop_context_stack_;
 
-        std::unordered_map<std::string, int> enum_table_;
+        GlobalContext &Declarations() { return (global_writes_ != nullptr) ? *global_writes_ : locals_; }
 
     public:
-        Context() : register_map_(CreateRegisterMap()), unused_registers_(InitializeUnusedRegisters()) {}
+        // global scope: declarations are added to globals
+        explicit Context(GlobalContext &globals);
+        // body of a single function: globals are only read, labels and literals are prefixed with the function name,
+        // and only the first visible_functions functions declared in the translation unit can be called
+        Context(const GlobalContext &globals, SymbolId function, size_t visible_functions);
+
+        Context(const Context &) = delete;
+        Context &operator=(const Context &) = delete;
+
+        const GlobalContext &GetGlobals() const { return globals_; }
+        ThreadPool *GetThreadPool() const { return thread_pool_; }
+        void SetThreadPool(ThreadPool *thread_pool) { thread_pool_ = thread_pool; } // nullptr generates functions in sequence
+        FunctionCache *GetFunctionCache() const { return function_cache_; }
+        void SetFunctionCache(FunctionCache *function_cache) { function_cache_ = function_cache; } // nullptr generates every function
+        std::ostream &GetDiagnostics() const { return *diagnostics_; }
+        void SetDiagnostics(std::ostream &diagnostics) { diagnostics_ = &diagnostics; } // where failure dumps go, std::cerr by default
+        TimeReport *GetTimeReport() const { return time_report_; }
+        void SetTimeReport(TimeReport *time_report) { time_report_ = time_report; } // nullptr unless phases are timed
+        bool UsesIR() const { return use_ir_; }
+        void SetUseIR(bool use_ir) { use_ir_ = use_ir; } // functions the IR can't lower are still generated directly
+        bool DumpsIR() const { return dump_ir_; }
+        void SetDumpIR(bool dump_ir) { dump_ir_ = dump_ir; } // the IR of each function goes into the output as comments
 
         // ----- dealing with variables in global scope ------
-        void AddGlobalVariable(const std::string &name, const TypeSpecifier type, const bool is_pointer, const int pointer_depth = 0);
-        void AddFunctionInfo(const std::string &name, const std::vector<ParamInfo> &params, const TypeSpecifier returnType);
-        bool VariableIsLocal(const std::string &name) const;
+        void AddGlobalVariable(SymbolId name, const TypeSpecifier type, const bool is_pointer, const int pointer_depth = 0);
+        void AddFunctionInfo(SymbolId name, const std::vector<ParamInfo> &params, const TypeSpecifier returnType);
         bool InGlobalScope() const;
-        FunctionInfo GetFunctionInfo(const std::string &name) const;
-        GlobalVariable GetGlobalVariableInfo(const std::string &name) const;
+        FunctionInfo GetFunctionInfo(SymbolId name) const;
+
+        // ---- single lookups that return nullptr on a miss ----
+        const GlobalVariable *FindGlobalVariable(SymbolId name) const;
+        const FunctionInfo *FindFunction(SymbolId name) const; // only functions declared before this body
 
         // ---- dealing with literal constants like float and double ----
-        int AddFloatLiteralConstant(double value, TypeSpecifier type);
-        int AddStringLiteralConstant(std::string s);
-        std::vector<LiteralConstant> GetLiteralConstants() const;
+        // both return the label of the constant
+        std::string AddFloatLiteralConstant(double value, TypeSpecifier type);
+        std::string AddStringLiteralConstant(std::string s);
+        const std::vector<LiteralConstant> &GetLiteralConstants() const;
+        std::string GetLiteralLabel(size_t index) const;
 
         // ---- function related context -----
-        void CreateNewFunctionScope(const std::string &funcID);
+        void CreateNewFunctionScope(SymbolId funcID);
         void DestroyFunctionScope();
         FunctionContext &GetCurrentFunctionContext();
 
         // ---- register management -----
         int AssignRegister(TypeSpecifier type);
-        void UseRegister(std::string reg_name);
+        void UseRegister(Reg reg, TypeSpecifier type = TypeSpecifier::INT); // type is what reg is going to hold
         void FreeRegister(int reg);
-        void FreeRegister(std::string reg_name);
-        const std::set<int> GetUsedRegisters() const; // get used registers
-        std::string GetRegString(int reg) const;
-        int GetRegIndex(const std::string &reg_name) const;
+        void FreeRegister(Reg reg);
+        void SetRegisterDead(int reg, bool dead); // a dead register stays reserved but isn't saved around calls
+        // For a destination that is only written once its operands are evaluated: flags reg dead if it is
+        // live, and returns whether it did, so that the caller sets it live again before writing it
+        bool DeferRegister(int reg);
+        RegisterMask GetUsedRegisters() const { return used_registers_; }
+        RegisterMask GetLiveRegisters() const { return used_registers_ & ~dead_registers_; }
+        bool IsRegisterDead(Reg reg) const { return (dead_registers_ >> static_cast<int>(reg)) & 1; }
+        TypeSpecifier GetRegisterType(Reg reg) const; // INT, FLOAT or DOUBLE: the width to save reg at
+        std::string_view GetRegString(int reg) const; // names are static, so no copy is made
         std::string GenerateUniqueLabel(const std::string &labelID);
 
         // ---- loop context management ----
@@ -174,15 +281,8 @@ namespace ast
         std::string GetEndLabel() const;
         std::string GetUpdateLabel() const;
 
-        // ---- enum context management ----
-        void AddEnum(const std::string &name, int value);
-        int GetEnumValue(const std::string &name) const;
-        bool InEnum(const std::string &name) const;
-
         // ---- array context management ----
-        void AddGlobalArray(const std::string &name, int size, TypeSpecifier type);
-
-        int GetPointerOffset(const std::string &name, int pointer_depth);
+        void AddGlobalArray(SymbolId name, int size, TypeSpecifier type);
 
         std::ostringstream PrintContext() const; // for debugging
     };
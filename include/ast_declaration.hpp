@@ -11,14 +11,17 @@ namespace ast
     private:
         const TypeSpecifier declaration_specifiers_;
         NodePtr declarator_list_;
+        mutable std::vector<Binding> bindings_; // one per declarator, made by Resolve
 
     public:
         Declaration(TypeSpecifier type, NodePtr declarator_list)
             : declaration_specifiers_(type),
               declarator_list_(std::move(declarator_list)) {};
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
+        void Resolve(Resolver &resolver) const override;
     };
 
 } // namespace ast
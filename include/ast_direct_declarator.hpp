@@ -10,12 +10,15 @@ namespace ast
     private:
         NodePtr identifier_;
         NodePtr parameter_list_;
+        mutable std::vector<Binding> parameters_; // made by Resolve, function definitions only
 
     public:
         DirectDeclarator(NodePtr identifier, NodePtr parameter_list) : identifier_(std::move(identifier)), parameter_list_(std::move(parameter_list)) {};
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
-        std::string GetID() const override;
+        LoweredValue Lower(Lowering &lowering) const override; // declares the parameters
+        void Resolve(Resolver &resolver) const override;
+        SymbolId GetID() const override;
         bool IsFunction() const override { return true; };
         void StoreFunctionInfo(TypeSpecifier return_type, Context &context) const;
     };
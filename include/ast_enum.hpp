@@ -8,32 +8,37 @@ namespace ast
     class EnumDeclaration : public Node
     {
     private:
-        const std::string enum_name_;
+        const SymbolId enum_name_;
         NodePtr enumerators_;
 
     public:
-        EnumDeclaration(const std::string &enum_name, NodePtr enumerators)
+        EnumDeclaration(SymbolId enum_name, NodePtr enumerators)
             : enum_name_(enum_name), enumerators_(std::move(enumerators)) {}
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        void Resolve(Resolver &resolver) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
     class Enumerator : public Node
     {
     private:
-        const std::string name_;
+        const SymbolId name_;
         NodePtr value_;
+        mutable Binding binding_; // its value is set when the enclosing declaration is resolved
 
     public:
-        Enumerator(const std::string &name, NodePtr value)
-            : name_(name), value_(std::move(value)) {}
+        Enumerator(SymbolId name, NodePtr value)
+            : name_(name), value_(std::move(value)), binding_{.kind = Binding::Kind::ENUM, .name = name, .type = TypeSpecifier::INT} {}
 
-        const std::string &GetName() const { return name_; }
+        SymbolId GetName() const { return name_; }
         const NodePtr &GetValue() const { return value_; }
+        void Declare(Resolver &resolver, int value) const;
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        const Binding *GetBinding() const override { return &binding_; };
     };
 
 } // namespace ast
@@ -20,7 +20,9 @@ namespace ast
               update_assignment_(std::move(update_assignment)),
               for_body_(std::move(body)) {};
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
+        void Resolve(Resolver &resolver) const override;
     };
 }
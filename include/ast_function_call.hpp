@@ -3,8 +3,20 @@
 
 namespace ast
 {
-    std::vector<std::string> SaveUsedRegisters(Context &context, std::ostream &stream);
-    void RestoreUsedRegisters(Context &context, std::ostream &stream, const std::vector<std::string> &saved_registers);
+    // A register in use across a call. Only a value read after the call is stored, at its own
+    // width, in a call save slot; the others are handed back without a load.
+    struct SavedRegister
+    {
+        Reg reg;
+        TypeSpecifier type; // INT, FLOAT or DOUBLE
+        bool stored;
+        bool dead;
+        int offset; // of the slot, if stored
+    };
+
+    // frees every register in use; destReg is overwritten by the call's result, so it is never stored
+    std::vector<SavedRegister> SaveUsedRegisters(Context &context, AsmWriter &stream, int destReg);
+    void RestoreUsedRegisters(Context &context, AsmWriter &stream, const std::vector<SavedRegister> &saved_registers);
 
     class FunctionCall : public Node
     {
@@ -16,9 +28,11 @@ namespace ast
         FunctionCall(NodePtr postfix_expression, NodePtr argument_expression_list)
             : postfix_expression_(std::move(postfix_expression)), argument_expression_list_(std::move(argument_expression_list)) {};
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        void Resolve(Resolver &resolver) const override;
         TypeSpecifier GetType(Context &context) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
 } // namespace ast
@@ -2,9 +2,14 @@
 
 #include "ast_node.hpp"
 #include "ast_type_specifier.hpp"
+#include "source_file.hpp"
 
 namespace ast
 {
+    // Writes the partial output and context of the function being generated on this thread, if any.
+    void DumpFunctionState(std::ostream &stream);
+    // Forgets that state, e.g. once a failed function has been reported and its context is going away.
+    void ClearFunctionState();
 
     class FunctionDefinition : public Node
     {
@@ -12,6 +17,8 @@ namespace ast
         const TypeSpecifier declaration_specifiers_;
         NodePtr declarator_;
         NodePtr compound_statement_;
+        const SourceSpan span_; // the whole definition
+        const SourceSpan body_; // its compound statement
 
         std::string function_name_;
 
@@ -19,12 +26,23 @@ namespace ast
         FunctionDefinition(
             TypeSpecifier declaration_specifiers,
             NodePtr declarator,
-            NodePtr compound_statement)
+            NodePtr compound_statement,
+            SourceSpan span,
+            SourceSpan body)
             : declaration_specifiers_(declaration_specifiers),
               declarator_(std::move(declarator)),
-              compound_statement_(std::move(compound_statement)) {};
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+              compound_statement_(std::move(compound_statement)),
+              span_(span),
+              body_(body) {};
+        // adds the function's signature to the global context; must run before EmitRISC
+        void Declare(Context &context) const;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
+        void Resolve(Resolver &resolver) const override;
+        SymbolId GetID() const override;
+        SourceSpan GetSourceSpan() const { return span_; }
+        SourceSpan GetBodySpan() const { return body_; }
     };
 
 } // namespace ast
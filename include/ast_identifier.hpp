@@ -8,17 +8,24 @@ namespace ast
     class Identifier : public Node
     {
     private:
-        std::string identifier_;
+        SymbolId identifier_;
+        mutable const Binding *binding_ = nullptr; // set by Resolve, nullptr if undeclared
 
     public:
-        Identifier(std::string identifier) : identifier_(std::move(identifier)) {};
+        Identifier(SymbolId identifier) : identifier_(identifier) {};
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
-        std::string GetID() const override;
+        void Resolve(Resolver &resolver) const override;
+        SymbolId GetID() const override;
+        const Binding *GetBinding() const override { return binding_; };
         bool IsFunction() const override { return false; };
+        ConstValue Evaluate(Context &context) const override;
+        bool IsConstant(Context &context) const override; // enumerators only
         TypeSpecifier GetType(Context &context) const override;
         bool IsPointer(Context &context, const bool has_been_declared) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
+        Place LowerPlace(Lowering &lowering) const override;
     };
 
 } // namespace ast
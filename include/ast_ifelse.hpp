@@ -15,8 +15,11 @@ namespace ast
     public:
         IfStatement(NodePtr condition, NodePtr ifBody, NodePtr elseBody) : condition_(std::move(condition)), ifBody_(std::move(ifBody)), elseBody_(std::move(elseBody)) {};
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        LoweredValue Lower(Lowering &lowering) const override; // as a ternary
+        void LowerStatement(Lowering &lowering) const override;
+        void Resolve(Resolver &resolver) const override;
 
         TypeSpecifier GetType(Context &context) const override;
     };
@@ -12,13 +12,15 @@ namespace ast
         NodePtr expression_;
         void SetAddiValue(char op_symbol_);
         std::string GetAddOrSubOp(TypeSpecifier type) const;
+        LoweredValue LowerUpdate(Lowering &lowering, bool yields_old_value) const;
 
     public:
         IncAndDecOp(char op_symbol, NodePtr expression)
             : op_symbol_(op_symbol), expression_(std::move(expression)) { SetAddiValue(op_symbol_); }
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override = 0;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override = 0;
         void Print(std::ostream &stream) const override = 0;
+        void Resolve(Resolver &resolver) const override;
         TypeSpecifier GetType(Context &context) const override;
     };
 
@@ -28,7 +30,8 @@ namespace ast
         PostIncAndDecOp(char op_symbol, NodePtr expression)
             : IncAndDecOp(op_symbol, std::move(expression)) {}
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
         void Print(std::ostream &stream) const override;
     };
 
@@ -41,7 +44,8 @@ namespace ast
         PreIncAndDecOp(char op_symbol, NodePtr expression)
             : IncAndDecOp(op_symbol, std::move(expression)) {}
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
         void Print(std::ostream &stream) const override;
     };
 
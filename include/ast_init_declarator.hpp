@@ -9,8 +9,8 @@ namespace ast
     private:
         NodePtr declarator_;
         NodePtr initializer_;
-        void EmitLocalDefinition(std::ostream &stream, std::string srcRegStr, int offset, TypeSpecifier type) const;
-        void EmitGlobalDefinition(std::ostream &stream, std::any value, TypeSpecifier type, std::string id) const;
+        void EmitLocalDefinition(AsmWriter &stream, std::string_view srcRegStr, int offset, TypeSpecifier type) const;
+        void EmitGlobalDefinition(AsmWriter &stream, ConstValue value, TypeSpecifier type) const;
 
     public:
         InitDeclarator(NodePtr declarator, NodePtr initializer)
@@ -23,9 +23,13 @@ namespace ast
         int GetPointerDepth() const override;
         int GetArraySize(Context &context) const override;
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
-        std::string GetID() const override;
+        void StoreFunctionInfo(TypeSpecifier return_type, Context &context) const; // of a prototype
+        LoweredValue Lower(Lowering &lowering) const override;
+        void Resolve(Resolver &resolver) const override;
+        SymbolId GetID() const override;
+        const Binding *GetBinding() const override;
     };
 
 } // namespace ast
@@ -15,8 +15,10 @@ namespace ast
     public:
         ReturnStatement(NodePtr expression) : expression_(std::move(expression)) {}
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        void Resolve(Resolver &resolver) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
 } // namespace ast
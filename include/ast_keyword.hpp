@@ -10,8 +10,9 @@ namespace ast
     public:
         ContinueStatement() {};
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
     class BreakStatement : public Node
@@ -19,7 +20,8 @@ namespace ast
     public:
         BreakStatement() {};
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 }
@@ -6,26 +6,35 @@ namespace ast
 {
     class LogicalOp : public Node
     {
+    private:
+        friend struct LeftChain;
+
+        // see LeftChain
+        std::optional<ConstValue> FoldOperation(ConstValue lhs, Context &context) const;
+        LoweredValue LowerOperation(Lowering &lowering, LoweredValue lhs) const;
+
     protected:
         NodePtr expression1_;
         NodePtr expression2_;
         std::string op_symbol_ = "LOGICAL_OP";
 
-        template <typename T>
-        std::any HandleOperations(TypeSpecifier type) const;
-        template <typename T, typename Op>
-        std::any EvalOperation(TypeSpecifier type, Op op) const;
+        // destReg holds the value of expression1_; leaves the 0 or 1 result of the operation in it
+        virtual void EmitOperation(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const = 0;
 
     public:
         LogicalOp(NodePtr expression1,
                   NodePtr expression2)
             : expression1_(std::move(expression1)),
               expression2_(std::move(expression2)) {}
+        ~LogicalOp() override { LeftChain::Unlink<LogicalOp>(expression1_); }
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override = 0;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
-        std::any GetValue(TypeSpecifier type) const override;
+        void Resolve(Resolver &resolver) const override;
+        ConstValue Evaluate(Context &context) const override;
+        bool IsConstant(Context &context) const override;
         TypeSpecifier GetType(Context &context) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
     class LogicalAnd : public LogicalOp
@@ -35,7 +44,8 @@ namespace ast
                    NodePtr expression2)
             : LogicalOp(std::move(expression1), std::move(expression2)) { op_symbol_ = "&&"; }
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+    protected:
+        void EmitOperation(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
     };
 
     class LogicalOr : public LogicalOp
@@ -45,6 +55,7 @@ namespace ast
                   NodePtr expression2)
             : LogicalOp(std::move(expression1), std::move(expression2)) { op_symbol_ = "||"; }
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+    protected:
+        void EmitOperation(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
     };
 } // namespace ast
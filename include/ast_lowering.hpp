@@ -0,0 +1,136 @@
+#pragma once
+
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ast_context.hpp"
+#include "ast_type_specifier.hpp"
+#include "ir.hpp"
+
+namespace ast
+{
+    class FunctionDefinition;
+    class Node;
+
+    // C type of a lowered expression or object. Arrays have an array_size of at least 0: as objects
+    // they have a pointer_depth of 0, and their values decay to a pointer to the first element that
+    // keeps the size for sizeof.
+    struct CType
+    {
+        TypeSpecifier base = TypeSpecifier::VOID;
+        int pointer_depth = 0;
+        int array_size = -1;
+
+        bool IsVoid() const { return base == TypeSpecifier::VOID && pointer_depth == 0; }
+        bool IsPointer() const { return pointer_depth > 0; }
+        bool IsArray() const { return array_size >= 0; }
+        bool IsFloating() const { return pointer_depth == 0 && (base == TypeSpecifier::FLOAT || base == TypeSpecifier::DOUBLE); }
+        bool IsInteger() const { return pointer_depth == 0 && (base == TypeSpecifier::INT || base == TypeSpecifier::UNSIGNED || base == TypeSpecifier::CHAR); }
+        bool IsScalar() const { return IsPointer() || IsFloating() || IsInteger(); }
+    };
+
+    // value of an expression, reg is ir::NO_VREG for void
+    struct LoweredValue
+    {
+        ir::VReg reg = ir::NO_VREG;
+        CType type;
+    };
+
+    // the object an lvalue designates
+    struct Place
+    {
+        ir::Address address;
+        CType type;
+    };
+
+    // Throws the std::runtime_error that sends a function back to the direct emitter, for constructs
+    // the lowering doesn't handle.
+    [[noreturn]] void Unsupported(std::string_view what);
+
+    // State of lowering one function body to IR (see ir.hpp), the counterpart of EmitRISC.
+    // Nodes append instructions to the current block through it and it carries the C semantics
+    // every node shares: conversions, pointer arithmetic, loads and stores of typed objects, and
+    // the stack slots of locals. After a terminator, instructions go to a fresh block nothing jumps
+    // to, which BuildCfg drops, so dead code after return or break needs no special casing.
+    class Lowering
+    {
+    private:
+        Context &context_; // literal pool, labels and function signatures
+        ir::Function function_;
+        ir::BlockId block_;
+        CType return_type_;
+        std::unordered_map<const Binding *, Place> locals_; // by declaration, parameters included
+        std::vector<ir::BlockId> break_targets_;
+        std::vector<ir::BlockId> continue_targets_; // NO_BLOCK inside a switch outside any loop
+
+    public:
+        Lowering(Context &context, SymbolId function);
+
+        Context &GetContext() const { return context_; }
+        const ir::Function &GetFunction() const { return function_; }
+
+        // ---- the function
+        void SetReturnType(CType type);
+        const CType &GetReturnType() const { return return_type_; }
+        ir::VReg AddParam(CType type);
+        // returns from the end of the body if it falls off, then builds and verifies the CFG
+        ir::Function Finish();
+
+        // ---- instructions, appended to the current block
+        ir::VReg Emit(ir::Instr instr, ir::Type type); // instr.dst is set to a new register of type
+        void EmitVoid(ir::Instr instr);
+        ir::VReg Const(int32_t value);
+        ir::VReg FConst(double value, ir::Type type);
+        ir::VReg Binary(ir::Op op, ir::VReg a, ir::VReg b); // of the type of a, or I32 for comparisons
+        ir::VReg Unary(ir::Op op, ir::VReg a, ir::Type type);
+        ir::VReg Address(const ir::Address &address);
+
+        // ---- control flow
+        ir::BlockId NewBlock() { return function_.NewBlock(); }
+        ir::BlockId CurrentBlock() const { return block_; }
+        void SetBlock(ir::BlockId block) { block_ = block; }
+        void Jump(ir::BlockId target);
+        void Branch(ir::VReg condition, ir::BlockId if_true, ir::BlockId if_false);
+        void Return(ir::VReg value); // ir::NO_VREG for void
+
+        // break and continue targets of the innermost loop or switch
+        void EnterLoop(ir::BlockId break_target, ir::BlockId continue_target);
+        void EnterSwitch(ir::BlockId break_target); // continue still targets the enclosing loop
+        void ExitLoop();
+        ir::BlockId BreakTarget() const;
+        ir::BlockId ContinueTarget() const;
+
+        // ---- C semantics
+        static ir::Type IRType(const CType &type);
+        static int SizeOf(const CType &type);
+        static int ElementSize(const CType &pointer); // bytes one step of the pointer moves
+        static CType CommonType(const CType &lhs, const CType &rhs); // usual arithmetic conversions
+
+        LoweredValue Convert(const LoweredValue &value, const CType &type); // as by assignment
+        LoweredValue Promote(const LoweredValue &value);                    // integer promotions
+        ir::VReg Truth(const LoweredValue &value);                          // nonzero iff value is
+        LoweredValue Bool(const LoweredValue &value);                       // 1 or 0
+
+        // op as BinaryOp spells it ('l' and 'r' for the shifts); pointer arithmetic is scaled
+        LoweredValue Arithmetic(char op, const LoweredValue &lhs, const LoweredValue &rhs);
+        // op is the C spelling of a relational or equality operator
+        LoweredValue Compare(std::string_view op, const LoweredValue &lhs, const LoweredValue &rhs);
+
+        LoweredValue Load(const Place &place); // an array decays to the address of its first element
+        void Store(const Place &place, const LoweredValue &value); // value must have the type of the place
+
+        // type of an expression, which is lowered into a block nothing jumps to
+        CType TypeOf(const Node &expression);
+
+        // ---- variables
+        Place DeclareLocal(const Binding &binding, int array_size); // array_size is -1 for scalars
+        Place NewTemporary(const CType &type);                      // an unnamed local
+        Place PlaceOf(const Binding &binding);                      // a local or a global
+    };
+
+    // IR of a function, or std::runtime_error if it uses something the lowering doesn't support or is
+    // too big for the IR passes
+    ir::Function LowerFunction(const FunctionDefinition &function, Context &context);
+
+} // namespace ast
@@ -2,23 +2,37 @@
 
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <vector>
-#include <any>
 
 #include "ast_type_specifier.hpp"
+#include "ast_const_value.hpp"
 #include "ast_context.hpp"
+#include "ast_arena.hpp"
+#include "ast_asm_writer.hpp"
 
 namespace ast
 {
+    class Resolver;
+    class Lowering;
+    struct LoweredValue;
+    struct Place;
 
     class Node
     {
     public:
         virtual ~Node() {}
-        virtual void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const = 0;
+
+        // nodes are placed in the current AstArena when there is one; delete then only runs the
+        // destructor and the memory is released with the arena
+        static void *operator new(size_t size);
+        static void operator delete(void *ptr);
+        virtual void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const = 0;
         virtual void Print(std::ostream &stream) const = 0;
-        virtual std::string GetID() const { return ""; };
-        virtual std::vector<std::string> GetIDs() const { throw std::runtime_error("GetIDs not implemented"); };
+        virtual void Resolve(Resolver &resolver) const { (void)resolver; }; // binds identifiers, see ast_resolver.hpp
+        virtual SymbolId GetID() const { return SymbolId::EMPTY; };
+        virtual const Binding *GetBinding() const { return nullptr; }; // declaration GetID() names, once resolved
+        virtual std::vector<SymbolId> GetIDs() const { throw std::runtime_error("GetIDs not implemented"); };
         virtual bool IsFunction() const { return false; }; // used to discern DirectDeclarator and Identifier
 
         // --- POINTERS
@@ -38,11 +52,16 @@ namespace ast
             return 0;
         }; // used to get the size of an array
 
-        virtual std::any GetValue(TypeSpecifier type) const
+        virtual ConstValue Evaluate(Context &context) const
+        {
+            (void)context;
+            throw std::runtime_error("Not a constant expression");
+        }; // compile time evaluation, for global initializers, enumerators, array sizes and case labels
+        virtual bool IsConstant(Context &context) const
         {
-            (void)type;
-            throw std::runtime_error("GetValue not implemented");
-        }; // used for compile time evaluation (global variables)
+            (void)context;
+            return false;
+        }; // whether Evaluate succeeds, so code generation can fold the expression
         virtual TypeSpecifier GetType(Context &context) const
         {
             (void)context;
@@ -53,6 +72,11 @@ namespace ast
             (void)context;
             throw std::runtime_error("GetParams not implemented");
         };
+
+        // --- IR (see ast_lowering.hpp); a function using a node that doesn't lower is generated by EmitRISC
+        virtual LoweredValue Lower(Lowering &lowering) const;
+        virtual Place LowerPlace(Lowering &lowering) const;     // lvalues only
+        virtual void LowerStatement(Lowering &lowering) const; // Lower, discarding the value
     };
 
     // If you don't feel comfortable using std::unique_ptr, you can switch NodePtr to be defined
@@ -61,23 +85,108 @@ namespace ast
     // (and get rid of the now unnecessary std::move-s)
     using NodePtr = std::unique_ptr<const Node>;
 
+    // Left-leaning chains of one operator class, like a + b + c + ..., are walked in loops instead of
+    // by recursing down expression1_, so the C++ stack doesn't grow with their length. Op names the
+    // class, which makes LeftChain a friend; its FoldOperation gives the value of one operation from
+    // the value of its left operand, or nothing when expression2_ doesn't fold with it.
+    struct LeftChain
+    {
+        template <class Op>
+        using Spine = std::vector<const Op *>;
+
+        // root and every Op down its expression1_ chain, outermost first; the expression1_ of the last
+        // one is the leftmost operand
+        template <class Op>
+        static Spine<Op> LeftSpine(const Op &root)
+        {
+            Spine<Op> spine = {&root};
+            while (const auto *op = dynamic_cast<const Op *>(spine.back()->expression1_.get()))
+            {
+                spine.push_back(op);
+            }
+            return spine;
+        }
+
+        // for the destructor of Op: releases the chain under left one node at a time, so that
+        // destroying it doesn't recurse either
+        template <class Op>
+        static void Unlink(NodePtr &left)
+        {
+            NodePtr node = std::move(left);
+            while (const auto *op = dynamic_cast<const Op *>(node.get()))
+            {
+                // the node is only const through NodePtr, and is being destroyed
+                NodePtr next = std::move(const_cast<Op *>(op)->expression1_);
+                node = std::move(next);
+            }
+        }
+
+        // folds the leftmost operand, which must be constant, with the operations that follow it while
+        // they fold; op is left at the first operation of the spine that doesn't
+        template <class Op>
+        static ConstValue FoldConstantPrefix(const Spine<Op> &spine, Context &context,
+                                             typename Spine<Op>::const_reverse_iterator &op)
+        {
+            ConstValue value = spine.back()->expression1_->Evaluate(context);
+            for (op = spine.crbegin(); op != spine.crend(); ++op)
+            {
+                const std::optional<ConstValue> next = (*op)->FoldOperation(value, context);
+                if (!next)
+                {
+                    break;
+                }
+                value = *next;
+            }
+            return value;
+        }
+
+        template <class Op>
+        static void Resolve(const Op &root, Resolver &resolver)
+        {
+            const Spine<Op> spine = LeftSpine(root);
+            spine.back()->expression1_->Resolve(resolver);
+            for (auto op = spine.crbegin(); op != spine.crend(); ++op)
+            {
+                (*op)->expression2_->Resolve(resolver);
+            }
+        }
+
+        // whether the whole chain folds
+        template <class Op>
+        static bool IsConstant(const Op &root, Context &context)
+        {
+            const Spine<Op> spine = LeftSpine(root);
+            if (!spine.back()->expression1_->IsConstant(context))
+            {
+                return false;
+            }
+            auto op = spine.crbegin();
+            FoldConstantPrefix(spine, context, op);
+            return op == spine.crend();
+        }
+    };
+
     class NodeList : public Node
     {
     private:
-        std::vector<NodePtr> nodes_;
+        using Storage = std::vector<NodePtr, ArenaAllocator<NodePtr>>;
+
+        Storage nodes_;
 
     public:
         NodeList(NodePtr first_node) { nodes_.push_back(std::move(first_node)); }
 
-        using iterator = std::vector<NodePtr>::iterator;
-        using const_iterator = std::vector<NodePtr>::const_iterator;
+        using iterator = Storage::iterator;
+        using const_iterator = Storage::const_iterator;
 
         void PushBack(NodePtr item);
-        virtual void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        virtual void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         virtual void Print(std::ostream &stream) const override;
-        virtual std::vector<std::string> GetIDs() const;
+        virtual void Resolve(Resolver &resolver) const override;
+        virtual std::vector<SymbolId> GetIDs() const;
         virtual std::vector<ParamInfo> GetParams(Context &context) const;
         virtual int GetArraySize(Context &context) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
 
         // The following methods are needed to iterate over the nodes in the NodeList
         iterator begin() { return nodes_.begin(); }
@@ -85,6 +194,7 @@ namespace ast
         const_iterator begin() const { return nodes_.begin(); }
         const_iterator end() const { return nodes_.end(); }
         size_t Size() const { return nodes_.size(); }
+        const NodePtr &operator[](size_t index) const { return nodes_[index]; }
     };
 
 } // namespace ast
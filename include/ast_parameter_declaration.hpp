@@ -15,11 +15,12 @@ namespace ast
     public:
         ParameterDeclaration(TypeSpecifier declaration_specifiers, NodePtr declarator) : declaration_specifiers_(declaration_specifiers), declarator_(std::move(declarator)) {};
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
-        std::string GetID() const override;
+        SymbolId GetID() const override;
         TypeSpecifier GetType(Context &context) const override;
         bool IsPointer(Context &context, const bool has_been_declared) const override;
+        int GetPointerDepth() const override;
     };
 
 } // namespace ast
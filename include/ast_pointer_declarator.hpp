@@ -14,9 +14,12 @@ namespace ast
     public:
         PointerDeclarator(int pointer_depth, NodePtr declarator) : declarator_(std::move(declarator)), pointer_depth_(pointer_depth) {};
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
-        std::string GetID() const override;
+        LoweredValue Lower(Lowering &lowering) const override;
+        void Resolve(Resolver &resolver) const override;
+        SymbolId GetID() const override;
+        const Binding *GetBinding() const override;
         bool IsPointer(Context &context, const bool has_been_declared) const override;
         int GetPointerDepth() const override;
 
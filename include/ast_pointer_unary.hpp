@@ -13,10 +13,12 @@ namespace ast
     public:
         PointerUnary(NodePtr expression) : expression_(std::move(expression)) {};
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override = 0;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override = 0;
         void Print(std::ostream &stream) const override = 0;
+        void Resolve(Resolver &resolver) const override;
         TypeSpecifier GetType(Context &context) const override = 0;
-        std::string GetID() const override;
+        SymbolId GetID() const override;
+        const Binding *GetBinding() const override;
     };
 
     class UnaryAddressOp : public PointerUnary
@@ -24,10 +26,11 @@ namespace ast
     public:
         UnaryAddressOp(NodePtr expression) : PointerUnary(std::move(expression)) {};
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
         TypeSpecifier GetType(Context &context) const override;
         bool IsPointer(Context &context, const bool has_been_declared) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
     class UnaryDereferenceOp : public PointerUnary
@@ -38,11 +41,13 @@ namespace ast
     public:
         UnaryDereferenceOp(NodePtr expression) : PointerUnary(std::move(expression)) { UpdatePointerDepth(); };
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
         TypeSpecifier GetType(Context &context) const override;
         bool IsPointer(Context &context, const bool has_been_declared) const override;
         int GetPointerDepth() const override;
+        LoweredValue Lower(Lowering &lowering) const override;
+        Place LowerPlace(Lowering &lowering) const override;
 
         void UpdatePointerDepth();
     };
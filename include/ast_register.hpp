@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace ast
+{
+    // Register Definitions
+    // x0               zero
+    // x1               ra
+    // x2               sp
+    // x3               gp
+    // x4               tp
+    // x5 - x7          t0-t2
+    // x8               s0/fp
+    // x9               s1
+    // x10 - x11        a0-a1
+    // x12 - x17        a2-a7
+    // x18 - x27        s2-s11
+    // x28 - x31        t3-t6
+
+    // Registers in the order the compiler numbers them: the register indices used by Context are
+    // the enum values. Everything before A1 is reserved, A1..T6 are allocatable integer registers
+    // and FA1..FT11 allocatable float registers.
+    // DO NOT REORDER: AssignRegister hands out the lowest free index of a class
+    enum class Reg : uint8_t
+    {
+        ZERO, RA, SP, GP, TP, S0,
+        S1, S2, S3, S4, S5, S6, S7, S8, S9, S10, S11,
+        FS0, FS1, FS2, FS3, FS4, FS5, FS6, FS7, FS8, FS9, FS10, FS11,
+        FA0,
+        A0, A1, A2, A3, A4, A5, A6, A7,
+        T0, T1, T2, T3, T4, T5, T6,
+        FA1, FA2, FA3, FA4, FA5, FA6, FA7,
+        FT0, FT1, FT2, FT3, FT4, FT5, FT6, FT7, FT8, FT9, FT10, FT11
+    };
+
+    constexpr int N_REGISTERS = static_cast<int>(Reg::FT11) + 1;
+
+    constexpr std::array<std::string_view, N_REGISTERS> REGISTER_NAMES = {
+        "zero", "ra", "sp", "gp", "tp", "s0",
+        "s1", "s2", "s3", "s4", "s5", "s6", "s7", "s8", "s9", "s10", "s11",
+        "fs0", "fs1", "fs2", "fs3", "fs4", "fs5", "fs6", "fs7", "fs8", "fs9", "fs10", "fs11",
+        "fa0",
+        "a0", "a1", "a2", "a3", "a4", "a5", "a6", "a7",
+        "t0", "t1", "t2", "t3", "t4", "t5", "t6",
+        "fa1", "fa2", "fa3", "fa4", "fa5", "fa6", "fa7",
+        "ft0", "ft1", "ft2", "ft3", "ft4", "ft5", "ft6", "ft7", "ft8", "ft9", "ft10", "ft11"};
+
+    // argument registers by position in the calling convention
+    constexpr std::array<Reg, 8> INT_ARGUMENT_REGISTERS = {Reg::A0, Reg::A1, Reg::A2, Reg::A3, Reg::A4, Reg::A5, Reg::A6, Reg::A7};
+    constexpr std::array<Reg, 8> FLOAT_ARGUMENT_REGISTERS = {Reg::FA0, Reg::FA1, Reg::FA2, Reg::FA3, Reg::FA4, Reg::FA5, Reg::FA6, Reg::FA7};
+
+    constexpr std::string_view RegisterName(Reg reg) { return REGISTER_NAMES[static_cast<int>(reg)]; }
+
+    constexpr bool IsFloatRegister(Reg reg)
+    {
+        return (reg >= Reg::FS0 && reg <= Reg::FA0) || reg >= Reg::FA1;
+    }
+
+    static_assert(RegisterName(Reg::FA0) == "fa0" && RegisterName(Reg::A1) == "a1" && RegisterName(Reg::FT11) == "ft11");
+}
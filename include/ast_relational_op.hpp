@@ -1,11 +1,21 @@
 #pragma once
 
+#include <utility>
+
 #include "ast_node.hpp"
 
 namespace ast
 {
     class RelationalOp : public Node
     {
+    private:
+        friend struct LeftChain;
+
+        // see LeftChain
+        std::optional<ConstValue> FoldOperation(ConstValue lhs, Context &context) const;
+        // what the operands are compared as, given the types of expression1_ and expression2_
+        std::pair<TypeSpecifier, TypeSpecifier> OperandTypes(Context &context) const;
+
     protected:
         NodePtr expression1_;
         NodePtr expression2_;
@@ -16,20 +26,18 @@ namespace ast
                      NodePtr expression2)
             : expression1_(std::move(expression1)),
               expression2_(std::move(expression2)) {}
+        ~RelationalOp() override { LeftChain::Unlink<RelationalOp>(expression1_); }
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
-        // use start and end to standardise the common parts of EmitRISC
-        void EmitStart(std::ostream &stream, Context &context, int srcReg1, int srcReg2, TypeSpecifier type) const;
-        void EmitEnd(std::ostream &stream, Context &context, int destReg) const;
-        virtual void EmitMain(std::ostream &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const = 0;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        // EmitMain compares srcReg1 with srcReg2 into destReg, and EmitEnd is common to every comparison
+        void EmitEnd(AsmWriter &stream, Context &context, int destReg) const;
+        virtual void EmitMain(AsmWriter &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const = 0;
         void Print(std::ostream &stream) const override;
+        void Resolve(Resolver &resolver) const override;
+        ConstValue Evaluate(Context &context) const override;
+        bool IsConstant(Context &context) const override;
         TypeSpecifier GetType(Context &context) const override;
-
-        std::any GetValue(TypeSpecifier type) const override;
-        template <typename T>
-        std::any HandleOperations(TypeSpecifier type) const;
-        template <typename T, typename Op>
-        std::any EvalOperation(TypeSpecifier type, Op op) const;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
     class LessThan : public RelationalOp
@@ -39,7 +47,7 @@ namespace ast
                  NodePtr expression2)
             : RelationalOp(std::move(expression1), std::move(expression2)) { op_symbol_ = "<"; }
 
-        void EmitMain(std::ostream &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const override;
+        void EmitMain(AsmWriter &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const override;
     };
 
     class LessThanEqual : public RelationalOp
@@ -49,7 +57,7 @@ namespace ast
                       NodePtr expression2)
             : RelationalOp(std::move(expression1), std::move(expression2)) { op_symbol_ = "<="; }
 
-        void EmitMain(std::ostream &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const override;
+        void EmitMain(AsmWriter &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const override;
     };
 
     class GreaterThan : public RelationalOp
@@ -59,7 +67,7 @@ namespace ast
                     NodePtr expression2)
             : RelationalOp(std::move(expression1), std::move(expression2)) { op_symbol_ = ">"; }
 
-        void EmitMain(std::ostream &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const override;
+        void EmitMain(AsmWriter &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const override;
     };
 
     class GreaterThanEqual : public RelationalOp
@@ -69,7 +77,7 @@ namespace ast
                          NodePtr expression2)
             : RelationalOp(std::move(expression1), std::move(expression2)) { op_symbol_ = ">="; }
 
-        void EmitMain(std::ostream &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const override;
+        void EmitMain(AsmWriter &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const override;
     };
 
     class Equal : public RelationalOp
@@ -79,7 +87,7 @@ namespace ast
               NodePtr expression2)
             : RelationalOp(std::move(expression1), std::move(expression2)) { op_symbol_ = "=="; }
 
-        void EmitMain(std::ostream &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const override;
+        void EmitMain(AsmWriter &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const override;
     };
 
     class NotEqual : public RelationalOp
@@ -89,7 +97,7 @@ namespace ast
                  NodePtr expression2)
             : RelationalOp(std::move(expression1), std::move(expression2)) { op_symbol_ = "!="; }
 
-        void EmitMain(std::ostream &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const override;
+        void EmitMain(AsmWriter &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const override;
     };
 
 } // namespace ast
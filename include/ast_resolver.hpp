@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ast_context.hpp"
+#include "ast_scoped_table.hpp"
+
+namespace ast
+{
+    // State of the resolve pass, run once between parsing and code generation.
+    // It opens the same scopes code generation will and binds every identifier to the declaration it
+    // names, so that EmitRISC, GetType and IsPointer read the binding instead of searching the
+    // symbol tables again. Unknown names are left unbound; code generation reports them.
+    class Resolver
+    {
+    private:
+        Context &context_;                                 // for declarator queries that take a context
+        ScopedTable<SymbolId, const Binding *> variables_; // the outermost scope holds the globals
+        ScopedTable<SymbolId, const Binding *> enums_;     // global enumerators, then those of the current function
+        bool in_function_ = false;
+
+    public:
+        explicit Resolver(Context &context) : context_(context) {}
+
+        Context &GetContext() const { return context_; }
+        bool InFunction() const { return in_function_; }
+
+        void EnterFunction();
+        void ExitFunction();
+        void EnterScope() { variables_.EnterScope(); }
+        void ExitScope() { variables_.ExitScope(); }
+
+        // the binding must outlive the pass; declaring nodes own theirs
+        void Declare(const Binding &binding) { variables_.Insert(binding.name, &binding); }
+        void DeclareEnum(const Binding &binding) { enums_.Insert(binding.name, &binding); }
+        const Binding *Find(SymbolId name) const; // enumerators hide variables, nullptr if undeclared
+    };
+
+} // namespace ast
@@ -16,8 +16,10 @@ namespace ast
 
         const NodeList &GetNodes() const { return statements_; }
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        void Resolve(Resolver &resolver) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
 } // namespace ast
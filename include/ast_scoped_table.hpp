@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace ast
+{
+    // Flat, scope-chained symbol table.
+    // Every entry of every open scope lives in a single vector, and an index maps each key to its
+    // innermost visible entry, so lookups are O(1) and never copy the table. An entry remembers the
+    // entry it shadows, which lets ExitScope restore outer declarations by unwinding the vector.
+    template <typename Key, typename Value>
+    class ScopedTable
+    {
+    private:
+        struct Entry
+        {
+            Key key;
+            Value value;
+            int shadowed; // index of the entry hidden by this one, or -1
+        };
+
+        std::vector<Entry> entries_;
+        std::vector<size_t> scope_starts_;   // size of entries_ when each open scope was entered
+        std::unordered_map<Key, int> index_; // key -> innermost visible entry
+
+    public:
+        ScopedTable() { scope_starts_.push_back(0); } // the outermost scope is always open
+
+        void EnterScope() { scope_starts_.push_back(entries_.size()); }
+
+        void ExitScope()
+        {
+            size_t start = scope_starts_.back();
+            scope_starts_.pop_back();
+            while (entries_.size() > start)
+            {
+                Entry &entry = entries_.back();
+                if (entry.shadowed < 0)
+                {
+                    index_.erase(entry.key);
+                }
+                else
+                {
+                    index_[entry.key] = entry.shadowed;
+                }
+                entries_.pop_back();
+            }
+        }
+
+        size_t Depth() const { return scope_starts_.size(); }
+
+        // Pointers returned by Find are invalidated by the next Insert.
+        const Value *Find(const Key &key) const
+        {
+            auto it = index_.find(key);
+            return (it == index_.end()) ? nullptr : &entries_[it->second].value;
+        }
+
+        const Value *FindInCurrentScope(const Key &key) const
+        {
+            auto it = index_.find(key);
+            if (it == index_.end() || static_cast<size_t>(it->second) < scope_starts_.back())
+            {
+                return nullptr;
+            }
+            return &entries_[it->second].value;
+        }
+
+        // Declares key in the current scope, replacing any declaration already made in this scope.
+        Value &Insert(const Key &key, const Value &value)
+        {
+            auto [it, inserted] = index_.try_emplace(key, -1);
+            if (!inserted && static_cast<size_t>(it->second) >= scope_starts_.back())
+            {
+                entries_[it->second].value = value;
+                return entries_[it->second].value;
+            }
+            int shadowed = inserted ? -1 : it->second;
+            it->second = static_cast<int>(entries_.size());
+            entries_.push_back({key, value, shadowed});
+            return entries_.back().value;
+        }
+
+        // Visits the visible and shadowed entries of all open scopes, outermost first.
+        template <typename Visitor>
+        void ForEach(Visitor visitor) const
+        {
+            for (const Entry &entry : entries_)
+            {
+                visitor(entry.key, entry.value);
+            }
+        }
+    };
+
+} // namespace ast
@@ -12,9 +12,13 @@ namespace ast
         SizeOfVar(NodePtr expression)
             : expression_(std::move(expression)) {}
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        void Resolve(Resolver &resolver) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
 
+        ConstValue Evaluate(Context &context) const override;
+        bool IsConstant(Context &context) const override;
         TypeSpecifier GetType(Context &context) const override;
     };
 
@@ -27,9 +31,12 @@ namespace ast
         SizeOfType(TypeSpecifier type)
             : type_(type) {}
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
 
+        ConstValue Evaluate(Context &context) const override;
+        bool IsConstant(Context &context) const override;
         TypeSpecifier GetType(Context &context) const override;
     };
 }
@@ -19,8 +19,10 @@ namespace ast
         const Node *GetExpression() const { return expression_.get(); }
         const Node *GetStatement() const { return statement_.get(); }
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
+        void Resolve(Resolver &resolver) const override;
     };
 
     class CaseStatement : public Node
@@ -37,8 +39,9 @@ namespace ast
         const Node *GetCondition() const { return condition_.get(); }
         const Node *GetBody() const { return body_.get(); }
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        void Resolve(Resolver &resolver) const override;
     };
 
     class DefaultStatement : public Node
@@ -52,7 +55,8 @@ namespace ast
 
         const Node *GetBody() const { return body_.get(); }
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        void Resolve(Resolver &resolver) const override;
     };
 }
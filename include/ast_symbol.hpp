@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace ast
+{
+    // Interned identifier. Equal spellings always map to the same id, so symbol tables can hash and
+    // compare a single integer instead of the string.
+    enum class SymbolId : uint32_t
+    {
+        EMPTY = 0, // the empty string, returned by nodes without an identifier
+    };
+
+    // Spellings of the ids handed out by Intern. Thread-safe; ids stay valid (and spellings stay put)
+    // for the lifetime of the table. A long-running process gives each compile its own table, so the
+    // identifiers of one request don't stay around for the next.
+    class SymbolTable
+    {
+    private:
+        // Spellings live in fixed-size chunks that never move, so Spelling() can index them without
+        // taking the lock and the map can key on views into them.
+        static constexpr size_t CHUNK_BITS = 12;
+        static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;
+        static constexpr size_t MAX_CHUNKS = 16384;
+
+        std::mutex mutex_;
+        std::unordered_map<std::string_view, SymbolId> ids_;
+        std::atomic<std::string *> chunks_[MAX_CHUNKS] = {};
+        size_t count_ = 0;
+
+    public:
+        SymbolTable() { Intern(""); } // SymbolId::EMPTY
+        ~SymbolTable();
+
+        SymbolTable(const SymbolTable &) = delete;
+        SymbolTable &operator=(const SymbolTable &) = delete;
+
+        SymbolId Intern(std::string_view spelling);
+        const std::string &Spelling(SymbolId id) const;
+
+        // table that Intern and Spelling use on this thread: the one of the current SymbolScope, or
+        // else a process-wide table that lives until exit
+        static SymbolTable &Current();
+        static void SetCurrent(SymbolTable *table); // nullptr goes back to the process-wide table
+    };
+
+    // Makes a table current for the lifetime of the scope (e.g. while one request is compiled). Work
+    // handed to other threads has to take the table along (see TranslationUnit::EmitRISC).
+    class SymbolScope
+    {
+    private:
+        SymbolTable *previous_;
+
+    public:
+        explicit SymbolScope(SymbolTable &table);
+        ~SymbolScope() { SymbolTable::SetCurrent(previous_); }
+
+        SymbolScope(const SymbolScope &) = delete;
+        SymbolScope &operator=(const SymbolScope &) = delete;
+    };
+
+    inline SymbolId Intern(std::string_view spelling) { return SymbolTable::Current().Intern(spelling); }
+    inline const std::string &Spelling(SymbolId id) { return SymbolTable::Current().Spelling(id); }
+
+    inline std::ostream &operator<<(std::ostream &stream, SymbolId id)
+    {
+        return stream << Spelling(id);
+    }
+
+} // namespace ast
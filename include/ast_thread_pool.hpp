@@ -0,0 +1,67 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ast
+{
+    // Work-stealing thread pool.
+    // Every worker owns a deque of jobs: it runs its newest job first and, once its deque is empty,
+    // steals the oldest job of another worker. A thread waiting in RunAll runs queued jobs instead of
+    // blocking, so a task may itself call RunAll without starving the pool.
+    class ThreadPool
+    {
+    public:
+        using Task = std::function<void()>;
+
+        explicit ThreadPool(unsigned n_workers);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        size_t Size() const { return workers_.size(); }
+
+        // Runs every task and returns once all of them have finished. The calling thread takes part,
+        // so a pool without workers runs the tasks in order. Tasks must not throw.
+        void RunAll(std::vector<Task> &tasks);
+
+    private:
+        struct Group
+        {
+            std::mutex mutex;
+            std::condition_variable done;
+            size_t remaining;
+        };
+
+        struct Job
+        {
+            Task *task;
+            Group *group;
+        };
+
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::vector<std::thread> workers_;
+
+        std::mutex sleep_mutex_;
+        std::condition_variable wake_;
+        size_t queued_ = 0; // jobs waiting in any queue, guarded by sleep_mutex_
+        bool stopping_ = false;
+        size_t next_queue_ = 0;
+
+        bool TryRunOne(size_t home);
+        void WorkerLoop(size_t index);
+    };
+
+} // namespace ast
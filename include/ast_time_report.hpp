@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace ast
+{
+    // Phase timings and event counts behind -ftime-report and -ftrace.
+    // Every timed scope becomes one slice with its wall and thread CPU time. Slices may be recorded
+    // from any thread; they are summed per phase for the report and laid out per thread in the
+    // Chrome trace_event timeline.
+    class TimeReport
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        TimeReport();
+
+        TimeReport(const TimeReport &) = delete;
+        TimeReport &operator=(const TimeReport &) = delete;
+
+        void Record(std::string_view phase, std::string name, Clock::time_point start, Clock::time_point end, std::chrono::nanoseconds cpu);
+        // adds n to a named event count, e.g. how often a peephole rule fired
+        void Count(std::string_view counter, size_t n);
+
+        // wall, CPU time and slice count per phase, in the order the phases first ran, then the counts
+        void PrintSummary(std::ostream &stream) const;
+        // Chrome trace_event JSON, loadable in chrome://tracing or Perfetto
+        void WriteTrace(const std::string &path) const;
+
+        static std::chrono::nanoseconds ThreadCpuTime();
+        static std::chrono::nanoseconds ProcessCpuTime();
+
+    private:
+        struct Slice
+        {
+            std::string phase;
+            std::string name;
+            Clock::duration start; // since origin_
+            Clock::duration wall;
+            std::chrono::nanoseconds cpu;
+            unsigned thread;
+        };
+
+        const Clock::time_point origin_;
+        const std::chrono::nanoseconds origin_cpu_; // process CPU time at origin_
+        mutable std::mutex mutex_;
+        std::vector<Slice> slices_;
+        std::vector<std::pair<std::string, size_t>> counters_; // in the order they were first counted
+        std::map<std::thread::id, unsigned> threads_; // small ids for the trace, in order of appearance
+    };
+
+    // Times the enclosing scope as one slice of phase. Does nothing when report is nullptr, which is
+    // the case unless -ftime-report or -ftrace was given.
+    class PhaseTimer
+    {
+    private:
+        TimeReport *report_;
+        std::string_view phase_;
+        std::string name_;
+        TimeReport::Clock::time_point start_;
+        std::chrono::nanoseconds cpu_start_;
+
+    public:
+        PhaseTimer(TimeReport *report, std::string_view phase, std::string_view name = {});
+        ~PhaseTimer();
+
+        PhaseTimer(const PhaseTimer &) = delete;
+        PhaseTimer &operator=(const PhaseTimer &) = delete;
+    };
+
+} // namespace ast
@@ -13,8 +13,9 @@ namespace ast
         TranslationUnit(NodePtr external_declarations)
             : external_declarations_(std::move(external_declarations)) {};
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        void Resolve(Resolver &resolver) const override;
     };
 
 } // namespace ast
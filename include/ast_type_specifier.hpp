@@ -1,8 +1,8 @@
 #pragma once
 
+#include <string>
 #include <string_view>
 #include <stdexcept>
-#include <unordered_map>
 
 namespace ast
 {
@@ -39,10 +39,10 @@ namespace ast
     int GetTypeSize(TypeSpecifier type);         // use for global and sizeof
     int GetTypeSizeForStack(TypeSpecifier type); // use for stack (keep it simple by assigning 4 bytes for char)
 
-    std::string GetLoadOp(TypeSpecifier type);
-    std::string GetStoreOp(TypeSpecifier type);
-    std::string GetMoveOp(TypeSpecifier type);
-    std::string GetArithmeticOp(TypeSpecifier type, std::string op);
+    std::string_view GetLoadOp(TypeSpecifier type);
+    std::string_view GetStoreOp(TypeSpecifier type);
+    std::string_view GetMoveOp(TypeSpecifier type);
+    std::string_view GetArithmeticOp(TypeSpecifier type, std::string_view op);
 
     template <typename LogStream>
     LogStream &operator<<(LogStream &ls, const TypeSpecifier &type)
@@ -11,18 +11,14 @@ namespace ast
         NodePtr expression_;
         char op_symbol_ = 'U';
 
-        std::any HandleIntOperation(TypeSpecifier type) const;
-        template <typename T>
-        std::any HandleFloatOperation(TypeSpecifier type) const;
-        template <typename T, typename Op>
-        std::any EvalOperation(TypeSpecifier type, Op op) const;
-
     public:
         UnaryOp(NodePtr expression) : expression_(std::move(expression)) {}
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override = 0;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override = 0;
         void Print(std::ostream &stream) const override;
-        std::any GetValue(TypeSpecifier type) const override;
+        void Resolve(Resolver &resolver) const override;
+        ConstValue Evaluate(Context &context) const override;
+        bool IsConstant(Context &context) const override;
         TypeSpecifier GetType(Context &context) const override;
     };
 
@@ -31,7 +27,8 @@ namespace ast
     public:
         UnaryMinusOp(NodePtr expression) : UnaryOp(std::move(expression)) { op_symbol_ = '-'; }
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
     class UnaryPlusOp : public UnaryOp
@@ -39,7 +36,8 @@ namespace ast
     public:
         UnaryPlusOp(NodePtr expression) : UnaryOp(std::move(expression)) { op_symbol_ = '+'; }
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
     class UnaryLogicalNotOp : public UnaryOp
@@ -47,7 +45,8 @@ namespace ast
     public:
         UnaryLogicalNotOp(NodePtr expression) : UnaryOp(std::move(expression)) { op_symbol_ = '!'; }
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
     class UnaryBitwiseNotOp : public UnaryOp
@@ -55,7 +54,8 @@ namespace ast
     public:
         UnaryBitwiseNotOp(NodePtr expression) : UnaryOp(std::move(expression)) { op_symbol_ = '~'; }
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
     };
 
 } // namespace ast
@@ -14,7 +14,9 @@ namespace ast
     public:
         WhileLoop(NodePtr condition, NodePtr body) : condition_(std::move(condition)), body_(std::move(body)) {};
 
-        void EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const override;
+        void EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const override;
         void Print(std::ostream &stream) const override;
+        LoweredValue Lower(Lowering &lowering) const override;
+        void Resolve(Resolver &resolver) const override;
     };
 }
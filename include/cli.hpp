@@ -1,12 +1,33 @@
 #pragma once
 
+#include <cstdint>
 #include <iostream>
+#include <string>
 #include <unistd.h>
+#include <vector>
 
 struct CommandLineArguments
 {
     std::string compile_source_path;
     std::string compile_output_path;
+    bool compact_asm = false; // -fcompact-asm: elide repeated section switches and batch .globl
+    bool time_report = false; // -ftime-report: print wall and CPU time per compiler phase
+    std::string trace_path;   // -ftrace=FILE: write a Chrome trace_event timeline of the phases
+    std::string cache_dir;                // -fcache=DIR: reuse assembly generated earlier for the same input
+    uint64_t cache_max_bytes = 256 << 20; // -fcache-size=N[KMG]: entries are evicted beyond this
+    bool cache_stats = false;             // -fcache-stats: print the cache's hit/miss counters
+    bool ir = false;                      // -fir: generate functions through the IR (see ir.hpp)
+    bool dump_ir = false;                 // -fdump-ir: with -fir, write each function's IR as comments
+    unsigned n_threads = 0;   // -j N: threads generating function bodies (files with -d), 0 for one per core
+
+    // Batch mode: -d DIR compiles every source operand into DIR instead of a single -S/-o pair.
+    std::string batch_output_dir;
+    std::vector<std::string> batch_sources; // @file operands are expanded to the paths they list
+
+    // Server mode: --serve SOCKET stays resident and compiles requests sent by --client SOCKET runs,
+    // which otherwise take the same -S/-o arguments as a single-file compile.
+    std::string serve_socket;
+    std::string client_socket;
 };
 
 CommandLineArguments ParseCommandLineArgs(int argc, char **argv);
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "source_file.hpp"
+
+// On-disk cache of generated assembly, addressed by the SHA-256 of the source bytes, the compiler
+// binary and the options that affect the output. Code generation is deterministic (labels and
+// literal pools are numbered per function), so a hit can stand in for ParseAST and EmitRISC.
+//
+// Layout of the cache directory:
+//   ab/cdef....s   one entry per key (a whole file or a single function), spread over 256 subdirectories
+//   ab/cdef....printed  the printed AST of a whole file, next to its assembly when the compile printed it
+//   stats          hit/miss/store/eviction counters and the total size of the entries
+//   lock           flock'd while the stats are updated or entries evicted
+// Several processes and threads may share a directory. Entries are written to a temporary file and
+// renamed into place, and a hit refreshes the entry's mtime, so eviction removes the least recently
+// used entries first once the total size goes over the limit.
+class CompileCache
+{
+public:
+    struct Stats
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t stores = 0;
+        uint64_t evictions = 0;
+        uint64_t bytes = 0; // total size of the entries
+        uint64_t function_hits = 0; // lookups of single functions, see FunctionCache
+        uint64_t function_misses = 0;
+        uint64_t replaced_bytes = 0; // only in a delta: size of the entries its stores overwrote
+    };
+
+    CompileCache(std::string directory, uint64_t max_bytes); // throws std::runtime_error
+
+    // options: every setting that changes the generated assembly
+    std::string Key(std::string_view source, std::string_view options) const;
+
+    // Copies the entry for key to output_path; false, with output_path untouched, on a miss. With a
+    // printed_path, a hit also needs the printed AST stored with the entry, which is copied there.
+    bool Fetch(const std::string &key, const std::string &output_path, const std::string &printed_path = "");
+    // printed: the printed AST of the source, empty if the compile didn't print it
+    void Store(const std::string &key, std::string_view assembly, std::string_view printed = {});
+
+    // Entries read and written in memory, leaving the counters to the caller: Load refreshes the
+    // entry's mtime on a hit, Save returns the size of the entry it overwrote (0 if there was none)
+    // and Record adds delta to the stats, evicting if the cache got too big.
+    bool Load(const std::string &key, std::string &contents);
+    uint64_t Save(const std::string &key, std::string_view contents);
+    void Record(const Stats &delta);
+
+    Stats ReadStats() const;
+    void PrintStats(std::ostream &stream) const;
+
+private:
+    std::string directory_;
+    uint64_t max_bytes_;
+    std::string compiler_stamp_; // identifies the compiler binary, so a rebuild invalidates every entry
+
+    std::string EntryPath(const std::string &key, const char *extension = ".s") const;
+    uint64_t SaveFile(const std::string &entry, std::string_view contents);
+
+    template <typename Update>
+    void UpdateStats(Update update);
+    void Evict(Stats &stats); // with the lock held
+};
+
+// Generated code of single functions, so that recompiling a file in which only some function bodies
+// changed regenerates just those. Code generation sees the rest of the file only through its
+// declarations: globals, prototypes and function signatures. A function's key therefore covers its
+// own text and the file with every function body cut out, and editing one body leaves the keys of
+// all the others unchanged. Entries share the directory, limit and eviction of the file-level cache.
+// Fetch and Store may be called from several threads.
+class FunctionCache
+{
+public:
+    // source: the bytes that were parsed, which the spans given below index
+    FunctionCache(CompileCache &cache, std::string source, std::string options);
+    ~FunctionCache(); // adds the lookups to the cache's stats
+
+    FunctionCache(const FunctionCache &) = delete;
+    FunctionCache &operator=(const FunctionCache &) = delete;
+
+    // bodies: the compound statement of every function definition, in source order
+    void SetBodies(const std::vector<SourceSpan> &bodies);
+
+    // empty if function isn't within the source
+    std::string Key(SourceSpan function) const;
+
+    bool Fetch(const std::string &key, std::string &entry);
+    void Store(const std::string &key, std::string_view entry); // failures are only reported
+
+private:
+    CompileCache &cache_;
+    std::string source_;
+    std::string options_;
+    std::string environment_; // digest of the source without function bodies
+    std::atomic<uint64_t> hits_ = 0;
+    std::atomic<uint64_t> misses_ = 0;
+    std::atomic<uint64_t> stores_ = 0;
+    std::atomic<uint64_t> bytes_ = 0;
+    std::atomic<uint64_t> replaced_bytes_ = 0;
+};
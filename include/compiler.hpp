@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "cli.hpp"
+#include "ast.hpp"
+#include "ast_time_report.hpp"
+#include "compile_cache.hpp"
+
+// Wrapper for ParseAST defined in YACC
+ast::NodePtr Parse(const std::string &compile_source_path, ast::TimeReport *time_report);
+
+// Output the pretty print version of what was parsed to the .printed output file, and return it.
+std::string PrettyPrint(const ast::NodePtr &root, const std::string &compile_output_path, ast::TimeReport *time_report);
+
+// Compile from the root of the AST and output this to the compiledOutputPath file.
+// The output is also stored in cache, if there is one, under cache_key, along with the printed AST.
+void Compile(const ast::NodePtr &root, const CommandLineArguments &cli_args, ast::TimeReport *time_report,
+             CompileCache *cache, const std::string &cache_key, std::string_view printed);
+
+// Resolve the identifiers of a whole translation unit, then generate its assembly into output, using ctx as its top-level Context.
+void GenerateAssembly(const ast::NodePtr &root, ast::Context &ctx, ast::AsmWriter &output);
+
+// The -fcache cache, or nullptr if it is disabled or its directory can't be created.
+std::unique_ptr<CompileCache> OpenCache(const CommandLineArguments &cli_args);
+
+// Copies the cached output of source_path to output_path and returns true on a hit. key is set to
+// the source's cache key, or left empty if the source can't be hashed (e.g. a pipe). With a
+// printed_path, only an entry with its printed AST is a hit, and the printed AST is copied there.
+bool FetchCached(CompileCache &cache, const std::string &source_path, const std::string &output_path,
+                 const CommandLineArguments &cli_args, std::string &key, ast::TimeReport *time_report,
+                 const std::string &printed_path = "");
+
+// Stores a successful compile under key, with its printed AST if there is one; failures to write
+// the cache are only reported.
+void StoreCached(CompileCache &cache, const std::string &key, std::string_view assembly, std::string_view printed = {});
+
+// The cache of single functions for a source that missed the file-level cache, or nullptr if the
+// source can't be read again. Pass it to the Context with SetFunctionCache.
+std::unique_ptr<FunctionCache> OpenFunctionCache(CompileCache &cache, const std::string &source_path,
+                                                 const CommandLineArguments &cli_args);
+
+// Print the -ftime-report summary, write the -ftrace timeline and print the -fcache-stats counters,
+// as requested by cli_args.
+void ReportRun(const CommandLineArguments &cli_args, const ast::TimeReport *time_report, const CompileCache *cache);
+
+// Compile every source of cli_args.batch_sources into cli_args.batch_output_dir, several files at a
+// time, and print a status line per file. Returns the process exit code.
+int CompileBatch(const CommandLineArguments &cli_args);
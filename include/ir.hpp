@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+#include "ast_symbol.hpp"
+
+namespace ir
+{
+    // Three-address code between the AST and the RISC-V backend (-fir).
+    // A Function is a control flow graph of basic blocks, each a list of instructions ending in
+    // exactly one terminator (JUMP, BRANCH or RET). Values live in typed virtual registers that are
+    // defined exactly once, by an instruction or as a parameter. C variables live in stack slots
+    // that are only accessed through ADDR, LOAD and STORE, so promoting the slots whose address
+    // never escapes is all it takes to put a function into SSA form (see ir_passes.hpp). Leaving
+    // SSA replaces the phis with copies, after which a register may be defined more than once.
+
+    // int, unsigned, char and pointers are all I32
+    enum class Type : uint8_t
+    {
+        I32,
+        F32,
+        F64
+    };
+
+    // of a memory access; bytes are zero-extended, as char is unsigned
+    enum class Width : uint8_t
+    {
+        BYTE,
+        WORD,
+        FLOAT,
+        DOUBLE
+    };
+
+    using VReg = uint32_t;
+    using BlockId = uint32_t;
+    using SlotId = uint32_t;
+
+    constexpr VReg NO_VREG = std::numeric_limits<VReg>::max();
+    constexpr BlockId NO_BLOCK = std::numeric_limits<BlockId>::max();
+    constexpr SlotId NO_SLOT = std::numeric_limits<SlotId>::max();
+
+    enum class Op : uint8_t
+    {
+        CONST,  // dst = imm
+        FCONST, // dst = fimm
+        COPY,   // dst = a
+        PHI,    // dst = args[i] when entered from the block's preds[i]; phis come first in a block
+
+        // dst = a op b, all of one type; only ADD, SUB, MUL and DIV take F32 and F64
+        ADD,
+        SUB,
+        MUL,
+        DIV,
+        DIVU,
+        REM,
+        REMU,
+        AND,
+        OR,
+        XOR,
+        SHL,
+        SHR, // arithmetic
+        SHRU,
+
+        // dst (I32) = a cmp b ? 1 : 0, for operands of one type; only EQ, NE, LT and LE take F32 and F64
+        EQ,
+        NE,
+        LT,
+        LE,
+        LTU,
+        LEU,
+
+        NEG, // dst = -a
+        NOT, // dst = ~a
+
+        // dst = a converted to the type of dst; float to integer rounds towards zero
+        ITOF,
+        UTOF,
+        FTOI,
+        FTOU,
+        FCVT, // between F32 and F64
+
+        ADDR,  // dst = address
+        LOAD,  // dst = *address
+        STORE, // *address = a
+        CALL,  // dst = callee(args), dst is NO_VREG for void functions
+
+        JUMP,   // to target
+        BRANCH, // to target if a != 0, else to target2
+        RET,    // returning a, or nothing if a is NO_VREG
+    };
+
+    // a base plus a constant byte offset; the base is exactly one of a virtual register, a stack
+    // slot (whose address is fixed in the frame) or a global symbol
+    struct Address
+    {
+        VReg base = NO_VREG;
+        SlotId slot = NO_SLOT;
+        ast::SymbolId symbol = ast::SymbolId::EMPTY;
+        int32_t offset = 0;
+    };
+
+    struct Instr
+    {
+        Op op;
+        VReg dst = NO_VREG;
+        VReg a = NO_VREG;
+        VReg b = NO_VREG;
+        int32_t imm = 0;                             // CONST
+        double fimm = 0;                             // FCONST, exactly representable in the type of dst
+        Width width = Width::WORD;                   // LOAD, STORE
+        Address address = {};                        // ADDR, LOAD, STORE
+        ast::SymbolId callee = ast::SymbolId::EMPTY; // CALL
+        std::vector<VReg> args = {};                 // CALL, PHI
+        BlockId target = NO_BLOCK;                   // JUMP, BRANCH
+        BlockId target2 = NO_BLOCK;                  // BRANCH
+    };
+
+    struct Slot
+    {
+        int32_t size;
+        int32_t align;
+    };
+
+    struct Block
+    {
+        std::vector<Instr> instrs;
+        std::vector<BlockId> preds; // filled in by BuildCfg
+        std::vector<BlockId> succs;
+    };
+
+    struct Function
+    {
+        ast::SymbolId name;
+        std::vector<VReg> params;
+        bool returns_value = false;
+        Type return_type = Type::I32;
+        std::vector<Type> vreg_types; // indexed by VReg
+        std::vector<Slot> slots;      // indexed by SlotId
+        std::vector<Block> blocks;    // indexed by BlockId, blocks[0] is the entry
+        bool single_definitions = true; // false once SSA has been left
+
+        VReg NewVReg(Type type);
+        SlotId NewSlot(int32_t size, int32_t align);
+        BlockId NewBlock();
+        Type TypeOf(VReg vreg) const { return vreg_types[vreg]; }
+
+        // Fills in preds and succs from the terminators and drops the blocks the entry can't reach,
+        // renumbering the others in their original order. Phis keep the arguments of the edges
+        // that remain, so it can run again after a pass removes edges.
+        void BuildCfg();
+    };
+
+    constexpr bool IsTerminator(Op op) { return op == Op::JUMP || op == Op::BRANCH || op == Op::RET; }
+    constexpr bool IsFloat(Type type) { return type != Type::I32; }
+
+    Width WidthOf(Type type); // of a full-size access to a value of type
+
+    // calls fn(VReg &) on every virtual register the instruction reads
+    template <typename Fn>
+    void ForEachUse(Instr &instr, Fn fn)
+    {
+        if (instr.a != NO_VREG)
+        {
+            fn(instr.a);
+        }
+        if (instr.b != NO_VREG)
+        {
+            fn(instr.b);
+        }
+        if (instr.address.base != NO_VREG)
+        {
+            fn(instr.address.base);
+        }
+        for (VReg &arg : instr.args)
+        {
+            fn(arg);
+        }
+    }
+
+    template <typename Fn>
+    void ForEachUse(const Instr &instr, Fn fn)
+    {
+        ForEachUse(const_cast<Instr &>(instr), [&fn](VReg &vreg)
+                   { fn(static_cast<VReg>(vreg)); });
+    }
+
+    // one instruction or a whole function as text, for -fdump-ir and failure reports
+    void Print(std::ostream &stream, const Function &function, const Instr &instr);
+    void Print(std::ostream &stream, const Function &function);
+
+    // Throws std::runtime_error naming the first broken invariant: a block without a terminator
+    // (or with one before its end), a register defined twice (while single_definitions) or used
+    // without a definition, operand types that don't match the operation, a branch to a block that
+    // doesn't exist, or a phi after other instructions or without one argument per predecessor.
+    void Verify(const Function &function);
+
+} // namespace ir
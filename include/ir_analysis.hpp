@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ir.hpp"
+
+namespace ir
+{
+    // Dominator tree of a function's CFG, by the iterative algorithm of Cooper, Harvey and Kennedy.
+    // Built from preds and succs, so BuildCfg must have run since the last change to the edges.
+    class DominatorTree
+    {
+    private:
+        std::vector<BlockId> idom_; // the entry is its own immediate dominator
+        std::vector<std::vector<BlockId>> children_;
+        std::vector<BlockId> reverse_postorder_;
+        std::vector<uint32_t> order_; // position of each block in reverse_postorder_
+
+    public:
+        explicit DominatorTree(const Function &function);
+
+        BlockId ImmediateDominator(BlockId block) const { return idom_[block]; }
+        const std::vector<BlockId> &Children(BlockId block) const { return children_[block]; }
+        const std::vector<BlockId> &ReversePostorder() const { return reverse_postorder_; }
+        bool Dominates(BlockId dominator, BlockId block) const; // reflexive
+
+        // blocks where the dominance of each block ends
+        std::vector<std::vector<BlockId>> Frontiers(const Function &function) const;
+    };
+
+    // set of virtual registers, one bit each
+    class RegisterSet
+    {
+    private:
+        std::vector<uint64_t> words_;
+
+    public:
+        RegisterSet() = default;
+        explicit RegisterSet(size_t registers) : words_((registers + 63) / 64, 0) {}
+
+        bool Contains(VReg vreg) const { return (words_[vreg / 64] >> (vreg % 64)) & 1; }
+        void Insert(VReg vreg) { words_[vreg / 64] |= uint64_t(1) << (vreg % 64); }
+        void Erase(VReg vreg) { words_[vreg / 64] &= ~(uint64_t(1) << (vreg % 64)); }
+        bool UnionWith(const RegisterSet &other); // true if this set grew
+
+        template <typename Fn>
+        void ForEach(Fn fn) const
+        {
+            for (size_t word = 0; word < words_.size(); word++)
+            {
+                for (uint64_t bits = words_[word]; bits != 0; bits &= bits - 1)
+                {
+                    fn(static_cast<VReg>(word * 64 + __builtin_ctzll(bits)));
+                }
+            }
+        }
+    };
+
+    // Registers live on entry to and exit from each block. The arguments of a phi are live out of
+    // the predecessor they come from rather than into the phi's block, and a phi defines its
+    // result at the top of its block. Correct whether or not registers have a single definition.
+    struct Liveness
+    {
+        std::vector<RegisterSet> live_in; // indexed by BlockId
+        std::vector<RegisterSet> live_out;
+    };
+
+    Liveness ComputeLiveness(const Function &function);
+
+} // namespace ir
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "ir.hpp"
+
+namespace ir
+{
+    // Optimizations run between lowering and instruction selection. Each leaves a function that
+    // passes Verify, with its CFG built.
+
+    // Promotes the slots that are only ever loaded and stored whole, at one width, to registers,
+    // with phis at the iterated dominance frontiers of their stores (mem2reg). The function is in
+    // SSA form afterwards. Stores to a char slot are masked to a byte, as the load did.
+    void PromoteSlots(Function &function);
+
+    // Sparse conditional constant propagation (Wegman and Zadeck). Registers that hold one constant
+    // on every path the entry can take become constants, branches on constants become jumps and
+    // the blocks no path reaches are dropped. Nothing is folded that would trap, that C leaves
+    // undefined, or that the target would round differently from the host.
+    void PropagateConstants(Function &function);
+
+    // Removes the instructions, phis included, whose results nothing with a side effect depends on.
+    void EliminateDeadCode(Function &function);
+
+    // Replaces each phi with copies on its incoming edges, splitting the critical ones, and then
+    // coalesces the two sides of every copy whose live ranges don't interfere, deleting the copy.
+    void LeaveSsa(Function &function);
+
+    // all of the above, in order
+    void Optimize(Function &function);
+
+} // namespace ir
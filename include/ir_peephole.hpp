@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+#include <vector>
+
+#include "ast_time_report.hpp"
+#include "ir_riscv.hpp"
+
+namespace ir
+{
+    // Rewrites of the selected instructions, each matching one instruction or two neighbours:
+    //   self move            mv x, x                         -> (nothing)
+    //   jump to next         j L; L:                         -> L:
+    //   branch over jump     beq .., L1; j L2; L1:           -> bne .., L2; L1:
+    //   store to load        sw r, o(b); lw d, o(b)          -> sw r, o(b); mv d, r
+    //   redundant mask       slt r, ..; andi d, r, 0xff      -> slt r, ..; mv d, r
+    //   immediate operand    li t, 4; add d, s, t            -> addi d, s, 4
+    //   power of two product li t, 4; mul d, s, t            -> slli d, s, 2
+    //   zero store           li t, 0; sw t, o(b)             -> sw zero, o(b)
+    //   copy into def        add t, x, y; mv d, t            -> add d, x, y
+    //   copy forward         mv t, s; add d, t, x            -> add d, s, x
+    // where t is dead afterwards. Registers are live as a dataflow over the whole list finds them:
+    // a call reads its arguments and clobbers every caller-saved register, see Uses and Defs.
+    enum class PeepholeRule : uint8_t
+    {
+        SELF_MOVE,
+        JUMP_TO_NEXT,
+        BRANCH_OVER_JUMP,
+        STORE_TO_LOAD,
+        REDUNDANT_MASK,
+        IMMEDIATE_OPERAND,
+        POWER_OF_TWO_PRODUCT,
+        ZERO_STORE,
+        COPY_INTO_DEF,
+        COPY_FORWARD,
+        COUNT
+    };
+
+    // times each rule fired, indexed by PeepholeRule
+    using PeepholeCounts = std::array<size_t, static_cast<size_t>(PeepholeRule::COUNT)>;
+
+    std::string_view PeepholeRuleName(PeepholeRule rule);
+
+    // rewrites instrs until no rule matches
+    PeepholeCounts Peephole(std::vector<MachineInstr> &instrs);
+
+    // adds the counts to -ftime-report; report may be nullptr
+    void ReportPeephole(ast::TimeReport *report, const PeepholeCounts &counts);
+
+} // namespace ir
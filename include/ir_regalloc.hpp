@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+
+#include "ast_register.hpp"
+#include "ir.hpp"
+
+namespace ir
+{
+    // Linear-scan register allocation (Poletto and Sarkar) for a function that has left SSA.
+    // Each virtual register gets one live interval, from its first to its last live position in
+    // block order, and the intervals are assigned registers in order of their start. A value live
+    // across a call only gets a callee-saved register (s1-s11, fs0-fs11). Other values prefer the
+    // temporaries and, unless a call or the incoming arguments are in their way, the argument
+    // registers. When every allowed register is taken, whichever interval ends last is spilled and
+    // stays in its frame slot. t0-t2, ft0-ft2 and t6 are never allocated: instruction selection
+    // loads spilled values into them.
+    struct Allocation
+    {
+        std::vector<ast::Reg> regs;         // indexed by VReg, ZERO for the spilled
+        std::vector<ast::Reg> callee_saved; // the callee-saved registers handed out, which the prologue saves
+    };
+
+    Allocation AllocateRegisters(const Function &function);
+
+} // namespace ir
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ast_asm_writer.hpp"
+#include "ast_context.hpp"
+#include "ast_register.hpp"
+#include "ir.hpp"
+
+namespace ir
+{
+    // RISC-V instructions the backend selects.
+    // DO NOT REORDER: indexes MOP_INFO
+    enum class MOp : uint8_t
+    {
+        LABEL, // symbol:
+
+        LI,
+        LUI,
+        MV,
+        NEG,
+        NOT,
+        SEQZ,
+        SNEZ,
+
+        ADD,
+        SUB,
+        MUL,
+        DIV,
+        DIVU,
+        REM,
+        REMU,
+        AND,
+        OR,
+        XOR,
+        SLL,
+        SRA,
+        SRL,
+        SLT,
+        SLTU,
+
+        ADDI,
+        ANDI,
+        ORI,
+        XORI,
+        SLLI,
+        SRAI,
+        SRLI,
+        SLTI,
+        SLTIU,
+
+        LBU,
+        LW,
+        FLW,
+        FLD,
+        SB,
+        SW,
+        FSW,
+        FSD,
+
+        FMV_S,
+        FMV_D,
+        FNEG_S,
+        FNEG_D,
+        FMV_X_W, // float bits to an integer register
+        FMV_W_X,
+        FADD_S,
+        FSUB_S,
+        FMUL_S,
+        FDIV_S,
+        FADD_D,
+        FSUB_D,
+        FMUL_D,
+        FDIV_D,
+        FEQ_S,
+        FLT_S,
+        FLE_S,
+        FEQ_D,
+        FLT_D,
+        FLE_D,
+        FCVT_S_W,
+        FCVT_S_WU,
+        FCVT_D_W,
+        FCVT_D_WU,
+        FCVT_W_S, // float to integer rounds towards zero, as in C
+        FCVT_WU_S,
+        FCVT_W_D,
+        FCVT_WU_D,
+        FCVT_S_D,
+        FCVT_D_S,
+
+        BEQZ,
+        BNEZ,
+        BEQ,
+        BNE,
+        BLT,
+        BGE,
+        BLTU,
+        BGEU,
+        J,
+        CALL,
+        RET,
+    };
+
+    // lui rd, %hi(symbol+imm) and %lo(symbol+imm) in place of an immediate
+    enum class Reloc : uint8_t
+    {
+        NONE,
+        HI,
+        LO
+    };
+
+    struct MachineInstr
+    {
+        MOp op;
+        ast::Reg rd = ast::Reg::ZERO;
+        ast::Reg rs1 = ast::Reg::ZERO; // the base of loads and stores
+        ast::Reg rs2 = ast::Reg::ZERO; // the value of stores
+        int32_t imm = 0;
+        Reloc reloc = Reloc::NONE;
+        std::string symbol = {}; // of LABEL, branches, J, CALL and relocations
+    };
+
+    void Print(ast::AsmWriter &stream, const MachineInstr &instr);
+
+    // Registers an instruction reads and writes, zero left out. A call reads the argument registers
+    // and writes every caller-saved one; ret reads the return value and the callee-saved ones.
+    ast::RegisterMask Uses(const MachineInstr &instr);
+    ast::RegisterMask Defs(const MachineInstr &instr);
+
+    // Selects the instructions of a function, prologue and epilogue included. Virtual registers
+    // live where AllocateRegisters puts them (see ir_regalloc.hpp); the spilled ones live in frame
+    // slots and are loaded into a scratch register (t0-t2, ft0-ft2) where they are used. t6 is left
+    // for addresses out of reach of a 12-bit offset. Labels and float constants are added to context.
+    std::vector<MachineInstr> SelectInstructions(const Function &function, ast::Context &context);
+
+    // the function as assembly text, from its section switch to its last instruction, after the
+    // peephole pass (see ir_peephole.hpp)
+    void EmitFunction(ast::AsmWriter &stream, const Function &function, ast::Context &context);
+
+} // namespace ir
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "cli.hpp"
+
+// Stay resident on the UNIX socket cli_args.serve_socket and compile the requests of --client runs,
+// keeping the thread pool and AST arena warm between them. Returns the process exit code.
+int Serve(const CommandLineArguments &cli_args);
+
+// Send the -S/-o compile of cli_args to the server on cli_args.client_socket and print its
+// diagnostics. Returns false, with status untouched, if no server could be reached.
+bool CompileOnServer(const CommandLineArguments &cli_args, int &status);
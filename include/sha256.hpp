@@ -0,0 +1,24 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Incremental SHA-256 (FIPS 180-4), used to key the compilation cache by content.
+class Sha256
+{
+private:
+    std::array<uint32_t, 8> state_;
+    std::array<uint8_t, 64> block_;
+    size_t block_size_ = 0;
+    uint64_t total_bytes_ = 0;
+
+    void Compress(const uint8_t *block);
+
+public:
+    Sha256();
+
+    void Update(std::string_view data);
+    std::string HexDigest(); // finishes the hash; the object must not be updated afterwards
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+// Bytes [begin, end) of a source, e.g. where a function definition was parsed from.
+struct SourceSpan
+{
+    size_t begin = 0;
+    size_t end = 0;
+};
+
+// Input of one parse. A regular file is mapped into memory so the lexer can scan it in place,
+// with the two NUL bytes flex requires after the end of a scan buffer. Pipes, terminals and
+// empty files are read through a FILE* stream instead.
+class SourceFile
+{
+private:
+    char *data_ = nullptr; // start of the mapping, nullptr when streaming
+    size_t size_ = 0;      // bytes of source, excluding the trailing NULs
+    size_t mapped_length_ = 0;
+    FILE *stream_ = nullptr;
+
+public:
+    explicit SourceFile(const std::string &path); // throws std::runtime_error if path can't be read
+    ~SourceFile();
+
+    SourceFile(const SourceFile &) = delete;
+    SourceFile &operator=(const SourceFile &) = delete;
+
+    bool IsMapped() const { return data_ != nullptr; }
+
+    // Mapped file contents followed by two NULs. The mapping is private and writable: flex
+    // NUL-terminates each token in place, and those writes are never carried back to the file.
+    char *Data() const { return data_; }
+    size_t Size() const { return size_; }
+
+    FILE *Stream() const { return stream_; } // nullptr when mapped
+};
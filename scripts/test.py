@@ -7,7 +7,7 @@ Makefile, run the tests and store the outputs in bin/output.
 This script will also generate a JUnit XML file, which can be used to integrate
 with CI/CD pipelines.
 
-Usage: test.py [-h] [-m] [-s] [--version] [--no_clean] [--coverage] [dir]
+Usage: test.py [-h] [-m] [-s] [--version] [--no_clean] [--compiler_flags FLAGS] [--coverage] [dir]
 
 Example usage: scripts/test.py compiler_tests/_example
 
@@ -177,12 +177,13 @@ class ProgressBar:
             self.failed += 1
         self.update()
 
-def run_test(driver: Path) -> Result:
+def run_test(driver: Path, compiler_flags: tuple = ()) -> Result:
     """
     Run an instance of a test case.
 
     Parameters:
     - driver: driver path.
+    - compiler_flags: extra flags for the compiler, such as -fir.
 
     Returns Result object
     """
@@ -213,7 +214,7 @@ def run_test(driver: Path) -> Result:
 
     # Compile
     return_code, _, timed_out = run_subprocess(
-        cmd=[COMPILER_FILE, "-S", to_assemble, "-o", f"{log_path}.s"],
+        cmd=[COMPILER_FILE, *compiler_flags, "-S", to_assemble, "-o", f"{log_path}.s"],
         timeout=RUN_TIMEOUT_SECONDS,
         env=custom_env,
         log_path=f"{log_path}.compiler",
@@ -409,7 +410,7 @@ def run_tests(args, xml_file: JUnitXMLFile):
 
     if args.multithreading:
         with ThreadPoolExecutor() as executor:
-            futures = [executor.submit(run_test, driver) for driver in drivers]
+            futures = [executor.submit(run_test, driver, args.compiler_flags.split()) for driver in drivers]
             for future in as_completed(futures):
                 result = future.result()
                 results.append(result.passed)
@@ -417,7 +418,7 @@ def run_tests(args, xml_file: JUnitXMLFile):
 
     else:
         for driver in drivers:
-            result = run_test(driver)
+            result = run_test(driver, args.compiler_flags.split())
             results.append(result.passed)
             process_result(result, xml_file, not args.short, progress_bar)
 
@@ -468,6 +469,12 @@ def parse_args():
         help="Don't clean the repository before testing. This will make it "
         "faster but it can be safer to clean if you have any compilation issues."
     )
+    parser.add_argument(
+        "--compiler_flags",
+        default="",
+        help="Extra flags to compile the tests with, e.g. --compiler_flags=-fir "
+        "to run them through the IR backend."
+    )
     parser.add_argument(
         "--coverage",
         action="store_true",
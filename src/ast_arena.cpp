@@ -0,0 +1,67 @@
+#include "ast_arena.hpp"
+
+namespace ast
+{
+    namespace
+    {
+        thread_local AstArena *current_arena = nullptr;
+    }
+
+    AstArena::~AstArena()
+    {
+        for (char *chunk : chunks_)
+        {
+            ::operator delete(chunk);
+        }
+        for (char *chunk : large_chunks_)
+        {
+            ::operator delete(chunk);
+        }
+    }
+
+    void AstArena::Reset()
+    {
+        for (char *chunk : large_chunks_)
+        {
+            ::operator delete(chunk);
+        }
+        large_chunks_.clear();
+        n_used_chunks_ = 0;
+        cursor_ = nullptr;
+        limit_ = nullptr;
+        bytes_allocated_ = 0;
+    }
+
+    void *AstArena::AllocateSlow(size_t size, size_t align)
+    {
+        // oversized requests get a dedicated chunk so the current one keeps being filled
+        if (size + align > CHUNK_SIZE / 4)
+        {
+            char *chunk = static_cast<char *>(::operator new(size + align));
+            large_chunks_.push_back(chunk);
+            bytes_allocated_ += size;
+            size_t padding = (align - reinterpret_cast<size_t>(chunk) % align) % align;
+            return chunk + padding;
+        }
+
+        if (n_used_chunks_ == chunks_.size())
+        {
+            chunks_.push_back(static_cast<char *>(::operator new(CHUNK_SIZE)));
+        }
+        char *chunk = chunks_[n_used_chunks_++];
+        cursor_ = chunk;
+        limit_ = chunk + CHUNK_SIZE;
+        return Allocate(size, align);
+    }
+
+    AstArena *AstArena::Current()
+    {
+        return current_arena;
+    }
+
+    void AstArena::SetCurrent(AstArena *arena)
+    {
+        current_arena = arena;
+    }
+
+} // namespace ast
@@ -3,14 +3,13 @@
 #include "ast_identifier.hpp"
 #include "ast_direct_declarator.hpp"
 #include <typeinfo>
-#include <any>
 #include <string>
 #include <iostream>
 
 namespace ast
 {
 
-    void ArrayDeclarator::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void ArrayDeclarator::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         (void)stream;
         (void)context;
@@ -19,11 +18,16 @@ namespace ast
         throw std::runtime_error("ArrayDeclarator: EmitRISC not implemented.");
     }
 
-    std::string ArrayDeclarator::GetID() const
+    SymbolId ArrayDeclarator::GetID() const
     {
         return identifier_->GetID();
     }
 
+    const Binding *ArrayDeclarator::GetBinding() const
+    {
+        return identifier_->GetBinding();
+    }
+
     bool ArrayDeclarator::IsFunction() const
     {
         return false;
@@ -36,12 +40,16 @@ namespace ast
 
     int ArrayDeclarator::GetArraySize(Context &context) const
     {
-        (void)context;
         if (size_ == nullptr)
         {
             return -1;
         }
-        return std::any_cast<int>(size_->GetValue(TypeSpecifier::INT));
+        ConstValue size = size_->Evaluate(context);
+        if (!size.IsInteger())
+        {
+            throw std::runtime_error("ArrayDeclarator: size of array has non-integer type");
+        }
+        return size.AsInt();
     }
 
     void ArrayDeclarator::Print(std::ostream &stream) const
@@ -53,4 +61,13 @@ namespace ast
         stream << "]";
     }
 
+    void ArrayDeclarator::Resolve(Resolver &resolver) const
+    {
+        identifier_->Resolve(resolver);
+        if (size_ != nullptr)
+        {
+            size_->Resolve(resolver);
+        }
+    }
+
 } // namespace ast
@@ -1,4 +1,6 @@
 #include "ast_array_index.hpp"
+#include "ast_lowering.hpp"
+#include <bit>
 #include <typeinfo>
 #include <any>
 #include <string>
@@ -6,50 +8,125 @@
 
 namespace ast
 {
-    void ArrayIndex::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    namespace
     {
-        (void)type;
-        std::string array_name = GetID();
+        constexpr bool FitsImmediate(int value) { return value >= -2048 && value < 2048; }
 
-        // Calculate element offset
-        int indexReg = context.AssignRegister(TypeSpecifier::INT);
-        index_->EmitRISC(stream, context, indexReg, TypeSpecifier::INT);
+        // symbol+offset as a relocation operand
+        std::string SymbolOffset(SymbolId symbol, int offset)
+        {
+            std::string operand = Spelling(symbol);
+            if (offset != 0)
+            {
+                operand += (offset > 0 ? "+" : "") + std::to_string(offset);
+            }
+            return operand;
+        }
+    }
 
-        int tmpReg = context.AssignRegister(TypeSpecifier::INT);
-        stream << "li " << context.GetRegString(tmpReg) << ", " << context.GetPointerOffset(GetID(), GetPointerDepth()) << "\n";
-        stream << "mul " << context.GetRegString(indexReg) << ", " << context.GetRegString(indexReg) << ", " << context.GetRegString(tmpReg) << "\n";
+    void EmitElementScale(AsmWriter &stream, Context &context, int reg, int element_size)
+    {
+        if (element_size == 1)
+        {
+            return;
+        }
+        if (std::has_single_bit(static_cast<unsigned>(element_size)))
+        {
+            stream << "slli " << context.GetRegString(reg) << ", " << context.GetRegString(reg) << ", " << std::countr_zero(static_cast<unsigned>(element_size)) << "\n";
+            return;
+        }
+        int sizeReg = context.AssignRegister(TypeSpecifier::INT);
+        stream << "li " << context.GetRegString(sizeReg) << ", " << element_size << "\n";
+        stream << "mul " << context.GetRegString(reg) << ", " << context.GetRegString(reg) << ", " << context.GetRegString(sizeReg) << "\n";
+        context.FreeRegister(sizeReg);
+    }
 
-        // handle pointer indexing as well
-        if (array_id_->IsPointer(context, true))
+    void ArrayIndex::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
+    {
+        int addrReg = context.AssignRegister(TypeSpecifier::INT);
+        bool deferred = context.DeferRegister(destReg); // only written by the load
+        const std::string address = EmitElementAddress(stream, context, addrReg);
+        if (deferred)
         {
-            array_id_->EmitRISC(stream, context, tmpReg, TypeSpecifier::INT);
+            context.SetRegisterDead(destReg, false);
         }
-        else
+        stream << GetLoadOp(type) << " " << context.GetRegString(destReg) << ", " << address << "\n";
+        context.FreeRegister(addrReg);
+    }
+
+    std::string ArrayIndex::EmitElementAddress(AsmWriter &stream, Context &context, int addrReg) const
+    {
+        const int element_size = GetPointerOffset(GetBinding(), GetPointerDepth());
+        const bool is_pointer = array_id_->IsPointer(context, true);
+        const Binding *local = LocalBinding(GetBinding());
+        const std::string addr(context.GetRegString(addrReg));
+
+        if (index_->IsConstant(context))
         {
-            if (context.VariableIsLocal(array_name))
+            const int offset = index_->Evaluate(context).AsInt() * element_size;
+            if (is_pointer && FitsImmediate(offset))
             {
-                const FunctionVariable var = context.GetCurrentFunctionContext().GetFunctionVariableInfo(array_name);
-                stream << "addi " << context.GetRegString(tmpReg) << ", s0, "
-                       << var.offset << "\n";
+                array_id_->EmitRISC(stream, context, addrReg, TypeSpecifier::INT);
+                return std::to_string(offset) + "(" + addr + ")";
             }
-            else
+            if (!is_pointer && local != nullptr && FitsImmediate(local->offset + offset))
             {
-                stream << "lui " << context.GetRegString(tmpReg) << ", %hi(" << array_name << ")\n";
-                stream << "addi " << context.GetRegString(tmpReg) << ", " << context.GetRegString(tmpReg) << ", %lo(" << array_name << ")\n";
+                return std::to_string(local->offset + offset) + "(s0)";
             }
+            if (!is_pointer && local == nullptr)
+            {
+                const std::string symbol = SymbolOffset(GetID(), offset);
+                stream << "lui " << addr << ", %hi(" << symbol << ")\n";
+                return "%lo(" + symbol + ")(" + addr + ")";
+            }
+        }
+
+        index_->EmitRISC(stream, context, addrReg, TypeSpecifier::INT);
+        EmitElementScale(stream, context, addrReg, element_size);
+
+        // handle pointer indexing as well
+        if (is_pointer)
+        {
+            int baseReg = context.AssignRegister(TypeSpecifier::INT);
+            array_id_->EmitRISC(stream, context, baseReg, TypeSpecifier::INT);
+            stream << "add " << addr << ", " << addr << ", " << context.GetRegString(baseReg) << "\n";
+            context.FreeRegister(baseReg);
+            return "0(" + addr + ")";
+        }
+        if (local != nullptr)
+        {
+            stream << "add " << addr << ", " << addr << ", s0\n";
+            return std::to_string(local->offset) + "(" + addr + ")";
         }
+        int baseReg = context.AssignRegister(TypeSpecifier::INT);
+        stream << "lui " << context.GetRegString(baseReg) << ", %hi(" << GetID() << ")\n";
+        stream << "add " << addr << ", " << addr << ", " << context.GetRegString(baseReg) << "\n";
+        context.FreeRegister(baseReg);
+        return "%lo(" + Spelling(GetID()) + ")(" + addr + ")";
+    }
 
-        // Add index offset
-        stream << "add " << context.GetRegString(tmpReg) << ", "
-               << context.GetRegString(tmpReg) << ", "
-               << context.GetRegString(indexReg) << "\n";
+    LoweredValue ArrayIndex::Lower(Lowering &lowering) const
+    {
+        return lowering.Load(LowerPlace(lowering));
+    }
 
-        // Load value
-        stream << GetLoadOp(type) << " " << context.GetRegString(destReg) << ", 0("
-               << context.GetRegString(tmpReg) << ")\n";
+    // a[i] is *(a + i)
+    Place ArrayIndex::LowerPlace(Lowering &lowering) const
+    {
+        LoweredValue array = array_id_->Lower(lowering);
+        LoweredValue index = index_->Lower(lowering);
+        if (!array.type.IsPointer() || !index.type.IsInteger())
+        {
+            Unsupported("subscript of a non-pointer");
+        }
+        LoweredValue element = lowering.Arithmetic('+', array, index);
+        return {{.base = element.reg}, {.base = array.type.base, .pointer_depth = array.type.pointer_depth - 1}};
+    }
 
-        context.FreeRegister(indexReg);
-        context.FreeRegister(tmpReg);
+    void ArrayIndex::Resolve(Resolver &resolver) const
+    {
+        array_id_->Resolve(resolver);
+        index_->Resolve(resolver);
     }
 
     void ArrayIndex::Print(std::ostream &stream) const
@@ -60,11 +137,16 @@ namespace ast
         stream << "]";
     }
 
-    std::string ArrayIndex::GetID() const
+    SymbolId ArrayIndex::GetID() const
     {
         return array_id_->GetID();
     }
 
+    const Binding *ArrayIndex::GetBinding() const
+    {
+        return array_id_->GetBinding();
+    }
+
     TypeSpecifier ArrayIndex::GetType(Context &context) const
     {
         return array_id_->GetType(context);
@@ -90,17 +172,4 @@ namespace ast
         return array_id_->GetPointerDepth();
     }
 
-    void ArrayIndex::EmitIndexOffset(std::ostream &stream, Context &context, int destReg) const
-    {
-        int srcReg = context.AssignRegister(TypeSpecifier::INT);
-        int tmpOffsetReg = context.AssignRegister(TypeSpecifier::INT);
-        index_->EmitRISC(stream, context, srcReg, TypeSpecifier::INT);
-        stream << "li " << context.GetRegString(tmpOffsetReg) << ", " << context.GetPointerOffset(GetID(), GetPointerDepth()) << "\n";
-        stream << "mul " << context.GetRegString(srcReg) << ", " << context.GetRegString(srcReg) << ", " << context.GetRegString(tmpOffsetReg) << "\n";
-        stream << "add " << context.GetRegString(destReg) << "," << context.GetRegString(destReg)
-               << "," << context.GetRegString(srcReg) << "\n";
-        context.FreeRegister(srcReg);
-        context.FreeRegister(tmpOffsetReg);
-    }
-
 } // namespace ast
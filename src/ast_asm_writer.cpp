@@ -0,0 +1,184 @@
+#include "ast_asm_writer.hpp"
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace ast
+{
+    namespace
+    {
+        // fields are written as "<size>:<bytes>"
+        void PutField(std::string &out, std::string_view field)
+        {
+            char digits[24];
+            auto result = std::to_chars(digits, digits + sizeof(digits), field.size());
+            out.append(digits, result.ptr);
+            out.push_back(':');
+            out.append(field);
+        }
+
+        bool TakeField(std::string_view &data, std::string_view &field)
+        {
+            size_t size = 0;
+            auto result = std::from_chars(data.data(), data.data() + data.size(), size);
+            size_t header = result.ptr - data.data();
+            if (result.ec != std::errc() || header >= data.size() || data[header] != ':' || data.size() - header - 1 < size)
+            {
+                return false;
+            }
+            field = data.substr(header + 1, size);
+            data.remove_prefix(header + 1 + size);
+            return true;
+        }
+    }
+
+    AsmWriter AsmWriter::Chunk(const AsmWriter &parent)
+    {
+        AsmWriter chunk(parent.compact_, 0);
+        chunk.is_chunk_ = true;
+        return chunk;
+    }
+
+    void AsmWriter::Section(std::string_view directive)
+    {
+        if (compact_ && section_ == directive)
+        {
+            return;
+        }
+        if (compact_ && is_chunk_ && buffer_.empty() && section_.empty())
+        {
+            // the section the chunk will be spliced into is not known yet
+            entry_section_.assign(directive);
+            section_.assign(directive);
+            return;
+        }
+        section_.assign(directive);
+        buffer_.append(directive);
+        buffer_.push_back('\n');
+    }
+
+    void AsmWriter::Global(std::string_view symbol)
+    {
+        if (compact_)
+        {
+            globals_.emplace_back(symbol);
+            return;
+        }
+        buffer_.append(".globl ");
+        buffer_.append(symbol);
+        buffer_.push_back('\n');
+    }
+
+    void AsmWriter::Splice(const AsmWriter &chunk)
+    {
+        if (!chunk.entry_section_.empty())
+        {
+            Section(chunk.entry_section_);
+        }
+        buffer_.append(chunk.buffer_);
+        if (!chunk.section_.empty())
+        {
+            section_ = chunk.section_;
+        }
+        globals_.insert(globals_.end(), chunk.globals_.begin(), chunk.globals_.end());
+    }
+
+    void AsmWriter::Serialize(std::string &out) const
+    {
+        PutField(out, entry_section_);
+        PutField(out, section_);
+        PutField(out, std::to_string(globals_.size()));
+        for (const std::string &global : globals_)
+        {
+            PutField(out, global);
+        }
+        PutField(out, buffer_);
+    }
+
+    bool AsmWriter::Deserialize(std::string_view &data, AsmWriter &chunk)
+    {
+        std::string_view entry_section, section, n_globals, global, buffer;
+        if (!TakeField(data, entry_section) || !TakeField(data, section) || !TakeField(data, n_globals))
+        {
+            return false;
+        }
+        size_t count = 0;
+        auto result = std::from_chars(n_globals.data(), n_globals.data() + n_globals.size(), count);
+        if (result.ec != std::errc() || result.ptr != n_globals.data() + n_globals.size())
+        {
+            return false;
+        }
+        std::vector<std::string> globals;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!TakeField(data, global))
+            {
+                return false;
+            }
+            globals.emplace_back(global);
+        }
+        if (!TakeField(data, buffer))
+        {
+            return false;
+        }
+        chunk.globals_ = std::move(globals);
+        chunk.entry_section_.assign(entry_section);
+        chunk.section_.assign(section);
+        chunk.buffer_.assign(buffer);
+        return true;
+    }
+
+    void AsmWriter::Finish()
+    {
+        if (globals_.empty())
+        {
+            return;
+        }
+        buffer_.append(".globl ");
+        for (size_t i = 0; i < globals_.size(); i++)
+        {
+            if (i != 0)
+            {
+                buffer_.append(", ");
+            }
+            buffer_.append(globals_[i]);
+        }
+        buffer_.push_back('\n');
+        globals_.clear();
+    }
+
+    void AsmWriter::WriteToFile(const std::string &path) const
+    {
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Couldn't open output file " + path + ": " + std::strerror(errno));
+        }
+
+        // a single write normally covers the whole buffer; loop for partial writes and signals
+        const char *data = buffer_.data();
+        size_t remaining = buffer_.size();
+        while (remaining > 0)
+        {
+            ssize_t written = write(fd, data, remaining);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                int error = errno;
+                close(fd);
+                throw std::runtime_error("Couldn't write output file " + path + ": " + std::strerror(error));
+            }
+            data += written;
+            remaining -= written;
+        }
+        close(fd);
+    }
+
+} // namespace ast
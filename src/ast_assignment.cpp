@@ -1,25 +1,42 @@
 #include "ast_assignment.hpp"
 #include "ast_array_index.hpp"
+#include "ast_lowering.hpp"
 #include <stdexcept>
+#include <utility>
 
 namespace ast
 {
 
-    const std::unordered_map<std::string, std::string> assignmentStringsBase = {
-        {"=", "NIL"},   // Assignment (we don't use any ops for this)
-        {"*=", "mul"},  // MUL_ASSIGN
-        {"/=", "div"},  // DIV_ASSIGN
-        {"%=", "rem"},  // MOD_ASSIGN
-        {"+=", "add"},  // ADD_ASSIGN
-        {"-=", "sub"},  // SUB_ASSIGN
-        {"<<=", "sll"}, // LEFT_ASSIGN
-        {">>=", "srl"}, // RIGHT_ASSIGN
-        {"&=", "and"},  // AND_ASSIGN
-        {"^=", "xor"},  // XOR_ASSIGN
-        {"|=", "or"},   // OR_ASSIGN
-    };
+    namespace
+    {
+        constexpr std::pair<std::string_view, std::string_view> assignmentStringsBase[] = {
+            {"=", "NIL"},   // Assignment (we don't use any ops for this)
+            {"*=", "mul"},  // MUL_ASSIGN
+            {"/=", "div"},  // DIV_ASSIGN
+            {"%=", "rem"},  // MOD_ASSIGN
+            {"+=", "add"},  // ADD_ASSIGN
+            {"-=", "sub"},  // SUB_ASSIGN
+            {"<<=", "sll"}, // LEFT_ASSIGN
+            {">>=", "srl"}, // RIGHT_ASSIGN
+            {"&=", "and"},  // AND_ASSIGN
+            {"^=", "xor"},  // XOR_ASSIGN
+            {"|=", "or"},   // OR_ASSIGN
+        };
+
+        std::string_view AssignmentString(std::string_view assignment)
+        {
+            for (const auto &[symbol, op] : assignmentStringsBase)
+            {
+                if (symbol == assignment)
+                {
+                    return op;
+                }
+            }
+            throw std::out_of_range("Assignment: unknown operator " + std::string(assignment));
+        }
+    }
 
-    void Assignment::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void Assignment::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         (void)type;
         (void)destReg; // don't use destReg because destination can be a float register
@@ -27,19 +44,15 @@ namespace ast
         TypeSpecifier destination_type;
         int tmpDestReg;
 
+        // enumerators are treated as int locals without storage
+        const SymbolId destination_id = destination_->GetID();
+        const Binding *destination = destination_->GetBinding();
+        const bool is_local = RequireBinding(destination).kind != Binding::Kind::GLOBAL;
+        const bool is_pointer = destination_->IsPointer(context, true);
+        const int dest_offset = destination->offset;
+
         // ------ LOADING THE DESTINATION REGISTER ---------
-        if (destination_->IsPointer(context, true))
-        {
-            destination_type = TypeSpecifier::INT;
-        }
-        else if (context.VariableIsLocal(destination_->GetID()))
-        {
-            destination_type = context.GetCurrentFunctionContext().GetFunctionVariableInfo(destination_->GetID()).type;
-        }
-        else
-        {
-            destination_type = context.GetGlobalVariableInfo(destination_->GetID()).type;
-        }
+        destination_type = is_pointer ? TypeSpecifier::INT : destination->type;
         tmpDestReg = context.AssignRegister(destination_type);
 
         // ------ EXECUTING THE ASSIGNMENT ---------
@@ -50,57 +63,46 @@ namespace ast
         else
         {
             int srcReg = context.AssignRegister(destination_type);
+            // the destination is only loaded after the source, so calls in the source don't save it
+            context.SetRegisterDead(tmpDestReg, true);
             source_->EmitRISC(stream, context, srcReg, destination_type);
+            context.SetRegisterDead(tmpDestReg, false);
             destination_->EmitRISC(stream, context, tmpDestReg, destination_type);
             // if destination is a pointer, we need to multiply by WORD_SIZE
-            if (destination_->IsPointer(context, true))
+            if (is_pointer)
             {
                 // we assume valid pointer operations and that pointer is always an int
-                int tmpIndexReg = context.AssignRegister(TypeSpecifier::INT);
-                stream << "li " << context.GetRegString(tmpIndexReg) << "," << context.GetPointerOffset(destination_->GetID(), destination_->GetPointerDepth()) << std::endl;
-                stream << "mul " << context.GetRegString(srcReg) << "," << context.GetRegString(srcReg) << "," << context.GetRegString(tmpIndexReg) << std::endl;
-                context.FreeRegister(tmpIndexReg);
+                EmitElementScale(stream, context, srcReg, GetPointerOffset(destination, destination_->GetPointerDepth()));
             }
-            std::string assignment_string = GetArithmeticOp(destination_type, assignmentStringsBase.at(assignment_str_));
-            stream << assignment_string << " " << context.GetRegString(tmpDestReg) << "," << context.GetRegString(tmpDestReg) << "," << context.GetRegString(srcReg) << std::endl;
+            std::string_view assignment_string = GetArithmeticOp(destination_type, AssignmentString(assignment_str_));
+            stream << assignment_string << " " << context.GetRegString(tmpDestReg) << "," << context.GetRegString(tmpDestReg) << "," << context.GetRegString(srcReg) << "\n";
             context.FreeRegister(srcReg);
         }
 
         // ------ STORING THE RESULT ---------
-        if (context.VariableIsLocal(destination_->GetID()))
+        // for arrays and pointer indexing
+        if (destination_->IsArray())
+        {
+            int tmpMemReg = context.AssignRegister(TypeSpecifier::INT);
+            const std::string address = static_cast<const ArrayIndex *>(destination_.get())->EmitElementAddress(stream, context, tmpMemReg);
+            stream << GetStoreOp(destination_type) << " " << context.GetRegString(tmpDestReg) << "," << address << "\n";
+            context.FreeRegister(tmpMemReg);
+        }
+        else if (is_local)
         {
-            FunctionVariable dest_var_info = context.GetCurrentFunctionContext().GetFunctionVariableInfo(destination_->GetID());
-
-            // for arrays and pointer indexing
-            if (destination_->IsArray())
-            {
-                int tmpMemReg = context.AssignRegister(TypeSpecifier::INT);
-                // deal with pointer indexing
-                if (destination_->IsPointer(context, true))
-                {
-                    destination_->EmitRISC(stream, context, tmpMemReg, TypeSpecifier::INT);
-                }
-                // deal with array indexing
-                else
-                {
-                    stream << "addi " << context.GetRegString(tmpMemReg) << ", s0, " << dest_var_info.offset << "\n";
-                }
-                dynamic_cast<const ArrayIndex *>(destination_.get())->EmitIndexOffset(stream, context, tmpMemReg);
-                stream << GetStoreOp(destination_type) << " " << context.GetRegString(tmpDestReg) << ",0(" << context.GetRegString(tmpMemReg) << ")" << std::endl;
-            }
             // if we are derefencing a pointer
-            else if (destination_->GetPointerDepth() > 0)
+            if (destination_->GetPointerDepth() > 0)
             {
                 int tmpMemReg = context.AssignRegister(TypeSpecifier::INT);
                 EmitPointerDereference(stream, context, tmpMemReg);
                 // we store either a pointer at a lower depth or the base value the pointer was pointing to
-                stream << GetStoreOp(destination_type) << " " << context.GetRegString(tmpDestReg) << ",0(" << context.GetRegString(tmpMemReg) << ")" << std::endl;
+                stream << GetStoreOp(destination_type) << " " << context.GetRegString(tmpDestReg) << ",0(" << context.GetRegString(tmpMemReg) << ")" << "\n";
                 context.FreeRegister(tmpMemReg);
             }
             // else handle normal registers or pointers that are not dereferenced at all
             else
             {
-                stream << GetStoreOp(destination_type) << " " << context.GetRegString(tmpDestReg) << "," << dest_var_info.offset << "(s0)" << std::endl;
+                stream << GetStoreOp(destination_type) << " " << context.GetRegString(tmpDestReg) << "," << dest_offset << "(s0)" << "\n";
             }
         }
         else
@@ -109,42 +111,66 @@ namespace ast
             if (destination_->GetPointerDepth() > 0)
             {
                 EmitPointerDereference(stream, context, tmpMemReg);
-                stream << GetStoreOp(destination_type) << " " << context.GetRegString(tmpDestReg) << ",0(" << context.GetRegString(tmpMemReg) << ")" << std::endl;
+                stream << GetStoreOp(destination_type) << " " << context.GetRegString(tmpDestReg) << ",0(" << context.GetRegString(tmpMemReg) << ")" << "\n";
             }
             else
             {
-                stream << "lui " << context.GetRegString(tmpMemReg) << ",%hi(" << destination_->GetID() << ")" << std::endl;
-                stream << GetStoreOp(destination_type) << " " << context.GetRegString(tmpDestReg) << ",%lo(" << destination_->GetID() << ")(" << context.GetRegString(tmpMemReg) << ")" << std::endl;
+                stream << "lui " << context.GetRegString(tmpMemReg) << ",%hi(" << destination_id << ")" << "\n";
+                stream << GetStoreOp(destination_type) << " " << context.GetRegString(tmpDestReg) << ",%lo(" << destination_id << ")(" << context.GetRegString(tmpMemReg) << ")" << "\n";
             }
             context.FreeRegister(tmpMemReg);
         }
         context.FreeRegister(tmpDestReg);
     }
 
+    LoweredValue Assignment::Lower(Lowering &lowering) const
+    {
+        Place place = destination_->LowerPlace(lowering);
+        LoweredValue value = source_->Lower(lowering);
+        if (assignment_str_ != "=")
+        {
+            // a op= b is a = a op b with a evaluated once; the operator is spelled as BinaryOp spells it
+            char op = assignment_str_[0];
+            op = (assignment_str_ == "<<=") ? 'l' : (assignment_str_ == ">>=") ? 'r'
+                                                                                 : op;
+            value = lowering.Arithmetic(op, lowering.Load(place), value);
+        }
+        value = lowering.Convert(value, place.type);
+        lowering.Store(place, value);
+        return value;
+    }
+
     // we use this for LHS pointer dereferencing to retrieve the memory location to store to
-    void Assignment::EmitPointerDereference(std::ostream &stream, Context &context, int destReg) const
+    void Assignment::EmitPointerDereference(AsmWriter &stream, Context &context, int destReg) const
     {
-        if (context.VariableIsLocal(destination_->GetID()))
+        const SymbolId destination_id = destination_->GetID();
+        if (const Binding *var = LocalBinding(destination_->GetBinding()))
         {
-            stream << "lw " << context.GetRegString(destReg) << "," << context.GetCurrentFunctionContext().GetFunctionVariableInfo(destination_->GetID()).offset << "(s0)" << std::endl;
+            stream << "lw " << context.GetRegString(destReg) << "," << var->offset << "(s0)" << "\n";
         }
         else
         {
-            stream << "lui " << context.GetRegString(destReg) << ",%hi(" << destination_->GetID() << ")" << std::endl;
-            stream << "addi " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << ",%lo(" << destination_->GetID() << ")" << std::endl;
+            stream << "lui " << context.GetRegString(destReg) << ",%hi(" << destination_id << ")" << "\n";
+            stream << "addi " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << ",%lo(" << destination_id << ")" << "\n";
         }
 
         for (int i = 0; i < destination_->GetPointerDepth() - 1; i++)
         {
-            stream << "lw " << context.GetRegString(destReg) << ",0(" << context.GetRegString(destReg) << ")" << std::endl;
+            stream << "lw " << context.GetRegString(destReg) << ",0(" << context.GetRegString(destReg) << ")" << "\n";
         }
     }
 
+    void Assignment::Resolve(Resolver &resolver) const
+    {
+        destination_->Resolve(resolver);
+        source_->Resolve(resolver);
+    }
+
     void Assignment::Print(std::ostream &stream) const
     {
         destination_->Print(stream);
         stream << " " << assignment_str_ << " ";
         source_->Print(stream);
-        stream << std::endl;
+        stream << "\n";
     }
 }
@@ -1,160 +1,348 @@
 #include "ast_binary_op.hpp"
-#include "unordered_map"
+#include "ast_array_index.hpp"
+#include "ast_constant.hpp"
+#include "ast_lowering.hpp"
+#include <bit>
+#include <cstdint>
 
 namespace ast
 {
-    const std::unordered_map<char, std::string> operatorStringsBase = {
-        {'+', "add"}, // Arithmetic Add
-        {'-', "sub"}, // Arithmetic Sub
-        {'*', "mul"}, // Arithmetic Mul
-        {'/', "div"}, // Arithmetic Div
-        {'%', "rem"}, // Arithmetic Rem
-        {'&', "and"}, // Bitwise And
-        {'|', "or"},  // Bitwise Or
-        {'^', "xor"}, // Bitwise XOR
-        {'l', "sll"}, // Shift Left
-        {'r', "sra"}, // Shift Right
-    };
-
-    void BinaryOp::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    namespace
     {
-        const int srcReg = context.AssignRegister(type);
-        expression1_->EmitRISC(stream, context, destReg, type);
-        expression2_->EmitRISC(stream, context, srcReg, type);
+        constexpr bool FitsImmediate(int value) { return value >= -2048 && value < 2048; }
+
+        // op_symbol_ spells the shifts 'l' and 'r'
+        std::string_view CSpelling(const char &op_symbol)
+        {
+            switch (op_symbol)
+            {
+            case 'l':
+                return "<<";
+            case 'r':
+                return ">>";
+            default:
+                return std::string_view(&op_symbol, 1);
+            }
+        }
+
+        std::string_view OperatorString(char op_symbol)
+        {
+            switch (op_symbol)
+            {
+            case '+':
+                return "add"; // Arithmetic Add
+            case '-':
+                return "sub"; // Arithmetic Sub
+            case '*':
+                return "mul"; // Arithmetic Mul
+            case '/':
+                return "div"; // Arithmetic Div
+            case '%':
+                return "rem"; // Arithmetic Rem
+            case '&':
+                return "and"; // Bitwise And
+            case '|':
+                return "or"; // Bitwise Or
+            case '^':
+                return "xor"; // Bitwise XOR
+            case 'l':
+                return "sll"; // Shift Left
+            case 'r':
+                return "sra"; // Shift Right
+            default:
+                throw std::out_of_range(std::string("BinaryOp: unknown operator ") + op_symbol);
+            }
+        }
+    }
 
-        // If we are doing pointer arithmetic, we need to multiply the second operand by 4
+    std::optional<ConstValue> BinaryOp::FoldOperation(ConstValue lhs, Context &context) const
+    {
+        if (!expression2_->IsConstant(context))
+        {
+            return std::nullopt;
+        }
+        const ConstValue rhs = expression2_->Evaluate(context);
+        const std::string_view symbol = CSpelling(op_symbol_);
+        if (!CanEvaluateBinary(symbol, lhs, rhs))
+        {
+            return std::nullopt;
+        }
+        return EvaluateBinary(symbol, lhs, rhs);
+    }
+
+    // The chain (see LeftChain) is generated bottom-up, accumulating into destReg, so the number of
+    // registers in use doesn't grow with its length either.
+    void BinaryOp::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
+    {
+        const LeftChain::Spine<BinaryOp> spine = LeftChain::LeftSpine(*this);
+        auto op = spine.crbegin();
+        if (spine.back()->expression1_->IsConstant(context))
+        {
+            // e.g. 4 + 4 + x is generated as 8 + x, and 8 + x as x + 8 so that 8 can be an immediate
+            const ConstValue value = LeftChain::FoldConstantPrefix(spine, context, op);
+            if (op != spine.crend() && (*op)->IsCommutative() && !(*op)->expression2_->IsPointer(context, true))
+            {
+                (*op)->expression2_->EmitRISC(stream, context, destReg, type);
+                (*op)->EmitConstantOperation(stream, context, destReg, type, value);
+                ++op;
+            }
+            else
+            {
+                EmitConstant(stream, context, destReg, type, value);
+            }
+        }
+        else
+        {
+            spine.back()->expression1_->EmitRISC(stream, context, destReg, type);
+        }
+        for (; op != spine.crend(); ++op)
+        {
+            (*op)->EmitOperation(stream, context, destReg, type);
+        }
+    }
+
+    // destReg holds the value of expression1_; applies the operator to it and expression2_
+    void BinaryOp::EmitOperation(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
+    {
+        // If we are doing pointer arithmetic, we need to scale the integer operand by the element size
         // NB: we let all ops work, but technically only add or sub is allowed
-        int tmpIndexReg = context.AssignRegister(TypeSpecifier::INT);
-        if (expression1_->IsPointer(context, true) && !expression2_->IsPointer(context, true))
+        const bool is_pointer1 = expression1_->IsPointer(context, true);
+        const bool is_pointer2 = expression2_->IsPointer(context, true);
+
+        if (!is_pointer2 && expression2_->IsConstant(context))
+        {
+            const ConstValue value = expression2_->Evaluate(context);
+            if (!is_pointer1)
+            {
+                EmitConstantOperation(stream, context, destReg, type, value);
+                return;
+            }
+            if (op_symbol_ == '+' || op_symbol_ == '-')
+            {
+                // the pointer moves by a constant number of bytes
+                const int element_size = GetPointerOffset(expression1_->GetBinding(), expression1_->GetPointerDepth());
+                const int offset = value.AsInt() * element_size * (op_symbol_ == '-' ? -1 : 1);
+                if (FitsImmediate(offset))
+                {
+                    if (offset != 0)
+                    {
+                        stream << "addi " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "," << offset << "\n";
+                    }
+                    return;
+                }
+            }
+        }
+
+        const int srcReg = context.AssignRegister(type);
+        expression2_->EmitRISC(stream, context, srcReg, type);
+        if (is_pointer1 && !is_pointer2)
         {
-            stream << "li " << context.GetRegString(tmpIndexReg) << "," << context.GetPointerOffset(expression1_->GetID(), expression1_->GetPointerDepth()) << std::endl;
-            stream << "mul " << context.GetRegString(srcReg) << "," << context.GetRegString(srcReg) << "," << context.GetRegString(tmpIndexReg) << std::endl;
+            EmitElementScale(stream, context, srcReg, GetPointerOffset(expression1_->GetBinding(), expression1_->GetPointerDepth()));
         }
-        else if (!expression1_->IsPointer(context, true) && expression2_->IsPointer(context, true))
+        else if (!is_pointer1 && is_pointer2)
         {
-            stream << "li " << context.GetRegString(tmpIndexReg) << "," << context.GetPointerOffset(expression2_->GetID(), expression1_->GetPointerDepth()) << std::endl;
-            stream << "mul " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "," << context.GetRegString(tmpIndexReg) << std::endl;
+            EmitElementScale(stream, context, destReg, GetPointerOffset(expression2_->GetBinding(), expression1_->GetPointerDepth()));
+        }
+        EmitRegisterOperation(stream, context, destReg, srcReg, type);
+        context.FreeRegister(srcReg);
+    }
+
+    void BinaryOp::EmitConstantOperation(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type, ConstValue value) const
+    {
+        value = value.ConvertTo(KindOf(type));
+        // floating point operations are always done: x + 0.0 isn't x for x = -0.0, and no operation
+        // leaves the NaN payload of x as it is
+        if (value.IsInteger())
+        {
+            const std::string_view dest = context.GetRegString(destReg);
+            const bool is_unsigned = type == TypeSpecifier::UNSIGNED;
+            const int32_t c = value.AsInt();
+            const uint32_t bits = value.AsUnsigned();
+
+            // the operation as an immediate instruction; identities return with destReg as it is
+            std::string_view op;
+            int32_t imm = c;
+            bool zero = false; // the result is 0 whatever destReg holds
+            switch (op_symbol_)
+            {
+            case '+':
+                if (c == 0)
+                    return;
+                op = "addi";
+                break;
+            case '-':
+                if (c == 0)
+                    return;
+                if (c != INT32_MIN)
+                {
+                    op = "addi";
+                    imm = -c;
+                }
+                break;
+            case '*':
+                if (c == 1)
+                    return;
+                if (c == -1)
+                {
+                    stream << "neg " << dest << "," << dest << "\n";
+                    return;
+                }
+                zero = c == 0;
+                if (std::has_single_bit(bits))
+                {
+                    op = "slli";
+                    imm = std::countr_zero(bits);
+                }
+                break;
+            case '/':
+                if (c == 1)
+                    return;
+                if (is_unsigned && std::has_single_bit(bits))
+                {
+                    op = "srli";
+                    imm = std::countr_zero(bits);
+                }
+                break;
+            case '%':
+                zero = c == 1 || (c == -1 && !is_unsigned);
+                if (is_unsigned && std::has_single_bit(bits))
+                {
+                    op = "andi";
+                    imm = static_cast<int32_t>(bits - 1);
+                }
+                break;
+            case '&':
+                if (c == -1)
+                    return;
+                zero = c == 0;
+                op = "andi";
+                break;
+            case '|':
+                if (c == 0)
+                    return;
+                op = "ori";
+                break;
+            case '^':
+                if (c == 0)
+                    return;
+                op = "xori";
+                break;
+            case 'l':
+            case 'r':
+                // sll and sra only use the low 5 bits of the count
+                imm = c & 31;
+                if (imm == 0)
+                    return;
+                op = (op_symbol_ == 'l') ? "slli" : is_unsigned ? "srli"
+                                                                 : "srai";
+                break;
+            }
+            if (zero)
+            {
+                stream << "li " << dest << ",0" << "\n";
+                return;
+            }
+            if (!op.empty() && FitsImmediate(imm))
+            {
+                stream << op << " " << dest << "," << dest << "," << imm << "\n";
+                return;
+            }
         }
-        context.FreeRegister(tmpIndexReg);
 
+        const int srcReg = context.AssignRegister(type);
+        EmitConstant(stream, context, srcReg, type, value);
+        EmitRegisterOperation(stream, context, destReg, srcReg, type);
+        context.FreeRegister(srcReg);
+    }
+
+    // destReg op= srcReg
+    void BinaryOp::EmitRegisterOperation(AsmWriter &stream, Context &context, int destReg, int srcReg, TypeSpecifier type) const
+    {
         if (type == TypeSpecifier::UNSIGNED)
         {
             if (op_symbol_ == 'r')
             {
-                stream << "srl " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "," << context.GetRegString(srcReg) << std::endl;
+                stream << "srl " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "," << context.GetRegString(srcReg) << "\n";
             }
             else if (op_symbol_ == '/')
             {
-                stream << "divu " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg) << std::endl;
+                stream << "divu " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "," << context.GetRegString(srcReg) << "\n";
             }
             else if (op_symbol_ == '%')
             {
-                stream << "remu " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg) << std::endl;
+                stream << "remu " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "," << context.GetRegString(srcReg) << "\n";
             }
             else
             {
-                stream << GetArithmeticOp(type, operatorStringsBase.at(op_symbol_)) << " " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "," << context.GetRegString(srcReg) << std::endl;
+                stream << GetArithmeticOp(type, OperatorString(op_symbol_)) << " " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "," << context.GetRegString(srcReg) << "\n";
             }
         }
         else
         {
-            stream << GetArithmeticOp(type, operatorStringsBase.at(op_symbol_)) << " " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "," << context.GetRegString(srcReg) << std::endl;
+            stream << GetArithmeticOp(type, OperatorString(op_symbol_)) << " " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "," << context.GetRegString(srcReg) << "\n";
         }
-
-        context.FreeRegister(srcReg);
     }
 
-    void BinaryOp::Print(std::ostream &stream) const
+    bool BinaryOp::IsCommutative() const
     {
-        expression1_->Print(stream);
-        stream << " " << op_symbol_ << " ";
-        expression2_->Print(stream);
+        return op_symbol_ == '+' || op_symbol_ == '*' || op_symbol_ == '&' || op_symbol_ == '|' || op_symbol_ == '^';
     }
 
-    std::any BinaryOp::GetValue(TypeSpecifier type) const
+    LoweredValue BinaryOp::Lower(Lowering &lowering) const
     {
-        if (type == TypeSpecifier::INT || type == TypeSpecifier::CHAR)
-        {
-            return HandleIntOperation(type);
-        }
-        else if (type == TypeSpecifier::FLOAT)
-        {
-            return HandleFloatOperation<float>(type);
-        }
-        else if (type == TypeSpecifier::DOUBLE)
+        const LeftChain::Spine<BinaryOp> spine = LeftChain::LeftSpine(*this);
+        LoweredValue value = spine.back()->expression1_->Lower(lowering);
+        for (auto op = spine.rbegin(); op != spine.rend(); ++op)
         {
-            return HandleFloatOperation<double>(type);
-        }
-        else
-        {
-            throw std::runtime_error("BinaryOp::GetValue called with invalid type!");
+            value = lowering.Arithmetic((*op)->op_symbol_, value, (*op)->expression2_->Lower(lowering));
         }
+        return value;
     }
 
-    TypeSpecifier BinaryOp::GetType(Context &context) const
+    void BinaryOp::Resolve(Resolver &resolver) const
     {
-        const TypeSpecifier type1 = expression1_->GetType(context);
-        const TypeSpecifier type2 = expression2_->GetType(context);
-        if (type1 != type2)
+        LeftChain::Resolve(*this, resolver);
+    }
+
+    void BinaryOp::Print(std::ostream &stream) const
+    {
+        const LeftChain::Spine<BinaryOp> spine = LeftChain::LeftSpine(*this);
+        spine.back()->expression1_->Print(stream);
+        for (auto op = spine.rbegin(); op != spine.rend(); ++op)
         {
-            throw std::runtime_error("BinaryOp::GetType called with mismatched types!");
+            stream << " " << (*op)->op_symbol_ << " ";
+            (*op)->expression2_->Print(stream);
         }
-        return type1;
     }
 
-    std::any BinaryOp::HandleIntOperation(TypeSpecifier type) const
+    ConstValue BinaryOp::Evaluate(Context &context) const
     {
-        switch (op_symbol_)
-        {
-        case '+':
-            return EvalOperation<int>(type, std::plus<int>());
-        case '-':
-            return EvalOperation<int>(type, std::minus<int>());
-        case '*':
-            return EvalOperation<int>(type, std::multiplies<int>());
-        case '/':
-            return EvalOperation<int>(type, std::divides<int>());
-        case '%':
-            return EvalOperation<int>(type, std::modulus<int>());
-        case '&':
-            return EvalOperation<int>(type, std::bit_and<int>());
-        case '|':
-            return EvalOperation<int>(type, std::bit_or<int>());
-        case '^':
-            return EvalOperation<int>(type, std::bit_xor<int>());
-        case 'l':
-            return std::any((std::any_cast<int>(expression1_->GetValue(type)) << std::any_cast<int>(expression2_->GetValue(type))));
-            ;
-        case 'r':
-            return std::any((std::any_cast<int>(expression1_->GetValue(type)) >> std::any_cast<int>(expression2_->GetValue(type))));
-        default:
-            throw std::runtime_error("BinaryOp::HandleIntOperation called with invalid operator!");
+        const LeftChain::Spine<BinaryOp> spine = LeftChain::LeftSpine(*this);
+        ConstValue value = spine.back()->expression1_->Evaluate(context);
+        for (auto op = spine.rbegin(); op != spine.rend(); ++op)
+        {
+            value = EvaluateBinary(CSpelling((*op)->op_symbol_), value, (*op)->expression2_->Evaluate(context));
         }
+        return value;
     }
 
-    template <typename T>
-    std::any BinaryOp::HandleFloatOperation(TypeSpecifier type) const
+    bool BinaryOp::IsConstant(Context &context) const
     {
-        switch (op_symbol_)
-        {
-        case '+':
-            return EvalOperation<T>(type, std::plus<T>());
-        case '-':
-            return EvalOperation<T>(type, std::minus<T>());
-        case '*':
-            return EvalOperation<T>(type, std::multiplies<T>());
-        case '/':
-            return EvalOperation<T>(type, std::divides<T>());
-        default:
-            throw std::runtime_error("BinaryOp::HandleFloatOperation called with invalid operator!");
-        }
+        return LeftChain::IsConstant(*this, context);
     }
 
-    template <typename T, typename Op>
-    std::any BinaryOp::EvalOperation(TypeSpecifier type, Op op) const
+    TypeSpecifier BinaryOp::GetType(Context &context) const
     {
-        return std::any(op(std::any_cast<T>(expression1_->GetValue(type)),
-                           std::any_cast<T>(expression2_->GetValue(type))));
+        const LeftChain::Spine<BinaryOp> spine = LeftChain::LeftSpine(*this);
+        const TypeSpecifier type = spine.back()->expression1_->GetType(context);
+        for (const BinaryOp *op : spine)
+        {
+            if (op->expression2_->GetType(context) != type)
+            {
+                throw std::runtime_error("BinaryOp::GetType called with mismatched types!");
+            }
+        }
+        return type;
     }
 
 } // namespace ast
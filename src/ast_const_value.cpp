@@ -0,0 +1,337 @@
+#include "ast_const_value.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace ast
+{
+    namespace
+    {
+        using Kind = ConstValue::Kind;
+
+        ConstValue Make(int32_t value) { return ConstValue::Int(value); }
+        ConstValue Make(uint32_t value) { return ConstValue::Unsigned(value); }
+        ConstValue Make(float value) { return ConstValue::Float(value); }
+        ConstValue Make(double value) { return ConstValue::Double(value); }
+
+        [[noreturn]] void InvalidOperands(std::string_view op)
+        {
+            throw std::runtime_error("Constant expression: invalid operands to " + std::string(op));
+        }
+
+        // rounds towards zero like fcvt.w and fcvt.wu: out of range values saturate and NaN gives the
+        // largest value, where a C++ cast would be undefined
+        template <typename T>
+        T Truncate(double value)
+        {
+            using Limits = std::numeric_limits<T>;
+            if (std::isnan(value) || value >= static_cast<double>(Limits::max()) + 1.0)
+            {
+                return Limits::max();
+            }
+            if (value <= static_cast<double>(Limits::min()))
+            {
+                return Limits::min();
+            }
+            return static_cast<T>(value);
+        }
+
+        // both operands already have T, the type of the operation
+        template <typename T>
+        ConstValue Arithmetic(std::string_view op, T a, T b)
+        {
+            if (op == "<")
+                return ConstValue::Bool(a < b);
+            if (op == "<=")
+                return ConstValue::Bool(a <= b);
+            if (op == ">")
+                return ConstValue::Bool(a > b);
+            if (op == ">=")
+                return ConstValue::Bool(a >= b);
+            if (op == "==")
+                return ConstValue::Bool(a == b);
+            if (op == "!=")
+                return ConstValue::Bool(a != b);
+
+            if constexpr (std::is_integral_v<T>)
+            {
+                // computed unsigned, so that overflow wraps as it does at run time
+                using U = std::make_unsigned_t<T>;
+                if (op == "+")
+                    return Make(static_cast<T>(static_cast<U>(a) + static_cast<U>(b)));
+                if (op == "-")
+                    return Make(static_cast<T>(static_cast<U>(a) - static_cast<U>(b)));
+                if (op == "*")
+                    return Make(static_cast<T>(static_cast<U>(a) * static_cast<U>(b)));
+                if (op == "&")
+                    return Make(static_cast<T>(a & b));
+                if (op == "|")
+                    return Make(static_cast<T>(a | b));
+                if (op == "^")
+                    return Make(static_cast<T>(a ^ b));
+                if (op == "/" || op == "%")
+                {
+                    if (b == 0)
+                    {
+                        throw std::runtime_error("Division by zero in constant expression");
+                    }
+                    if constexpr (std::is_signed_v<T>)
+                    {
+                        if (b == -1)
+                        {
+                            // INT_MIN / -1 overflows: wrap like div and rem
+                            return Make(op == "/" ? static_cast<T>(U(0) - static_cast<U>(a)) : T(0));
+                        }
+                    }
+                    return Make(static_cast<T>(op == "/" ? a / b : a % b));
+                }
+            }
+            else
+            {
+                if (op == "+")
+                    return Make(static_cast<T>(a + b));
+                if (op == "-")
+                    return Make(static_cast<T>(a - b));
+                if (op == "*")
+                    return Make(static_cast<T>(a * b));
+                if (op == "/")
+                    return Make(static_cast<T>(a / b));
+            }
+            InvalidOperands(op);
+        }
+    }
+
+    ConstValue ConstValue::Int(int32_t value)
+    {
+        ConstValue constant(Kind::INT);
+        constant.value_.i = value;
+        return constant;
+    }
+
+    ConstValue ConstValue::Unsigned(uint32_t value)
+    {
+        ConstValue constant(Kind::UNSIGNED);
+        constant.value_.u = value;
+        return constant;
+    }
+
+    ConstValue ConstValue::Float(float value)
+    {
+        ConstValue constant(Kind::FLOAT);
+        constant.value_.f = value;
+        return constant;
+    }
+
+    ConstValue ConstValue::Double(double value)
+    {
+        ConstValue constant(Kind::DOUBLE);
+        constant.value_.d = value;
+        return constant;
+    }
+
+    bool ConstValue::IsTrue() const
+    {
+        switch (kind_)
+        {
+        case Kind::INT:
+            return value_.i != 0;
+        case Kind::UNSIGNED:
+            return value_.u != 0;
+        case Kind::FLOAT:
+            return value_.f != 0;
+        case Kind::DOUBLE:
+            return value_.d != 0;
+        }
+        throw std::runtime_error("ConstValue: invalid kind");
+    }
+
+    int32_t ConstValue::AsInt() const
+    {
+        switch (kind_)
+        {
+        case Kind::INT:
+            return value_.i;
+        case Kind::UNSIGNED:
+            return static_cast<int32_t>(value_.u);
+        case Kind::FLOAT:
+            return Truncate<int32_t>(value_.f);
+        case Kind::DOUBLE:
+            return Truncate<int32_t>(value_.d);
+        }
+        throw std::runtime_error("ConstValue: invalid kind");
+    }
+
+    uint32_t ConstValue::AsUnsigned() const
+    {
+        switch (kind_)
+        {
+        case Kind::INT:
+            return static_cast<uint32_t>(value_.i);
+        case Kind::UNSIGNED:
+            return value_.u;
+        case Kind::FLOAT:
+            return Truncate<uint32_t>(value_.f);
+        case Kind::DOUBLE:
+            return Truncate<uint32_t>(value_.d);
+        }
+        throw std::runtime_error("ConstValue: invalid kind");
+    }
+
+    float ConstValue::AsFloat() const
+    {
+        switch (kind_)
+        {
+        case Kind::INT:
+            return static_cast<float>(value_.i);
+        case Kind::UNSIGNED:
+            return static_cast<float>(value_.u);
+        case Kind::FLOAT:
+            return value_.f;
+        case Kind::DOUBLE:
+            return static_cast<float>(value_.d);
+        }
+        throw std::runtime_error("ConstValue: invalid kind");
+    }
+
+    double ConstValue::AsDouble() const
+    {
+        switch (kind_)
+        {
+        case Kind::INT:
+            return value_.i;
+        case Kind::UNSIGNED:
+            return value_.u;
+        case Kind::FLOAT:
+            return value_.f;
+        case Kind::DOUBLE:
+            return value_.d;
+        }
+        throw std::runtime_error("ConstValue: invalid kind");
+    }
+
+    ConstValue ConstValue::ConvertTo(Kind kind) const
+    {
+        switch (kind)
+        {
+        case Kind::INT:
+            return Int(AsInt());
+        case Kind::UNSIGNED:
+            return Unsigned(AsUnsigned());
+        case Kind::FLOAT:
+            return Float(AsFloat());
+        case Kind::DOUBLE:
+            return Double(AsDouble());
+        }
+        throw std::runtime_error("ConstValue: invalid kind");
+    }
+
+    ConstValue EvaluateUnary(std::string_view op, ConstValue operand)
+    {
+        if (op == "!")
+        {
+            return ConstValue::Bool(!operand.IsTrue());
+        }
+        if (op == "+")
+        {
+            return operand;
+        }
+        switch (operand.GetKind())
+        {
+        case Kind::INT:
+            if (op == "-")
+                return ConstValue::Int(static_cast<int32_t>(0u - operand.AsUnsigned()));
+            if (op == "~")
+                return ConstValue::Int(~operand.AsInt());
+            break;
+        case Kind::UNSIGNED:
+            if (op == "-")
+                return ConstValue::Unsigned(0u - operand.AsUnsigned());
+            if (op == "~")
+                return ConstValue::Unsigned(~operand.AsUnsigned());
+            break;
+        case Kind::FLOAT:
+            if (op == "-")
+                return ConstValue::Float(-operand.AsFloat());
+            break;
+        case Kind::DOUBLE:
+            if (op == "-")
+                return ConstValue::Double(-operand.AsDouble());
+            break;
+        }
+        InvalidOperands(op);
+    }
+
+    ConstValue EvaluateBinary(std::string_view op, ConstValue lhs, ConstValue rhs)
+    {
+        if (op == "<<" || op == ">>")
+        {
+            // no usual arithmetic conversions: the result has the type of the left operand
+            if (!lhs.IsInteger() || !rhs.IsInteger())
+            {
+                InvalidOperands(op);
+            }
+            uint32_t count = rhs.AsUnsigned() & 31;
+            if (lhs.GetKind() == Kind::UNSIGNED)
+            {
+                return ConstValue::Unsigned(op == "<<" ? lhs.AsUnsigned() << count : lhs.AsUnsigned() >> count);
+            }
+            return ConstValue::Int(op == "<<" ? static_cast<int32_t>(lhs.AsUnsigned() << count) : lhs.AsInt() >> count);
+        }
+
+        // usual arithmetic conversions: the operation takes the higher ranked of the two types
+        switch (std::max(lhs.GetKind(), rhs.GetKind()))
+        {
+        case Kind::INT:
+            return Arithmetic<int32_t>(op, lhs.AsInt(), rhs.AsInt());
+        case Kind::UNSIGNED:
+            return Arithmetic<uint32_t>(op, lhs.AsUnsigned(), rhs.AsUnsigned());
+        case Kind::FLOAT:
+            return Arithmetic<float>(op, lhs.AsFloat(), rhs.AsFloat());
+        case Kind::DOUBLE:
+            return Arithmetic<double>(op, lhs.AsDouble(), rhs.AsDouble());
+        }
+        throw std::runtime_error("ConstValue: invalid kind");
+    }
+
+    bool CanEvaluateUnary(std::string_view op, ConstValue operand)
+    {
+        return op != "~" || operand.IsInteger();
+    }
+
+    bool CanEvaluateBinary(std::string_view op, ConstValue lhs, ConstValue rhs)
+    {
+        const bool integer = lhs.IsInteger() && rhs.IsInteger();
+        if (op == "<<" || op == ">>" || op == "%" || op == "&" || op == "|" || op == "^")
+        {
+            if (!integer)
+            {
+                return false;
+            }
+        }
+        // floating point division by zero is an infinity or a NaN, as at run time
+        if ((op == "/" || op == "%") && integer)
+        {
+            return rhs.AsUnsigned() != 0;
+        }
+        return true;
+    }
+
+    ConstValue::Kind KindOf(TypeSpecifier type)
+    {
+        switch (type)
+        {
+        case TypeSpecifier::FLOAT:
+            return Kind::FLOAT;
+        case TypeSpecifier::DOUBLE:
+            return Kind::DOUBLE;
+        case TypeSpecifier::UNSIGNED:
+            return Kind::UNSIGNED;
+        default:
+            return Kind::INT;
+        }
+    }
+
+} // namespace ast
@@ -1,26 +1,51 @@
 #include "ast_constant.hpp"
+#include "ast_lowering.hpp"
 #include <bitset>
 namespace ast
 {
-    std::any IntConstant::GetValue(TypeSpecifier type) const
+    ConstValue IntConstant::Evaluate(Context &context) const
     {
-        if (type == TypeSpecifier::INT)
-        {
-            return value_;
-        }
-        else
+        (void)context;
+        if (raw_str_.find_first_of("uU") != std::string::npos)
         {
-            throw std::runtime_error("IntConstant::GetValue called with non-int type");
+            return ConstValue::Unsigned(static_cast<uint32_t>(value_));
         }
+        return ConstValue::Int(value_);
+    }
+
+    bool IntConstant::IsConstant(Context &context) const
+    {
+        (void)context;
+        return true;
     }
 
-    void IntConstant::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void EmitConstant(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type, ConstValue value)
     {
-        if (type != TypeSpecifier::INT && type != TypeSpecifier::CHAR)
+        value = value.ConvertTo(KindOf(type));
+        if (value.IsInteger())
         {
-            throw std::runtime_error("IntConstant::EmitRISC called with non-int type");
+            stream << "li " << context.GetRegString(destReg) << ", " << value.AsInt() << "\n";
+            return;
         }
-        stream << "li " << context.GetRegString(destReg) << ", " << value_ << std::endl;
+
+        // a float widens to a double exactly, and the literal is narrowed back to the same bits
+        std::string lc_label = context.AddFloatLiteralConstant(value.AsDouble(), type);
+        int srcReg = context.AssignRegister(TypeSpecifier::INT);
+        stream << "lui " << context.GetRegString(srcReg) << ", %hi(" << lc_label << ")" << "\n";
+        stream << GetLoadOp(type) << " " << context.GetRegString(destReg) << ",%lo(" << lc_label << ")(" << context.GetRegString(srcReg) << ")" << "\n";
+        context.FreeRegister(srcReg);
+    }
+
+    void IntConstant::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
+    {
+        EmitConstant(stream, context, destReg, type, Evaluate(context));
+    }
+
+    LoweredValue IntConstant::Lower(Lowering &lowering) const
+    {
+        ConstValue value = Evaluate(lowering.GetContext());
+        TypeSpecifier type = value.GetKind() == ConstValue::Kind::UNSIGNED ? TypeSpecifier::UNSIGNED : TypeSpecifier::INT;
+        return {lowering.Const(value.AsInt()), {.base = type}};
     }
 
     TypeSpecifier IntConstant::GetType(Context &context) const
@@ -34,40 +59,30 @@ namespace ast
         stream << raw_str_;
     }
 
-    void FloatConstant::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void FloatConstant::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
-        int lc_n = context.AddFloatLiteralConstant(value_, type);
-        int srcReg = context.AssignRegister(TypeSpecifier::INT);
-        stream << "lui " << context.GetRegString(srcReg) << ", %hi(.LC" << lc_n << ")" << std::endl;
-        if (type == TypeSpecifier::FLOAT)
-        {
-            stream << "flw " << context.GetRegString(destReg) << ",%lo(.LC" << lc_n << ")(" << context.GetRegString(srcReg) << ")" << std::endl;
-        }
-        else if (type == TypeSpecifier::DOUBLE)
-        {
-            stream << "fld " << context.GetRegString(destReg) << ",%lo(.LC" << lc_n << ")(" << context.GetRegString(srcReg) << ")" << std::endl;
-        }
-        else
-        {
-            throw std::runtime_error("FloatConstant::EmitRISC called with non-float type");
-        }
-        context.FreeRegister(srcReg);
+        EmitConstant(stream, context, destReg, type, Evaluate(context));
     }
 
-    std::any FloatConstant::GetValue(TypeSpecifier type) const
+    LoweredValue FloatConstant::Lower(Lowering &lowering) const
     {
-        if (type == TypeSpecifier::FLOAT)
-        {
-            return static_cast<float>(value_);
-        }
-        else if (type == TypeSpecifier::DOUBLE)
-        {
-            return value_;
-        }
-        else
+        TypeSpecifier type = GetType(lowering.GetContext());
+        return {lowering.FConst(value_, Lowering::IRType({.base = type})), {.base = type}};
+    }
+
+    ConstValue FloatConstant::Evaluate(Context &context) const
+    {
+        if (GetType(context) == TypeSpecifier::FLOAT)
         {
-            throw std::runtime_error("FloatConstant::GetValue called with non-float type");
+            return ConstValue::Float(static_cast<float>(value_));
         }
+        return ConstValue::Double(value_);
+    }
+
+    bool FloatConstant::IsConstant(Context &context) const
+    {
+        (void)context;
+        return true;
     }
 
     void FloatConstant::Print(std::ostream &stream) const
@@ -131,23 +146,29 @@ namespace ast
     void CharLiteral::Char2Int()
     {
         // assume position 0 is the literal ' char
-        if (raw_str_[1] == '\\')
+        const std::string &raw_str = Spelling(raw_str_);
+        if (raw_str[1] == '\\')
         {
-            value_ = EscapedCharMap(raw_str_);
+            value_ = EscapedCharMap(raw_str);
         }
         else
         {
-            value_ = static_cast<int>(raw_str_[1]);
+            value_ = static_cast<int>(raw_str[1]);
         }
     }
 
-    void CharLiteral::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void CharLiteral::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         if (type != TypeSpecifier::CHAR && type != TypeSpecifier::INT)
         {
             throw std::runtime_error("CharLiteral::EmitRISC called with non-char or int type");
         }
-        stream << "li " << context.GetRegString(destReg) << ", " << value_ << std::endl;
+        stream << "li " << context.GetRegString(destReg) << ", " << value_ << "\n";
+    }
+
+    LoweredValue CharLiteral::Lower(Lowering &lowering) const
+    {
+        return {lowering.Const(value_), {.base = TypeSpecifier::INT}}; // character constants have type int
     }
 
     void CharLiteral::Print(std::ostream &stream) const
@@ -155,16 +176,16 @@ namespace ast
         stream << raw_str_;
     }
 
-    std::any CharLiteral::GetValue(TypeSpecifier type) const
+    ConstValue CharLiteral::Evaluate(Context &context) const
     {
-        if (type == TypeSpecifier::CHAR)
-        {
-            return value_;
-        }
-        else
-        {
-            throw std::runtime_error("CharLiteral::GetValue called with non-char type");
-        }
+        (void)context;
+        return ConstValue::Int(value_); // character constants have type int
+    }
+
+    bool CharLiteral::IsConstant(Context &context) const
+    {
+        (void)context;
+        return true;
     }
 
     TypeSpecifier CharLiteral::GetType(Context &context) const
@@ -173,12 +194,19 @@ namespace ast
         return TypeSpecifier::CHAR;
     }
 
-    void StringLiteral::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void StringLiteral::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         (void)type;
-        int lc_n = context.AddStringLiteralConstant(raw_str_);
-        stream << "lui " << context.GetRegString(destReg) << ", %hi(.LC" << lc_n << ")" << std::endl;
-        stream << "addi " << context.GetRegString(destReg) << ", " << context.GetRegString(destReg) << ", %lo(.LC" << lc_n << ")" << std::endl;
+        std::string lc_label = context.AddStringLiteralConstant(Spelling(raw_str_));
+        stream << "lui " << context.GetRegString(destReg) << ", %hi(" << lc_label << ")" << "\n";
+        stream << "addi " << context.GetRegString(destReg) << ", " << context.GetRegString(destReg) << ", %lo(" << lc_label << ")" << "\n";
+    }
+
+    LoweredValue StringLiteral::Lower(Lowering &lowering) const
+    {
+        std::string lc_label = lowering.GetContext().AddStringLiteralConstant(Spelling(raw_str_));
+        ir::VReg address = lowering.Address({.symbol = Intern(lc_label)});
+        return {address, {.base = TypeSpecifier::CHAR, .pointer_depth = 1, .array_size = GetArraySize(lowering.GetContext())}};
     }
 
     void StringLiteral::Print(std::ostream &stream) const
@@ -186,7 +214,7 @@ namespace ast
         stream << raw_str_;
     }
 
-    std::string StringLiteral::GetID() const
+    SymbolId StringLiteral::GetID() const
     {
         return raw_str_;
     }
@@ -201,7 +229,7 @@ namespace ast
     {
         (void)context;
         // -1 to remove the quotes but include the null terminator
-        return raw_str_.size() - 1;
+        return Spelling(raw_str_).size() - 1;
     }
 
 } // namespace ast
@@ -1,110 +1,79 @@
 #include "ast_context.hpp"
+#include <algorithm>
+#include <bit>
 #include <stdexcept>
 #include <iostream>
 #include <fstream>
+#include <limits>
 
 namespace ast
 {
-    const int N_REGISTERS = 64;
-    const int START_SINGLE_REGISTER = 31; // start with a1, the previous registers are reserved
-    const int START_FLOAT_REGISTER = 45;
+    const int START_SINGLE_REGISTER = static_cast<int>(Reg::A1); // start with a1, the previous registers are reserved
+    const int START_FLOAT_REGISTER = static_cast<int>(Reg::FA1);
     const int DEFAULT_STACK_SIZE = 32; // TODO: for now, just default as size 16, but should increse with more variables
     const int WORD_SIZE = 4;
-    const int MAX_REGISTER_PARAM = 8;                 // after 8 params, we don't have registers to store them
-    const std::string RESERVED_VARIABLE_PREFIX = "#"; // use this prefix for storing registers in the variable table
+    const int MAX_REGISTER_PARAM = 8;            // after 8 params, we don't have registers to store them
+    const char RESERVED_VARIABLE_PREFIX[] = "#"; // use this prefix for storing registers in the variable table
 
-    // Register Definitions
-    // x0               zero
-    // x1               ra
-    // x2               sp
-    // x3               gp
-    // x4               tp
-    // x5 - x7          t0-t2
-    // x8               s0/fp
-    // x9               s1
-    // x10 - x11        a0-a1
-    // x12 - x17        a2-a7
-    // x18 - x27        s2-s11
-    // x28 - x31        t3-t6
+    // bit i stands for register i, split by class; everything below a1 is reserved
+    static_assert(N_REGISTERS <= 64, "registers must fit in a RegisterMask");
+    const RegisterMask INT_REGISTER_MASK = ((RegisterMask(1) << START_FLOAT_REGISTER) - 1) & ~((RegisterMask(1) << START_SINGLE_REGISTER) - 1);
+    const RegisterMask FLOAT_REGISTER_MASK = ~((RegisterMask(1) << START_FLOAT_REGISTER) - 1);
 
-    // Definitions for the static constants
-    // DO NOT MODIFY
-    // affects: function_definition.cpp
-    const std::string registers[N_REGISTERS] = {
-        "zero", "ra", "sp", "gp", "tp", "s0",
-        "s1", "s2", "s3", "s4", "s5", "s6", "s7", "s8", "s9", "s10", "s11",
-        "fs0", "fs1", "fs2", "fs3", "fs4", "fs5", "fs6", "fs7", "fs8", "fs9", "fs10", "fs11",
-        "fa0",
-        "a0", "a1", "a2", "a3", "a4", "a5", "a6", "a7",
-        "t0", "t1", "t2", "t3", "t4", "t5", "t6",
-        "fa1", "fa2", "fa3", "fa4", "fa5", "fa6", "fa7",
-        "ft0", "ft1", "ft2", "ft3", "ft4", "ft5", "ft6", "ft7", "ft8", "ft9", "ft10", "ft11"};
 
-    std::map<std::string, int> Context::CreateRegisterMap()
+    const Binding &RequireBinding(const Binding *binding)
     {
-        std::map<std::string, int> register_map;
-        for (int i = 0; i < N_REGISTERS; i++)
+        if (binding == nullptr)
         {
-            register_map[registers[i]] = i;
+            throw std::runtime_error("Variable not found");
         }
-        return register_map;
+        return *binding;
     }
 
-    std::set<int> Context::InitializeUnusedRegisters()
+    int GetPointerOffset(const Binding *binding, int my_pointer_depth)
     {
-        std::set<int> unused_registers;
-        for (int i = START_SINGLE_REGISTER; i < N_REGISTERS; i++)
+        // TODO: add pointer to struct lmaooo
+        const Binding &var = RequireBinding(binding);
+        // if child is a pointer to a pointer, we default to shifting by 4
+        if (my_pointer_depth + 1 < var.pointer_depth)
         {
-            unused_registers.insert(i);
+            return GetTypeSize(TypeSpecifier::INT);
         }
-        return unused_registers;
+        return GetTypeSize(var.type);
     }
 
-    void Context::AddGlobalVariable(const std::string &name, const TypeSpecifier type, const bool is_pointer, const int pointer_depth)
+    Context::Context(GlobalContext &globals)
+        : unused_registers_(INT_REGISTER_MASK | FLOAT_REGISTER_MASK),
+          globals_(globals), global_writes_(&globals), label_prefix_("."),
+          visible_functions_(std::numeric_limits<size_t>::max())
     {
-        GlobalVariable var = {name, type, is_pointer, pointer_depth, false, 0};
-        if (global_variable_table_.find(name) != global_variable_table_.end())
-        {
-            throw std::runtime_error("Global variable already declared");
-        }
-        global_variable_table_[name] = var;
     }
 
-    void Context::AddFunctionInfo(const std::string &name, const std::vector<ParamInfo> &params, const TypeSpecifier returnType)
+    Context::Context(const GlobalContext &globals, SymbolId function, size_t visible_functions)
+        : unused_registers_(INT_REGISTER_MASK | FLOAT_REGISTER_MASK),
+          globals_(globals), global_writes_(nullptr), label_prefix_("." + Spelling(function) + "."),
+          visible_functions_(visible_functions)
     {
-        if (function_info_table_.find(name) != function_info_table_.end())
-        {
-            throw std::runtime_error("Function already declared");
-        }
-        FunctionInfo fun = {name, params, returnType};
-        function_info_table_[name] = fun;
     }
 
-    bool Context::VariableIsLocal(const std::string &name) const
+    void Context::AddGlobalVariable(SymbolId name, const TypeSpecifier type, const bool is_pointer, const int pointer_depth)
     {
-        // First check if it's an enum
-        if (InEnum(name))
+        GlobalVariable var = {name, type, is_pointer, pointer_depth, false, 0};
+        if (FindGlobalVariable(name) != nullptr)
         {
-            return true;
+            throw std::runtime_error("Global variable already declared");
         }
+        Declarations().AddVariable(var);
+    }
 
-        // Then check in current scope
-        if (!function_context_stack_.empty())
-        {
-            FunctionContext fun = function_context_stack_.top();
-            if (fun.VariableInLocalScope(name))
-            {
-                return true;
-            }
-        }
-        if (global_variable_table_.find(name) != global_variable_table_.end())
-        {
-            return false;
-        }
-        else
+    void Context::AddFunctionInfo(SymbolId name, const std::vector<ParamInfo> &params, const TypeSpecifier returnType)
+    {
+        if (FindFunction(name) != nullptr)
         {
-            throw std::runtime_error("Variable not found");
+            throw std::runtime_error("Function already declared");
         }
+        FunctionInfo fun = {name, params, returnType};
+        Declarations().AddFunction(fun);
     }
 
     bool Context::InGlobalScope() const
@@ -112,50 +81,59 @@ namespace ast
         return function_context_stack_.empty();
     }
 
-    FunctionInfo Context::GetFunctionInfo(const std::string &name) const
+    FunctionInfo Context::GetFunctionInfo(SymbolId name) const
     {
-        if (function_info_table_.find(name) != function_info_table_.end())
-        {
-            return function_info_table_.at(name);
-        }
-        else
+        const FunctionInfo *fun = FindFunction(name);
+        if (fun == nullptr)
         {
             throw std::runtime_error("Function not found");
         }
+        return *fun;
     }
 
-    GlobalVariable Context::GetGlobalVariableInfo(const std::string &name) const
+    const FunctionInfo *Context::FindFunction(SymbolId name) const
     {
-        if (global_variable_table_.find(name) != global_variable_table_.end())
+        const FunctionInfo *fun = locals_.FindFunction(name);
+        if (fun != nullptr)
         {
-            return global_variable_table_.at(name);
-        }
-        else
-        {
-            throw std::runtime_error("Global variable not found");
+            return fun;
         }
+        fun = globals_.FindFunction(name);
+        // a function declared later in the file isn't in scope yet
+        return (fun != nullptr && fun->order < visible_functions_) ? fun : nullptr;
+    }
+
+    const GlobalVariable *Context::FindGlobalVariable(SymbolId name) const
+    {
+        const GlobalVariable *var = locals_.FindVariable(name);
+        return (var != nullptr) ? var : globals_.FindVariable(name);
     }
 
-    int Context::AddFloatLiteralConstant(double value, TypeSpecifier type)
+    std::string Context::AddFloatLiteralConstant(double value, TypeSpecifier type)
     {
         LiteralConstant lc = {value, "", type};
         literal_constants_.push_back(lc);
-        return (literal_constants_.size() - 1);
+        return GetLiteralLabel(literal_constants_.size() - 1);
     }
 
-    int Context::AddStringLiteralConstant(std::string s)
+    std::string Context::AddStringLiteralConstant(std::string s)
     {
         LiteralConstant lc = {0, s, TypeSpecifier::STRING};
         literal_constants_.push_back(lc);
-        return (literal_constants_.size() - 1);
+        return GetLiteralLabel(literal_constants_.size() - 1);
     }
 
-    std::vector<LiteralConstant> Context::GetLiteralConstants() const
+    const std::vector<LiteralConstant> &Context::GetLiteralConstants() const
     {
         return literal_constants_;
     }
 
-    void Context::CreateNewFunctionScope(const std::string &funcID)
+    std::string Context::GetLiteralLabel(size_t index) const
+    {
+        return label_prefix_ + "LC" + std::to_string(index);
+    }
+
+    void Context::CreateNewFunctionScope(SymbolId funcID)
     {
         function_context_stack_.push(FunctionContext(funcID));
     }
@@ -176,46 +154,55 @@ namespace ast
 
     int Context::AssignRegister(TypeSpecifier type)
     {
-        if (unused_registers_.empty())
+        if (unused_registers_ == 0)
         {
             throw std::out_of_range("Out of usable registers");
         }
-        for (auto it = unused_registers_.begin(); it != unused_registers_.end(); ++it)
+        RegisterMask candidates = 0;
+        if (type == TypeSpecifier::INT || type == TypeSpecifier::CHAR || type == TypeSpecifier::VOID || type == TypeSpecifier::UNSIGNED)
         {
-            int reg = *it;
-            if ((type == TypeSpecifier::INT || type == TypeSpecifier::CHAR || type == TypeSpecifier::VOID || type == TypeSpecifier::UNSIGNED) && reg < START_FLOAT_REGISTER)
-            {
-                unused_registers_.erase(reg);
-                used_registers_.insert(reg);
-                return reg;
-            }
-            else if ((type == TypeSpecifier::FLOAT || type == TypeSpecifier::DOUBLE) && reg >= START_FLOAT_REGISTER)
-            {
-                unused_registers_.erase(reg);
-                used_registers_.insert(reg);
-                return reg;
-            }
+            candidates = unused_registers_ & INT_REGISTER_MASK;
+        }
+        else if (type == TypeSpecifier::FLOAT || type == TypeSpecifier::DOUBLE)
+        {
+            candidates = unused_registers_ & FLOAT_REGISTER_MASK;
+        }
+        if (candidates == 0)
+        {
+            throw std::out_of_range("Out of usable registers or register type mismatch");
         }
-        throw std::out_of_range("Out of usable registers or register type mismatch");
+        // lowest free register of the class, as the ordered set used to hand out
+        int reg = std::countr_zero(candidates);
+        RegisterMask bit = RegisterMask(1) << reg;
+        unused_registers_ &= ~bit;
+        used_registers_ |= bit;
+        dead_registers_ &= ~bit;
+        single_registers_ = (type == TypeSpecifier::FLOAT) ? (single_registers_ | bit) : (single_registers_ & ~bit);
+        return reg;
     }
 
-    void Context::UseRegister(const std::string reg_name)
+    void Context::UseRegister(const Reg reg, const TypeSpecifier type)
     {
-        int reg = register_map_.at(reg_name);
-        if (used_registers_.find(reg) != used_registers_.end())
+        RegisterMask bit = RegisterMask(1) << static_cast<int>(reg);
+        if ((used_registers_ & bit) != 0)
         {
-            throw std::runtime_error("Register " + reg_name + " already in use");
+            throw std::runtime_error("Register " + std::string(RegisterName(reg)) + " already in use");
         }
-        used_registers_.insert(reg);
-        unused_registers_.erase(reg);
+        used_registers_ |= bit;
+        unused_registers_ &= ~bit;
+        dead_registers_ &= ~bit;
+        single_registers_ = (type == TypeSpecifier::FLOAT) ? (single_registers_ | bit) : (single_registers_ & ~bit);
     }
 
     void Context::FreeRegister(const int reg)
     {
         if (reg >= START_SINGLE_REGISTER && reg < N_REGISTERS)
         {
-            unused_registers_.insert(reg);
-            used_registers_.erase(reg);
+            RegisterMask bit = RegisterMask(1) << reg;
+            unused_registers_ |= bit;
+            used_registers_ &= ~bit;
+            dead_registers_ &= ~bit;
+            single_registers_ &= ~bit;
         }
         else
         {
@@ -223,40 +210,54 @@ namespace ast
         }
     }
 
-    void Context::FreeRegister(const std::string reg_name)
+    void Context::FreeRegister(const Reg reg)
     {
-        int reg = register_map_.at(reg_name);
-        FreeRegister(reg);
+        FreeRegister(static_cast<int>(reg));
     }
 
-    const std::set<int> Context::GetUsedRegisters() const
+    void Context::SetRegisterDead(const int reg, const bool dead)
     {
-        return used_registers_;
+        RegisterMask bit = RegisterMask(1) << reg;
+        if (reg < START_SINGLE_REGISTER || reg >= N_REGISTERS || (used_registers_ & bit) == 0)
+        {
+            throw std::runtime_error("SetRegisterDead: register i" + std::to_string(reg) + " not in use");
+        }
+        dead_registers_ = dead ? (dead_registers_ | bit) : (dead_registers_ & ~bit);
     }
 
-    std::string Context::GenerateUniqueLabel(const std::string &labelID)
+    bool Context::DeferRegister(const int reg)
     {
-        static int label_counter_ = 0;
-        return "." + labelID + std::to_string(label_counter_++);
-        // TODO: Test with multiple ifs in a function
+        if (reg < START_SINGLE_REGISTER || reg >= N_REGISTERS || ((GetLiveRegisters() >> reg) & 1) == 0)
+        {
+            return false;
+        }
+        SetRegisterDead(reg, true);
+        return true;
     }
 
-    std::string Context::GetRegString(const int reg) const
+    TypeSpecifier Context::GetRegisterType(const Reg reg) const
     {
-        if (reg < 0 || reg >= N_REGISTERS)
+        if (!IsFloatRegister(reg))
         {
-            throw std::runtime_error("Register " + std::to_string(reg) + " not found");
+            return TypeSpecifier::INT;
         }
-        return registers[reg];
+        // float registers of unknown width are saved whole
+        return ((single_registers_ >> static_cast<int>(reg)) & 1) ? TypeSpecifier::FLOAT : TypeSpecifier::DOUBLE;
     }
 
-    int Context::GetRegIndex(const std::string &reg_name) const
+    std::string Context::GenerateUniqueLabel(const std::string &labelID)
+    {
+        // labels are numbered per function, so functions can be generated independently
+        return label_prefix_ + labelID + std::to_string(label_counter_++);
+    }
+
+    std::string_view Context::GetRegString(const int reg) const
     {
-        if (register_map_.find(reg_name) == register_map_.end())
+        if (reg < 0 || reg >= N_REGISTERS)
         {
-            throw std::runtime_error("Register " + reg_name + " not found");
+            throw std::runtime_error("Register " + std::to_string(reg) + " not found");
         }
-        return register_map_.at(reg_name);
+        return REGISTER_NAMES[reg];
     }
 
     void Context::NewLoopContext(ControlFlowType type, const std::string &start_label, const std::string &end_label, const std::string &update_label)
@@ -296,85 +297,37 @@ namespace ast
         return GetCurrentLoopContext().update_label;
     }
 
-    void Context::AddEnum(const std::string &name, const int value)
+    void Context::AddGlobalArray(SymbolId name, int size, TypeSpecifier type)
     {
-        enum_table_[name] = value;
-        std::cerr << "Added enum: " << name << " = " << value << std::endl;
-    }
-
-    bool Context::InEnum(const std::string &name) const
-    {
-        return enum_table_.find(name) != enum_table_.end();
-    }
-
-    int Context::GetEnumValue(const std::string &name) const
-    {
-        auto it = enum_table_.find(name);
-        if (it != enum_table_.end())
-        {
-            return it->second;
-        }
-        // Handle error case - enum not found
-        // This should never happen if you check with InEnum first
-        return 0;
-    }
-
-    void Context::AddGlobalArray(const std::string &name, int size, TypeSpecifier type)
-    {
-        if (global_variable_table_.find(name) != global_variable_table_.end())
+        if (FindGlobalVariable(name) != nullptr)
         {
             throw std::runtime_error("Global array already declared");
         }
         GlobalVariable array = {name, type, false, 0, true, size};
-        global_variable_table_[name] = array;
-    }
-
-    int Context::GetPointerOffset(const std::string &name, int my_pointer_depth)
-    {
-        // TODO: add pointer to struct lmaooo
-        int pointer_depth;
-        TypeSpecifier type;
-        if (VariableIsLocal(name))
-        {
-            pointer_depth = GetCurrentFunctionContext().GetFunctionVariableInfo(name).pointer_depth;
-            type = GetCurrentFunctionContext().GetFunctionVariableInfo(name).type;
-        }
-        else
-        {
-            pointer_depth = GetGlobalVariableInfo(name).pointer_depth;
-            type = GetGlobalVariableInfo(name).type;
-        }
-        // if child is a pointer to a pointer, we default to shifting by 4
-        if (my_pointer_depth + 1 < pointer_depth)
-        {
-            return GetTypeSize(TypeSpecifier::INT);
-        }
-        return GetTypeSize(type);
+        Declarations().AddVariable(array);
     }
 
     std::ostringstream Context::PrintContext() const
     {
         std::ostringstream buffer;
-        buffer << "Global Variables: " << std::endl;
-        for (auto const &var : global_variable_table_)
+        buffer << "Global Variables: " << "\n";
+        globals_.PrintVariables(buffer);
+        locals_.PrintVariables(buffer);
+        buffer << "Unused Registers: " << "\n";
+        for (RegisterMask unused = unused_registers_; unused != 0; unused &= unused - 1)
         {
-            buffer << var.first << " : " << var.second.type << std::endl;
+            buffer << std::countr_zero(unused) << ", ";
         }
-        buffer << "Unused Registers: " << std::endl;
-        for (auto const &reg : unused_registers_)
-        {
-            buffer << reg << ", ";
-        }
-        buffer << std::endl
-               << std::endl;
+        buffer << "\n"
+               << "\n";
 
-        buffer << "Literal Constants: " << std::endl;
+        buffer << "Literal Constants: " << "\n";
         for (auto const &lc : literal_constants_)
         {
-            buffer << lc.value << " : " << lc.type << std::endl;
+            buffer << lc.value << " : " << lc.type << "\n";
         }
-        buffer << std::endl
-               << std::endl;
+        buffer << "\n"
+               << "\n";
 
         if (!function_context_stack_.empty())
         {
@@ -383,47 +336,67 @@ namespace ast
         return buffer;
     }
 
+    // ----------  GLOBAL CONTEXT  ------------------
+    const GlobalVariable *GlobalContext::FindVariable(SymbolId name) const
+    {
+        auto it = global_variable_table_.find(name);
+        return (it == global_variable_table_.end()) ? nullptr : &it->second;
+    }
+
+    const FunctionInfo *GlobalContext::FindFunction(SymbolId name) const
+    {
+        auto it = function_info_table_.find(name);
+        return (it == function_info_table_.end()) ? nullptr : &it->second;
+    }
+
+    void GlobalContext::PrintVariables(std::ostream &stream) const
+    {
+        for (auto const &var : global_variable_table_)
+        {
+            stream << var.first << " : " << var.second.type << "\n";
+        }
+    }
+
     // ----------  FUNCTION CONTEXT  ------------------
     std::string FunctionContext::GetName() const
     {
-        return name_;
+        return Spelling(name_);
     }
 
     std::string FunctionContext::GetEndLabel() const
     {
-        return "." + name_ + "_func_end";
+        return "." + Spelling(name_) + "_func_end";
     }
 
     void FunctionContext::EnterScope()
     {
-        Scope new_frame;
-        new_frame.scope_pointer_ = stack_pointer_offset_; // save pointer location
-        variable_table_stack_.push(new_frame);            // push new frame to stack (similar to protected access)
+        scope_pointer_stack_.push_back(stack_pointer_offset_); // save pointer location
+        variable_table_.EnterScope();
     }
 
     void FunctionContext::ExitScope()
     {
-        if (variable_table_stack_.size() <= 1)
+        if (variable_table_.Depth() <= 1)
         {
             throw std::runtime_error("Cannot exit the outermost scope");
         }
-        Scope last_frame = variable_table_stack_.top(); // get the top frame (current scope/inner most scope)
-        variable_table_stack_.pop();
-        stack_pointer_offset_ = last_frame.scope_pointer_;
+        variable_table_.ExitScope(); // drops the variables of the innermost scope, unshadowing outer ones
+        // call save slots outlive the scope they were made in, later call sites reuse them
+        stack_pointer_offset_ = std::min(scope_pointer_stack_.back(), call_save_floor_);
+        scope_pointer_stack_.pop_back();
     }
 
-    void FunctionContext::AddFunctionVariable(const std::string &name, const TypeSpecifier type, const bool is_pointer, const int pointer_depth)
+    int FunctionContext::AddFunctionVariable(SymbolId name, const TypeSpecifier type, const bool is_pointer, const int pointer_depth)
     {
-        Scope &current_frame = variable_table_stack_.top();
-        auto &variables = current_frame.variable_table_;
-        // check if variable already exists in the table
-        if (variables.find(name) != variables.end())
+        // check if variable already exists in the current scope
+        if (const FunctionVariable *existing = variable_table_.FindInCurrentScope(name))
         {
-            if (name[0] == RESERVED_VARIABLE_PREFIX[0])
+            const std::string &spelling = Spelling(name);
+            if (spelling[0] == RESERVED_VARIABLE_PREFIX[0])
             {
-                return;
+                return existing->offset;
             }
-            throw std::runtime_error("Variable " + name + " already declared in function context");
+            throw std::runtime_error("Variable " + spelling + " already declared in function context");
         }
 
         if (!is_pointer)
@@ -442,12 +415,12 @@ namespace ast
 
         // Initialize ALL struct fields
         FunctionVariable var = {name, type, is_pointer, pointer_depth, stack_pointer_offset_, false, 0};
-        variables[name] = var;
+        variable_table_.Insert(name, var);
+        return stack_pointer_offset_;
     }
 
-    void FunctionContext::AddArray(const std::string &name, int size, TypeSpecifier type)
+    int FunctionContext::AddArray(SymbolId name, int size, TypeSpecifier type)
     {
-        Scope &current_scope = variable_table_stack_.top();
         int element_size = GetTypeSize(type);
         int total_size = size * element_size;
 
@@ -456,22 +429,14 @@ namespace ast
         int off = WORD_SIZE - (total_size % WORD_SIZE);
         stack_pointer_offset_ -= off;
 
-        current_scope.variable_table_[name] = {
-            .name = name,
-            .type = type,
-            .is_pointer = false,
-            .pointer_depth = 0,
-            .offset = stack_pointer_offset_,
-            .is_array = true,
-            .array_size = size};
-
         // use while loop because array can grow much larger than stack size
         while (stack_pointer_offset_ + stack_size_ <= 0)
         {
             stack_size_ *= 2; // double stack size when it's full
         }
         FunctionVariable var = {name, type, false, 0, stack_pointer_offset_, true, size};
-        current_scope.variable_table_[name] = var;
+        variable_table_.Insert(name, var);
+        return stack_pointer_offset_;
     }
 
     void FunctionContext::AllocateStackSpaceForParams(const std::vector<ParamInfo> param_infos)
@@ -542,76 +507,60 @@ namespace ast
         }
     }
 
-    void FunctionContext::AcceptParamFromStack(const std::string &name, const TypeSpecifier type, const bool is_pointer, const int pointer_depth, const int offset)
+    void FunctionContext::AcceptParamFromStack(SymbolId name, const TypeSpecifier type, const bool is_pointer, const int pointer_depth, const int offset)
     {
-        Scope &current_frame = variable_table_stack_.top();
         // TODO accept array params; for now, assume no array params
         FunctionVariable var = {name, type, is_pointer, pointer_depth, offset, false, 0};
-        current_frame.variable_table_[name] = var;
+        variable_table_.Insert(name, var);
     }
 
-    bool FunctionContext::VariableInLocalScope(const std::string &name) const
+    const FunctionVariable *FunctionContext::FindVariable(SymbolId name) const
     {
-        std::stack<Scope> temp_stack = variable_table_stack_;
-        while (!temp_stack.empty())
-        {
-            if (temp_stack.top().variable_table_.find(name) !=
-                temp_stack.top().variable_table_.end())
-            {
-                return true;
-            }
-            temp_stack.pop();
-        }
-        return false;
+        return variable_table_.Find(name);
     }
 
-    FunctionVariable FunctionContext::GetFunctionVariableInfo(const std::string &name) const
+    int FunctionContext::GetStackSize() const
     {
-        std::stack<Scope> temp_stack = variable_table_stack_;
-        while (!temp_stack.empty())
+        return stack_size_;
+    }
+
+    int FunctionContext::AcquireCallSaveSlot()
+    {
+        if (call_save_depth_ == call_save_slots_.size())
         {
-            const auto &frame = temp_stack.top();
-            if (frame.variable_table_.count(name))
+            // 8-byte aligned, for doubles
+            stack_pointer_offset_ = (stack_pointer_offset_ - GetTypeSizeForStack(TypeSpecifier::DOUBLE)) & ~7;
+            while (stack_pointer_offset_ + stack_size_ <= 0)
             {
-                return frame.variable_table_.at(name);
+                stack_size_ *= 2; // double stack size when it's full
             }
-            temp_stack.pop();
+            call_save_slots_.push_back(stack_pointer_offset_);
+            call_save_floor_ = stack_pointer_offset_;
         }
-        return FunctionVariable();
+        return call_save_slots_[call_save_depth_++];
     }
 
-    int FunctionContext::GetStackSize() const
+    void FunctionContext::ReleaseCallSaveSlots(const size_t count)
     {
-        return stack_size_;
+        if (count > call_save_depth_)
+        {
+            throw std::runtime_error("ReleaseCallSaveSlots: more slots released than acquired");
+        }
+        call_save_depth_ -= count;
     }
 
     void FunctionContext::PrintFunctionContext(std::ostream &stream) const
     {
-        stream << "FunctionContext: " << std::endl;
-        stream << "Name: " << name_ << std::endl;
-        stream << "Stack Pointer Offset: " << stack_pointer_offset_ << std::endl;
-        stream << "Stack Size: " << stack_size_ << std::endl;
-        stream << "Variable Table {" << std::endl;
+        stream << "FunctionContext: " << "\n";
+        stream << "Name: " << name_ << "\n";
+        stream << "Stack Pointer Offset: " << stack_pointer_offset_ << "\n";
+        stream << "Stack Size: " << stack_size_ << "\n";
+        stream << "Variable Table {" << "\n";
 
-        std::stack<Scope> temp_stack = variable_table_stack_;
-        std::vector<Scope> frames;
-
-        while (!temp_stack.empty())
-        {
-            frames.push_back(temp_stack.top());
-            temp_stack.pop();
-        }
-
-        std::reverse(frames.begin(), frames.end()); // set outer scope to be at the top of the stack
-
-        for (auto const &frame : frames)
-        {
-            for (auto const &pair : frame.variable_table_)
-            {
-                stream << pair.first << " : " << pair.second.type << " : " << pair.second.offset << std::endl;
-            }
-        }
-        stream << "}" << std::endl;
+        // outer scopes are printed first
+        variable_table_.ForEach([&stream](SymbolId name, const FunctionVariable &var)
+                                { stream << name << " : " << var.type << " : " << var.offset << "\n"; });
+        stream << "}" << "\n";
     }
 
 } // namespace ast
@@ -1,42 +1,50 @@
 #include "ast_declaration.hpp"
+#include "ast_init_declarator.hpp"
+#include "ast_resolver.hpp"
+#include "ast_lowering.hpp"
 #include <unordered_map>
 
 namespace ast
 {
-    void Declaration::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void Declaration::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         (void)type;
         (void)destReg; // destReg is invalid. It's a trap!
         // only function definition and this case ignore destReg entirely.
+        // array sizes are constant expressions, evaluated here rather than in Resolve so that
+        // they can use enumerators declared before them
         const NodeList &node_list = dynamic_cast<const NodeList &>(*declarator_list_);
         if (context.InGlobalScope())
         {
-            for (const auto &node : node_list)
+            for (size_t i = 0; i < bindings_.size(); i++)
             {
+                const Binding &binding = bindings_[i];
                 // NB: this also adds functions to the variable table.
                 // This is fine because global names are unique anyway.
                 // this should be fine with strings
-                if (node->IsArray())
+                if (binding.is_array)
                 {
-                    context.AddGlobalArray(node->GetID(), node->GetArraySize(context), declaration_specifiers_);
+                    context.AddGlobalArray(binding.name, node_list[i]->GetArraySize(context), binding.type);
                 }
                 else
                 {
-                    context.AddGlobalVariable(node->GetID(), declaration_specifiers_, node->IsPointer(context, false), node->GetPointerDepth());
+                    context.AddGlobalVariable(binding.name, binding.type, binding.is_pointer, binding.pointer_depth);
                 }
             }
         }
         else
         {
-            for (const auto &node : node_list)
+            FunctionContext &function_context = context.GetCurrentFunctionContext();
+            for (size_t i = 0; i < bindings_.size(); i++)
             {
-                if (node->IsArray())
+                Binding &binding = bindings_[i];
+                if (binding.is_array)
                 {
-                    context.GetCurrentFunctionContext().AddArray(node->GetID(), node->GetArraySize(context), declaration_specifiers_);
+                    binding.offset = function_context.AddArray(binding.name, node_list[i]->GetArraySize(context), binding.type);
                 }
                 else
                 {
-                    context.GetCurrentFunctionContext().AddFunctionVariable(node->GetID(), declaration_specifiers_, node->IsPointer(context, false), node->GetPointerDepth());
+                    binding.offset = function_context.AddFunctionVariable(binding.name, binding.type, binding.is_pointer, binding.pointer_depth);
                 }
             }
         }
@@ -45,11 +53,64 @@ namespace ast
         context.FreeRegister(srcReg);
     }
 
+    void Declaration::Resolve(Resolver &resolver) const
+    {
+        const NodeList &node_list = dynamic_cast<const NodeList &>(*declarator_list_);
+        Context &context = resolver.GetContext();
+        Binding::Kind kind = resolver.InFunction() ? Binding::Kind::LOCAL : Binding::Kind::GLOBAL;
+        bindings_.clear();
+        for (const auto &node : node_list)
+        {
+            Binding binding = {.kind = kind, .name = node->GetID(), .type = declaration_specifiers_};
+            if (node->IsArray())
+            {
+                binding.is_array = true;
+            }
+            else
+            {
+                binding.is_pointer = node->IsPointer(context, false);
+                binding.pointer_depth = node->GetPointerDepth();
+            }
+            bindings_.push_back(binding);
+        }
+
+        // declared before any initializer is resolved, as EmitRISC adds them before generating any
+        for (const Binding &binding : bindings_)
+        {
+            resolver.Declare(binding);
+        }
+        declarator_list_->Resolve(resolver);
+    }
+
     void Declaration::Print(std::ostream &stream) const
     {
         stream << declaration_specifiers_ << " ";
         declarator_list_->Print(stream);
         // TODO: this is a big bugged because we don't print commas currently
-        stream << ";" << std::endl;
+        stream << ";" << "\n";
+    }
+
+    LoweredValue Declaration::Lower(Lowering &lowering) const
+    {
+        // every declarator gets its slot before any initializer runs, as in EmitRISC
+        const NodeList &node_list = dynamic_cast<const NodeList &>(*declarator_list_);
+        for (size_t i = 0; i < bindings_.size(); i++)
+        {
+            if (node_list[i]->IsFunction())
+            {
+                dynamic_cast<const InitDeclarator &>(*node_list[i]).StoreFunctionInfo(declaration_specifiers_, lowering.GetContext());
+                continue;
+            }
+            const Binding &binding = bindings_[i];
+            lowering.DeclareLocal(binding, binding.is_array ? node_list[i]->GetArraySize(lowering.GetContext()) : -1);
+        }
+        for (const auto &node : node_list)
+        {
+            if (!node->IsFunction())
+            {
+                node->Lower(lowering);
+            }
+        }
+        return {};
     }
 }
@@ -1,11 +1,13 @@
 #include "ast_direct_declarator.hpp"
 #include "ast_function_call.hpp"
+#include "ast_resolver.hpp"
+#include "ast_lowering.hpp"
 
 namespace ast
 {
 
     // ONLY CALLED DURING FUNCTION DEFINITION
-    void DirectDeclarator::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void DirectDeclarator::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         (void)destReg;
         (void)type;
@@ -15,18 +17,16 @@ namespace ast
             int single_reg_index = 0;
             int float_reg_index = 0;
             int stack_offset = 0;
-            std::vector<ParamInfo> param_infos = parameter_list_->GetParams(context);
-            for (auto &param : param_infos)
+            for (Binding &param : parameters_)
             {
-                std::vector<std::string> registers_passed;
+                std::vector<Reg> registers_passed;
                 TypeSpecifier param_type = param.type;
                 param_type = param.is_pointer ? TypeSpecifier::INT : param_type; // if it's a pointer, treat it as an int
 
                 // if we can retrieve from 'fa' registers
                 if ((param_type == TypeSpecifier::FLOAT || param_type == TypeSpecifier::DOUBLE) && float_reg_index < MAX_REGISTER_PARAM)
                 {
-                    std::string register_passed = "fa" + std::to_string(float_reg_index);
-                    registers_passed.push_back(register_passed);
+                    registers_passed.push_back(FLOAT_ARGUMENT_REGISTERS[float_reg_index]);
                     float_reg_index++;
                 }
 
@@ -41,8 +41,7 @@ namespace ast
                     }
                     for (int i = 0; i < count; i++)
                     {
-                        std::string register_passed = "a" + std::to_string(single_reg_index);
-                        registers_passed.push_back(register_passed);
+                        registers_passed.push_back(INT_ARGUMENT_REGISTERS[single_reg_index]);
                         single_reg_index++;
                     }
                 }
@@ -51,27 +50,29 @@ namespace ast
                 {
                     // literally the worst case, where we pass a double to an 'a' register and memory
                     // we store in on the stack to span across -4(s0) to 3(s0).
-                    if (param_type == TypeSpecifier::DOUBLE && registers_passed.size() == 1 && registers_passed[0][0] == 'a')
+                    if (param_type == TypeSpecifier::DOUBLE && registers_passed.size() == 1 && !IsFloatRegister(registers_passed[0]))
                     {
-                        stream << "sw " << registers_passed[0] << ",-4(s0)" << std::endl; // we saved a space for this worst case double on every stack frame
+                        stream << "sw " << registers_passed[0] << ",-4(s0)" << "\n"; // we saved a space for this worst case double on every stack frame
                         stack_offset += WORD_SIZE;
                         context.GetCurrentFunctionContext().AcceptParamFromStack(param.name, param.type, param.is_pointer, param.pointer_depth, -4);
+                        param.offset = -4;
                     }
                     // normal case where we fully pass into registers
                     else
                     {
-                        context.GetCurrentFunctionContext().AddFunctionVariable(param.name, param.type, param.is_pointer, param.pointer_depth);
+                        int offset = context.GetCurrentFunctionContext().AddFunctionVariable(param.name, param.type, param.is_pointer, param.pointer_depth);
+                        param.offset = offset;
                         int i = 0;
-                        for (auto &register_passed : registers_passed)
+                        for (Reg register_passed : registers_passed)
                         {
                             // need to enforce this because we might be using an 'a' register to pass a float/double
-                            if (register_passed[0] == 'a')
+                            if (!IsFloatRegister(register_passed))
                             {
-                                stream << "sw " << register_passed << "," << context.GetCurrentFunctionContext().GetFunctionVariableInfo(param.name).offset + i * WORD_SIZE << "(s0)" << std::endl;
+                                stream << "sw " << register_passed << "," << offset + i * WORD_SIZE << "(s0)" << "\n";
                             }
                             else
                             {
-                                stream << GetStoreOp(param_type) << " " << register_passed << "," << context.GetCurrentFunctionContext().GetFunctionVariableInfo(param.name).offset + i * WORD_SIZE << "(s0) " << std::endl;
+                                stream << GetStoreOp(param_type) << " " << register_passed << "," << offset + i * WORD_SIZE << "(s0) " << "\n";
                             }
                         }
                     }
@@ -79,12 +80,32 @@ namespace ast
                 else
                 {
                     context.GetCurrentFunctionContext().AcceptParamFromStack(param.name, param.type, param.is_pointer, param.pointer_depth, stack_offset);
+                    param.offset = stack_offset;
                     stack_offset += GetTypeSizeForStack(param.type);
                 }
             }
         }
     }
 
+    // ONLY CALLED DURING FUNCTION DEFINITION
+    void DirectDeclarator::Resolve(Resolver &resolver) const
+    {
+        parameters_.clear();
+        if (parameter_list_ == nullptr)
+        {
+            return;
+        }
+        for (const ParamInfo &param : parameter_list_->GetParams(resolver.GetContext()))
+        {
+            parameters_.push_back({.kind = Binding::Kind::LOCAL, .name = param.name, .type = param.type,
+                                   .is_pointer = param.is_pointer, .pointer_depth = param.pointer_depth});
+        }
+        for (const Binding &param : parameters_)
+        {
+            resolver.Declare(param);
+        }
+    }
+
     void DirectDeclarator::StoreFunctionInfo(TypeSpecifier return_type, Context &context) const
     {
         std::vector<ParamInfo> param_infos;
@@ -107,9 +128,21 @@ namespace ast
         }
     }
 
-    std::string DirectDeclarator::GetID() const
+    SymbolId DirectDeclarator::GetID() const
     {
         return identifier_->GetID();
     }
 
+    // ONLY CALLED DURING FUNCTION DEFINITION
+    LoweredValue DirectDeclarator::Lower(Lowering &lowering) const
+    {
+        // the backend places the incoming arguments in the parameter registers
+        for (const Binding &param : parameters_)
+        {
+            CType type = {.base = param.type, .pointer_depth = param.is_pointer ? param.pointer_depth : 0};
+            ir::VReg reg = lowering.AddParam(type);
+            lowering.Store(lowering.DeclareLocal(param, -1), {reg, type});
+        }
+        return {};
+    }
 } // namespace ast
@@ -1,16 +1,50 @@
 #include "ast_enum.hpp"
 #include <typeinfo>
-#include <any>
 #include "ast_constant.hpp"
+#include "ast_resolver.hpp"
+#include "ast_lowering.hpp"
 
 namespace ast
 {
-    void EnumDeclaration::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void EnumDeclaration::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
+        // enumerators are compile time constants, bound to their values by Resolve
         (void)stream;
+        (void)context;
         (void)destReg;
         (void)type;
+    }
+
+    void EnumDeclaration::Print(std::ostream &stream) const
+    {
+        stream << "enum " << enum_name_ << " {" << "\n";
+        if (enumerators_ == nullptr)
+        {
+            stream << "};" << "\n";
+            return;
+        }
+        if (const NodeList *list = dynamic_cast<const NodeList *>(enumerators_.get()))
+        {
+            for (const auto &enumerator : *list)
+            {
+                const Enumerator *enum_node = dynamic_cast<const Enumerator *>(enumerator.get());
+                if (!enum_node)
+                    continue;
 
+                stream << enum_node->GetName();
+                if (enum_node->GetValue())
+                {
+                    stream << " = ";
+                    enum_node->GetValue()->Print(stream);
+                }
+                stream << "," << "\n";
+            }
+        }
+        stream << "};" << "\n";
+    }
+
+    void EnumDeclaration::Resolve(Resolver &resolver) const
+    {
         if (!enumerators_)
         {
             return;
@@ -31,64 +65,39 @@ namespace ast
             // First check if the value is explicitly defined
             if (enum_node->GetValue())
             {
-                if (const auto *constant = dynamic_cast<const IntConstant *>(enum_node->GetValue().get()))
+                enum_node->GetValue()->Resolve(resolver);
+                ConstValue value = enum_node->GetValue()->Evaluate(resolver.GetContext());
+                if (!value.IsInteger())
                 {
-                    current_val = std::any_cast<int>(constant->GetValue(TypeSpecifier::INT));
+                    throw std::runtime_error("Enumerator value for " + Spelling(enum_node->GetName()) + " is not an integer constant");
                 }
+                current_val = value.AsInt();
             }
 
-            // Add enum to global context
-            context.AddEnum(enum_node->GetName(), current_val);
+            // visible from here to the end of the enclosing function, or everywhere at global scope
+            enum_node->Declare(resolver, current_val);
             current_val++;
         }
     }
 
-    void EnumDeclaration::Print(std::ostream &stream) const
-    {
-        stream << "enum " << enum_name_ << " {" << std::endl;
-        if (enumerators_ == nullptr)
-        {
-            stream << "};" << std::endl;
-            return;
-        }
-        if (const NodeList *list = dynamic_cast<const NodeList *>(enumerators_.get()))
-        {
-            for (const auto &enumerator : *list)
-            {
-                const Enumerator *enum_node = dynamic_cast<const Enumerator *>(enumerator.get());
-                if (!enum_node)
-                    continue;
-
-                stream << enum_node->GetName();
-                if (enum_node->GetValue())
-                {
-                    stream << " = ";
-                    enum_node->GetValue()->Print(stream);
-                }
-                stream << "," << std::endl;
-            }
-        }
-        stream << "};" << std::endl;
-    }
-
-    void Enumerator::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void Enumerator::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         if (value_)
         {
             value_->EmitRISC(stream, context, destReg, type);
         }
-        else if (context.InEnum(name_))
-        {
-            int value = context.GetEnumValue(name_);
-            stream << "    li " << context.GetRegString(destReg) << ", " << value << " # Load enum value " << name_ << std::endl;
-        }
         else
         {
-            stream << "    # WARNING: Enum " << name_ << " not found" << std::endl;
-            stream << "    li " << context.GetRegString(destReg) << ", 0 # Default value" << std::endl;
+            stream << "    li " << context.GetRegString(destReg) << ", " << binding_.value << " # Load enum value " << name_ << "\n";
         }
     }
 
+    void Enumerator::Declare(Resolver &resolver, int value) const
+    {
+        binding_.value = value;
+        resolver.DeclareEnum(binding_);
+    }
+
     void Enumerator::Print(std::ostream &stream) const
     {
         stream << name_;
@@ -98,4 +107,11 @@ namespace ast
             value_->Print(stream);
         }
     }
+
+    LoweredValue EnumDeclaration::Lower(Lowering &lowering) const
+    {
+        // enumerators are constants, bound by Resolve
+        (void)lowering;
+        return {};
+    }
 }
@@ -1,10 +1,11 @@
 #include "ast_for.hpp"
+#include "ast_lowering.hpp"
 #include <ostream>
 
 namespace ast
 {
 
-    void ForStatement::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void ForStatement::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         // Generate unique labels for the for loop
         std::string startLabel = context.GenerateUniqueLabel("start_for");
@@ -18,13 +19,13 @@ namespace ast
             init_assignment_->EmitRISC(stream, context, destReg, type);
         }
 
-        stream << startLabel << ":" << std::endl;
+        stream << startLabel << ":" << "\n";
 
         if (condition_ != nullptr)
         {
             int tmpConditionReg = context.AssignRegister(TypeSpecifier::INT);
             condition_->EmitRISC(stream, context, tmpConditionReg, TypeSpecifier::INT);
-            stream << "beq " << context.GetRegString(tmpConditionReg) << ", zero, " << endLabel << std::endl;
+            stream << "beq " << context.GetRegString(tmpConditionReg) << ", zero, " << endLabel << "\n";
             context.FreeRegister(tmpConditionReg);
         }
 
@@ -33,7 +34,7 @@ namespace ast
             for_body_->EmitRISC(stream, context, destReg, type);
         }
 
-        stream << updateLabel << ":" << std::endl;
+        stream << updateLabel << ":" << "\n";
 
         if (update_assignment_ != nullptr)
         {
@@ -51,13 +52,33 @@ namespace ast
             }
         }
 
-        stream << "j " << startLabel << std::endl;
+        stream << "j " << startLabel << "\n";
 
-        stream << endLabel << ":" << std::endl;
+        stream << endLabel << ":" << "\n";
 
         context.EndLoopContext();
     }
 
+    void ForStatement::Resolve(Resolver &resolver) const
+    {
+        if (init_assignment_ != nullptr)
+        {
+            init_assignment_->Resolve(resolver);
+        }
+        if (condition_ != nullptr)
+        {
+            condition_->Resolve(resolver);
+        }
+        if (update_assignment_ != nullptr)
+        {
+            update_assignment_->Resolve(resolver);
+        }
+        if (for_body_ != nullptr)
+        {
+            for_body_->Resolve(resolver);
+        }
+    }
+
     void ForStatement::Print(std::ostream &stream) const
     {
         stream << "for(";
@@ -66,8 +87,50 @@ namespace ast
         condition_->Print(stream);
         stream << "; ";
         update_assignment_->Print(stream);
-        stream << ") {" << std::endl;
+        stream << ") {" << "\n";
         for_body_->Print(stream);
-        stream << "}" << std::endl;
+        stream << "}" << "\n";
     };
+
+    LoweredValue ForStatement::Lower(Lowering &lowering) const
+    {
+        ir::BlockId condition_block = lowering.NewBlock();
+        ir::BlockId body_block = lowering.NewBlock();
+        ir::BlockId update_block = lowering.NewBlock();
+        ir::BlockId end_block = lowering.NewBlock();
+        if (init_assignment_ != nullptr)
+        {
+            init_assignment_->LowerStatement(lowering);
+        }
+        lowering.Jump(condition_block);
+
+        lowering.SetBlock(condition_block);
+        if (condition_ != nullptr)
+        {
+            lowering.Branch(lowering.Truth(condition_->Lower(lowering)), body_block, end_block);
+        }
+        else
+        {
+            lowering.Jump(body_block);
+        }
+
+        lowering.SetBlock(body_block);
+        lowering.EnterLoop(end_block, update_block);
+        if (for_body_ != nullptr)
+        {
+            for_body_->LowerStatement(lowering);
+        }
+        lowering.ExitLoop();
+        lowering.Jump(update_block);
+
+        lowering.SetBlock(update_block);
+        if (update_assignment_ != nullptr)
+        {
+            update_assignment_->LowerStatement(lowering);
+        }
+        lowering.Jump(condition_block);
+
+        lowering.SetBlock(end_block);
+        return {};
+    }
 }
@@ -1,64 +1,70 @@
 #include "ast_function_call.hpp"
+#include "ast_lowering.hpp"
+#include <bit>
 
 namespace ast
 {
-    std::vector<std::string> SaveUsedRegisters(Context &context, std::ostream &stream)
+    std::vector<SavedRegister> SaveUsedRegisters(Context &context, AsmWriter &stream, int destReg)
     {
-        std::vector<std::string> saved_registers;
-        std::set<int> used_registers_copy = context.GetUsedRegisters();
-        for (const int &reg : used_registers_copy)
+        std::vector<SavedRegister> saved_registers;
+        FunctionContext &function_context = context.GetCurrentFunctionContext();
+        // every allocatable register is caller-saved; registers are freed as they are saved, so walk
+        // the mask as it was on entry
+        for (RegisterMask used = context.GetUsedRegisters(); used != 0; used &= used - 1)
         {
-            std::string register_name = context.GetRegString(reg);
-            saved_registers.push_back(register_name);
-            std::string reserved_name = RESERVED_VARIABLE_PREFIX + register_name;
-            // TODO: we need to dynamically change the stack stored based on type
-            TypeSpecifier type;
-            if (register_name[0] == 'f')
-            {
-                // handle worst case scenario where we have to store a double
-                type = TypeSpecifier::DOUBLE;
-            }
-            else
+            int reg = std::countr_zero(used);
+            Reg saved = static_cast<Reg>(reg);
+            SavedRegister saved_register = {saved, context.GetRegisterType(saved), false, context.IsRegisterDead(saved), 0};
+            if (reg != destReg && !saved_register.dead)
             {
-                type = TypeSpecifier::INT;
+                saved_register.stored = true;
+                saved_register.offset = function_context.AcquireCallSaveSlot();
+                stream << GetStoreOp(saved_register.type) << " " << context.GetRegString(reg) << "," << saved_register.offset << "(s0)" << "\n";
             }
-            context.GetCurrentFunctionContext().AddFunctionVariable(reserved_name, type, false);
-            stream << GetStoreOp(type) << " " << context.GetRegString(reg) << "," << context.GetCurrentFunctionContext().GetFunctionVariableInfo(reserved_name).offset << "(s0)" << std::endl;
+            saved_registers.push_back(saved_register);
             context.FreeRegister(reg);
         }
         return saved_registers;
     }
 
-    void RestoreUsedRegisters(Context &context, std::ostream &stream, const std::vector<std::string> &saved_registers)
+    void RestoreUsedRegisters(Context &context, AsmWriter &stream, const std::vector<SavedRegister> &saved_registers)
     {
-        for (const std::string &register_name : saved_registers)
+        size_t n_slots = 0;
+        for (const SavedRegister &saved : saved_registers)
         {
-            std::string reserved_name = RESERVED_VARIABLE_PREFIX + register_name;
-            TypeSpecifier type;
-            if (register_name[0] == 'f')
+            if (saved.stored)
             {
-                type = TypeSpecifier::DOUBLE;
+                stream << GetLoadOp(saved.type) << " " << saved.reg << "," << saved.offset << "(s0)" << "\n";
+                n_slots++;
             }
-            else
+            context.UseRegister(saved.reg, saved.type);
+            if (saved.dead)
             {
-                type = TypeSpecifier::INT;
+                context.SetRegisterDead(static_cast<int>(saved.reg), true);
             }
-            stream << GetLoadOp(type) << " " << register_name << "," << context.GetCurrentFunctionContext().GetFunctionVariableInfo(reserved_name).offset << "(s0)" << std::endl;
-            context.UseRegister(register_name);
         }
+        context.GetCurrentFunctionContext().ReleaseCallSaveSlots(n_slots);
     }
 
-    void FunctionCall::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void FunctionCall::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
-        std::string function_name = postfix_expression_->GetID();
+        SymbolId function_name = postfix_expression_->GetID();
         FunctionContext &function_context = context.GetCurrentFunctionContext();
-        std::vector<std::string> used_register_vec;
-        std::vector<std::string> param_register_vec;
+        std::vector<Reg> param_register_vec;
         FunctionInfo function_info = context.GetFunctionInfo(function_name);
+        // save used registers
+        std::vector<SavedRegister> used_register_vec = SaveUsedRegisters(context, stream, destReg);
+        // a0 and fa0 bring back the result of a call, so nothing keeps them across one: the arguments
+        // going there are evaluated after the others, which may call
+        struct LastArgument
+        {
+            const Node *node;
+            Reg reg;
+            TypeSpecifier type;
+        };
+        std::vector<LastArgument> last_arguments;
         if (argument_expression_list_ != nullptr)
         {
-            // save used registers
-            used_register_vec = SaveUsedRegisters(context, stream);
             const NodeList &node_list = dynamic_cast<const NodeList &>(*argument_expression_list_);
             function_context.AllocateStackSpaceForParams(function_info.params);
 
@@ -68,7 +74,7 @@ namespace ast
             int stack_offset = 0;
             for (const auto &node : node_list)
             {
-                std::vector<std::string> registers_to_save;
+                std::vector<Reg> registers_to_save;
                 TypeSpecifier param_type = function_info.params[node_i].type;
                 bool is_pointer = function_info.params[node_i].is_pointer;
                 param_type = is_pointer ? TypeSpecifier::INT : param_type;
@@ -76,8 +82,7 @@ namespace ast
                 // check if we can pass float/double in 'fa' registers
                 if ((param_type == TypeSpecifier::FLOAT || param_type == TypeSpecifier::DOUBLE) && float_register_i < MAX_REGISTER_PARAM)
                 {
-                    std::string register_to_save = "fa" + std::to_string(float_register_i);
-                    registers_to_save.push_back(register_to_save);
+                    registers_to_save.push_back(FLOAT_ARGUMENT_REGISTERS[float_register_i]);
                     float_register_i++;
                 }
 
@@ -91,31 +96,30 @@ namespace ast
                     }
                     for (int i = 0; i < count; i++)
                     {
-                        std::string register_to_save = "a" + std::to_string(single_register_i);
-                        registers_to_save.push_back(register_to_save);
+                        registers_to_save.push_back(INT_ARGUMENT_REGISTERS[single_register_i]);
                         single_register_i++;
                     }
                 }
 
                 if (!registers_to_save.empty())
                 {
-                    for (auto &register_to_save : registers_to_save)
+                    for (Reg register_to_save : registers_to_save)
                     {
-                        if (register_to_save[register_to_save.size() - 1] != '0')
+                        if (register_to_save != Reg::A0 && register_to_save != Reg::FA0)
                         {
-                            context.UseRegister(register_to_save); // never add a0 into used registers list
+                            context.UseRegister(register_to_save, IsFloatRegister(register_to_save) ? param_type : TypeSpecifier::INT); // never add a0 into used registers list
                             param_register_vec.push_back(register_to_save);
                         }
                     }
                     // handle case where we are passing a float/double in 'a' registers
                     // we have to store the float/double in memory and load it back into the 'a' registers. What a pain!
-                    if (registers_to_save[0][0] == 'a' && (param_type == TypeSpecifier::FLOAT || param_type == TypeSpecifier::DOUBLE))
+                    if (!IsFloatRegister(registers_to_save[0]) && (param_type == TypeSpecifier::FLOAT || param_type == TypeSpecifier::DOUBLE))
                     {
                         int tmpReg = context.AssignRegister(param_type);
                         node->EmitRISC(stream, context, tmpReg, param_type);
-                        std::string tmp_name = RESERVED_VARIABLE_PREFIX + std::to_string(node_i);
-                        context.GetCurrentFunctionContext().AddFunctionVariable(tmp_name, param_type, false); // we can do this now, because we allocated space for all non 'fa' register floats/doubles
-                        stream << GetStoreOp(param_type) << " " << context.GetRegString(tmpReg) << "," << context.GetCurrentFunctionContext().GetFunctionVariableInfo(tmp_name).offset << "(s0)" << std::endl;
+                        SymbolId tmp_name = Intern(RESERVED_VARIABLE_PREFIX + std::to_string(node_i));
+                        int tmp_offset = context.GetCurrentFunctionContext().AddFunctionVariable(tmp_name, param_type, false); // we can do this now, because we allocated space for all non 'fa' register floats/doubles
+                        stream << GetStoreOp(param_type) << " " << context.GetRegString(tmpReg) << "," << tmp_offset << "(s0)" << "\n";
 
                         // literally the worst possible case where a double is SPLIT between an 'a' register and memory
                         if (param_type == TypeSpecifier::DOUBLE && registers_to_save.size() == 1)
@@ -125,22 +129,26 @@ namespace ast
                                 std::runtime_error("FunctionCall: Stack offset is not 0 when passing split double argument.");
                             }
                             int tmpReg2 = context.AssignRegister(TypeSpecifier::INT);
-                            stream << "lw " << context.GetRegString(tmpReg2) << "," << (context.GetCurrentFunctionContext().GetFunctionVariableInfo(tmp_name).offset + WORD_SIZE) << "(s0)" << std::endl;
-                            stream << "sw " << context.GetRegString(tmpReg2) << "," << "0(sp)" << std::endl;
+                            stream << "lw " << context.GetRegString(tmpReg2) << "," << (tmp_offset + WORD_SIZE) << "(s0)" << "\n";
+                            stream << "sw " << context.GetRegString(tmpReg2) << "," << "0(sp)" << "\n";
                             stack_offset += WORD_SIZE;
                             context.FreeRegister(tmpReg2);
                         }
                         context.FreeRegister(tmpReg);
                         int i = 0;
-                        for (const std::string &register_to_save : registers_to_save)
+                        for (Reg register_to_save : registers_to_save)
                         {
-                            stream << "lw " << register_to_save << "," << context.GetCurrentFunctionContext().GetFunctionVariableInfo(tmp_name).offset + i * WORD_SIZE << "(s0)" << std::endl;
+                            stream << "lw " << register_to_save << "," << tmp_offset + i * WORD_SIZE << "(s0)" << "\n";
                         }
                     }
                     // normal case where we are passing an int/char in 'a' registers or a float/double in 'fa' registers
+                    else if (registers_to_save[0] == Reg::A0 || registers_to_save[0] == Reg::FA0)
+                    {
+                        last_arguments.push_back({node.get(), registers_to_save[0], param_type});
+                    }
                     else
                     {
-                        node->EmitRISC(stream, context, context.GetRegIndex(registers_to_save[0]), param_type);
+                        node->EmitRISC(stream, context, static_cast<int>(registers_to_save[0]), param_type);
                     }
                 }
                 // store the rest of the parameters in memory
@@ -148,17 +156,35 @@ namespace ast
                 {
                     int tempReg = context.AssignRegister(param_type);
                     node->EmitRISC(stream, context, tempReg, param_type);
-                    stream << GetStoreOp(param_type) << " " << context.GetRegString(tempReg) << "," << stack_offset << "(sp)" << std::endl;
+                    stream << GetStoreOp(param_type) << " " << context.GetRegString(tempReg) << "," << stack_offset << "(sp)" << "\n";
                     context.FreeRegister(tempReg);
                     stack_offset += GetTypeSizeForStack(param_type);
                 }
                 node_i++;
             }
         }
-        stream << "call " << function_name << std::endl;
+        // with both a0 and fa0 to fill, the first waits in a call-save slot while the second is evaluated
+        std::vector<SavedRegister> parked;
+        for (size_t i = 0; i < last_arguments.size(); i++)
+        {
+            const LastArgument &argument = last_arguments[i];
+            argument.node->EmitRISC(stream, context, static_cast<int>(argument.reg), argument.type);
+            if (i + 1 < last_arguments.size())
+            {
+                int offset = function_context.AcquireCallSaveSlot();
+                stream << GetStoreOp(argument.type) << " " << argument.reg << "," << offset << "(s0)" << "\n";
+                parked.push_back({argument.reg, argument.type, true, false, offset});
+            }
+        }
+        for (const SavedRegister &argument : parked)
+        {
+            stream << GetLoadOp(argument.type) << " " << argument.reg << "," << argument.offset << "(s0)" << "\n";
+        }
+        function_context.ReleaseCallSaveSlots(parked.size());
+        stream << "call " << function_name << "\n";
 
         // restore all registers to previous state;
-        for (const std::string &param_register : param_register_vec)
+        for (Reg param_register : param_register_vec)
         {
             context.FreeRegister(param_register);
         }
@@ -173,11 +199,64 @@ namespace ast
         // store return value
         if (type == TypeSpecifier::FLOAT || type == TypeSpecifier::DOUBLE)
         {
-            stream << GetMoveOp(type) << " " << context.GetRegString(destReg) << ", fa0" << std::endl;
+            stream << GetMoveOp(type) << " " << context.GetRegString(destReg) << ", fa0" << "\n";
         }
         else
         {
-            stream << "mv " << context.GetRegString(destReg) << ", a0" << std::endl;
+            stream << "mv " << context.GetRegString(destReg) << ", a0" << "\n";
+        }
+    }
+
+    // arguments are converted to the parameter types here; where each goes is up to the backend
+    LoweredValue FunctionCall::Lower(Lowering &lowering) const
+    {
+        SymbolId function_name = postfix_expression_->GetID();
+        FunctionInfo function_info = lowering.GetContext().GetFunctionInfo(function_name);
+        ir::Instr call = {.op = ir::Op::CALL, .callee = function_name};
+        size_t n_args = 0;
+        if (argument_expression_list_ != nullptr)
+        {
+            for (const auto &node : dynamic_cast<const NodeList &>(*argument_expression_list_))
+            {
+                LoweredValue arg = node->Lower(lowering);
+                if (n_args < function_info.params.size())
+                {
+                    const ParamInfo &param = function_info.params[n_args];
+                    arg = lowering.Convert(arg, {.base = param.type, .pointer_depth = param.is_pointer ? param.pointer_depth : 0});
+                }
+                else
+                {
+                    // default argument promotions, e.g. for printf
+                    arg = lowering.Promote(arg);
+                    if (arg.type.IsFloating())
+                    {
+                        arg = lowering.Convert(arg, {.base = TypeSpecifier::DOUBLE});
+                    }
+                }
+                call.args.push_back(arg.reg);
+                n_args++;
+            }
+        }
+        if (n_args < function_info.params.size())
+        {
+            throw std::runtime_error("FunctionCall: too few arguments to " + Spelling(function_name));
+        }
+
+        CType return_type = {.base = function_info.return_type};
+        if (return_type.IsVoid())
+        {
+            lowering.EmitVoid(std::move(call));
+            return {ir::NO_VREG, return_type};
+        }
+        return {lowering.Emit(std::move(call), Lowering::IRType(return_type)), return_type};
+    }
+
+    void FunctionCall::Resolve(Resolver &resolver) const
+    {
+        // the callee is looked up in the function table, not bound
+        if (argument_expression_list_ != nullptr)
+        {
+            argument_expression_list_->Resolve(resolver);
         }
     }
 
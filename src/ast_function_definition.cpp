@@ -1,25 +1,38 @@
 #include "ast_function_definition.hpp"
 #include "ast_direct_declarator.hpp"
 #include "ast_pointer_declarator.hpp"
+#include "ast_resolver.hpp"
+#include "ast_lowering.hpp"
+#include <mutex>
 #include <vector>
-#include <sstream>
 
-std::ostringstream buffer;
+// per thread, as functions may be generated in parallel
+thread_local ast::AsmWriter buffer;
+thread_local ast::Context *context_ptr = nullptr;
 std::terminate_handler defaultTerminate = nullptr;
-ast::Context *context_ptr = nullptr;
 
 namespace ast
 {
-    void customTerminate()
+    void DumpFunctionState(std::ostream &stream)
     {
-        std::cerr << std::endl;
-        std::cerr << "Exception ocurred: Dumping function stream contents:\n";
-        std::cerr << buffer.str() << std::endl; // Dump log stream
-
-        if (context_ptr != nullptr)
+        if (context_ptr == nullptr)
         {
-            std::cerr << context_ptr->PrintContext().str() << std::endl; // Dump context
+            return;
         }
+        stream << std::endl;
+        stream << "Exception ocurred: Dumping function stream contents:\n";
+        stream << buffer.View() << std::endl;                     // Dump log stream
+        stream << context_ptr->PrintContext().str() << std::endl; // Dump context
+    }
+
+    void ClearFunctionState()
+    {
+        context_ptr = nullptr;
+    }
+
+    void customTerminate()
+    {
+        DumpFunctionState(std::cerr);
 
         try
         {
@@ -37,66 +50,97 @@ namespace ast
         std::abort();
     }
 
-    void FunctionDefinition::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void FunctionDefinition::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         context_ptr = &context;
-        buffer.str(""); // clear buffer
+        buffer.Clear(); // clear buffer
         (void)destReg;  // ignore
 
-        std::string function_name_ = declarator_->GetID();
+        SymbolId function_name_ = declarator_->GetID();
 
-        stream << ".text" << std::endl;
-        stream << ".globl " << function_name_ << std::endl;
-        stream << function_name_ << ":" << std::endl;
+        stream.Section(".text");
+        stream.Global(Spelling(function_name_));
+        stream << function_name_ << ":" << "\n";
 
         context.CreateNewFunctionScope(function_name_);
         FunctionContext &function_context = context.GetCurrentFunctionContext();
 
-        // start logging
-        defaultTerminate = std::set_terminate(customTerminate);
+        // start logging (the handler is installed once and reads the state of the failing thread)
+        static std::once_flag terminate_installed;
+        std::call_once(terminate_installed, []
+                       { defaultTerminate = std::set_terminate(customTerminate); });
 
-        // Store function info and handle params being passed
+        // handle params being passed (the function info was stored by Declare)
         if (declarator_->IsPointer(context, false))
         {
-            const PointerDeclarator &pointer_declarator = dynamic_cast<const PointerDeclarator &>(*declarator_);
-            pointer_declarator.StoreFunctionInfo(declaration_specifiers_, context);
             declarator_->EmitRISC(buffer, context, destReg, TypeSpecifier::INT);
         }
         else
         {
-            const DirectDeclarator &func_declarator = dynamic_cast<const DirectDeclarator &>(*declarator_);
-            func_declarator.StoreFunctionInfo(declaration_specifiers_, context);
             declarator_->EmitRISC(buffer, context, destReg, type);
         }
 
         // EmitRISC for the function body
         // if void, then just retrieve a GPR
         int retReg = context.AssignRegister((declaration_specifiers_ == TypeSpecifier::VOID) ? TypeSpecifier::INT : declaration_specifiers_);
+        // only a return statement puts a value in it, right before leaving, so calls elsewhere don't save it
+        context.SetRegisterDead(retReg, true);
 
         // pass void type down to compound:
         // indicate we don't have an expected destreg for any of the statements (except return)
         compound_statement_->EmitRISC(buffer, context, retReg, type);
         context.FreeRegister(retReg);
 
-        buffer << function_context.GetEndLabel() << ":" << std::endl;
+        buffer << function_context.GetEndLabel() << ":" << "\n";
 
         // note that this stack size may be different from the defaultStackSize, as it may have been increased
         // during the function body
-        buffer << "lw ra," << (function_context.GetStackSize() - 2 * WORD_SIZE) << "(sp)" << std::endl;
-        buffer << "lw s0," << (function_context.GetStackSize() - 3 * WORD_SIZE) << "(sp)" << std::endl;
-        buffer << "addi sp,sp," << function_context.GetStackSize() << std::endl;
-        buffer << "ret" << std::endl;
+        buffer << "lw ra," << (function_context.GetStackSize() - 2 * WORD_SIZE) << "(sp)" << "\n";
+        buffer << "lw s0," << (function_context.GetStackSize() - 3 * WORD_SIZE) << "(sp)" << "\n";
+        buffer << "addi sp,sp," << function_context.GetStackSize() << "\n";
+        buffer << "ret" << "\n";
 
         // stream the stack setup
-        stream << "addi sp,sp,-" << function_context.GetStackSize() << std::endl;
-        stream << "sw ra," << (function_context.GetStackSize() - 2 * WORD_SIZE) << "(sp)" << std::endl;
-        stream << "sw s0," << (function_context.GetStackSize() - 3 * WORD_SIZE) << "(sp)" << std::endl;
-        stream << "addi s0,sp," << function_context.GetStackSize() << std::endl;
+        stream << "addi sp,sp,-" << function_context.GetStackSize() << "\n";
+        stream << "sw ra," << (function_context.GetStackSize() - 2 * WORD_SIZE) << "(sp)" << "\n";
+        stream << "sw s0," << (function_context.GetStackSize() - 3 * WORD_SIZE) << "(sp)" << "\n";
+        stream << "addi s0,sp," << function_context.GetStackSize() << "\n";
 
         // stream the rest of the function
-        stream << buffer.str();
+        stream << buffer;
 
         context.DestroyFunctionScope();
+        ClearFunctionState(); // the context does not outlive the function
+    }
+
+    void FunctionDefinition::Declare(Context &context) const
+    {
+        if (declarator_->IsPointer(context, false))
+        {
+            const PointerDeclarator &pointer_declarator = dynamic_cast<const PointerDeclarator &>(*declarator_);
+            pointer_declarator.StoreFunctionInfo(declaration_specifiers_, context);
+        }
+        else
+        {
+            const DirectDeclarator &func_declarator = dynamic_cast<const DirectDeclarator &>(*declarator_);
+            func_declarator.StoreFunctionInfo(declaration_specifiers_, context);
+        }
+    }
+
+    void FunctionDefinition::Resolve(Resolver &resolver) const
+    {
+        resolver.EnterFunction();
+        declarator_->Resolve(resolver); // declares the parameters
+        if (compound_statement_ != nullptr)
+        {
+            compound_statement_->Resolve(resolver);
+        }
+        resolver.ExitFunction();
+    }
+
+    SymbolId FunctionDefinition::GetID() const
+    {
+        return declarator_->GetID();
     }
 
     void FunctionDefinition::Print(std::ostream &stream) const
@@ -104,13 +148,28 @@ namespace ast
         stream << declaration_specifiers_ << " ";
 
         declarator_->Print(stream);
-        stream << "() {" << std::endl;
+        stream << "() {" << "\n";
 
         if (compound_statement_ != nullptr)
         {
             compound_statement_->Print(stream);
         }
-        stream << "}" << std::endl;
+        stream << "}" << "\n";
     }
 
+    LoweredValue FunctionDefinition::Lower(Lowering &lowering) const
+    {
+        CType return_type = {.base = declaration_specifiers_};
+        if (declarator_->IsPointer(lowering.GetContext(), false))
+        {
+            return_type.pointer_depth = declarator_->GetPointerDepth();
+        }
+        lowering.SetReturnType(return_type);
+        declarator_->Lower(lowering); // the parameters
+        if (compound_statement_ != nullptr)
+        {
+            compound_statement_->LowerStatement(lowering);
+        }
+        return {};
+    }
 }
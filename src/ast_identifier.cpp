@@ -1,33 +1,36 @@
 #include "ast_identifier.hpp"
+#include "ast_constant.hpp"
+#include "ast_lowering.hpp"
+#include "ast_resolver.hpp"
 #include <stdexcept>
 
 namespace ast
 {
-    void Identifier::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void Identifier::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
-        if (context.InEnum(identifier_))
+        const Binding &var = RequireBinding(binding_);
+        if (var.kind == Binding::Kind::ENUM)
         {
-            int value = context.GetEnumValue(identifier_);
-            stream << "li " << context.GetRegString(destReg) << ", " << value << std::endl;
+            EmitConstant(stream, context, destReg, type, ConstValue::Int(var.value));
             return;
         }
-        else if (context.VariableIsLocal(identifier_))
+        else if (var.kind == Binding::Kind::LOCAL)
         {
-            type = (IsPointer(context, true)) ? TypeSpecifier::INT : type;
-            int offset = context.GetCurrentFunctionContext().GetFunctionVariableInfo(identifier_).offset;
+            type = (var.is_pointer) ? TypeSpecifier::INT : type;
+            int offset = var.offset;
             switch (type)
             {
             case TypeSpecifier::INT:
-                stream << "lw " << context.GetRegString(destReg) << ", " << offset << "(s0)" << std::endl;
+                stream << "lw " << context.GetRegString(destReg) << ", " << offset << "(s0)" << "\n";
                 break;
             case TypeSpecifier::CHAR:
-                stream << "lbu " << context.GetRegString(destReg) << ", " << offset << "(s0)" << std::endl;
+                stream << "lbu " << context.GetRegString(destReg) << ", " << offset << "(s0)" << "\n";
                 break;
             case TypeSpecifier::FLOAT:
-                stream << "flw " << context.GetRegString(destReg) << ", " << offset << "(s0)" << std::endl;
+                stream << "flw " << context.GetRegString(destReg) << ", " << offset << "(s0)" << "\n";
                 break;
             case TypeSpecifier::DOUBLE:
-                stream << "fld " << context.GetRegString(destReg) << ", " << offset << "(s0)" << std::endl;
+                stream << "fld " << context.GetRegString(destReg) << ", " << offset << "(s0)" << "\n";
                 break;
             default:
                 throw std::runtime_error("Identifier Function: Not all types implemented.");
@@ -36,20 +39,20 @@ namespace ast
         else
         {
             int srcReg = context.AssignRegister(TypeSpecifier::INT);
-            stream << "lui " << context.GetRegString(srcReg) << ", %hi(" << identifier_ << ")" << std::endl;
+            stream << "lui " << context.GetRegString(srcReg) << ", %hi(" << identifier_ << ")" << "\n";
             switch (type)
             {
             case TypeSpecifier::INT:
-                stream << "lw " << context.GetRegString(destReg) << ", %lo(" << identifier_ << ")(" << context.GetRegString(srcReg) << ")" << std::endl;
+                stream << "lw " << context.GetRegString(destReg) << ", %lo(" << identifier_ << ")(" << context.GetRegString(srcReg) << ")" << "\n";
                 break;
             case TypeSpecifier::CHAR:
-                stream << "lbu " << context.GetRegString(destReg) << ", %lo(" << identifier_ << ")(" << context.GetRegString(srcReg) << ")" << std::endl;
+                stream << "lbu " << context.GetRegString(destReg) << ", %lo(" << identifier_ << ")(" << context.GetRegString(srcReg) << ")" << "\n";
                 break;
             case TypeSpecifier::FLOAT:
-                stream << "flw " << context.GetRegString(destReg) << ", %lo(" << identifier_ << ")(" << context.GetRegString(srcReg) << ")" << std::endl;
+                stream << "flw " << context.GetRegString(destReg) << ", %lo(" << identifier_ << ")(" << context.GetRegString(srcReg) << ")" << "\n";
                 break;
             case TypeSpecifier::DOUBLE:
-                stream << "fld " << context.GetRegString(destReg) << ", %lo(" << identifier_ << ")(" << context.GetRegString(srcReg) << ")" << std::endl;
+                stream << "fld " << context.GetRegString(destReg) << ", %lo(" << identifier_ << ")(" << context.GetRegString(srcReg) << ")" << "\n";
                 break;
             default:
                 throw std::runtime_error("Identifier Global: Not all types implemented.");
@@ -58,41 +61,67 @@ namespace ast
         }
     }
 
+    LoweredValue Identifier::Lower(Lowering &lowering) const
+    {
+        const Binding &var = RequireBinding(binding_);
+        if (var.kind == Binding::Kind::ENUM)
+        {
+            return {lowering.Const(var.value), {.base = TypeSpecifier::INT}};
+        }
+        return lowering.Load(lowering.PlaceOf(var));
+    }
+
+    Place Identifier::LowerPlace(Lowering &lowering) const
+    {
+        return lowering.PlaceOf(RequireBinding(binding_));
+    }
+
     void Identifier::Print(std::ostream &stream) const
     {
         stream << identifier_;
     }
 
-    std::string Identifier::GetID() const
+    void Identifier::Resolve(Resolver &resolver) const
+    {
+        binding_ = resolver.Find(identifier_);
+    }
+
+    SymbolId Identifier::GetID() const
     {
         return identifier_;
     }
 
-    TypeSpecifier Identifier::GetType(Context &context) const
+    ConstValue Identifier::Evaluate(Context &context) const
     {
-        if (context.VariableIsLocal(identifier_))
+        (void)context;
+        // of all identifiers, only enumerators are constant expressions
+        const Binding &binding = RequireBinding(binding_);
+        if (binding.kind != Binding::Kind::ENUM)
         {
-            return context.GetCurrentFunctionContext().GetFunctionVariableInfo(identifier_).type;
-        }
-        else
-        {
-            return context.GetGlobalVariableInfo(identifier_).type;
+            throw std::runtime_error("Not a constant expression: " + Spelling(identifier_));
         }
+        return ConstValue::Int(binding.value);
+    }
+
+    bool Identifier::IsConstant(Context &context) const
+    {
+        (void)context;
+        return binding_ != nullptr && binding_->kind == Binding::Kind::ENUM;
+    }
+
+    TypeSpecifier Identifier::GetType(Context &context) const
+    {
+        (void)context;
+        return RequireBinding(binding_).type;
     }
 
     bool Identifier::IsPointer(Context &context, const bool has_been_declared) const
     {
+        (void)context;
         if (!has_been_declared)
         {
             return false;
         }
-        if (context.VariableIsLocal(identifier_))
-        {
-            return context.GetCurrentFunctionContext().GetFunctionVariableInfo(identifier_).is_pointer;
-        }
-        else
-        {
-            return context.GetGlobalVariableInfo(identifier_).is_pointer;
-        }
+        return RequireBinding(binding_).is_pointer;
     }
 }
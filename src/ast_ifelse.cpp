@@ -1,10 +1,11 @@
 #include "ast_ifelse.hpp"
+#include "ast_lowering.hpp"
 #include <ostream>
 
 namespace ast
 {
 
-    void IfStatement::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void IfStatement::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         int tmpConditionReg = context.AssignRegister(TypeSpecifier::INT);
 
@@ -15,11 +16,11 @@ namespace ast
 
         if (elseBody_)
         {
-            stream << "beq " << context.GetRegString(tmpConditionReg) << ", zero, " << elseLabel << std::endl;
+            stream << "beq " << context.GetRegString(tmpConditionReg) << ", zero, " << elseLabel << "\n";
         }
         else
         {
-            stream << "beq " << context.GetRegString(tmpConditionReg) << ", zero, " << endLabel << std::endl;
+            stream << "beq " << context.GetRegString(tmpConditionReg) << ", zero, " << endLabel << "\n";
         }
 
         context.FreeRegister(tmpConditionReg);
@@ -28,29 +29,42 @@ namespace ast
 
         if (elseBody_)
         {
-            stream << "j " << endLabel << std::endl;
-            stream << elseLabel << ":" << std::endl;
+            stream << "j " << endLabel << "\n";
+            stream << elseLabel << ":" << "\n";
             elseBody_->EmitRISC(stream, context, destReg, type);
         }
 
-        stream << endLabel << ":" << std::endl;
+        stream << endLabel << ":" << "\n";
+    }
+
+    void IfStatement::Resolve(Resolver &resolver) const
+    {
+        condition_->Resolve(resolver);
+        if (ifBody_ != nullptr)
+        {
+            ifBody_->Resolve(resolver);
+        }
+        if (elseBody_ != nullptr)
+        {
+            elseBody_->Resolve(resolver);
+        }
     }
 
     void IfStatement::Print(std::ostream &stream) const
     {
         stream << "if(";
         condition_->Print(stream);
-        stream << ") {" << std::endl;
+        stream << ") {" << "\n";
         ifBody_->Print(stream);
         stream << "}";
 
         if (elseBody_)
         {
-            stream << "else {" << std::endl;
+            stream << "else {" << "\n";
             elseBody_->Print(stream);
-            stream << "}" << std::endl;
+            stream << "}" << "\n";
         }
-        stream << std::endl;
+        stream << "\n";
     };
 
     TypeSpecifier IfStatement::GetType(Context &context) const
@@ -58,4 +72,73 @@ namespace ast
         (void)context; // Unused
         return ifBody_->GetType(context);
     }
+
+    void IfStatement::LowerStatement(Lowering &lowering) const
+    {
+        ir::BlockId if_block = lowering.NewBlock();
+        ir::BlockId else_block = lowering.NewBlock();
+        ir::BlockId end_block = lowering.NewBlock();
+        ir::VReg condition = lowering.Truth(condition_->Lower(lowering));
+        lowering.Branch(condition, if_block, elseBody_ ? else_block : end_block);
+
+        lowering.SetBlock(if_block);
+        if (ifBody_ != nullptr)
+        {
+            ifBody_->LowerStatement(lowering);
+        }
+        lowering.Jump(end_block);
+        if (elseBody_)
+        {
+            lowering.SetBlock(else_block);
+            elseBody_->LowerStatement(lowering);
+            lowering.Jump(end_block);
+        }
+        lowering.SetBlock(end_block);
+    }
+
+    LoweredValue IfStatement::Lower(Lowering &lowering) const
+    {
+        if (!ifBody_ || !elseBody_)
+        {
+            Unsupported("conditional expression without two operands");
+        }
+        ir::BlockId if_block = lowering.NewBlock();
+        ir::BlockId else_block = lowering.NewBlock();
+        ir::BlockId end_block = lowering.NewBlock();
+        ir::VReg condition = lowering.Truth(condition_->Lower(lowering));
+        lowering.Branch(condition, if_block, else_block);
+
+        // both operands are lowered before their common type is known, and converted at the end
+        // of their branch
+        lowering.SetBlock(if_block);
+        LoweredValue if_value = lowering.Promote(ifBody_->Lower(lowering));
+        ir::BlockId if_end = lowering.CurrentBlock();
+        lowering.SetBlock(else_block);
+        LoweredValue else_value = lowering.Promote(elseBody_->Lower(lowering));
+        ir::BlockId else_end = lowering.CurrentBlock();
+
+        CType type;
+        if (if_value.type.IsPointer() || else_value.type.IsPointer())
+        {
+            const CType &pointer = if_value.type.IsPointer() ? if_value.type : else_value.type;
+            type = {.base = pointer.base, .pointer_depth = pointer.pointer_depth};
+        }
+        else if (!if_value.type.IsVoid() && !else_value.type.IsVoid())
+        {
+            type = Lowering::CommonType(if_value.type, else_value.type);
+        }
+
+        Place result = type.IsVoid() ? Place{} : lowering.NewTemporary(type);
+        for (auto [block, value] : {std::pair{if_end, if_value}, std::pair{else_end, else_value}})
+        {
+            lowering.SetBlock(block);
+            if (!type.IsVoid())
+            {
+                lowering.Store(result, lowering.Convert(value, type));
+            }
+            lowering.Jump(end_block);
+        }
+        lowering.SetBlock(end_block);
+        return type.IsVoid() ? LoweredValue{} : lowering.Load(result);
+    }
 }
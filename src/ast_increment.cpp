@@ -1,8 +1,14 @@
 #include "ast_increment.hpp"
+#include "ast_lowering.hpp"
 #include "unordered_map"
 
 namespace ast
 {
+    void IncAndDecOp::Resolve(Resolver &resolver) const
+    {
+        expression_->Resolve(resolver);
+    }
+
     std::string IncAndDecOp::GetAddOrSubOp(TypeSpecifier type) const
     {
         if (addi_value_ == "1")
@@ -55,43 +61,67 @@ namespace ast
         return expression_->GetType(context);
     }
 
-    void PostIncAndDecOp::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    LoweredValue IncAndDecOp::LowerUpdate(Lowering &lowering, bool yields_old_value) const
+    {
+        Place place = expression_->LowerPlace(lowering);
+        LoweredValue old_value = lowering.Load(place);
+        LoweredValue one = {lowering.Const(1), {.base = TypeSpecifier::INT}};
+        if (old_value.type.IsFloating())
+        {
+            one = {lowering.FConst(1, Lowering::IRType(old_value.type)), old_value.type};
+        }
+        LoweredValue new_value = lowering.Convert(lowering.Arithmetic(op_symbol_, old_value, one), place.type);
+        lowering.Store(place, new_value);
+        return yields_old_value ? old_value : new_value;
+    }
+
+    LoweredValue PostIncAndDecOp::Lower(Lowering &lowering) const
+    {
+        return LowerUpdate(lowering, true);
+    }
+
+    LoweredValue PreIncAndDecOp::Lower(Lowering &lowering) const
+    {
+        return LowerUpdate(lowering, false);
+    }
+
+    void PostIncAndDecOp::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         // TODO: not sure if this works for array as well
-        std::string expr_name = expression_->GetID();
+        SymbolId expr_name = expression_->GetID();
         int tempReg = context.AssignRegister(type);
         expression_->EmitRISC(stream, context, destReg, type);
 
         if (type == TypeSpecifier::FLOAT || type == TypeSpecifier::DOUBLE)
         {
-            int lc_n = context.AddFloatLiteralConstant(1.0, type);
+            std::string lc_label = context.AddFloatLiteralConstant(1.0, type);
             int srcMemReg = context.AssignRegister(TypeSpecifier::INT);
-            stream << "lui " << context.GetRegString(srcMemReg) << ", %hi(.LC" << lc_n << ")" << std::endl;
-            stream << GetLoadOp(type) << " " << context.GetRegString(tempReg) << ",%lo(.LC" << lc_n << ")(" << context.GetRegString(srcMemReg) << ")" << std::endl;
-            stream << GetAddOrSubOp(type) << " " << context.GetRegString(tempReg) << "," << context.GetRegString(destReg) << "," << context.GetRegString(tempReg) << std::endl;
-            if (context.VariableIsLocal(expr_name))
+            stream << "lui " << context.GetRegString(srcMemReg) << ", %hi(" << lc_label << ")" << "\n";
+            stream << GetLoadOp(type) << " " << context.GetRegString(tempReg) << ",%lo(" << lc_label << ")(" << context.GetRegString(srcMemReg) << ")" << "\n";
+            stream << GetAddOrSubOp(type) << " " << context.GetRegString(tempReg) << "," << context.GetRegString(destReg) << "," << context.GetRegString(tempReg) << "\n";
+            if (const Binding *var = LocalBinding(expression_->GetBinding()))
             {
-                stream << GetStoreOp(type) << " " << context.GetRegString(tempReg) << "," << context.GetCurrentFunctionContext().GetFunctionVariableInfo(expr_name).offset << "(s0)" << std::endl;
+                stream << GetStoreOp(type) << " " << context.GetRegString(tempReg) << "," << var->offset << "(s0)" << "\n";
             }
             else
             {
-                stream << "lui " << context.GetRegString(srcMemReg) << ",%hi(" << expr_name << ")" << std::endl;
-                stream << GetStoreOp(type) << " " << context.GetRegString(tempReg) << ",%lo(" << expr_name << ")(" << context.GetRegString(srcMemReg) << ")" << std::endl;
+                stream << "lui " << context.GetRegString(srcMemReg) << ",%hi(" << expr_name << ")" << "\n";
+                stream << GetStoreOp(type) << " " << context.GetRegString(tempReg) << ",%lo(" << expr_name << ")(" << context.GetRegString(srcMemReg) << ")" << "\n";
             }
             context.FreeRegister(srcMemReg);
         }
         else
         {
-            stream << "addi " << context.GetRegString(tempReg) << "," << context.GetRegString(destReg) << "," << addi_value_ << std::endl;
-            if (context.VariableIsLocal(expr_name))
+            stream << "addi " << context.GetRegString(tempReg) << "," << context.GetRegString(destReg) << "," << addi_value_ << "\n";
+            if (const Binding *var = LocalBinding(expression_->GetBinding()))
             {
-                stream << "sw " << context.GetRegString(tempReg) << "," << context.GetCurrentFunctionContext().GetFunctionVariableInfo(expr_name).offset << "(s0)" << std::endl;
+                stream << "sw " << context.GetRegString(tempReg) << "," << var->offset << "(s0)" << "\n";
             }
             else
             {
                 int tempReg2 = context.AssignRegister(TypeSpecifier::INT);
-                stream << "lui " << context.GetRegString(tempReg2) << ",%hi(" << expr_name << ")" << std::endl;
-                stream << "sw " << context.GetRegString(tempReg) << ",%lo(" << expr_name << ")(" << context.GetRegString(tempReg2) << ")" << std::endl;
+                stream << "lui " << context.GetRegString(tempReg2) << ",%hi(" << expr_name << ")" << "\n";
+                stream << "sw " << context.GetRegString(tempReg) << ",%lo(" << expr_name << ")(" << context.GetRegString(tempReg2) << ")" << "\n";
                 context.FreeRegister(tempReg2);
             }
             context.FreeRegister(tempReg);
@@ -104,42 +134,42 @@ namespace ast
         stream << op_symbol_ << op_symbol_;
     }
 
-    void PreIncAndDecOp::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void PreIncAndDecOp::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
-        std::string expr_name = expression_->GetID();
+        SymbolId expr_name = expression_->GetID();
         expression_->EmitRISC(stream, context, destReg, type);
         if (type == TypeSpecifier::FLOAT || type == TypeSpecifier::DOUBLE)
         {
             int tempReg = context.AssignRegister(type);
-            int lc_n = context.AddFloatLiteralConstant(1.0, type);
+            std::string lc_label = context.AddFloatLiteralConstant(1.0, type);
             int srcMemReg = context.AssignRegister(TypeSpecifier::INT);
-            stream << "lui " << context.GetRegString(srcMemReg) << ", %hi(.LC" << lc_n << ")" << std::endl;
-            stream << GetLoadOp(type) << " " << context.GetRegString(tempReg) << ",%lo(.LC" << lc_n << ")(" << context.GetRegString(srcMemReg) << ")" << std::endl;
-            stream << GetAddOrSubOp(type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "," << context.GetRegString(tempReg) << std::endl;
+            stream << "lui " << context.GetRegString(srcMemReg) << ", %hi(" << lc_label << ")" << "\n";
+            stream << GetLoadOp(type) << " " << context.GetRegString(tempReg) << ",%lo(" << lc_label << ")(" << context.GetRegString(srcMemReg) << ")" << "\n";
+            stream << GetAddOrSubOp(type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "," << context.GetRegString(tempReg) << "\n";
             context.FreeRegister(tempReg);
-            if (context.VariableIsLocal(expr_name))
+            if (const Binding *var = LocalBinding(expression_->GetBinding()))
             {
-                stream << GetStoreOp(type) << " " << context.GetRegString(destReg) << "," << context.GetCurrentFunctionContext().GetFunctionVariableInfo(expr_name).offset << "(s0)" << std::endl;
+                stream << GetStoreOp(type) << " " << context.GetRegString(destReg) << "," << var->offset << "(s0)" << "\n";
             }
             else
             {
-                stream << "lui " << context.GetRegString(srcMemReg) << ",%hi(" << expr_name << ")" << std::endl;
-                stream << GetStoreOp(type) << " " << context.GetRegString(destReg) << ",%lo(" << expr_name << ")(" << context.GetRegString(srcMemReg) << ")" << std::endl;
+                stream << "lui " << context.GetRegString(srcMemReg) << ",%hi(" << expr_name << ")" << "\n";
+                stream << GetStoreOp(type) << " " << context.GetRegString(destReg) << ",%lo(" << expr_name << ")(" << context.GetRegString(srcMemReg) << ")" << "\n";
             }
             context.FreeRegister(srcMemReg);
         }
         else
         {
-            stream << "addi " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "," << addi_value_ << std::endl;
-            if (context.VariableIsLocal(expr_name))
+            stream << "addi " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "," << addi_value_ << "\n";
+            if (const Binding *var = LocalBinding(expression_->GetBinding()))
             {
-                stream << "sw " << context.GetRegString(destReg) << "," << context.GetCurrentFunctionContext().GetFunctionVariableInfo(expr_name).offset << "(s0)" << std::endl;
+                stream << "sw " << context.GetRegString(destReg) << "," << var->offset << "(s0)" << "\n";
             }
             else
             {
                 int tempReg = context.AssignRegister(TypeSpecifier::INT);
-                stream << "lui " << context.GetRegString(tempReg) << ",%hi(" << expr_name << ")" << std::endl;
-                stream << "sw " << context.GetRegString(destReg) << ",%lo(" << expr_name << ")(" << context.GetRegString(tempReg) << ")" << std::endl;
+                stream << "lui " << context.GetRegString(tempReg) << ",%hi(" << expr_name << ")" << "\n";
+                stream << "sw " << context.GetRegString(destReg) << ",%lo(" << expr_name << ")(" << context.GetRegString(tempReg) << ")" << "\n";
                 context.FreeRegister(tempReg);
             }
         }
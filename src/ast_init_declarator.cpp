@@ -1,11 +1,14 @@
 #include "ast_init_declarator.hpp"
 #include "ast_direct_declarator.hpp"
+#include "ast_pointer_declarator.hpp"
+#include "ast_pointer_unary.hpp"
+#include "ast_lowering.hpp"
 #include <typeinfo>
 
 namespace ast
 {
 
-    void InitDeclarator::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void InitDeclarator::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         // we can safely remove functions because they cannot be declared inside functions
         if (declarator_->IsFunction())
@@ -18,24 +21,25 @@ namespace ast
         // update type to int if its a pointer
         type = declarator_->IsPointer(context, true) ? TypeSpecifier::INT : type;
         // handle local
-        if (context.VariableIsLocal(declarator_->GetID()))
+        const Binding &declared = RequireBinding(declarator_->GetBinding());
+        if (declared.kind != Binding::Kind::GLOBAL)
         {
             // assumes that declarator has already been declared
             if (initializer_)
             {
-                int offset = context.GetCurrentFunctionContext().GetFunctionVariableInfo(declarator_->GetID()).offset;
+                int offset = declared.offset;
                 if (declarator_->IsArray())
                 {
                     // handle char[] x = "hello"
                     if (initializer_->GetType(context) == TypeSpecifier::STRING)
                     {
-                        int lc_n = context.AddStringLiteralConstant(initializer_->GetID());
+                        std::string lc_label = context.AddStringLiteralConstant(Spelling(initializer_->GetID()));
                         int indexReg = context.AssignRegister(TypeSpecifier::INT);
-                        stream << "lui " << context.GetRegString(indexReg) << ", %hi(.LC" << lc_n << ")" << std::endl;
-                        stream << "addi " << context.GetRegString(indexReg) << ", " << context.GetRegString(indexReg) << ", %lo(.LC" << lc_n << ")" << std::endl;
+                        stream << "lui " << context.GetRegString(indexReg) << ", %hi(" << lc_label << ")" << "\n";
+                        stream << "addi " << context.GetRegString(indexReg) << ", " << context.GetRegString(indexReg) << ", %lo(" << lc_label << ")" << "\n";
                         for (int i = 0; i < initializer_->GetArraySize(context); i++)
                         {
-                            stream << "lbu " << context.GetRegString(destReg) << ", " << i << "(" << context.GetRegString(indexReg) << ")" << std::endl;
+                            stream << "lbu " << context.GetRegString(destReg) << ", " << i << "(" << context.GetRegString(indexReg) << ")" << "\n";
                             EmitLocalDefinition(stream, context.GetRegString(destReg), offset, type);
                             offset += GetTypeSize(type); // shift by 1 byte not 4
                         }
@@ -71,9 +75,9 @@ namespace ast
         // handle global
         else
         {
-            stream << ".data" << std::endl;
-            stream << ".globl " << declarator_->GetID() << std::endl;
-            stream << declarator_->GetID() << ":" << std::endl;
+            stream.Section(".data");
+            stream.Global(Spelling(declarator_->GetID()));
+            stream << declarator_->GetID() << ":" << "\n";
             if (initializer_)
             {
                 if (declarator_->IsArray())
@@ -82,18 +86,18 @@ namespace ast
                     if (initializer_->GetType(context) == TypeSpecifier::STRING)
                     {
                         // TODO: check if need special case for "", if the array only contains null terminator
-                        EmitGlobalDefinition(stream, std::any(0), TypeSpecifier::STRING, initializer_->GetID());
+                        stream << ".string " << initializer_->GetID() << "\n";
                     }
                     else
                     {
                         const NodeList &node_list = dynamic_cast<const NodeList &>(*initializer_);
                         for (const auto &node : node_list)
                         {
-                            EmitGlobalDefinition(stream, node->GetValue(type), type, "");
+                            EmitGlobalDefinition(stream, node->Evaluate(context), type);
                         }
                         // fill the rest with zeros
                         int undefined_size = GetTypeSize(type) * (declarator_->GetArraySize(context) - node_list.Size());
-                        stream << ".zero " << undefined_size << std::endl;
+                        stream << ".zero " << undefined_size << "\n";
                     }
                 }
                 else
@@ -101,12 +105,17 @@ namespace ast
                     // handle char *x = "hello"
                     if (initializer_->GetType(context) == TypeSpecifier::STRING)
                     {
-                        int lc_n = context.AddStringLiteralConstant(initializer_->GetID());
-                        stream << ".word " << ".LC" << lc_n << std::endl;
+                        std::string lc_label = context.AddStringLiteralConstant(Spelling(initializer_->GetID()));
+                        stream << ".word " << lc_label << "\n";
+                    }
+                    // handle int *p = &x
+                    else if (const auto *address_of = dynamic_cast<const UnaryAddressOp *>(initializer_.get()))
+                    {
+                        stream << ".word " << address_of->GetID() << "\n";
                     }
                     else
                     {
-                        EmitGlobalDefinition(stream, initializer_->GetValue(type), type, initializer_->GetID());
+                        EmitGlobalDefinition(stream, initializer_->Evaluate(context), type);
                     }
                 }
             }
@@ -117,68 +126,61 @@ namespace ast
                 {
                     size *= declarator_->GetArraySize(context);
                 }
-                stream << ".zero " << size << std::endl;
+                stream << ".zero " << size << "\n";
             }
         }
     }
 
-    void InitDeclarator::EmitLocalDefinition(std::ostream &stream, std::string srcRegStr, int offset, TypeSpecifier type) const
+    void InitDeclarator::EmitLocalDefinition(AsmWriter &stream, std::string_view srcRegStr, int offset, TypeSpecifier type) const
     {
         switch (type)
         {
         case TypeSpecifier::CHAR:
-            stream << "sb " << srcRegStr << ", " << offset << "(s0)" << std::endl;
+            stream << "sb " << srcRegStr << ", " << offset << "(s0)" << "\n";
             break;
         case TypeSpecifier::INT:
-            stream << "sw " << srcRegStr << ", " << offset << "(s0)" << std::endl;
+            stream << "sw " << srcRegStr << ", " << offset << "(s0)" << "\n";
             break;
         case TypeSpecifier::FLOAT:
-            stream << "fsw " << srcRegStr << ", " << offset << "(s0)" << std::endl;
+            stream << "fsw " << srcRegStr << ", " << offset << "(s0)" << "\n";
             break;
         case TypeSpecifier::DOUBLE:
-            stream << "fsd " << srcRegStr << ", " << offset << "(s0)" << std::endl;
+            stream << "fsd " << srcRegStr << ", " << offset << "(s0)" << "\n";
             break;
         default:
             std::runtime_error("InitDeclarator: Invalid Type.");
         }
     }
 
-    // id is for handling cases for pointer to global variable
-    void InitDeclarator::EmitGlobalDefinition(std::ostream &stream, std::any value, TypeSpecifier type, std::string id) const
+    // value is converted to type as by assignment
+    void InitDeclarator::EmitGlobalDefinition(AsmWriter &stream, ConstValue value, TypeSpecifier type) const
     {
-        if (type != TypeSpecifier::STRING && !id.empty())
+        switch (type)
+        {
+        case TypeSpecifier::CHAR:
+            stream << ".byte " << (value.AsInt() & 0xff) << "\n";
+            break;
+        case TypeSpecifier::INT:
+            stream << ".word " << value.AsInt() << "\n";
+            break;
+        case TypeSpecifier::UNSIGNED:
+            stream << ".word " << value.AsUnsigned() << "\n";
+            break;
+        case TypeSpecifier::FLOAT:
         {
-            stream << ".word " << id << std::endl;
+            union FloatUnion f_union = {.f = value.AsFloat()};
+            stream << ".word " << f_union.rep << "\n";
+            break;
         }
-        else
+        case TypeSpecifier::DOUBLE:
         {
-            switch (type)
-            {
-            case TypeSpecifier::CHAR:
-                stream << ".byte" << std::any_cast<char>(value) << std::endl;
-                break;
-            case TypeSpecifier::INT:
-                stream << ".word " << std::any_cast<int>(value) << std::endl;
-                break;
-            case TypeSpecifier::FLOAT:
-            {
-                union FloatUnion f_union = {.f = std::any_cast<float>(value)};
-                stream << ".word " << f_union.rep << std::endl;
-                break;
-            }
-            case TypeSpecifier::DOUBLE:
-            {
-                union DoubleUnion d_union = {.d = std::any_cast<double>(value)};
-                stream << ".word " << d_union.reps[0] << std::endl;
-                stream << ".word " << d_union.reps[1] << std::endl;
-                break;
-            }
-            case TypeSpecifier::STRING:
-                stream << ".string " << id << std::endl;
-                break;
-            default:
-                std::runtime_error("InitDeclarator: Invalid Type.");
-            }
+            union DoubleUnion d_union = {.d = value.AsDouble()};
+            stream << ".word " << d_union.reps[0] << "\n";
+            stream << ".word " << d_union.reps[1] << "\n";
+            break;
+        }
+        default:
+            throw std::runtime_error("InitDeclarator: Invalid Type.");
         }
     }
 
@@ -192,11 +194,30 @@ namespace ast
         }
     }
 
-    std::string InitDeclarator::GetID() const
+    void InitDeclarator::Resolve(Resolver &resolver) const
+    {
+        // nothing to bind in a prototype, its parameter names are never used
+        if (declarator_->IsFunction())
+        {
+            return;
+        }
+        declarator_->Resolve(resolver);
+        if (initializer_)
+        {
+            initializer_->Resolve(resolver);
+        }
+    }
+
+    SymbolId InitDeclarator::GetID() const
     {
         return declarator_->GetID();
     }
 
+    const Binding *InitDeclarator::GetBinding() const
+    {
+        return declarator_->GetBinding();
+    }
+
     bool InitDeclarator::IsFunction() const
     {
         return declarator_->IsFunction();
@@ -228,4 +249,66 @@ namespace ast
         }
         return size;
     }
+
+    void InitDeclarator::StoreFunctionInfo(TypeSpecifier return_type, Context &context) const
+    {
+        if (const auto *pointer_declarator = dynamic_cast<const PointerDeclarator *>(declarator_.get()))
+        {
+            pointer_declarator->StoreFunctionInfo(return_type, context);
+            return;
+        }
+        dynamic_cast<const DirectDeclarator &>(*declarator_).StoreFunctionInfo(return_type, context);
+    }
+
+    // locals only: Declaration::Lower has given the declarator its slot
+    LoweredValue InitDeclarator::Lower(Lowering &lowering) const
+    {
+        if (!initializer_)
+        {
+            return {};
+        }
+        Context &context = lowering.GetContext();
+        const Place place = lowering.PlaceOf(RequireBinding(declarator_->GetBinding()));
+        if (!place.type.IsArray())
+        {
+            lowering.Store(place, lowering.Convert(initializer_->Lower(lowering), place.type));
+            return {};
+        }
+
+        const CType element = {.base = place.type.base};
+        const int element_size = GetTypeSize(element.base);
+        auto element_place = [&](int index)
+        {
+            Place result = {place.address, element};
+            result.address.offset += index * element_size;
+            return result;
+        };
+
+        // unlike EmitRISC, the elements without an initializer are zeroed
+        int index = 0;
+        if (initializer_->GetType(context) == TypeSpecifier::STRING)
+        {
+            // char x[] = "hello" copies the literal, terminator included
+            LoweredValue literal = initializer_->Lower(lowering);
+            for (; index < initializer_->GetArraySize(context) && index < place.type.array_size; index++)
+            {
+                Place source = {{.base = literal.reg, .offset = index}, element};
+                lowering.Store(element_place(index), lowering.Load(source));
+            }
+        }
+        else
+        {
+            const NodeList &node_list = dynamic_cast<const NodeList &>(*initializer_);
+            for (const auto &node : node_list)
+            {
+                lowering.Store(element_place(index), lowering.Convert(node->Lower(lowering), element));
+                index++;
+            }
+        }
+        for (; index < place.type.array_size; index++)
+        {
+            lowering.Store(element_place(index), lowering.Convert({lowering.Const(0), {.base = TypeSpecifier::INT}}, element));
+        }
+        return {};
+    }
 }
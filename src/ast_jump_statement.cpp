@@ -1,35 +1,46 @@
 #include "ast_jump_statement.hpp"
+#include "ast_lowering.hpp"
 #include <thread>
 
 namespace ast
 {
 
-    void ReturnStatement::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void ReturnStatement::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         (void)type;
         if (expression_ != nullptr)
         {
             TypeSpecifier ret_type = expression_->GetType(context);
+            context.SetRegisterDead(destReg, false); // live while the expression is evaluated
             expression_->EmitRISC(stream, context, destReg, ret_type);
             if (ret_type == TypeSpecifier::INT || ret_type == TypeSpecifier::CHAR || ret_type == TypeSpecifier::UNSIGNED)
             {
-                stream << "mv a0" << ", " << context.GetRegString(destReg) << std::endl;
+                stream << "mv a0" << ", " << context.GetRegString(destReg) << "\n";
             }
             else if (ret_type == TypeSpecifier::FLOAT)
             {
-                stream << "fmv.s fa0" << ", " << context.GetRegString(destReg) << std::endl;
+                stream << "fmv.s fa0" << ", " << context.GetRegString(destReg) << "\n";
             }
             else if (ret_type == TypeSpecifier::DOUBLE)
             {
-                stream << "fmv.d fa0" << ", " << context.GetRegString(destReg) << std::endl;
+                stream << "fmv.d fa0" << ", " << context.GetRegString(destReg) << "\n";
             }
             else
             {
                 std::runtime_error("ReturnStatement: Invalid Type.");
             }
+            context.SetRegisterDead(destReg, true);
         }
         std::string functionLabel = context.GetCurrentFunctionContext().GetEndLabel();
-        stream << "j " << functionLabel << std::endl;
+        stream << "j " << functionLabel << "\n";
+    }
+
+    void ReturnStatement::Resolve(Resolver &resolver) const
+    {
+        if (expression_ != nullptr)
+        {
+            expression_->Resolve(resolver);
+        }
     }
 
     void ReturnStatement::Print(std::ostream &stream) const
@@ -40,6 +51,26 @@ namespace ast
             stream << " ";
             expression_->Print(stream);
         }
-        stream << ";" << std::endl;
+        stream << ";" << "\n";
+    }
+
+    LoweredValue ReturnStatement::Lower(Lowering &lowering) const
+    {
+        if (expression_ == nullptr)
+        {
+            lowering.Return(ir::NO_VREG);
+        }
+        else if (lowering.GetReturnType().IsVoid())
+        {
+            // return f(); in a void function
+            expression_->LowerStatement(lowering);
+            lowering.Return(ir::NO_VREG);
+        }
+        else
+        {
+            LoweredValue value = lowering.Convert(expression_->Lower(lowering), lowering.GetReturnType());
+            lowering.Return(value.reg);
+        }
+        return {};
     }
 }
@@ -1,10 +1,11 @@
 #include "ast_keyword.hpp"
+#include "ast_lowering.hpp"
 #include <ostream>
 
 namespace ast
 {
     // ---------- CONTINUE ----------
-    void ContinueStatement::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void ContinueStatement::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         (void)destReg;
         (void)type;
@@ -13,31 +14,43 @@ namespace ast
         if (context.GetCurrentLoopContext().type == ControlFlowType::FOR)
         {
             // jump to the update label for for loops
-            stream << "j " << context.GetUpdateLabel() << std::endl;
+            stream << "j " << context.GetUpdateLabel() << "\n";
         }
         else
         {
             // jump to the start label for other loops
-            stream << "j " << context.GetStartLabel() << std::endl;
+            stream << "j " << context.GetStartLabel() << "\n";
         }
     }
 
     void ContinueStatement::Print(std::ostream &stream) const
     {
-        stream << "continue;" << std::endl;
+        stream << "continue;" << "\n";
     };
 
     // ---------- BREAK ----------
-    void BreakStatement::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void BreakStatement::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         (void)destReg;
         (void)type;
         // jump to end of loop
-        stream << "j " << context.GetEndLabel() << std::endl;
+        stream << "j " << context.GetEndLabel() << "\n";
     }
 
     void BreakStatement::Print(std::ostream &stream) const
     {
-        stream << "break;" << std::endl;
+        stream << "break;" << "\n";
     };
+
+    LoweredValue ContinueStatement::Lower(Lowering &lowering) const
+    {
+        lowering.Jump(lowering.ContinueTarget());
+        return {};
+    }
+
+    LoweredValue BreakStatement::Lower(Lowering &lowering) const
+    {
+        lowering.Jump(lowering.BreakTarget());
+        return {};
+    }
 }
@@ -1,122 +1,176 @@
 #include "ast_logical_op.hpp"
+#include "ast_constant.hpp"
+#include "ast_lowering.hpp"
 
 namespace ast
 {
+    // the second operand only has to be constant when the first doesn't decide the result
+    std::optional<ConstValue> LogicalOp::FoldOperation(ConstValue lhs, Context &context) const
+    {
+        const bool is_and = op_symbol_ == "&&";
+        if (is_and ? !lhs.IsTrue() : lhs.IsTrue())
+        {
+            return ConstValue::Bool(lhs.IsTrue());
+        }
+        if (!expression2_->IsConstant(context))
+        {
+            return std::nullopt;
+        }
+        return ConstValue::Bool(expression2_->Evaluate(context).IsTrue());
+    }
+
+    void LogicalOp::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
+    {
+        if (type != TypeSpecifier::INT)
+        {
+            throw std::runtime_error("LogicalOp::EmitRISC: invalid type");
+        }
+
+        const LeftChain::Spine<LogicalOp> spine = LeftChain::LeftSpine(*this);
+        auto op = spine.crbegin();
+        if (spine.back()->expression1_->IsConstant(context))
+        {
+            EmitConstant(stream, context, destReg, type, LeftChain::FoldConstantPrefix(spine, context, op));
+        }
+        else
+        {
+            spine.back()->expression1_->EmitRISC(stream, context, destReg, type);
+        }
+        for (; op != spine.crend(); ++op)
+        {
+            (*op)->EmitOperation(stream, context, destReg, type);
+        }
+    }
+
+    void LogicalOp::Resolve(Resolver &resolver) const
+    {
+        LeftChain::Resolve(*this, resolver);
+    }
+
     void LogicalOp::Print(std::ostream &stream) const
     {
-        stream << "(";
-        expression1_->Print(stream);
-        stream << " " << op_symbol_ << " ";
-        expression2_->Print(stream);
-        stream << ")";
+        const LeftChain::Spine<LogicalOp> spine = LeftChain::LeftSpine(*this);
+        for (size_t i = 0; i < spine.size(); i++)
+        {
+            stream << "(";
+        }
+        spine.back()->expression1_->Print(stream);
+        for (auto op = spine.rbegin(); op != spine.rend(); ++op)
+        {
+            stream << " " << (*op)->op_symbol_ << " ";
+            (*op)->expression2_->Print(stream);
+            stream << ")";
+        }
+    }
+
+    LoweredValue LogicalOp::Lower(Lowering &lowering) const
+    {
+        const LeftChain::Spine<LogicalOp> spine = LeftChain::LeftSpine(*this);
+        LoweredValue value = spine.back()->expression1_->Lower(lowering);
+        for (auto op = spine.rbegin(); op != spine.rend(); ++op)
+        {
+            value = (*op)->LowerOperation(lowering, value);
+        }
+        return value;
+    }
+
+    // the result goes through a temporary, which becomes a phi once locals are promoted
+    LoweredValue LogicalOp::LowerOperation(Lowering &lowering, LoweredValue lhs) const
+    {
+        const bool is_and = op_symbol_ == "&&";
+        Place result = lowering.NewTemporary({.base = TypeSpecifier::INT});
+        lowering.Store(result, {lowering.Const(is_and ? 0 : 1), result.type});
+
+        ir::BlockId rhs_block = lowering.NewBlock();
+        ir::BlockId end_block = lowering.NewBlock();
+        ir::VReg truth = lowering.Truth(lhs);
+        lowering.Branch(truth, is_and ? rhs_block : end_block, is_and ? end_block : rhs_block);
+
+        lowering.SetBlock(rhs_block);
+        lowering.Store(result, lowering.Bool(expression2_->Lower(lowering)));
+        lowering.Jump(end_block);
+
+        lowering.SetBlock(end_block);
+        return lowering.Load(result);
     }
 
-    void LogicalAnd::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void LogicalAnd::EmitOperation(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         std::string label_short = context.GenerateUniqueLabel("and_short");
         std::string label_end = context.GenerateUniqueLabel("and_end");
-        std::string destRegStr = context.GetRegString(destReg);
+        std::string_view destRegStr = context.GetRegString(destReg);
 
-        if (type != TypeSpecifier::INT)
-        {
-            throw std::runtime_error("LogicalAnd::EmitRISC: invalid type");
-        }
-        // evaluate expressions
-        expression1_->EmitRISC(stream, context, destReg, type);
-        stream << "beq " << destRegStr << ",zero," << label_short << std::endl;
+        stream << "beq " << destRegStr << ",zero," << label_short << "\n";
         expression2_->EmitRISC(stream, context, destReg, type);
-        stream << "beq " << destRegStr << ",zero," << label_short << std::endl;
-        stream << "li " << destRegStr << ",1" << std::endl;
-        stream << "j " << label_end << std::endl;
+        stream << "beq " << destRegStr << ",zero," << label_short << "\n";
+        stream << "li " << destRegStr << ",1" << "\n";
+        stream << "j " << label_end << "\n";
 
         // short circuit
-        stream << label_short << ":" << std::endl;
-        stream << "li " << destRegStr << ",0" << std::endl;
+        stream << label_short << ":" << "\n";
+        stream << "li " << destRegStr << ",0" << "\n";
 
         // end
-        stream << label_end << ":" << std::endl;
+        stream << label_end << ":" << "\n";
     }
 
-    void LogicalOr::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void LogicalOr::EmitOperation(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         std::string label_short_true = context.GenerateUniqueLabel("or_short_true");
         std::string label_false = context.GenerateUniqueLabel("or_false");
         std::string label_end = context.GenerateUniqueLabel("or_end");
-        std::string destRegStr = context.GetRegString(destReg);
+        std::string_view destRegStr = context.GetRegString(destReg);
 
-        if (type != TypeSpecifier::INT)
-        {
-            throw std::runtime_error("LogicalOr::EmitRISC: invalid type");
-        }
-        // evaluate expressions
-        expression1_->EmitRISC(stream, context, destReg, type);
-        stream << "bne " << destRegStr << ",zero," << label_short_true << std::endl;
+        stream << "bne " << destRegStr << ",zero," << label_short_true << "\n";
         expression2_->EmitRISC(stream, context, destReg, type);
-        stream << "beq " << destRegStr << ",zero," << label_false << std::endl;
+        stream << "beq " << destRegStr << ",zero," << label_false << "\n";
 
         // short circuit
-        stream << label_short_true << ":" << std::endl;
-        stream << "li " << destRegStr << ",1" << std::endl;
-        stream << "j " << label_end << std::endl;
+        stream << label_short_true << ":" << "\n";
+        stream << "li " << destRegStr << ",1" << "\n";
+        stream << "j " << label_end << "\n";
 
         // false path
-        stream << label_false << ":" << std::endl;
-        stream << "li " << destRegStr << ",0" << std::endl;
+        stream << label_false << ":" << "\n";
+        stream << "li " << destRegStr << ",0" << "\n";
 
         // end
-        stream << label_end << ":" << std::endl;
+        stream << label_end << ":" << "\n";
     }
 
-    std::any LogicalOp::GetValue(TypeSpecifier type) const
+    ConstValue LogicalOp::Evaluate(Context &context) const
     {
-        if (type == TypeSpecifier::INT || type == TypeSpecifier::CHAR)
-        {
-            return HandleOperations<int>(type);
-        }
-        else if (type == TypeSpecifier::FLOAT)
-        {
-            return HandleOperations<float>(type);
-        }
-        else if (type == TypeSpecifier::DOUBLE)
-        {
-            return HandleOperations<double>(type);
-        }
-        else
+        // the second operand is only evaluated when it decides the result, as at run time
+        const LeftChain::Spine<LogicalOp> spine = LeftChain::LeftSpine(*this);
+        ConstValue value = spine.back()->expression1_->Evaluate(context);
+        for (auto op = spine.rbegin(); op != spine.rend(); ++op)
         {
-            throw std::runtime_error("LogicalOp::GetValue called with invalid type!");
+            const bool lhs = value.IsTrue();
+            if ((*op)->op_symbol_ == "&&")
+            {
+                value = ConstValue::Bool(lhs && (*op)->expression2_->Evaluate(context).IsTrue());
+            }
+            else if ((*op)->op_symbol_ == "||")
+            {
+                value = ConstValue::Bool(lhs || (*op)->expression2_->Evaluate(context).IsTrue());
+            }
+            else
+            {
+                throw std::runtime_error("LogicalOp::Evaluate: invalid operator");
+            }
         }
+        return value;
     }
 
-    TypeSpecifier LogicalOp::GetType(Context &context) const
+    bool LogicalOp::IsConstant(Context &context) const
     {
-        (void)context;
-        return TypeSpecifier::INT;
+        return LeftChain::IsConstant(*this, context);
     }
 
-    template <typename T>
-    std::any LogicalOp::HandleOperations(TypeSpecifier type) const
-    {
-        if (op_symbol_ == "&&")
-        {
-            return EvalOperation<T>(type, std::logical_and<int>());
-        }
-        else if (op_symbol_ == "||")
-        {
-            return EvalOperation<T>(type, std::logical_or<int>());
-        }
-        else
-        {
-            throw std::runtime_error("LogicalOp::HandleOperations: invalid operator");
-        }
-    }
-
-    template <typename T, typename Op>
-    std::any LogicalOp::EvalOperation(TypeSpecifier type, Op op) const
+    TypeSpecifier LogicalOp::GetType(Context &context) const
     {
-        return op(std::any_cast<T>(expression1_->GetValue(type)),
-                  std::any_cast<T>(expression2_->GetValue(type)))
-                   ? std::any(1)
-                   : std::any(0);
+        (void)context;
+        return TypeSpecifier::INT;
     }
 
 } // namespace ast
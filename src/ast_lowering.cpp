@@ -0,0 +1,529 @@
+#include "ast_lowering.hpp"
+#include "ast_function_definition.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace ast
+{
+    namespace
+    {
+        // DO NOT REORDER: ranked for the usual arithmetic conversions
+        constexpr TypeSpecifier ARITHMETIC_RANKS[] = {TypeSpecifier::CHAR, TypeSpecifier::INT, TypeSpecifier::UNSIGNED,
+                                                      TypeSpecifier::FLOAT, TypeSpecifier::DOUBLE};
+
+        int Rank(TypeSpecifier type)
+        {
+            for (size_t i = 0; i < std::size(ARITHMETIC_RANKS); i++)
+            {
+                if (ARITHMETIC_RANKS[i] == type)
+                {
+                    return i;
+                }
+            }
+            Unsupported("arithmetic on a non-arithmetic type");
+        }
+
+        ir::Width WidthOf(const CType &type)
+        {
+            if (!type.IsPointer() && type.base == TypeSpecifier::CHAR)
+            {
+                return ir::Width::BYTE;
+            }
+            return ir::WidthOf(Lowering::IRType(type));
+        }
+
+        constexpr std::pair<char, ir::Op> ARITHMETIC_OPS[] = {
+            {'+', ir::Op::ADD},
+            {'-', ir::Op::SUB},
+            {'*', ir::Op::MUL},
+            {'/', ir::Op::DIV},
+            {'%', ir::Op::REM},
+            {'&', ir::Op::AND},
+            {'|', ir::Op::OR},
+            {'^', ir::Op::XOR},
+            {'l', ir::Op::SHL},
+            {'r', ir::Op::SHR},
+        };
+
+        // liveness and the other passes keep a bit per block for every virtual register, so their cost
+        // grows with the square of the function's size; bigger functions are generated directly
+        constexpr size_t MAX_BLOCKS = 4096;
+    }
+
+    void Unsupported(std::string_view what)
+    {
+        throw std::runtime_error("IR lowering: " + std::string(what));
+    }
+
+    Lowering::Lowering(Context &context, SymbolId function) : context_(context)
+    {
+        function_.name = function;
+        block_ = function_.NewBlock();
+    }
+
+    void Lowering::SetReturnType(CType type)
+    {
+        return_type_ = type;
+        function_.returns_value = !type.IsVoid();
+        if (function_.returns_value)
+        {
+            function_.return_type = IRType(type);
+        }
+    }
+
+    ir::VReg Lowering::AddParam(CType type)
+    {
+        ir::VReg param = function_.NewVReg(IRType(type));
+        function_.params.push_back(param);
+        return param;
+    }
+
+    ir::Function Lowering::Finish()
+    {
+        // falling off the end of main returns 0; other functions are given the same
+        Return(ir::NO_VREG);
+        function_.BuildCfg();
+        ir::Verify(function_);
+        return std::move(function_);
+    }
+
+    ir::VReg Lowering::Emit(ir::Instr instr, ir::Type type)
+    {
+        instr.dst = function_.NewVReg(type);
+        function_.blocks[block_].instrs.push_back(std::move(instr));
+        return function_.blocks[block_].instrs.back().dst;
+    }
+
+    void Lowering::EmitVoid(ir::Instr instr)
+    {
+        function_.blocks[block_].instrs.push_back(std::move(instr));
+    }
+
+    ir::VReg Lowering::Const(int32_t value)
+    {
+        return Emit({.op = ir::Op::CONST, .imm = value}, ir::Type::I32);
+    }
+
+    ir::VReg Lowering::FConst(double value, ir::Type type)
+    {
+        return Emit({.op = ir::Op::FCONST, .fimm = (type == ir::Type::F32) ? static_cast<float>(value) : value}, type);
+    }
+
+    ir::VReg Lowering::Binary(ir::Op op, ir::VReg a, ir::VReg b)
+    {
+        const bool is_compare = op >= ir::Op::EQ && op <= ir::Op::LEU;
+        return Emit({.op = op, .a = a, .b = b}, is_compare ? ir::Type::I32 : function_.TypeOf(a));
+    }
+
+    ir::VReg Lowering::Unary(ir::Op op, ir::VReg a, ir::Type type)
+    {
+        return Emit({.op = op, .a = a}, type);
+    }
+
+    ir::VReg Lowering::Address(const ir::Address &address)
+    {
+        return Emit({.op = ir::Op::ADDR, .address = address}, ir::Type::I32);
+    }
+
+    void Lowering::Jump(ir::BlockId target)
+    {
+        EmitVoid({.op = ir::Op::JUMP, .target = target});
+        block_ = NewBlock();
+    }
+
+    void Lowering::Branch(ir::VReg condition, ir::BlockId if_true, ir::BlockId if_false)
+    {
+        EmitVoid({.op = ir::Op::BRANCH, .a = condition, .target = if_true, .target2 = if_false});
+        block_ = NewBlock();
+    }
+
+    void Lowering::Return(ir::VReg value)
+    {
+        if (value == ir::NO_VREG && function_.returns_value)
+        {
+            value = IRType(return_type_) == ir::Type::I32 ? Const(0) : FConst(0, IRType(return_type_));
+        }
+        EmitVoid({.op = ir::Op::RET, .a = value});
+        block_ = NewBlock();
+    }
+
+    void Lowering::EnterLoop(ir::BlockId break_target, ir::BlockId continue_target)
+    {
+        break_targets_.push_back(break_target);
+        continue_targets_.push_back(continue_target);
+    }
+
+    void Lowering::EnterSwitch(ir::BlockId break_target)
+    {
+        break_targets_.push_back(break_target);
+        continue_targets_.push_back(continue_targets_.empty() ? ir::NO_BLOCK : continue_targets_.back());
+    }
+
+    void Lowering::ExitLoop()
+    {
+        break_targets_.pop_back();
+        continue_targets_.pop_back();
+    }
+
+    ir::BlockId Lowering::BreakTarget() const
+    {
+        if (break_targets_.empty())
+        {
+            throw std::runtime_error("break statement not within loop or switch");
+        }
+        return break_targets_.back();
+    }
+
+    ir::BlockId Lowering::ContinueTarget() const
+    {
+        if (continue_targets_.empty() || continue_targets_.back() == ir::NO_BLOCK)
+        {
+            throw std::runtime_error("continue statement not within a loop");
+        }
+        return continue_targets_.back();
+    }
+
+    ir::Type Lowering::IRType(const CType &type)
+    {
+        if (type.IsPointer())
+        {
+            return ir::Type::I32;
+        }
+        switch (type.base)
+        {
+        case TypeSpecifier::INT:
+        case TypeSpecifier::UNSIGNED:
+        case TypeSpecifier::CHAR:
+            return ir::Type::I32;
+        case TypeSpecifier::FLOAT:
+            return ir::Type::F32;
+        case TypeSpecifier::DOUBLE:
+            return ir::Type::F64;
+        default:
+            Unsupported("value of a non-scalar type");
+        }
+    }
+
+    int Lowering::SizeOf(const CType &type)
+    {
+        if (type.IsArray())
+        {
+            return type.array_size * GetTypeSize(type.base);
+        }
+        return type.IsPointer() ? WORD_SIZE : GetTypeSize(type.base);
+    }
+
+    int Lowering::ElementSize(const CType &pointer)
+    {
+        if (pointer.pointer_depth > 1)
+        {
+            return WORD_SIZE;
+        }
+        return (pointer.base == TypeSpecifier::VOID) ? 1 : GetTypeSize(pointer.base);
+    }
+
+    CType Lowering::CommonType(const CType &lhs, const CType &rhs)
+    {
+        if (!lhs.IsInteger() && !lhs.IsFloating())
+        {
+            Unsupported("arithmetic on a pointer");
+        }
+        if (!rhs.IsInteger() && !rhs.IsFloating())
+        {
+            Unsupported("arithmetic on a pointer");
+        }
+        TypeSpecifier common = (Rank(lhs.base) >= Rank(rhs.base)) ? lhs.base : rhs.base;
+        return {.base = (common == TypeSpecifier::CHAR) ? TypeSpecifier::INT : common};
+    }
+
+    LoweredValue Lowering::Convert(const LoweredValue &value, const CType &type)
+    {
+        if (value.reg == ir::NO_VREG || !value.type.IsScalar() || !type.IsScalar())
+        {
+            Unsupported("conversion of a non-scalar value");
+        }
+        const CType from = {.base = value.type.base, .pointer_depth = value.type.pointer_depth};
+        const CType to = {.base = type.base, .pointer_depth = type.pointer_depth};
+        const ir::Type from_ir = IRType(from);
+        const ir::Type to_ir = IRType(to);
+
+        ir::VReg reg = value.reg;
+        if (from_ir == ir::Type::I32 && to_ir == ir::Type::I32)
+        {
+            // integers and pointers share one representation, except that a char is its low byte
+            const bool to_char = to.IsInteger() && to.base == TypeSpecifier::CHAR;
+            const bool from_char = from.IsInteger() && from.base == TypeSpecifier::CHAR;
+            if (to_char && !from_char)
+            {
+                reg = Binary(ir::Op::AND, reg, Const(0xff));
+            }
+        }
+        else if (from_ir == ir::Type::I32)
+        {
+            reg = Unary(from.IsInteger() && from.base == TypeSpecifier::UNSIGNED ? ir::Op::UTOF : ir::Op::ITOF, reg, to_ir);
+        }
+        else if (to_ir == ir::Type::I32)
+        {
+            if (to.IsPointer())
+            {
+                Unsupported("conversion of a floating point value to a pointer");
+            }
+            reg = Unary(to.base == TypeSpecifier::UNSIGNED ? ir::Op::FTOU : ir::Op::FTOI, reg, to_ir);
+            if (to.base == TypeSpecifier::CHAR)
+            {
+                reg = Binary(ir::Op::AND, reg, Const(0xff));
+            }
+        }
+        else if (from_ir != to_ir)
+        {
+            reg = Unary(ir::Op::FCVT, reg, to_ir);
+        }
+        return {reg, to};
+    }
+
+    LoweredValue Lowering::Promote(const LoweredValue &value)
+    {
+        if (value.type.IsInteger() && value.type.base == TypeSpecifier::CHAR)
+        {
+            return {value.reg, {.base = TypeSpecifier::INT}};
+        }
+        return value;
+    }
+
+    ir::VReg Lowering::Truth(const LoweredValue &value)
+    {
+        if (!value.type.IsScalar())
+        {
+            Unsupported("condition of a non-scalar type");
+        }
+        if (value.type.IsFloating())
+        {
+            ir::Type type = IRType(value.type);
+            return Binary(ir::Op::NE, value.reg, FConst(0, type));
+        }
+        return value.reg;
+    }
+
+    LoweredValue Lowering::Bool(const LoweredValue &value)
+    {
+        if (!value.type.IsScalar())
+        {
+            Unsupported("condition of a non-scalar type");
+        }
+        ir::VReg zero = value.type.IsFloating() ? FConst(0, IRType(value.type)) : Const(0);
+        return {Binary(ir::Op::NE, value.reg, zero), {.base = TypeSpecifier::INT}};
+    }
+
+    LoweredValue Lowering::Arithmetic(char op, const LoweredValue &lhs_value, const LoweredValue &rhs_value)
+    {
+        const LoweredValue lhs = Promote(lhs_value);
+        const LoweredValue rhs = Promote(rhs_value);
+
+        // pointer arithmetic: the integer operand counts elements
+        if ((op == '+' || op == '-') && lhs.type.IsPointer() && rhs.type.IsInteger())
+        {
+            ir::VReg offset = rhs.reg;
+            if (ElementSize(lhs.type) != 1)
+            {
+                offset = Binary(ir::Op::MUL, offset, Const(ElementSize(lhs.type)));
+            }
+            return {Binary(op == '+' ? ir::Op::ADD : ir::Op::SUB, lhs.reg, offset),
+                    {.base = lhs.type.base, .pointer_depth = lhs.type.pointer_depth}};
+        }
+        if (op == '+' && lhs.type.IsInteger() && rhs.type.IsPointer())
+        {
+            return Arithmetic(op, rhs, lhs);
+        }
+        if (op == '-' && lhs.type.IsPointer() && rhs.type.IsPointer())
+        {
+            ir::VReg difference = Binary(ir::Op::SUB, lhs.reg, rhs.reg);
+            if (ElementSize(lhs.type) != 1)
+            {
+                difference = Binary(ir::Op::DIV, difference, Const(ElementSize(lhs.type)));
+            }
+            return {difference, {.base = TypeSpecifier::INT}};
+        }
+
+        ir::Op ir_op = ir::Op::ADD;
+        bool found = false;
+        for (const auto &[symbol, candidate] : ARITHMETIC_OPS)
+        {
+            if (symbol == op)
+            {
+                ir_op = candidate;
+                found = true;
+            }
+        }
+        if (!found)
+        {
+            throw std::out_of_range(std::string("Lowering: unknown operator ") + op);
+        }
+
+        // the shifts have the type of their promoted left operand
+        if (ir_op == ir::Op::SHL || ir_op == ir::Op::SHR)
+        {
+            if (!lhs.type.IsInteger() || !rhs.type.IsInteger())
+            {
+                Unsupported("shift of a non-integer");
+            }
+            if (ir_op == ir::Op::SHR && lhs.type.base == TypeSpecifier::UNSIGNED)
+            {
+                ir_op = ir::Op::SHRU;
+            }
+            return {Binary(ir_op, lhs.reg, rhs.reg), lhs.type};
+        }
+
+        const CType type = CommonType(lhs.type, rhs.type);
+        const bool integer_only = ir_op != ir::Op::ADD && ir_op != ir::Op::SUB && ir_op != ir::Op::MUL && ir_op != ir::Op::DIV;
+        if (integer_only && type.IsFloating())
+        {
+            Unsupported("integer operator on a floating point value");
+        }
+        if (type.base == TypeSpecifier::UNSIGNED)
+        {
+            ir_op = (ir_op == ir::Op::DIV) ? ir::Op::DIVU : (ir_op == ir::Op::REM) ? ir::Op::REMU
+                                                                                    : ir_op;
+        }
+        return {Binary(ir_op, Convert(lhs, type).reg, Convert(rhs, type).reg), type};
+    }
+
+    LoweredValue Lowering::Compare(std::string_view op, const LoweredValue &lhs_value, const LoweredValue &rhs_value)
+    {
+        LoweredValue lhs = Promote(lhs_value);
+        LoweredValue rhs = Promote(rhs_value);
+
+        bool is_unsigned = false;
+        if (lhs.type.IsPointer() || rhs.type.IsPointer())
+        {
+            // pointers compare as addresses; comparing with an integer (0) is taken as is
+            is_unsigned = true;
+        }
+        else
+        {
+            const CType type = CommonType(lhs.type, rhs.type);
+            lhs = Convert(lhs, type);
+            rhs = Convert(rhs, type);
+            is_unsigned = type.base == TypeSpecifier::UNSIGNED;
+        }
+
+        // a > b is b < a and a >= b is b <= a
+        ir::Op ir_op;
+        bool swap = false;
+        if (op == "==")
+        {
+            ir_op = ir::Op::EQ;
+        }
+        else if (op == "!=")
+        {
+            ir_op = ir::Op::NE;
+        }
+        else if (op == "<" || op == ">")
+        {
+            ir_op = is_unsigned ? ir::Op::LTU : ir::Op::LT;
+            swap = op == ">";
+        }
+        else if (op == "<=" || op == ">=")
+        {
+            ir_op = is_unsigned ? ir::Op::LEU : ir::Op::LE;
+            swap = op == ">=";
+        }
+        else
+        {
+            throw std::out_of_range("Lowering: unknown comparison " + std::string(op));
+        }
+        ir::VReg result = swap ? Binary(ir_op, rhs.reg, lhs.reg) : Binary(ir_op, lhs.reg, rhs.reg);
+        return {result, {.base = TypeSpecifier::INT}};
+    }
+
+    LoweredValue Lowering::Load(const Place &place)
+    {
+        if (place.type.IsArray())
+        {
+            return {Address(place.address), {.base = place.type.base, .pointer_depth = 1, .array_size = place.type.array_size}};
+        }
+        if (!place.type.IsScalar())
+        {
+            Unsupported("load of a non-scalar object");
+        }
+        ir::VReg reg = Emit({.op = ir::Op::LOAD, .width = WidthOf(place.type), .address = place.address}, IRType(place.type));
+        return {reg, place.type};
+    }
+
+    void Lowering::Store(const Place &place, const LoweredValue &value)
+    {
+        if (place.type.IsArray() || !place.type.IsScalar())
+        {
+            Unsupported("assignment to a non-scalar object");
+        }
+        EmitVoid({.op = ir::Op::STORE, .a = value.reg, .width = WidthOf(place.type), .address = place.address});
+    }
+
+    CType Lowering::TypeOf(const Node &expression)
+    {
+        const ir::BlockId block = block_;
+        block_ = NewBlock();
+        CType type = expression.Lower(*this).type;
+        block_ = block;
+        return type;
+    }
+
+    Place Lowering::DeclareLocal(const Binding &binding, int array_size)
+    {
+        CType type = {.base = binding.type, .pointer_depth = binding.is_pointer ? binding.pointer_depth : 0};
+        if (binding.is_array)
+        {
+            type = {.base = binding.type, .array_size = array_size};
+        }
+        Place place = NewTemporary(type);
+        locals_[&binding] = place;
+        return place;
+    }
+
+    Place Lowering::NewTemporary(const CType &type)
+    {
+        int size = SizeOf(type);
+        int align = type.IsArray() ? GetTypeSize(type.base) : size;
+        return {{.slot = function_.NewSlot(size, align)}, type};
+    }
+
+    Place Lowering::PlaceOf(const Binding &binding)
+    {
+        switch (binding.kind)
+        {
+        case Binding::Kind::LOCAL:
+        {
+            auto local = locals_.find(&binding);
+            if (local == locals_.end())
+            {
+                Unsupported("use of " + Spelling(binding.name) + " outside its declaration");
+            }
+            return local->second;
+        }
+        case Binding::Kind::GLOBAL:
+        {
+            CType type = {.base = binding.type, .pointer_depth = binding.is_pointer ? binding.pointer_depth : 0};
+            if (binding.is_array)
+            {
+                const GlobalVariable *global = context_.FindGlobalVariable(binding.name);
+                type = {.base = binding.type, .array_size = (global != nullptr) ? global->array_size : 0};
+            }
+            return {{.symbol = binding.name}, type};
+        }
+        default:
+            Unsupported("enumerator " + Spelling(binding.name) + " is not an object");
+        }
+    }
+
+    ir::Function LowerFunction(const FunctionDefinition &function, Context &context)
+    {
+        Lowering lowering(context, function.GetID());
+        function.Lower(lowering);
+        ir::Function ir_function = lowering.Finish();
+        if (ir_function.blocks.size() > MAX_BLOCKS)
+        {
+            Unsupported(std::to_string(ir_function.blocks.size()) + " blocks, more than the passes take");
+        }
+        return ir_function;
+    }
+
+} // namespace ast
@@ -1,14 +1,61 @@
 #include "ast_node.hpp"
+#include "ast_lowering.hpp"
+#include <typeinfo>
 
 namespace ast
 {
+    namespace
+    {
+        // every node is prefixed by the arena it came from (nullptr for the heap), padded to keep
+        // the node itself maximally aligned
+        constexpr size_t NODE_HEADER_SIZE = alignof(std::max_align_t);
+    }
+
+    void *Node::operator new(size_t size)
+    {
+        AstArena *arena = AstArena::Current();
+        char *block = static_cast<char *>(arena != nullptr ? arena->Allocate(NODE_HEADER_SIZE + size)
+                                                           : ::operator new(NODE_HEADER_SIZE + size));
+        *reinterpret_cast<AstArena **>(block) = arena;
+        return block + NODE_HEADER_SIZE;
+    }
+
+    void Node::operator delete(void *ptr)
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+        char *block = static_cast<char *>(ptr) - NODE_HEADER_SIZE;
+        if (*reinterpret_cast<AstArena **>(block) == nullptr)
+        {
+            ::operator delete(block);
+        }
+    }
+
+    LoweredValue Node::Lower(Lowering &lowering) const
+    {
+        (void)lowering;
+        Unsupported(typeid(*this).name());
+    }
+
+    Place Node::LowerPlace(Lowering &lowering) const
+    {
+        (void)lowering;
+        Unsupported(std::string("assignment to a ") + typeid(*this).name());
+    }
+
+    void Node::LowerStatement(Lowering &lowering) const
+    {
+        Lower(lowering);
+    }
 
     void NodeList::PushBack(NodePtr item)
     {
         nodes_.push_back(std::move(item));
     }
 
-    void NodeList::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void NodeList::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         for (const auto &node : nodes_)
         {
@@ -32,6 +79,29 @@ namespace ast
         }
     }
 
+    LoweredValue NodeList::Lower(Lowering &lowering) const
+    {
+        for (const auto &node : nodes_)
+        {
+            if (node != nullptr)
+            {
+                node->LowerStatement(lowering);
+            }
+        }
+        return {};
+    }
+
+    void NodeList::Resolve(Resolver &resolver) const
+    {
+        for (const auto &node : nodes_)
+        {
+            if (node != nullptr)
+            {
+                node->Resolve(resolver);
+            }
+        }
+    }
+
     void NodeList::Print(std::ostream &stream) const
     {
         for (const auto &node : nodes_)
@@ -44,9 +114,9 @@ namespace ast
         }
     }
 
-    std::vector<std::string> NodeList::GetIDs() const
+    std::vector<SymbolId> NodeList::GetIDs() const
     {
-        std::vector<std::string> ids;
+        std::vector<SymbolId> ids;
         for (const auto &node : nodes_)
         {
             if (node == nullptr)
@@ -70,7 +140,7 @@ namespace ast
             TypeSpecifier type = node->GetType(context);
             bool is_pointer = node->IsPointer(context, false);
             int pointer_depth = node->GetPointerDepth();
-            std::string name = node->GetID();
+            SymbolId name = node->GetID();
             params.push_back({name, type, is_pointer, pointer_depth});
         }
         return params;
@@ -3,7 +3,7 @@
 namespace ast
 {
 
-    void ParameterDeclaration::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void ParameterDeclaration::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         (void)stream;
         (void)context;
@@ -17,7 +17,7 @@ namespace ast
         declarator_->Print(stream);
     }
 
-    std::string ParameterDeclaration::GetID() const
+    SymbolId ParameterDeclaration::GetID() const
     {
         return declarator_->GetID();
     }
@@ -34,4 +34,9 @@ namespace ast
         return declarator_->IsPointer(context, false);
     }
 
+    int ParameterDeclaration::GetPointerDepth() const
+    {
+        return declarator_->GetPointerDepth();
+    }
+
 } // namespace ast
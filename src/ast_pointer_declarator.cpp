@@ -1,26 +1,37 @@
 #include "ast_pointer_declarator.hpp"
 #include "ast_direct_declarator.hpp"
+#include "ast_lowering.hpp"
 
 namespace ast
 {
     // this is used as a pssthrough for pointer return type functions
-    void PointerDeclarator::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void PointerDeclarator::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         declarator_->EmitRISC(stream, context, destReg, type);
     }
 
-    std::string PointerDeclarator::GetID() const
+    SymbolId PointerDeclarator::GetID() const
     {
         // return (std::string(pointer_depth_, '*') + declarator_->GetID());
         return declarator_->GetID();
     }
 
+    const Binding *PointerDeclarator::GetBinding() const
+    {
+        return declarator_->GetBinding();
+    }
+
     void PointerDeclarator::Print(std::ostream &stream) const
     {
         stream << std::string(pointer_depth_, '*');
         declarator_->Print(stream);
     }
 
+    void PointerDeclarator::Resolve(Resolver &resolver) const
+    {
+        declarator_->Resolve(resolver);
+    }
+
     bool PointerDeclarator::IsPointer(Context &context, const bool has_been_declared) const
     {
         (void)context;
@@ -57,4 +68,9 @@ namespace ast
         const DirectDeclarator &func_declarator = dynamic_cast<const DirectDeclarator &>(*declarator_);
         func_declarator.StoreFunctionInfo(return_type, context);
     }
+
+    LoweredValue PointerDeclarator::Lower(Lowering &lowering) const
+    {
+        return declarator_->Lower(lowering);
+    }
 } // namespace ast
@@ -1,21 +1,32 @@
 #include "ast_pointer_unary.hpp"
+#include "ast_lowering.hpp"
 
 namespace ast
 {
-    void UnaryAddressOp::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void UnaryAddressOp::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         (void)type;
-        if (context.VariableIsLocal(expression_->GetID()))
+        if (const Binding *var = LocalBinding(expression_->GetBinding()))
         {
-            stream << "addi " << context.GetRegString(destReg) << ",s0," << context.GetCurrentFunctionContext().GetFunctionVariableInfo(expression_->GetID()).offset << std::endl;
+            stream << "addi " << context.GetRegString(destReg) << ",s0," << var->offset << "\n";
         }
         else
         {
-            stream << "lui " << context.GetRegString(destReg) << ",%hi(" << expression_->GetID() << ")" << std::endl;
-            stream << "addi " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << ",%lo(" << expression_->GetID() << ")" << std::endl;
+            stream << "lui " << context.GetRegString(destReg) << ",%hi(" << expression_->GetID() << ")" << "\n";
+            stream << "addi " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << ",%lo(" << expression_->GetID() << ")" << "\n";
         }
     }
 
+    LoweredValue UnaryAddressOp::Lower(Lowering &lowering) const
+    {
+        Place place = expression_->LowerPlace(lowering);
+        if (place.type.IsArray())
+        {
+            Unsupported("pointer to an array");
+        }
+        return {lowering.Address(place.address), {.base = place.type.base, .pointer_depth = place.type.pointer_depth + 1}};
+    }
+
     void UnaryAddressOp::Print(std::ostream &stream) const
     {
         stream << "&";
@@ -35,10 +46,11 @@ namespace ast
         return true;
     }
 
-    void UnaryDereferenceOp::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void UnaryDereferenceOp::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
+        const bool is_pointer = IsPointer(context, true);
         int srcReg;
-        if (!IsPointer(context, true))
+        if (!is_pointer)
         {
             srcReg = context.AssignRegister(TypeSpecifier::INT);
         }
@@ -46,15 +58,20 @@ namespace ast
         {
             srcReg = destReg;
         }
+        bool deferred = (srcReg != destReg) && context.DeferRegister(destReg); // only written by the load
         expression_->EmitRISC(stream, context, srcReg, type);
+        if (deferred)
+        {
+            context.SetRegisterDead(destReg, false);
+        }
 
-        if (IsPointer(context, true))
+        if (is_pointer)
         {
-            stream << "lw " << context.GetRegString(destReg) << ",0(" << context.GetRegString(srcReg) << ")" << std::endl;
+            stream << "lw " << context.GetRegString(destReg) << ",0(" << context.GetRegString(srcReg) << ")" << "\n";
         }
         else
         {
-            stream << GetLoadOp(GetType(context)) << " " << context.GetRegString(destReg) << ",0(" << context.GetRegString(srcReg) << ")" << std::endl;
+            stream << GetLoadOp(GetType(context)) << " " << context.GetRegString(destReg) << ",0(" << context.GetRegString(srcReg) << ")" << "\n";
         }
 
         if (destReg != srcReg)
@@ -63,6 +80,21 @@ namespace ast
         }
     }
 
+    LoweredValue UnaryDereferenceOp::Lower(Lowering &lowering) const
+    {
+        return lowering.Load(LowerPlace(lowering));
+    }
+
+    Place UnaryDereferenceOp::LowerPlace(Lowering &lowering) const
+    {
+        LoweredValue pointer = expression_->Lower(lowering);
+        if (!pointer.type.IsPointer())
+        {
+            Unsupported("dereference of a non-pointer");
+        }
+        return {{.base = pointer.reg}, {.base = pointer.type.base, .pointer_depth = pointer.type.pointer_depth - 1}};
+    }
+
     void UnaryDereferenceOp::Print(std::ostream &stream) const
     {
         stream << "*";
@@ -76,16 +108,9 @@ namespace ast
 
     bool UnaryDereferenceOp::IsPointer(Context &context, const bool has_been_declared) const
     {
+        (void)context;
         (void)has_been_declared;
-        int ptr_depth;
-        if (context.VariableIsLocal(expression_->GetID()))
-        {
-            ptr_depth = context.GetCurrentFunctionContext().GetFunctionVariableInfo(expression_->GetID()).pointer_depth;
-        }
-        else
-        {
-            ptr_depth = context.GetGlobalVariableInfo(expression_->GetID()).pointer_depth;
-        }
+        int ptr_depth = RequireBinding(expression_->GetBinding()).pointer_depth; // 0 for enumerators
 
         return (ptr_depth > pointer_depth_) ? true : false;
     }
@@ -95,11 +120,21 @@ namespace ast
         return pointer_depth_;
     }
 
-    std::string PointerUnary::GetID() const
+    void PointerUnary::Resolve(Resolver &resolver) const
+    {
+        expression_->Resolve(resolver);
+    }
+
+    SymbolId PointerUnary::GetID() const
     {
         return expression_->GetID();
     }
 
+    const Binding *PointerUnary::GetBinding() const
+    {
+        return expression_->GetBinding();
+    }
+
     TypeSpecifier UnaryDereferenceOp::GetType(Context &context) const
     {
         return expression_->GetType(context);
@@ -1,5 +1,6 @@
 #include "ast_relational_op.hpp"
-#include <functional>
+#include "ast_constant.hpp"
+#include "ast_lowering.hpp"
 
 namespace ast
 {
@@ -23,46 +24,128 @@ namespace ast
         }
     }
 
-    void RelationalOp::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    std::optional<ConstValue> RelationalOp::FoldOperation(ConstValue lhs, Context &context) const
     {
-        if (type != TypeSpecifier::INT)
+        if (!expression2_->IsConstant(context))
         {
-            throw std::runtime_error("RelationalOp::EmitRISC: expected return type must be INT");
+            return std::nullopt;
+        }
+        const ConstValue rhs = expression2_->Evaluate(context);
+        if (!CanEvaluateBinary(op_symbol_, lhs, rhs))
+        {
+            return std::nullopt;
         }
+        return EvaluateBinary(op_symbol_, lhs, rhs);
+    }
 
+    std::pair<TypeSpecifier, TypeSpecifier> RelationalOp::OperandTypes(Context &context) const
+    {
         TypeSpecifier type1 = expression1_->GetType(context);
         TypeSpecifier type2 = expression2_->GetType(context);
 
         type1 = (expression1_->IsPointer(context, true)) ? TypeSpecifier::INT : type1;
         type2 = (expression2_->IsPointer(context, true)) ? TypeSpecifier::INT : type2;
+        return {type1, type2};
+    }
 
-        int srcReg1 = context.AssignRegister(type1);
-        int srcReg2 = context.AssignRegister(type2);
-        // evaluate both expressions
-        EmitStart(stream, context, srcReg1, srcReg2, type1);
-        EmitMain(stream, context, destReg, srcReg1, srcReg2, type1);
-        EmitEnd(stream, context, destReg);
+    void RelationalOp::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
+    {
+        if (type != TypeSpecifier::INT)
+        {
+            throw std::runtime_error("RelationalOp::EmitRISC: expected return type must be INT");
+        }
+
+        const LeftChain::Spine<RelationalOp> spine = LeftChain::LeftSpine(*this);
+        auto op = spine.crbegin();
+        // destReg only gets the result of the last comparison, so calls before it don't save it
+        const bool deferred = context.DeferRegister(destReg);
+
+        // lhsReg holds the left operand of *op: the leftmost operand, then the result of each comparison
+        int lhsReg;
+        if (spine.back()->expression1_->IsConstant(context))
+        {
+            const ConstValue value = LeftChain::FoldConstantPrefix(spine, context, op);
+            if (op == spine.crend())
+            {
+                if (deferred)
+                {
+                    context.SetRegisterDead(destReg, false);
+                }
+                EmitConstant(stream, context, destReg, type, value);
+                return;
+            }
+            const TypeSpecifier lhs_type = (*op)->OperandTypes(context).first;
+            lhsReg = context.AssignRegister(lhs_type);
+            EmitConstant(stream, context, lhsReg, lhs_type, value);
+        }
+        else
+        {
+            const TypeSpecifier lhs_type = spine.back()->OperandTypes(context).first;
+            lhsReg = context.AssignRegister(lhs_type);
+            spine.back()->expression1_->EmitRISC(stream, context, lhsReg, lhs_type);
+        }
+
+        for (; op != spine.crend(); ++op)
+        {
+            const auto [type1, type2] = (*op)->OperandTypes(context);
+            const int rhsReg = context.AssignRegister(type2);
+            (*op)->expression2_->EmitRISC(stream, context, rhsReg, type1);
+
+            int resultReg = lhsReg;
+            if (std::next(op) == spine.crend())
+            {
+                if (deferred)
+                {
+                    context.SetRegisterDead(destReg, false);
+                }
+                resultReg = destReg;
+            }
+            else if (IsFloatRegister(static_cast<Reg>(lhsReg)))
+            {
+                resultReg = context.AssignRegister(TypeSpecifier::INT);
+            }
+            (*op)->EmitMain(stream, context, resultReg, lhsReg, rhsReg, type1);
+            (*op)->EmitEnd(stream, context, resultReg);
+
+            context.FreeRegister(rhsReg);
+            if (resultReg != lhsReg)
+            {
+                context.FreeRegister(lhsReg);
+            }
+            lhsReg = resultReg;
+        }
+    }
 
-        context.FreeRegister(srcReg1);
-        context.FreeRegister(srcReg2);
+    void RelationalOp::EmitEnd(AsmWriter &stream, Context &context, int destReg) const
+    {
+        stream << "andi " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << ",0xff" << "\n";
     }
 
-    void RelationalOp::EmitStart(std::ostream &stream, Context &context, int srcReg1, int srcReg2, TypeSpecifier type) const
+    LoweredValue RelationalOp::Lower(Lowering &lowering) const
     {
-        expression1_->EmitRISC(stream, context, srcReg1, type);
-        expression2_->EmitRISC(stream, context, srcReg2, type);
+        const LeftChain::Spine<RelationalOp> spine = LeftChain::LeftSpine(*this);
+        LoweredValue value = spine.back()->expression1_->Lower(lowering);
+        for (auto op = spine.rbegin(); op != spine.rend(); ++op)
+        {
+            value = lowering.Compare((*op)->op_symbol_, value, (*op)->expression2_->Lower(lowering));
+        }
+        return value;
     }
 
-    void RelationalOp::EmitEnd(std::ostream &stream, Context &context, int destReg) const
+    void RelationalOp::Resolve(Resolver &resolver) const
     {
-        stream << "andi " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << ",0xff" << std::endl;
+        LeftChain::Resolve(*this, resolver);
     }
 
     void RelationalOp::Print(std::ostream &stream) const
     {
-        expression1_->Print(stream);
-        stream << " " << op_symbol_ << " ";
-        expression2_->Print(stream);
+        const LeftChain::Spine<RelationalOp> spine = LeftChain::LeftSpine(*this);
+        spine.back()->expression1_->Print(stream);
+        for (auto op = spine.rbegin(); op != spine.rend(); ++op)
+        {
+            stream << " " << (*op)->op_symbol_ << " ";
+            (*op)->expression2_->Print(stream);
+        }
     }
 
     TypeSpecifier RelationalOp::GetType(Context &context) const
@@ -73,118 +156,84 @@ namespace ast
     }
 
     // NB: make sure that result is stored in destReg for ALL EmitMain
-    void LessThan::EmitMain(std::ostream &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const
+    void LessThan::EmitMain(AsmWriter &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const
     {
-        stream << GetRelationalOpString("lt", type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << std::endl;
+        stream << GetRelationalOpString("lt", type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << "\n";
     }
 
-    void LessThanEqual::EmitMain(std::ostream &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const
+    void LessThanEqual::EmitMain(AsmWriter &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const
     {
-        stream << GetRelationalOpString("gt", type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << std::endl;
-        stream << "xori " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << ",1" << std::endl;
+        // not (a > b) is true for NaN, so floats need their own instruction
+        if (type == TypeSpecifier::FLOAT || type == TypeSpecifier::DOUBLE)
+        {
+            stream << GetRelationalOpString("le", type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << "\n";
+            return;
+        }
+        stream << GetRelationalOpString("gt", type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << "\n";
+        stream << "xori " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << ",1" << "\n";
     }
 
-    void GreaterThan::EmitMain(std::ostream &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const
+    void GreaterThan::EmitMain(AsmWriter &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const
     {
-        stream << GetRelationalOpString("gt", type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << std::endl;
+        stream << GetRelationalOpString("gt", type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << "\n";
     }
 
-    void GreaterThanEqual::EmitMain(std::ostream &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const
+    void GreaterThanEqual::EmitMain(AsmWriter &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const
     {
-        // signed for integer
-        stream << GetRelationalOpString("lt", type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << std::endl;
-        stream << "xori " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << ",1" << std::endl;
-    }
-
-    void Equal::EmitMain(std::ostream &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const
-    {
-        // TODO: this needs to work for chars too
-        if (type == TypeSpecifier::INT || type == TypeSpecifier::CHAR)
+        // b <= a, as not (a < b) is true for NaN
+        if (type == TypeSpecifier::FLOAT || type == TypeSpecifier::DOUBLE)
         {
-            stream << "sub " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << std::endl;
-            stream << "seqz " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << std::endl;
-        }
-        else
-        {
-            stream << GetRelationalOpString("eq", type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << std::endl;
+            stream << GetRelationalOpString("le", type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg2) << "," << context.GetRegString(srcReg1) << "\n";
+            return;
         }
+        // signed for integer
+        stream << GetRelationalOpString("lt", type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << "\n";
+        stream << "xori " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << ",1" << "\n";
     }
 
-    void NotEqual::EmitMain(std::ostream &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const
+    void Equal::EmitMain(AsmWriter &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const
     {
         // TODO: this needs to work for chars too
         if (type == TypeSpecifier::INT || type == TypeSpecifier::CHAR)
         {
-            stream << "sub " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << std::endl;
-            stream << "snez " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << std::endl;
+            stream << "sub " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << "\n";
+            stream << "seqz " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "\n";
         }
         else
         {
-            stream << GetRelationalOpString("eq", type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << std::endl;
-            stream << "xori " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << ",1" << std::endl;
+            stream << GetRelationalOpString("eq", type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << "\n";
         }
     }
 
-    std::any RelationalOp::GetValue(TypeSpecifier type) const
+    void NotEqual::EmitMain(AsmWriter &stream, Context &context, int destReg, int srcReg1, int srcReg2, TypeSpecifier type) const
     {
+        // TODO: this needs to work for chars too
         if (type == TypeSpecifier::INT || type == TypeSpecifier::CHAR)
         {
-            return HandleOperations<int>(type);
-        }
-        else if (type == TypeSpecifier::FLOAT)
-        {
-            return HandleOperations<float>(type);
-        }
-        else if (type == TypeSpecifier::DOUBLE)
-        {
-            return HandleOperations<double>(type);
+            stream << "sub " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << "\n";
+            stream << "snez " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "\n";
         }
         else
         {
-            throw std::runtime_error("RelationalOp::GetValue called with invalid type!");
+            stream << GetRelationalOpString("eq", type) << " " << context.GetRegString(destReg) << "," << context.GetRegString(srcReg1) << "," << context.GetRegString(srcReg2) << "\n";
+            stream << "xori " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << ",1" << "\n";
         }
     }
 
-    template <typename T>
-    std::any RelationalOp::HandleOperations(TypeSpecifier type) const
+    ConstValue RelationalOp::Evaluate(Context &context) const
     {
-        if (op_symbol_ == "<")
-        {
-            return EvalOperation<T>(type, std::less<T>());
-        }
-        else if (op_symbol_ == "<=")
-        {
-            return EvalOperation<T>(type, std::less_equal<T>());
-        }
-        else if (op_symbol_ == ">")
-        {
-            return EvalOperation<T>(type, std::greater<T>());
-        }
-        else if (op_symbol_ == ">=")
-        {
-            return EvalOperation<T>(type, std::greater_equal<T>());
-        }
-        else if (op_symbol_ == "==")
-        {
-            return EvalOperation<T>(type, std::equal_to<T>());
-        }
-        else if (op_symbol_ == "!=")
-        {
-            return EvalOperation<T>(type, std::not_equal_to<T>());
-        }
-        else
+        const LeftChain::Spine<RelationalOp> spine = LeftChain::LeftSpine(*this);
+        ConstValue value = spine.back()->expression1_->Evaluate(context);
+        for (auto op = spine.rbegin(); op != spine.rend(); ++op)
         {
-            throw std::runtime_error("RelationalOp::HandleOperations called with invalid operator!");
+            value = EvaluateBinary((*op)->op_symbol_, value, (*op)->expression2_->Evaluate(context));
         }
+        return value;
     }
 
-    template <typename T, typename Op>
-    std::any RelationalOp::EvalOperation(TypeSpecifier type, Op op) const
+    bool RelationalOp::IsConstant(Context &context) const
     {
-        return op(std::any_cast<T>(expression1_->GetValue(type)),
-                  std::any_cast<T>(expression2_->GetValue(type)))
-                   ? std::any(1)
-                   : std::any(0);
+        return LeftChain::IsConstant(*this, context);
     }
 
 } // namespace ast
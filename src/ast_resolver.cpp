@@ -0,0 +1,29 @@
+#include "ast_resolver.hpp"
+
+namespace ast
+{
+    void Resolver::EnterFunction()
+    {
+        in_function_ = true;
+        variables_.EnterScope();
+        enums_.EnterScope();
+    }
+
+    void Resolver::ExitFunction()
+    {
+        enums_.ExitScope();
+        variables_.ExitScope();
+        in_function_ = false;
+    }
+
+    const Binding *Resolver::Find(SymbolId name) const
+    {
+        if (const Binding *const *binding = enums_.Find(name))
+        {
+            return *binding;
+        }
+        const Binding *const *binding = variables_.Find(name);
+        return (binding != nullptr) ? *binding : nullptr;
+    }
+
+} // namespace ast
@@ -1,11 +1,13 @@
 #include "ast_scope.hpp"
+#include "ast_resolver.hpp"
+#include "ast_lowering.hpp"
 #include <cerrno>
 #include <vector>
 
 namespace ast
 {
 
-    void Scope::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void Scope::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         // TODO: check if statements is empty
 
@@ -27,6 +29,20 @@ namespace ast
         }
     }
 
+    void Scope::Resolve(Resolver &resolver) const
+    {
+        // same scopes as EmitRISC: none at global scope
+        if (resolver.InFunction())
+        {
+            resolver.EnterScope();
+        }
+        statements_.Resolve(resolver);
+        if (resolver.InFunction())
+        {
+            resolver.ExitScope();
+        }
+    }
+
     void Scope::Print(std::ostream &stream) const
     {
         for (auto const &statement : statements_)
@@ -34,4 +50,10 @@ namespace ast
             statement->Print(stream);
         }
     }
+
+    LoweredValue Scope::Lower(Lowering &lowering) const
+    {
+        // locals are found by declaration, so a scope needs nothing of its own
+        return statements_.Lower(lowering);
+    }
 }
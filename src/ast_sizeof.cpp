@@ -1,11 +1,12 @@
 #include "ast_sizeof.hpp"
 #include "ast_context.hpp"
 #include "ast_type_specifier.hpp"
+#include "ast_lowering.hpp"
 #include <iostream>
 
 namespace ast
 {
-    void SizeOfVar::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void SizeOfVar::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         (void)type; // Unused
 
@@ -14,7 +15,15 @@ namespace ast
         int size = GetTypeSize(expr_type);
 
         // Load the size into the destination register
-        stream << "li " << context.GetRegString(destReg) << ", " << size << " # sizeof(expression)" << std::endl;
+        stream << "li " << context.GetRegString(destReg) << ", " << size << " # sizeof(expression)" << "\n";
+    }
+
+    void SizeOfVar::Resolve(Resolver &resolver) const
+    {
+        if (expression_ != nullptr)
+        {
+            expression_->Resolve(resolver);
+        }
     }
 
     void SizeOfVar::Print(std::ostream &stream) const
@@ -24,13 +33,24 @@ namespace ast
         stream << ")";
     }
 
+    ConstValue SizeOfVar::Evaluate(Context &context) const
+    {
+        return ConstValue::Int(GetTypeSize(expression_->GetType(context)));
+    }
+
+    bool SizeOfVar::IsConstant(Context &context) const
+    {
+        (void)context;
+        return true;
+    }
+
     TypeSpecifier SizeOfVar::GetType(Context &context) const
     {
         (void)context; // Unused
         return TypeSpecifier::INT;
     }
 
-    void SizeOfType::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void SizeOfType::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         (void)type; // Unused
 
@@ -38,7 +58,12 @@ namespace ast
         int size = GetTypeSize(type_);
 
         // Load the size into the destination register
-        stream << "li " << context.GetRegString(destReg) << ", " << size << " # sizeof(type)" << std::endl;
+        stream << "li " << context.GetRegString(destReg) << ", " << size << " # sizeof(type)" << "\n";
+    }
+
+    LoweredValue SizeOfType::Lower(Lowering &lowering) const
+    {
+        return {lowering.Const(GetTypeSize(type_)), {.base = TypeSpecifier::UNSIGNED}};
     }
 
     void SizeOfType::Print(std::ostream &stream) const
@@ -46,9 +71,28 @@ namespace ast
         stream << "sizeof(" << type_ << ")";
     }
 
+    ConstValue SizeOfType::Evaluate(Context &context) const
+    {
+        (void)context;
+        return ConstValue::Int(GetTypeSize(type_));
+    }
+
+    bool SizeOfType::IsConstant(Context &context) const
+    {
+        (void)context;
+        return true;
+    }
+
     TypeSpecifier SizeOfType::GetType(Context &context) const
     {
         (void)context; // Unused
         return TypeSpecifier::INT;
     }
+
+    LoweredValue SizeOfVar::Lower(Lowering &lowering) const
+    {
+        // unlike GetType, TypeOf knows arrays and pointers
+        int size = Lowering::SizeOf(lowering.TypeOf(*expression_));
+        return {lowering.Const(size), {.base = TypeSpecifier::UNSIGNED}};
+    }
 }
@@ -1,12 +1,13 @@
 #include "ast_switch_case.hpp"
 #include "ast_scope.hpp"
+#include "ast_lowering.hpp"
 #include <ostream>
 #include <map>
 #include <algorithm>
 
 namespace ast
 {
-    void SwitchStatement::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void SwitchStatement::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         // ----------------  PREREQS and CODE GENERATION FOR SWITCH ----------------
 
@@ -63,21 +64,27 @@ namespace ast
         // check where to jump to case labels
         for (const auto &caseInfo : cases)
         {
+            ConstValue case_value = caseInfo.stmt->GetCondition()->Evaluate(context);
+            if (!case_value.IsInteger())
+            {
+                throw std::runtime_error("SwitchStatement: case label is not an integer constant");
+            }
             int case_reg = context.AssignRegister(TypeSpecifier::INT);
-            caseInfo.stmt->GetCondition()->EmitRISC(stream, context, case_reg, TypeSpecifier::INT);
+            stream << "li " << context.GetRegString(case_reg) << ", " << case_value.AsInt() << "\n";
             stream << "beq " << context.GetRegString(switch_reg) << ", "
-                   << context.GetRegString(case_reg) << ", " << caseInfo.label << std::endl;
+                   << context.GetRegString(case_reg) << ", " << caseInfo.label << "\n";
             context.FreeRegister(case_reg);
         }
+        context.FreeRegister(switch_reg); // dead once dispatched, so calls in the cases don't save it
 
         // jump to default or end if no cases match
         if (defaultStatement)
         {
-            stream << "j " << defaultLabel << std::endl;
+            stream << "j " << defaultLabel << "\n";
         }
         else
         {
-            stream << "j " << endLabel << std::endl;
+            stream << "j " << endLabel << "\n";
         }
 
         // ----------------  CODE GENERATION FOR CASES ----------------
@@ -100,7 +107,7 @@ namespace ast
             auto labelIt = positionToLabel.find(position);
             if (labelIt != positionToLabel.end())
             {
-                stream << labelIt->second << ":" << std::endl;
+                stream << labelIt->second << ":" << "\n";
             }
 
             if (const CaseStatement *caseStmt = dynamic_cast<const CaseStatement *>(node.get()))
@@ -128,25 +135,42 @@ namespace ast
             position++;
         }
 
-        stream << endLabel << ":" << std::endl;
-        context.FreeRegister(switch_reg);
+        stream << endLabel << ":" << "\n";
         context.EndLoopContext();
     }
 
+    void SwitchStatement::Resolve(Resolver &resolver) const
+    {
+        expression_->Resolve(resolver);
+        if (statement_ != nullptr)
+        {
+            statement_->Resolve(resolver);
+        }
+    }
+
     void SwitchStatement::Print(std::ostream &stream) const
     {
         stream << "switch (";
         expression_->Print(stream);
-        stream << ") {" << std::endl;
+        stream << ") {" << "\n";
         statement_->Print(stream);
-        stream << "}" << std::endl;
+        stream << "}" << "\n";
     };
 
-    void CaseStatement::EmitRISC(std::ostream &, Context &, int, TypeSpecifier) const
+    void CaseStatement::EmitRISC(AsmWriter &, Context &, int, TypeSpecifier) const
     {
         // The actual code emission happens in SwitchStatement::EmitRISC
     }
 
+    void CaseStatement::Resolve(Resolver &resolver) const
+    {
+        condition_->Resolve(resolver);
+        if (body_ != nullptr)
+        {
+            body_->Resolve(resolver);
+        }
+    }
+
     void CaseStatement::Print(std::ostream &stream) const
     {
         stream << "case ";
@@ -155,14 +179,97 @@ namespace ast
         GetBody()->Print(stream);
     }
 
-    void DefaultStatement::EmitRISC(std::ostream &, Context &, int, TypeSpecifier) const
+    void DefaultStatement::EmitRISC(AsmWriter &, Context &, int, TypeSpecifier) const
     {
         // The actual code emission happens in SwitchStatement::EmitRISC
     }
 
+    void DefaultStatement::Resolve(Resolver &resolver) const
+    {
+        if (body_ != nullptr)
+        {
+            body_->Resolve(resolver);
+        }
+    }
+
     void DefaultStatement::Print(std::ostream &stream) const
     {
         stream << "default: ";
         GetBody()->Print(stream);
     }
+
+    LoweredValue SwitchStatement::Lower(Lowering &lowering) const
+    {
+        if (!GetExpression() || !GetStatement())
+        {
+            return {};
+        }
+        const Scope *scope = dynamic_cast<const Scope *>(GetStatement());
+        if (!scope)
+        {
+            Unsupported("switch without a compound statement");
+        }
+        LoweredValue value = lowering.Promote(GetExpression()->Lower(lowering));
+        if (!value.type.IsInteger())
+        {
+            throw std::runtime_error("SwitchStatement: switch quantity is not an integer");
+        }
+
+        // a chain of comparisons, in the order of the case labels, then the default
+        const NodeList &nodes = scope->GetNodes();
+        std::vector<ir::BlockId> labels(nodes.Size(), ir::NO_BLOCK);
+        ir::BlockId end_block = lowering.NewBlock();
+        ir::BlockId default_block = end_block;
+        for (size_t i = 0; i < nodes.Size(); i++)
+        {
+            if (const CaseStatement *caseStmt = dynamic_cast<const CaseStatement *>(nodes[i].get()))
+            {
+                ConstValue case_value = caseStmt->GetCondition()->Evaluate(lowering.GetContext());
+                if (!case_value.IsInteger())
+                {
+                    throw std::runtime_error("SwitchStatement: case label is not an integer constant");
+                }
+                labels[i] = lowering.NewBlock();
+                ir::BlockId next = lowering.NewBlock();
+                ir::VReg matches = lowering.Binary(ir::Op::EQ, value.reg, lowering.Const(case_value.AsInt()));
+                lowering.Branch(matches, labels[i], next);
+                lowering.SetBlock(next);
+            }
+            else if (dynamic_cast<const DefaultStatement *>(nodes[i].get()))
+            {
+                labels[i] = lowering.NewBlock();
+                default_block = labels[i];
+            }
+        }
+        lowering.Jump(default_block);
+
+        // the statements in order, falling through from one label to the next
+        lowering.EnterSwitch(end_block);
+        for (size_t i = 0; i < nodes.Size(); i++)
+        {
+            if (labels[i] != ir::NO_BLOCK)
+            {
+                lowering.Jump(labels[i]);
+                lowering.SetBlock(labels[i]);
+            }
+            const Node *body = nodes[i].get();
+            if (const CaseStatement *caseStmt = dynamic_cast<const CaseStatement *>(body))
+            {
+                body = caseStmt->GetBody();
+            }
+            else if (const DefaultStatement *defStmt = dynamic_cast<const DefaultStatement *>(body))
+            {
+                body = defStmt->GetBody();
+            }
+            if (body != nullptr)
+            {
+                body->LowerStatement(lowering);
+            }
+        }
+        lowering.ExitLoop();
+        lowering.Jump(end_block);
+
+        lowering.SetBlock(end_block);
+        return {};
+    }
 }
@@ -0,0 +1,75 @@
+#include "ast_symbol.hpp"
+
+#include <stdexcept>
+
+namespace ast
+{
+    namespace
+    {
+        thread_local SymbolTable *current_table = nullptr;
+
+        SymbolTable &ProcessTable()
+        {
+            static SymbolTable table;
+            return table;
+        }
+    }
+
+    SymbolTable::~SymbolTable()
+    {
+        for (auto &chunk : chunks_)
+        {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    SymbolId SymbolTable::Intern(std::string_view spelling)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = ids_.find(spelling);
+        if (it != ids_.end())
+        {
+            return it->second;
+        }
+
+        size_t chunk_index = count_ >> CHUNK_BITS;
+        if (chunk_index >= MAX_CHUNKS)
+        {
+            throw std::runtime_error("Too many distinct identifiers");
+        }
+        std::string *chunk = chunks_[chunk_index].load(std::memory_order_relaxed);
+        if (chunk == nullptr)
+        {
+            chunk = new std::string[CHUNK_SIZE];
+            chunks_[chunk_index].store(chunk, std::memory_order_release);
+        }
+
+        std::string &stored = chunk[count_ & (CHUNK_SIZE - 1)];
+        stored.assign(spelling);
+        SymbolId id = static_cast<SymbolId>(count_++);
+        ids_.emplace(stored, id);
+        return id;
+    }
+
+    const std::string &SymbolTable::Spelling(SymbolId id) const
+    {
+        size_t index = static_cast<size_t>(id);
+        return chunks_[index >> CHUNK_BITS].load(std::memory_order_acquire)[index & (CHUNK_SIZE - 1)];
+    }
+
+    SymbolTable &SymbolTable::Current()
+    {
+        return (current_table != nullptr) ? *current_table : ProcessTable();
+    }
+
+    void SymbolTable::SetCurrent(SymbolTable *table)
+    {
+        current_table = table;
+    }
+
+    SymbolScope::SymbolScope(SymbolTable &table) : previous_(current_table)
+    {
+        SymbolTable::SetCurrent(&table);
+    }
+
+} // namespace ast
@@ -0,0 +1,137 @@
+#include "ast_thread_pool.hpp"
+
+namespace ast
+{
+    ThreadPool::ThreadPool(unsigned n_workers)
+    {
+        // one queue per worker, plus one for threads outside the pool
+        for (unsigned i = 0; i <= n_workers; i++)
+        {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        for (unsigned i = 0; i < n_workers; i++)
+        {
+            workers_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread &worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::RunAll(std::vector<Task> &tasks)
+    {
+        if (tasks.empty())
+        {
+            return;
+        }
+
+        Group group;
+        group.remaining = tasks.size();
+
+        // deal the jobs round-robin; idle workers steal to even out the load
+        {
+            std::lock_guard<std::mutex> sleep_lock(sleep_mutex_);
+            for (Task &task : tasks)
+            {
+                Queue &queue = *queues_[next_queue_];
+                next_queue_ = (next_queue_ + 1) % queues_.size();
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.jobs.push_back({&task, &group});
+            }
+            queued_ += tasks.size();
+        }
+        wake_.notify_all();
+
+        // help until every job of the group is finished
+        while (true)
+        {
+            {
+                std::lock_guard<std::mutex> lock(group.mutex);
+                if (group.remaining == 0)
+                {
+                    break;
+                }
+            }
+            if (!TryRunOne(workers_.size()))
+            {
+                // the rest of the group is running on other threads
+                std::unique_lock<std::mutex> lock(group.mutex);
+                group.done.wait(lock, [&group]
+                                { return group.remaining == 0; });
+                break;
+            }
+        }
+    }
+
+    bool ThreadPool::TryRunOne(size_t home)
+    {
+        Job job = {nullptr, nullptr};
+        for (size_t i = 0; i < queues_.size() && job.task == nullptr; i++)
+        {
+            Queue &queue = *queues_[(home + i) % queues_.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.jobs.empty())
+            {
+                continue;
+            }
+            // own queue is used as a stack, other queues are stolen from the front
+            if (i == 0)
+            {
+                job = queue.jobs.back();
+                queue.jobs.pop_back();
+            }
+            else
+            {
+                job = queue.jobs.front();
+                queue.jobs.pop_front();
+            }
+        }
+        if (job.task == nullptr)
+        {
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            queued_--;
+        }
+        (*job.task)();
+
+        // the waiting thread may destroy the group as soon as the lock is released
+        std::lock_guard<std::mutex> lock(job.group->mutex);
+        if (--job.group->remaining == 0)
+        {
+            job.group->done.notify_all();
+        }
+        return true;
+    }
+
+    void ThreadPool::WorkerLoop(size_t index)
+    {
+        while (true)
+        {
+            if (TryRunOne(index))
+            {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            wake_.wait(lock, [this]
+                       { return stopping_ || queued_ > 0; });
+            if (stopping_ && queued_ == 0)
+            {
+                return;
+            }
+        }
+    }
+
+} // namespace ast
@@ -0,0 +1,203 @@
+#include "ast_time_report.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace ast
+{
+    namespace
+    {
+        double Seconds(std::chrono::nanoseconds duration)
+        {
+            return std::chrono::duration<double>(duration).count();
+        }
+
+        double Microseconds(std::chrono::nanoseconds duration)
+        {
+            return std::chrono::duration<double, std::micro>(duration).count();
+        }
+
+        void WriteJsonString(std::ostream &stream, std::string_view text)
+        {
+            stream << '"';
+            for (char c : text)
+            {
+                switch (c)
+                {
+                case '"':
+                    stream << "\\\"";
+                    break;
+                case '\\':
+                    stream << "\\\\";
+                    break;
+                case '\n':
+                    stream << "\\n";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec << std::setfill(' ');
+                    }
+                    else
+                    {
+                        stream << c;
+                    }
+                }
+            }
+            stream << '"';
+        }
+    }
+
+    TimeReport::TimeReport() : origin_(Clock::now()), origin_cpu_(ProcessCpuTime())
+    {
+    }
+
+    void TimeReport::Record(std::string_view phase, std::string name, Clock::time_point start, Clock::time_point end, std::chrono::nanoseconds cpu)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto [thread, inserted] = threads_.emplace(std::this_thread::get_id(), threads_.size());
+        slices_.push_back({std::string(phase), std::move(name), start - origin_, end - start, cpu, thread->second});
+    }
+
+    void TimeReport::Count(std::string_view counter, size_t n)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find_if(counters_.begin(), counters_.end(), [&](const auto &entry)
+                               { return entry.first == counter; });
+        if (it == counters_.end())
+        {
+            counters_.emplace_back(counter, n);
+            return;
+        }
+        it->second += n;
+    }
+
+    void TimeReport::PrintSummary(std::ostream &stream) const
+    {
+        struct Total
+        {
+            std::string phase;
+            std::chrono::nanoseconds wall{0};
+            std::chrono::nanoseconds cpu{0};
+            size_t count = 0;
+        };
+
+        std::vector<Total> totals;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const Slice &slice : slices_)
+            {
+                auto it = totals.begin();
+                while (it != totals.end() && it->phase != slice.phase)
+                {
+                    ++it;
+                }
+                if (it == totals.end())
+                {
+                    totals.push_back({slice.phase});
+                    it = totals.end() - 1;
+                }
+                it->wall += slice.wall;
+                it->cpu += slice.cpu;
+                it->count++;
+            }
+        }
+
+        // slices of a phase may overlap when they ran on different threads, so walls can add up to
+        // more than the elapsed time
+        stream << "Execution times (seconds)\n";
+        stream << std::left << std::setw(16) << " phase" << std::right << std::setw(12) << "wall" << std::setw(12) << "cpu" << std::setw(10) << "slices" << "\n";
+        stream << std::fixed << std::setprecision(6);
+        for (const Total &total : totals)
+        {
+            stream << " " << std::left << std::setw(15) << total.phase << std::right
+                   << std::setw(12) << Seconds(total.wall) << std::setw(12) << Seconds(total.cpu) << std::setw(10) << total.count << "\n";
+        }
+        stream << " " << std::left << std::setw(15) << "TOTAL" << std::right
+               << std::setw(12) << Seconds(Clock::now() - origin_) << std::setw(12) << Seconds(ProcessCpuTime() - origin_cpu_) << "\n";
+        stream << std::defaultfloat;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (counters_.empty())
+        {
+            return;
+        }
+        stream << "Counts\n";
+        for (const auto &[counter, n] : counters_)
+        {
+            stream << " " << std::left << std::setw(39) << counter << std::right << std::setw(10) << n << "\n";
+        }
+    }
+
+    void TimeReport::WriteTrace(const std::string &path) const
+    {
+        std::ofstream trace(path, std::ios::trunc);
+        if (!trace)
+        {
+            throw std::runtime_error("Couldn't open trace file " + path);
+        }
+
+        trace << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        trace << std::fixed << std::setprecision(3);
+        std::lock_guard<std::mutex> lock(mutex_);
+        bool first = true;
+        for (const Slice &slice : slices_)
+        {
+            trace << (first ? "\n" : ",\n");
+            first = false;
+            trace << "{\"name\":";
+            WriteJsonString(trace, slice.name.empty() ? slice.phase : slice.name);
+            trace << ",\"cat\":";
+            WriteJsonString(trace, slice.phase);
+            trace << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << slice.thread
+                  << ",\"ts\":" << Microseconds(slice.start) << ",\"dur\":" << Microseconds(slice.wall)
+                  << ",\"args\":{\"cpu_us\":" << Microseconds(slice.cpu) << "}}";
+        }
+        trace << "\n]}\n";
+
+        if (!trace)
+        {
+            throw std::runtime_error("Couldn't write trace file " + path);
+        }
+    }
+
+    std::chrono::nanoseconds TimeReport::ThreadCpuTime()
+    {
+        timespec now;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+    }
+
+    std::chrono::nanoseconds TimeReport::ProcessCpuTime()
+    {
+        timespec now;
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+        return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+    }
+
+    PhaseTimer::PhaseTimer(TimeReport *report, std::string_view phase, std::string_view name)
+        : report_(report), phase_(phase)
+    {
+        if (report_ == nullptr)
+        {
+            return;
+        }
+        name_.assign(name);
+        cpu_start_ = TimeReport::ThreadCpuTime();
+        start_ = TimeReport::Clock::now();
+    }
+
+    PhaseTimer::~PhaseTimer()
+    {
+        if (report_ == nullptr)
+        {
+            return;
+        }
+        TimeReport::Clock::time_point end = TimeReport::Clock::now();
+        report_->Record(phase_, std::move(name_), start_, end, TimeReport::ThreadCpuTime() - cpu_start_);
+    }
+
+} // namespace ast
@@ -1,45 +1,297 @@
 #include "ast_translation_unit.hpp"
+#include "ast_function_definition.hpp"
+#include "ast_lowering.hpp"
+#include "ast_thread_pool.hpp"
+#include "ast_time_report.hpp"
+#include "compile_cache.hpp"
+#include "ir_passes.hpp"
+#include "ir_riscv.hpp"
+#include <optional>
+#include <sstream>
 #include <stdexcept>
 
 namespace ast
 {
-    void TranslationUnit::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    namespace
     {
-        external_declarations_->EmitRISC(stream, context, destReg, type);
-        std::vector<LiteralConstant> literal_constants = context.GetLiteralConstants();
-        if (literal_constants.size() == 0)
+        // output of one external declaration, kept apart until everything is concatenated in source order
+        struct Chunk
         {
-            return;
+            AsmWriter text;
+            AsmWriter rodata; // literal constants of a function
+            std::exception_ptr error;
+            std::string error_state; // DumpFunctionState output for a failed function
+
+            explicit Chunk(const AsmWriter &parent) : text(AsmWriter::Chunk(parent)), rodata(AsmWriter::Chunk(parent)) {}
+        };
+
+        // a function body left for after the pre-pass
+        struct PendingFunction
+        {
+            const FunctionDefinition *function;
+            Chunk *chunk;
+            size_t visible_functions; // functions declared up to and including this one
+        };
+
+        void EmitLiteralConstants(AsmWriter &stream, const Context &context)
+        {
+            const std::vector<LiteralConstant> &literal_constants = context.GetLiteralConstants();
+            for (size_t i = 0; i < literal_constants.size(); i++)
+            {
+                const LiteralConstant &literal_constant = literal_constants[i];
+                // aligned before the label, which would otherwise point at the padding
+                if (literal_constant.type == TypeSpecifier::FLOAT)
+                {
+                    stream << ".align 2" << "\n";
+                }
+                else if (literal_constant.type == TypeSpecifier::DOUBLE)
+                {
+                    stream << ".align 3" << "\n";
+                }
+                stream << context.GetLiteralLabel(i) << ":" << "\n";
+                switch (literal_constant.type)
+                {
+                case TypeSpecifier::FLOAT:
+                {
+                    union FloatUnion f_union = {.f = static_cast<float>(literal_constant.value)};
+                    stream << ".word " << f_union.rep << "\n";
+                    break;
+                }
+                case TypeSpecifier::DOUBLE:
+                {
+                    union DoubleUnion d_union = {.d = literal_constant.value};
+                    stream << ".word " << d_union.reps[0] << "\n";
+                    stream << ".word " << d_union.reps[1] << "\n";
+                    break;
+                }
+                case TypeSpecifier::STRING:
+                {
+                    stream << ".string " << literal_constant.str << "\n";
+                    break;
+                }
+                default:
+                    throw std::runtime_error("TranslationUnit: Invalid Type.");
+                }
+            }
+        }
+
+        // a cached function is only used if both of its chunks could be read back
+        bool FetchFunction(FunctionCache &cache, const std::string &key, Chunk &chunk)
+        {
+            std::string entry;
+            if (!cache.Fetch(key, entry))
+            {
+                return false;
+            }
+            std::string_view data = entry;
+            AsmWriter text = AsmWriter::Chunk(chunk.text);
+            AsmWriter rodata = AsmWriter::Chunk(chunk.rodata);
+            if (!AsmWriter::Deserialize(data, text) || !AsmWriter::Deserialize(data, rodata) || !data.empty())
+            {
+                return false;
+            }
+            chunk.text = std::move(text);
+            chunk.rodata = std::move(rodata);
+            return true;
+        }
+
+        // Generates a function through the IR into chunk. Returns false if the function uses something
+        // the lowering doesn't support, having written nothing but a note for -fdump-ir.
+        bool GenerateFunctionIR(const FunctionDefinition &function, size_t visible_functions, const Context &unit, Chunk &chunk)
+        {
+            Context context(unit.GetGlobals(), function.GetID(), visible_functions);
+            context.SetTimeReport(unit.GetTimeReport());
+            ir::Function ir_function;
+            try
+            {
+                ir_function = LowerFunction(function, context);
+                PhaseTimer timer(unit.GetTimeReport(), "ir optimize", Spelling(function.GetID()));
+                ir::Optimize(ir_function);
+            }
+            catch (const std::exception &e)
+            {
+                if (unit.DumpsIR())
+                {
+                    chunk.text << "# " << function.GetID() << " not lowered: " << e.what() << "\n";
+                }
+                return false;
+            }
+
+            if (unit.DumpsIR())
+            {
+                std::ostringstream text;
+                ir::Print(text, ir_function);
+                std::istringstream lines(text.str());
+                for (std::string line; std::getline(lines, line);)
+                {
+                    chunk.text << "# " << line << "\n";
+                }
+            }
+            ir::EmitFunction(chunk.text, ir_function, context);
+            EmitLiteralConstants(chunk.rodata, context);
+            return true;
+        }
+
+        // unit is the context of the translation unit, read by every function; the body can only call
+        // the first visible_functions functions the unit declared
+        void GenerateFunction(const FunctionDefinition &function, size_t visible_functions, const Context &unit, Chunk &chunk)
+        {
+            TimeReport *time_report = unit.GetTimeReport();
+            FunctionCache *cache = unit.GetFunctionCache();
+            PhaseTimer timer(time_report, "codegen", Spelling(function.GetID()));
+            std::string key = (cache != nullptr) ? cache->Key(function.GetSourceSpan()) : "";
+            if (!key.empty() && FetchFunction(*cache, key, chunk))
+            {
+                return;
+            }
+
+            std::optional<Context> context; // outlives the try block, so a failure can still dump it
+            try
+            {
+                if (!unit.UsesIR() || !GenerateFunctionIR(function, visible_functions, unit, chunk))
+                {
+                    context.emplace(unit.GetGlobals(), function.GetID(), visible_functions);
+                    context->SetTimeReport(time_report);
+                    function.EmitRISC(chunk.text, *context, -1, TypeSpecifier::VOID);
+                    EmitLiteralConstants(chunk.rodata, *context);
+                }
+                if (!key.empty())
+                {
+                    std::string entry;
+                    chunk.text.Serialize(entry);
+                    chunk.rodata.Serialize(entry);
+                    cache->Store(key, entry);
+                }
+            }
+            catch (...)
+            {
+                // rethrown by the generating thread once every function has finished
+                std::ostringstream state;
+                DumpFunctionState(state);
+                ClearFunctionState();
+                chunk.error_state = state.str();
+                chunk.error = std::current_exception();
+            }
         }
-        stream << ".section .rodata" << std::endl;
-        for (size_t i = 0; i < literal_constants.size(); i++)
+    }
+
+    void TranslationUnit::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
+    {
+        const NodeList &external_declarations = dynamic_cast<const NodeList &>(*external_declarations_);
+        std::vector<std::unique_ptr<Chunk>> chunks;
+        std::vector<PendingFunction> functions;
+
+        // pre-pass in source order: emit global declarations and declare every function, so the
+        // global context is complete before any function body is generated. Each body still only
+        // sees what was declared before it: globals through Resolve, functions through visible_functions
+        TimeReport *time_report = context.GetTimeReport();
+        {
+            PhaseTimer timer(time_report, "declarations");
+            for (const auto &node : external_declarations)
+            {
+                if (node == nullptr)
+                {
+                    continue;
+                }
+                chunks.push_back(std::make_unique<Chunk>(stream));
+                Chunk &chunk = *chunks.back();
+                if (const FunctionDefinition *function = dynamic_cast<const FunctionDefinition *>(node.get()))
+                {
+                    function->Declare(context);
+                    functions.push_back({function, &chunk, context.GetGlobals().FunctionCount()});
+                    continue;
+                }
+                TypeSpecifier node_type = node->GetType(context);
+                if (type == TypeSpecifier::VOID && node_type != TypeSpecifier::VOID)
+                {
+                    int tmpDestReg = context.AssignRegister(node_type);
+                    node->EmitRISC(chunk.text, context, tmpDestReg, node_type);
+                    context.FreeRegister(tmpDestReg);
+                }
+                else
+                {
+                    node->EmitRISC(chunk.text, context, destReg, type);
+                }
+            }
+        }
+
+        // a function's cache key covers the file without function bodies
+        FunctionCache *cache = context.GetFunctionCache();
+        if (cache != nullptr)
         {
-            LiteralConstant literal_constant = literal_constants[i];
-            stream << ".LC" << i << ":" << std::endl;
-            switch (literal_constant.type)
+            std::vector<SourceSpan> bodies;
+            for (const PendingFunction &pending : functions)
             {
-            case TypeSpecifier::FLOAT:
+                bodies.push_back(pending.function->GetBodySpan());
+            }
+            cache->SetBodies(bodies);
+        }
+
+        // function bodies only read the global context, so they can be generated in any order
+        ThreadPool *thread_pool = context.GetThreadPool();
+        if (thread_pool != nullptr && functions.size() > 1)
+        {
+            std::vector<ThreadPool::Task> tasks;
+            SymbolTable &symbols = SymbolTable::Current(); // the pool may be shared by other compiles
+            for (const PendingFunction &pending : functions)
             {
-                union FloatUnion f_union = {.f = static_cast<float>(literal_constant.value)};
-                stream << ".align 2" << std::endl;
-                stream << ".word " << f_union.rep << std::endl;
-                break;
+                tasks.push_back([pending, &context, &symbols]
+                                {
+                                    SymbolScope symbol_scope(symbols);
+                                    GenerateFunction(*pending.function, pending.visible_functions, context, *pending.chunk); });
             }
-            case TypeSpecifier::DOUBLE:
+            thread_pool->RunAll(tasks);
+        }
+        else
+        {
+            for (const PendingFunction &pending : functions)
             {
-                union DoubleUnion d_union = {.d = literal_constant.value};
-                stream << ".align 3" << std::endl;
-                stream << ".word " << d_union.reps[0] << std::endl;
-                stream << ".word " << d_union.reps[1] << std::endl;
-                break;
+                GenerateFunction(*pending.function, pending.visible_functions, context, *pending.chunk);
             }
-            case TypeSpecifier::STRING:
+        }
+
+        // report the first failure in source order, as a sequential run would have
+        for (const PendingFunction &pending : functions)
+        {
+            if (pending.chunk->error)
             {
-                stream << ".string " << literal_constant.str << std::endl;
-                break;
+                context.GetDiagnostics() << pending.chunk->error_state;
+                std::rethrow_exception(pending.chunk->error);
             }
-            default:
-                throw std::runtime_error("TranslationUnit: Invalid Type.");
+        }
+
+        PhaseTimer timer(time_report, "splice");
+        for (const auto &chunk : chunks)
+        {
+            stream.Splice(chunk->text);
+        }
+
+        bool has_literals = !context.GetLiteralConstants().empty();
+        for (const auto &chunk : chunks)
+        {
+            has_literals = has_literals || chunk->rodata.Size() > 0;
+        }
+        if (!has_literals)
+        {
+            return;
+        }
+        stream.Section(".section .rodata");
+        EmitLiteralConstants(stream, context);
+        for (const auto &chunk : chunks)
+        {
+            stream.Splice(chunk->rodata);
+        }
+    }
+
+    void TranslationUnit::Resolve(Resolver &resolver) const
+    {
+        // in source order, so a function body only sees the globals declared before it
+        const NodeList &external_declarations = dynamic_cast<const NodeList &>(*external_declarations_);
+        for (const auto &node : external_declarations)
+        {
+            if (node != nullptr)
+            {
+                node->Resolve(resolver);
             }
         }
     }
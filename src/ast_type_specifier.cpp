@@ -1,112 +1,117 @@
 #include "ast_type_specifier.hpp"
 
+#include <array>
+
 namespace ast
 {
-    const std::unordered_map<TypeSpecifier, std::string> storeOp = {
-        {TypeSpecifier::INT, "sw"},
-        {TypeSpecifier::CHAR, "sb"},
-        {TypeSpecifier::UNSIGNED, "sw"},
-        {TypeSpecifier::FLOAT, "fsw"},
-        {TypeSpecifier::DOUBLE, "fsd"},
-    };
+    namespace
+    {
+        constexpr size_t N_TYPES = static_cast<size_t>(TypeSpecifier::VOID) + 1;
 
-    const std::unordered_map<TypeSpecifier, std::string> loadOp = {
-        {TypeSpecifier::INT, "lw"},
-        {TypeSpecifier::UNSIGNED, "lw"},
-        {TypeSpecifier::CHAR, "lbu"},
-        {TypeSpecifier::FLOAT, "flw"},
-        {TypeSpecifier::DOUBLE, "fld"},
-    };
+        // indexed by TypeSpecifier; an empty op or a negative size marks a type without one
+        template <typename Value>
+        using TypeTable = std::array<Value, N_TYPES>;
 
-    const std::unordered_map<TypeSpecifier, int> typeSize = {
-        {TypeSpecifier::INT, 4},
-        {TypeSpecifier::UNSIGNED, 4},
-        {TypeSpecifier::FLOAT, 4},
-        {TypeSpecifier::DOUBLE, 8},
-        {TypeSpecifier::CHAR, 1},
-        {TypeSpecifier::VOID, 0},
-    };
+        //                                               INT    FLOAT    DOUBLE   UNSIGNED CHAR   STRING VOID
+        constexpr TypeTable<std::string_view> storeOp = {"sw",  "fsw",   "fsd",   "sw",    "sb",  "",    ""};
+        constexpr TypeTable<std::string_view> loadOp =  {"lw",  "flw",   "fld",   "lw",    "lbu", "",    ""};
+        constexpr TypeTable<std::string_view> moveOp =  {"mv",  "fmv.s", "fmv.d", "mv",    "mv",  "",    ""};
+        constexpr TypeTable<int> typeSize =             {4,     4,       8,       4,       1,     -1,    0};
+        constexpr TypeTable<int> typeSizeForStack =     {4,     4,       8,       4,       4,     -1,    0};
 
-    const std::unordered_map<TypeSpecifier, int> typeSizeForStack = {
-        {TypeSpecifier::INT, 4},
-        {TypeSpecifier::UNSIGNED, 4},
-        {TypeSpecifier::FLOAT, 4},
-        {TypeSpecifier::DOUBLE, 8},
-        {TypeSpecifier::CHAR, 4},
-        {TypeSpecifier::VOID, 0},
-    };
+        // floating point variants of the integer ops that have one
+        struct FloatOp
+        {
+            std::string_view op;
+            std::string_view single;
+            std::string_view double_precision;
+        };
+        constexpr FloatOp floatOps[] = {
+            {"add", "fadd.s", "fadd.d"},
+            {"sub", "fsub.s", "fsub.d"},
+            {"mul", "fmul.s", "fmul.d"},
+            {"div", "fdiv.s", "fdiv.d"},
+            {"neg", "fneg.s", "fneg.d"},
+        };
 
-    const std::unordered_map<TypeSpecifier, std::string> moveOp = {
-        {TypeSpecifier::INT, "mv"},
-        {TypeSpecifier::UNSIGNED, "mv"},
-        {TypeSpecifier::CHAR, "mv"},
-        {TypeSpecifier::FLOAT, "fmv.s"},
-        {TypeSpecifier::DOUBLE, "fmv.d"},
-    };
+        template <typename Value>
+        constexpr Value Lookup(const TypeTable<Value> &table, TypeSpecifier type)
+        {
+            size_t index = static_cast<size_t>(type);
+            return (index < N_TYPES) ? table[index] : Value();
+        }
+
+        static_assert(Lookup(loadOp, TypeSpecifier::CHAR) == "lbu" && Lookup(typeSize, TypeSpecifier::DOUBLE) == 8);
+    }
 
     int GetTypeSize(TypeSpecifier type)
     {
-        if (typeSize.find(type) == typeSize.end())
+        int size = Lookup(typeSize, type);
+        if (size < 0)
         {
             throw std::runtime_error("Invalid type specifier for size");
         }
-        return typeSize.at(type);
+        return size;
     }
 
     int GetTypeSizeForStack(TypeSpecifier type)
     {
-        if (typeSizeForStack.find(type) == typeSizeForStack.end())
+        int size = Lookup(typeSizeForStack, type);
+        if (size < 0)
         {
             throw std::runtime_error("Invalid type specifier for size");
         }
-        return typeSizeForStack.at(type);
+        return size;
     }
 
-    std::string GetLoadOp(TypeSpecifier type)
+    std::string_view GetLoadOp(TypeSpecifier type)
     {
-        if (loadOp.find(type) == loadOp.end())
+        std::string_view op = Lookup(loadOp, type);
+        if (op.empty())
         {
             throw std::runtime_error("Invalid type specifier for load operation");
         }
-        return loadOp.at(type);
+        return op;
     }
 
-    std::string GetStoreOp(TypeSpecifier type)
+    std::string_view GetStoreOp(TypeSpecifier type)
     {
-        if (storeOp.find(type) == storeOp.end())
+        std::string_view op = Lookup(storeOp, type);
+        if (op.empty())
         {
             throw std::runtime_error("Invalid type specifier for store operation");
         }
-        return storeOp.at(type);
+        return op;
     }
 
-    std::string GetMoveOp(TypeSpecifier type)
+    std::string_view GetMoveOp(TypeSpecifier type)
     {
-        if (moveOp.find(type) == moveOp.end())
+        std::string_view op = Lookup(moveOp, type);
+        if (op.empty())
         {
             throw std::runtime_error("Invalid type specifier for move operation");
         }
-        return moveOp.at(type);
+        return op;
     }
 
-    std::string GetArithmeticOp(TypeSpecifier type, std::string op)
+    std::string_view GetArithmeticOp(TypeSpecifier type, std::string_view op)
     {
         if (type == TypeSpecifier::INT || type == TypeSpecifier::CHAR)
         {
             return op;
         }
-        else if (type == TypeSpecifier::FLOAT)
-        {
-            return "f" + op + ".s";
-        }
-        else if (type == TypeSpecifier::DOUBLE)
+        if (type != TypeSpecifier::FLOAT && type != TypeSpecifier::DOUBLE)
         {
-            return "f" + op + ".d";
+            throw std::runtime_error("Invalid type specifier for arithmetic operation");
         }
-        else
+        for (const FloatOp &float_op : floatOps)
         {
-            throw std::runtime_error("Invalid type specifier for arithmetic operation");
+            if (float_op.op == op)
+            {
+                return (type == TypeSpecifier::FLOAT) ? float_op.single : float_op.double_precision;
+            }
         }
+        throw std::runtime_error("Invalid floating point operation " + std::string(op));
     }
 
 }
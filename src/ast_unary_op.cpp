@@ -1,8 +1,14 @@
 #include "ast_unary_op.hpp"
-#include <functional>
+#include "ast_constant.hpp"
+#include "ast_lowering.hpp"
 
 namespace ast
 {
+    void UnaryOp::Resolve(Resolver &resolver) const
+    {
+        expression_->Resolve(resolver);
+    }
+
     void UnaryOp::Print(std::ostream &stream) const
     {
         stream << op_symbol_;
@@ -14,81 +20,96 @@ namespace ast
         return expression_->GetType(context);
     }
 
-    void UnaryMinusOp::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void UnaryMinusOp::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
+        if (IsConstant(context))
+        {
+            EmitConstant(stream, context, destReg, type, Evaluate(context));
+            return;
+        }
         expression_->EmitRISC(stream, context, destReg, type);
-        stream << GetArithmeticOp(type, "neg") << " " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << std::endl;
+        stream << GetArithmeticOp(type, "neg") << " " << context.GetRegString(destReg) << "," << context.GetRegString(destReg) << "\n";
     }
 
-    void UnaryPlusOp::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void UnaryPlusOp::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
+        if (IsConstant(context))
+        {
+            EmitConstant(stream, context, destReg, type, Evaluate(context));
+            return;
+        }
         expression_->EmitRISC(stream, context, destReg, type);
     }
 
-    void UnaryLogicalNotOp::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void UnaryLogicalNotOp::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
-        std::string destRegStr = context.GetRegString(destReg);
+        if (IsConstant(context))
+        {
+            EmitConstant(stream, context, destReg, type, Evaluate(context));
+            return;
+        }
+        std::string_view destRegStr = context.GetRegString(destReg);
 
         expression_->EmitRISC(stream, context, destReg, type);
-        stream << "seqz " << destRegStr << "," << destRegStr << std::endl;
-        stream << "andi " << destRegStr << "," << destRegStr << ",0xff" << std::endl;
+        stream << "seqz " << destRegStr << "," << destRegStr << "\n";
+        stream << "andi " << destRegStr << "," << destRegStr << ",0xff" << "\n";
     }
 
-    void UnaryBitwiseNotOp::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void UnaryBitwiseNotOp::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
+        if (IsConstant(context))
+        {
+            EmitConstant(stream, context, destReg, type, Evaluate(context));
+            return;
+        }
         expression_->EmitRISC(stream, context, destReg, type);
-        stream << "not " << context.GetRegString(destReg) << ", " << context.GetRegString(destReg) << std::endl;
+        stream << "not " << context.GetRegString(destReg) << ", " << context.GetRegString(destReg) << "\n";
     }
 
-    std::any UnaryOp::GetValue(TypeSpecifier type) const
+    LoweredValue UnaryMinusOp::Lower(Lowering &lowering) const
     {
-        if (type == TypeSpecifier::FLOAT)
-            return HandleFloatOperation<float>(type);
-        else if (type == TypeSpecifier::DOUBLE)
-            return HandleFloatOperation<double>(type);
-        else if (type == TypeSpecifier::INT || type == TypeSpecifier::CHAR)
-            return HandleIntOperation(type);
-        else
-            throw std::runtime_error("UnaryOp::GetValue called with invalid type!");
+        LoweredValue value = lowering.Promote(expression_->Lower(lowering));
+        if (!value.type.IsInteger() && !value.type.IsFloating())
+        {
+            Unsupported("negation of a pointer");
+        }
+        return {lowering.Unary(ir::Op::NEG, value.reg, Lowering::IRType(value.type)), value.type};
     }
 
-    std::any UnaryOp::HandleIntOperation(TypeSpecifier type) const
+    LoweredValue UnaryPlusOp::Lower(Lowering &lowering) const
     {
-        switch (op_symbol_)
+        return lowering.Promote(expression_->Lower(lowering));
+    }
+
+    LoweredValue UnaryLogicalNotOp::Lower(Lowering &lowering) const
+    {
+        LoweredValue value = expression_->Lower(lowering);
+        if (!value.type.IsScalar())
         {
-        case '-':
-            return EvalOperation<int>(type, std::negate<int>());
-        case '+':
-            return std::any_cast<int>(expression_->GetValue(type));
-        case '!':
-            return !std::any_cast<int>(expression_->GetValue(type)) ? std::any(1) : std::any(0);
-        case '~':
-            return EvalOperation<int>(type, std::bit_not<int>());
-        default:
-            throw std::runtime_error("UnaryOp Int Op: Invalid operation");
+            Unsupported("! of a non-scalar");
         }
+        ir::VReg zero = value.type.IsFloating() ? lowering.FConst(0, Lowering::IRType(value.type)) : lowering.Const(0);
+        return {lowering.Binary(ir::Op::EQ, value.reg, zero), {.base = TypeSpecifier::INT}};
     }
 
-    template <typename T>
-    std::any UnaryOp::HandleFloatOperation(TypeSpecifier type) const
+    LoweredValue UnaryBitwiseNotOp::Lower(Lowering &lowering) const
     {
-        switch (op_symbol_)
+        LoweredValue value = lowering.Promote(expression_->Lower(lowering));
+        if (!value.type.IsInteger())
         {
-        case '-':
-            return EvalOperation<T>(type, std::negate<float>());
-        case '+':
-            return std::any_cast<T>(expression_->GetValue(type));
-        case '!':
-            return !std::any_cast<T>(expression_->GetValue(type)) ? std::any(1) : std::any(0);
-        default:
-            throw std::runtime_error("UnaryOp Float Op: Invalid operation");
+            Unsupported("~ of a non-integer");
         }
+        return {lowering.Unary(ir::Op::NOT, value.reg, ir::Type::I32), value.type};
+    }
+
+    ConstValue UnaryOp::Evaluate(Context &context) const
+    {
+        return EvaluateUnary(std::string_view(&op_symbol_, 1), expression_->Evaluate(context));
     }
 
-    template <typename T, typename Op>
-    std::any UnaryOp::EvalOperation(TypeSpecifier type, Op op) const
+    bool UnaryOp::IsConstant(Context &context) const
     {
-        return std::any(op(std::any_cast<T>(expression_->GetValue(type))));
+        return expression_->IsConstant(context) && CanEvaluateUnary(std::string_view(&op_symbol_, 1), expression_->Evaluate(context));
     }
 
 } // namespace ast
@@ -1,34 +1,67 @@
 #include "ast_while.hpp"
+#include "ast_lowering.hpp"
 #include <ostream>
 
 namespace ast
 {
 
-    void WhileLoop::EmitRISC(std::ostream &stream, Context &context, int destReg, TypeSpecifier type) const
+    void WhileLoop::EmitRISC(AsmWriter &stream, Context &context, int destReg, TypeSpecifier type) const
     {
         std::string startLabel = context.GenerateUniqueLabel("while_start");
         std::string endLabel = context.GenerateUniqueLabel("while_end");
 
         context.NewLoopContext(ControlFlowType::WHILE, startLabel, endLabel, "");
 
-        stream << startLabel << ":" << std::endl;
+        stream << startLabel << ":" << "\n";
         int tmpConditionReg = context.AssignRegister(TypeSpecifier::INT);
         condition_->EmitRISC(stream, context, tmpConditionReg, TypeSpecifier::INT);
-        stream << "beq " << context.GetRegString(tmpConditionReg) << ", zero, " << endLabel << std::endl;
+        stream << "beq " << context.GetRegString(tmpConditionReg) << ", zero, " << endLabel << "\n";
+        context.FreeRegister(tmpConditionReg); // dead in the body, so calls there don't save it
         body_->EmitRISC(stream, context, destReg, type);
-        stream << "j " << startLabel << std::endl;
-        stream << endLabel << ":" << std::endl;
+        stream << "j " << startLabel << "\n";
+        stream << endLabel << ":" << "\n";
 
-        context.FreeRegister(tmpConditionReg);
         context.EndLoopContext();
     }
 
+    void WhileLoop::Resolve(Resolver &resolver) const
+    {
+        condition_->Resolve(resolver);
+        if (body_ != nullptr)
+        {
+            body_->Resolve(resolver);
+        }
+    }
+
     void WhileLoop::Print(std::ostream &stream) const
     {
         stream << "while(";
         condition_->Print(stream);
-        stream << ") {" << std::endl;
+        stream << ") {" << "\n";
         body_->Print(stream);
-        stream << "}" << std::endl;
+        stream << "}" << "\n";
     };
+
+    LoweredValue WhileLoop::Lower(Lowering &lowering) const
+    {
+        ir::BlockId condition_block = lowering.NewBlock();
+        ir::BlockId body_block = lowering.NewBlock();
+        ir::BlockId end_block = lowering.NewBlock();
+        lowering.Jump(condition_block);
+
+        lowering.SetBlock(condition_block);
+        lowering.Branch(lowering.Truth(condition_->Lower(lowering)), body_block, end_block);
+
+        lowering.SetBlock(body_block);
+        lowering.EnterLoop(end_block, condition_block);
+        if (body_ != nullptr)
+        {
+            body_->LowerStatement(lowering);
+        }
+        lowering.ExitLoop();
+        lowering.Jump(condition_block);
+
+        lowering.SetBlock(end_block);
+        return {};
+    }
 }
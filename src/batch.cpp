@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <thread>
+
+#include "compiler.hpp"
+#include "ast_thread_pool.hpp"
+
+using ast::NodePtr;
+
+namespace
+{
+    struct BatchJob
+    {
+        std::string source_path;
+        std::string output_path;
+        bool ok = false;
+        bool cached = false; // output copied from the -fcache cache
+        std::string message; // why the file failed
+        double milliseconds = 0;
+    };
+
+    // Mirrors the source path under output_dir, with a .s extension. Leading "/" and ".." are dropped
+    // so that every output stays inside output_dir.
+    std::string OutputPathFor(const std::string &source_path, const std::string &output_dir)
+    {
+        std::filesystem::path relative;
+        for (const auto &part : std::filesystem::path(source_path).lexically_normal().relative_path())
+        {
+            if (part != "..")
+            {
+                relative /= part;
+            }
+        }
+        relative.replace_extension(".s");
+        return (std::filesystem::path(output_dir) / relative).string();
+    }
+
+    // Writes the output of one file, generated or copied from the cache. Throws on failure.
+    void BuildFile(BatchJob &job, const CommandLineArguments &cli_args, ast::TimeReport *time_report, CompileCache *cache)
+    {
+        std::filesystem::create_directories(std::filesystem::path(job.output_path).parent_path());
+
+        std::string cache_key;
+        if (cache != nullptr && FetchCached(*cache, job.source_path, job.output_path, cli_args, cache_key, time_report))
+        {
+            job.cached = true;
+            return;
+        }
+
+        // every file gets its own arena, released as soon as the file is written
+        ast::AstArena arena;
+        ast::ArenaScope arena_scope(arena);
+        NodePtr root;
+        {
+            ast::PhaseTimer timer(time_report, "parse", job.source_path);
+            root = ParseAST(job.source_path);
+        }
+        if (root == nullptr)
+        {
+            throw std::runtime_error("The root of the AST is a null pointer.");
+        }
+
+        // files are the unit of parallelism here, so function bodies are generated in order
+        ast::GlobalContext globals;
+        ast::Context ctx(globals);
+        ctx.SetTimeReport(time_report);
+        ctx.SetUseIR(cli_args.ir);
+        ctx.SetDumpIR(cli_args.dump_ir);
+        std::unique_ptr<FunctionCache> function_cache;
+        if (cache != nullptr && !cache_key.empty())
+        {
+            function_cache = OpenFunctionCache(*cache, job.source_path, cli_args);
+            ctx.SetFunctionCache(function_cache.get());
+        }
+        ast::AsmWriter output(cli_args.compact_asm);
+        GenerateAssembly(root, ctx, output);
+        ast::PhaseTimer timer(time_report, "output write", job.output_path);
+        output.WriteToFile(job.output_path);
+        if (cache != nullptr)
+        {
+            StoreCached(*cache, cache_key, output.View());
+        }
+    }
+
+    void CompileFile(BatchJob &job, const CommandLineArguments &cli_args, ast::TimeReport *time_report, CompileCache *cache)
+    {
+        auto start = std::chrono::steady_clock::now();
+        ast::PhaseTimer file_timer(time_report, "file", job.source_path);
+        try
+        {
+            BuildFile(job, cli_args, time_report, cache);
+            job.ok = true;
+        }
+        catch (const std::exception &e)
+        {
+            job.message = e.what();
+        }
+        catch (...)
+        {
+            job.message = "unknown error";
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        job.milliseconds = elapsed.count();
+    }
+}
+
+int CompileBatch(const CommandLineArguments &cli_args)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<ast::TimeReport> time_report;
+    if (cli_args.time_report || !cli_args.trace_path.empty())
+    {
+        time_report = std::make_unique<ast::TimeReport>();
+    }
+
+    std::unique_ptr<CompileCache> cache = OpenCache(cli_args);
+
+    std::vector<BatchJob> jobs(cli_args.batch_sources.size());
+    std::map<std::string, size_t> outputs; // output path -> job writing it
+    std::vector<ast::ThreadPool::Task> tasks;
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        BatchJob &job = jobs[i];
+        job.source_path = cli_args.batch_sources[i];
+        job.output_path = OutputPathFor(job.source_path, cli_args.batch_output_dir);
+        auto [it, inserted] = outputs.emplace(job.output_path, i);
+        if (!inserted)
+        {
+            job.message = "Output " + job.output_path + " is already written for " + jobs[it->second].source_path;
+            continue;
+        }
+        tasks.push_back([&job, &cli_args, &time_report, &cache]
+                        { CompileFile(job, cli_args, time_report.get(), cache.get()); });
+    }
+
+    unsigned n_threads = (cli_args.n_threads != 0) ? cli_args.n_threads : std::max(1u, std::thread::hardware_concurrency());
+    {
+        ast::ThreadPool thread_pool(n_threads - 1); // this thread helps too
+        thread_pool.RunAll(tasks);
+    }
+
+    // reported in the order the sources were given, whatever order they finished in
+    size_t n_failed = 0;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const BatchJob &job : jobs)
+    {
+        if (job.ok)
+        {
+            std::cout << (job.cached ? "CACHE " : "OK    ") << std::setw(9) << job.milliseconds << " ms  " << job.source_path << " -> " << job.output_path << "\n";
+        }
+        else
+        {
+            n_failed++;
+            std::cout << "FAIL  " << std::setw(9) << job.milliseconds << " ms  " << job.source_path << ": " << job.message << "\n";
+        }
+    }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Compiled " << (jobs.size() - n_failed) << "/" << jobs.size() << " files in "
+              << elapsed.count() << " ms on " << n_threads << " threads" << std::endl;
+
+    ReportRun(cli_args, time_report.get(), cache.get());
+
+    return (n_failed == 0) ? 0 : 1;
+}
@@ -1,5 +1,78 @@
 #include <cli.hpp>
 
+#include <fstream>
+#include <getopt.h>
+
+namespace
+{
+    // long options without a single-letter form
+    enum LongOption
+    {
+        OPT_SERVE = 256,
+        OPT_CLIENT,
+    };
+
+    const option long_options[] = {
+        {"serve", required_argument, nullptr, OPT_SERVE},
+        {"client", required_argument, nullptr, OPT_CLIENT},
+        {nullptr, 0, nullptr, 0},
+    };
+
+    // Byte count with an optional K, M or G suffix, e.g. 512M.
+    bool ParseSize(const char *text, uint64_t &size)
+    {
+        char *end = nullptr;
+        unsigned long long value = strtoull(text, &end, 10);
+        if (end == text)
+        {
+            return false;
+        }
+        switch (*end)
+        {
+        case 'G':
+            value <<= 10;
+            [[fallthrough]];
+        case 'M':
+            value <<= 10;
+            [[fallthrough]];
+        case 'K':
+            value <<= 10;
+            end++;
+            break;
+        default:
+            break;
+        }
+        if (*end != '\0' || value == 0)
+        {
+            return false;
+        }
+        size = value;
+        return true;
+    }
+
+    // Response file: one source path per line; blank lines and lines starting with '#' are skipped.
+    void ReadResponseFile(const std::string &path, std::vector<std::string> &sources)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            std::cerr << "Couldn't open response file: " << path << std::endl;
+            exit(2);
+        }
+        std::string line;
+        while (std::getline(file, line))
+        {
+            size_t begin = line.find_first_not_of(" \t\r");
+            if (begin == std::string::npos || line[begin] == '#')
+            {
+                continue;
+            }
+            size_t end = line.find_last_not_of(" \t\r");
+            sources.push_back(line.substr(begin, end - begin + 1));
+        }
+    }
+}
+
 CommandLineArguments ParseCommandLineArgs(int argc, char **argv)
 {
     std::string input = "";
@@ -17,24 +90,98 @@ CommandLineArguments ParseCommandLineArgs(int argc, char **argv)
     // Prevent opterr messages from being outputted.
     opterr = 0;
 
-    // ./bin/c_compiler -S [source-file.c] -o [dest-file.s]
+    // ./bin/c_compiler [-fcompact-asm] [-fir [-fdump-ir]] [-ftime-report] [-ftrace=trace.json] [-fcache=dir] [-j threads] -S [source-file.c] -o [dest-file.s]
+    // ./bin/c_compiler [-fcompact-asm] [-fir [-fdump-ir]] [-ftime-report] [-ftrace=trace.json] [-fcache=dir] [-j threads] -d [dest-dir] [source-file.c | @list-file]...
+    // ./bin/c_compiler [-j threads] --serve [socket]
+    // ./bin/c_compiler --client [socket] [-fcompact-asm] [-fir [-fdump-ir]] -S [source-file.c] -o [dest-file.s]
     CommandLineArguments cli_args;
     int opt;
-    while ((opt = getopt(argc, argv, "S:o:")) != -1)
+    while ((opt = getopt_long(argc, argv, "S:o:f:j:d:", long_options, nullptr)) != -1)
     {
         switch (opt)
         {
+        case OPT_SERVE:
+            cli_args.serve_socket = std::string(optarg);
+            break;
+        case OPT_CLIENT:
+            cli_args.client_socket = std::string(optarg);
+            break;
         case 'S':
             cli_args.compile_source_path = std::string(optarg);
             break;
         case 'o':
             cli_args.compile_output_path = std::string(optarg);
             break;
+        case 'f':
+            if (std::string(optarg) == "compact-asm")
+            {
+                cli_args.compact_asm = true;
+            }
+            else if (std::string(optarg) == "time-report")
+            {
+                cli_args.time_report = true;
+            }
+            else if (std::string(optarg).rfind("trace=", 0) == 0 && optarg[6] != '\0')
+            {
+                cli_args.trace_path = std::string(optarg + 6);
+            }
+            else if (std::string(optarg).rfind("cache=", 0) == 0 && optarg[6] != '\0')
+            {
+                cli_args.cache_dir = std::string(optarg + 6);
+            }
+            else if (std::string(optarg).rfind("cache-size=", 0) == 0)
+            {
+                if (!ParseSize(optarg + 11, cli_args.cache_max_bytes))
+                {
+                    fprintf(stderr, "Invalid cache size `%s'.\n", optarg + 11);
+                    fprintf(stderr, "Exiting due to failure to parse CLI args\n");
+                    exit(2);
+                }
+            }
+            else if (std::string(optarg) == "cache-stats")
+            {
+                cli_args.cache_stats = true;
+            }
+            else if (std::string(optarg) == "ir")
+            {
+                cli_args.ir = true;
+            }
+            else if (std::string(optarg) == "dump-ir")
+            {
+                cli_args.dump_ir = true;
+            }
+            else
+            {
+                fprintf(stderr, "Unknown option `-f%s'.\n", optarg);
+                fprintf(stderr, "Exiting due to failure to parse CLI args\n");
+                exit(2);
+            }
+            break;
+        case 'd':
+            cli_args.batch_output_dir = std::string(optarg);
+            break;
+        case 'j':
+        {
+            char *end = nullptr;
+            long n_threads = strtol(optarg, &end, 10);
+            if (end == optarg || *end != '\0' || n_threads < 0)
+            {
+                fprintf(stderr, "Invalid thread count `%s'.\n", optarg);
+                fprintf(stderr, "Exiting due to failure to parse CLI args\n");
+                exit(2);
+            }
+            cli_args.n_threads = n_threads;
+            break;
+        }
         case '?':
-            if (optopt == 'S' || optopt == 'o')
+            if (optopt == 'S' || optopt == 'o' || optopt == 'f' || optopt == 'j' || optopt == 'd')
             {
                 fprintf(stderr, "Option -%c requires an argument.\n", optopt);
             }
+            else if (optopt == OPT_SERVE || optopt == OPT_CLIENT)
+            {
+                fprintf(stderr, "Option %s requires an argument.\n", argv[optind - 1]);
+            }
             else if (isprint(optopt))
             {
                 fprintf(stderr, "Unknown option `-%c'.\n", optopt);
@@ -48,6 +195,43 @@ CommandLineArguments ParseCommandLineArgs(int argc, char **argv)
         }
     }
 
+    if (cli_args.serve_socket.length() != 0)
+    {
+        if (cli_args.compile_source_path.length() != 0 || cli_args.compile_output_path.length() != 0 ||
+            cli_args.batch_output_dir.length() != 0 || cli_args.client_socket.length() != 0)
+        {
+            std::cerr << "--serve only takes -j; sources are sent by clients." << std::endl;
+            exit(2);
+        }
+        return cli_args;
+    }
+
+    if (cli_args.batch_output_dir.length() != 0)
+    {
+        for (int i = optind; i < argc; i++)
+        {
+            if (argv[i][0] == '@')
+            {
+                ReadResponseFile(argv[i] + 1, cli_args.batch_sources);
+            }
+            else
+            {
+                cli_args.batch_sources.push_back(argv[i]);
+            }
+        }
+        if (cli_args.compile_source_path.length() != 0 || cli_args.compile_output_path.length() != 0)
+        {
+            std::cerr << "The -S and -o arguments can't be combined with -d." << std::endl;
+            exit(2);
+        }
+        if (cli_args.batch_sources.empty())
+        {
+            std::cerr << "No source files were given to compile into " << cli_args.batch_output_dir << std::endl;
+            exit(2);
+        }
+        return cli_args;
+    }
+
     if (cli_args.compile_source_path.length() == 0)
     {
         std::cerr << "The source path -S argument was not set." << std::endl;
@@ -0,0 +1,422 @@
+#include "compile_cache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "sha256.hpp"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    // Holds an exclusive flock on the cache's lock file for its lifetime.
+    class DirectoryLock
+    {
+    private:
+        int fd_;
+
+    public:
+        explicit DirectoryLock(const std::string &path)
+        {
+            fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (fd_ < 0)
+            {
+                throw std::runtime_error("Couldn't open cache lock " + path + ": " + std::strerror(errno));
+            }
+            while (flock(fd_, LOCK_EX) != 0 && errno == EINTR)
+            {
+            }
+        }
+        ~DirectoryLock() { close(fd_); } // closing releases the lock
+
+        DirectoryLock(const DirectoryLock &) = delete;
+        DirectoryLock &operator=(const DirectoryLock &) = delete;
+    };
+
+    void WriteFile(const std::string &path, std::string_view contents)
+    {
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Couldn't open " + path + ": " + std::strerror(errno));
+        }
+        while (!contents.empty())
+        {
+            ssize_t written = write(fd, contents.data(), contents.size());
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                int error = errno;
+                close(fd);
+                throw std::runtime_error("Couldn't write " + path + ": " + std::strerror(error));
+            }
+            contents.remove_prefix(written);
+        }
+        close(fd);
+    }
+
+    // unique within the machine, so concurrent writers never share a temporary file
+    std::string TemporaryName()
+    {
+        static std::atomic<unsigned> counter = 0;
+        std::ostringstream name;
+        name << "tmp." << getpid() << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << "." << counter++;
+        return name.str();
+    }
+
+    std::string CompilerStamp()
+    {
+        // size, mtime and inode of the running binary change with every rebuild
+        std::ostringstream stamp;
+        stamp << __DATE__ << " " << __TIME__;
+        char path[PATH_MAX];
+        ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+        struct stat info;
+        if (length > 0)
+        {
+            path[length] = '\0';
+            if (stat(path, &info) == 0)
+            {
+                stamp << " " << path << " " << info.st_size << " " << info.st_ino << " "
+                      << info.st_mtim.tv_sec << "." << info.st_mtim.tv_nsec;
+            }
+        }
+        return stamp.str();
+    }
+}
+
+CompileCache::CompileCache(std::string directory, uint64_t max_bytes)
+    : directory_(std::move(directory)), max_bytes_(max_bytes), compiler_stamp_(CompilerStamp())
+{
+    std::error_code error;
+    fs::create_directories(directory_, error);
+    if (error)
+    {
+        throw std::runtime_error("Couldn't create cache directory " + directory_ + ": " + error.message());
+    }
+}
+
+std::string CompileCache::Key(std::string_view source, std::string_view options) const
+{
+    // fields are NUL-separated so that no two different inputs hash the same bytes
+    Sha256 hash;
+    hash.Update("c_compiler cache v1");
+    hash.Update(std::string_view("", 1));
+    hash.Update(compiler_stamp_);
+    hash.Update(std::string_view("", 1));
+    hash.Update(options);
+    hash.Update(std::string_view("", 1));
+    hash.Update(source);
+    return hash.HexDigest();
+}
+
+std::string CompileCache::EntryPath(const std::string &key, const char *extension) const
+{
+    return directory_ + "/" + key.substr(0, 2) + "/" + key.substr(2) + extension;
+}
+
+bool CompileCache::Fetch(const std::string &key, const std::string &output_path, const std::string &printed_path)
+{
+    std::string entry = EntryPath(key);
+    std::string printed_entry = EntryPath(key, ".printed");
+    std::error_code error;
+    // the printed AST first, so that a miss never leaves output_path half updated
+    bool hit = printed_path.empty() || fs::copy_file(printed_entry, printed_path, fs::copy_options::overwrite_existing, error);
+    hit = hit && fs::copy_file(entry, output_path, fs::copy_options::overwrite_existing, error);
+    if (hit)
+    {
+        utimensat(AT_FDCWD, entry.c_str(), nullptr, 0); // most recently used
+        if (!printed_path.empty())
+        {
+            utimensat(AT_FDCWD, printed_entry.c_str(), nullptr, 0);
+        }
+    }
+    Stats delta;
+    (hit ? delta.hits : delta.misses) = 1;
+    Record(delta);
+    return hit;
+}
+
+void CompileCache::Store(const std::string &key, std::string_view assembly, std::string_view printed)
+{
+    Stats delta;
+    delta.stores = 1;
+    delta.bytes = assembly.size();
+    delta.replaced_bytes = Save(key, assembly);
+    if (!printed.empty())
+    {
+        delta.bytes += printed.size();
+        delta.replaced_bytes += SaveFile(EntryPath(key, ".printed"), printed);
+    }
+    Record(delta);
+}
+
+bool CompileCache::Load(const std::string &key, std::string &contents)
+{
+    std::string entry = EntryPath(key);
+    std::ifstream file(entry, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    std::ostringstream data;
+    data << file.rdbuf();
+    if (!file)
+    {
+        return false;
+    }
+    contents = std::move(data).str();
+    utimensat(AT_FDCWD, entry.c_str(), nullptr, 0); // most recently used
+    return true;
+}
+
+uint64_t CompileCache::Save(const std::string &key, std::string_view contents)
+{
+    return SaveFile(EntryPath(key), contents);
+}
+
+uint64_t CompileCache::SaveFile(const std::string &entry, std::string_view contents)
+{
+    std::string temporary = directory_ + "/" + TemporaryName();
+    fs::create_directories(fs::path(entry).parent_path());
+    WriteFile(temporary, contents);
+    std::error_code missing;
+    uint64_t replaced = fs::file_size(entry, missing);
+    if (missing)
+    {
+        replaced = 0;
+    }
+    if (rename(temporary.c_str(), entry.c_str()) != 0)
+    {
+        int error = errno;
+        unlink(temporary.c_str());
+        throw std::runtime_error("Couldn't store cache entry " + entry + ": " + std::strerror(error));
+    }
+    return replaced;
+}
+
+void CompileCache::Record(const Stats &delta)
+{
+    UpdateStats([this, &delta](Stats &stats)
+                {
+                    stats.hits += delta.hits;
+                    stats.misses += delta.misses;
+                    stats.stores += delta.stores;
+                    stats.evictions += delta.evictions;
+                    stats.bytes += delta.bytes;
+                    stats.bytes -= std::min(stats.bytes, delta.replaced_bytes); // an overwritten entry no longer counts
+                    stats.function_hits += delta.function_hits;
+                    stats.function_misses += delta.function_misses;
+                    if (stats.bytes > max_bytes_)
+                    {
+                        Evict(stats);
+                    } });
+}
+
+void CompileCache::Evict(Stats &stats)
+{
+    struct Entry
+    {
+        fs::file_time_type last_used;
+        uint64_t size;
+        fs::path path;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    std::error_code error;
+    for (const auto &file : fs::recursive_directory_iterator(directory_, error))
+    {
+        if (!file.is_regular_file(error) || (file.path().extension() != ".s" && file.path().extension() != ".printed"))
+        {
+            continue;
+        }
+        Entry entry = {file.last_write_time(error), file.file_size(error), file.path()};
+        if (!error)
+        {
+            total += entry.size;
+            entries.push_back(std::move(entry));
+        }
+    }
+
+    // drop the least recently used entries until 10% of the limit is free again
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+              { return a.last_used < b.last_used; });
+    uint64_t target = max_bytes_ - max_bytes_ / 10;
+    for (const Entry &entry : entries)
+    {
+        if (total <= target)
+        {
+            break;
+        }
+        if (fs::remove(entry.path, error))
+        {
+            total -= entry.size;
+            stats.evictions++;
+        }
+    }
+    stats.bytes = total;
+}
+
+template <typename Update>
+void CompileCache::UpdateStats(Update update)
+{
+    DirectoryLock lock(directory_ + "/lock");
+    Stats stats = ReadStats();
+    update(stats);
+
+    std::ostringstream text;
+    text << "hits " << stats.hits << "\n"
+         << "misses " << stats.misses << "\n"
+         << "stores " << stats.stores << "\n"
+         << "evictions " << stats.evictions << "\n"
+         << "bytes " << stats.bytes << "\n"
+         << "function_hits " << stats.function_hits << "\n"
+         << "function_misses " << stats.function_misses << "\n";
+    WriteFile(directory_ + "/stats", text.str());
+}
+
+CompileCache::Stats CompileCache::ReadStats() const
+{
+    Stats stats;
+    const std::pair<const char *, uint64_t *> fields[] = {
+        {"hits", &stats.hits},
+        {"misses", &stats.misses},
+        {"stores", &stats.stores},
+        {"evictions", &stats.evictions},
+        {"bytes", &stats.bytes},
+        {"function_hits", &stats.function_hits},
+        {"function_misses", &stats.function_misses},
+    };
+    std::ifstream file(directory_ + "/stats");
+    std::string name;
+    uint64_t value;
+    while (file >> name >> value)
+    {
+        for (const auto &[field_name, field] : fields)
+        {
+            if (name == field_name)
+            {
+                *field = value;
+            }
+        }
+    }
+    return stats;
+}
+
+void CompileCache::PrintStats(std::ostream &stream) const
+{
+    Stats stats = ReadStats();
+    uint64_t lookups = stats.hits + stats.misses;
+    stream << "Cache " << directory_ << ": " << stats.hits << " hits, " << stats.misses << " misses";
+    if (lookups > 0)
+    {
+        stream << " (" << std::fixed << std::setprecision(1) << 100.0 * stats.hits / lookups << "% hit rate)" << std::defaultfloat;
+    }
+    stream << ", " << stats.stores << " stores, " << stats.evictions << " evictions, "
+           << stats.bytes << " of " << max_bytes_ << " bytes used";
+    uint64_t function_lookups = stats.function_hits + stats.function_misses;
+    if (function_lookups > 0)
+    {
+        stream << "; functions: " << stats.function_hits << " hits, " << stats.function_misses << " misses";
+    }
+    stream << std::endl;
+}
+
+FunctionCache::FunctionCache(CompileCache &cache, std::string source, std::string options)
+    : cache_(cache), source_(std::move(source)), options_(std::move(options))
+{
+    SetBodies({});
+}
+
+FunctionCache::~FunctionCache()
+{
+    CompileCache::Stats delta;
+    delta.function_hits = hits_;
+    delta.function_misses = misses_;
+    delta.stores = stores_;
+    delta.bytes = bytes_;
+    delta.replaced_bytes = replaced_bytes_;
+    if (delta.function_hits + delta.function_misses == 0)
+    {
+        return;
+    }
+    try
+    {
+        cache_.Record(delta);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+void FunctionCache::SetBodies(const std::vector<SourceSpan> &bodies)
+{
+    // each body is replaced by a NUL, which the C source around it can't contain
+    Sha256 hash;
+    size_t position = 0;
+    for (const SourceSpan &body : bodies)
+    {
+        if (body.begin < position || body.end < body.begin || body.end > source_.size())
+        {
+            throw std::runtime_error("FunctionCache: function bodies out of order");
+        }
+        hash.Update(std::string_view(source_).substr(position, body.begin - position));
+        hash.Update(std::string_view("", 1));
+        position = body.end;
+    }
+    hash.Update(std::string_view(source_).substr(position));
+    environment_ = hash.HexDigest();
+}
+
+std::string FunctionCache::Key(SourceSpan function) const
+{
+    if (function.end < function.begin || function.end > source_.size())
+    {
+        return "";
+    }
+    std::string options = options_;
+    options.append("\0function\0", 10);
+    options.append(environment_);
+    return cache_.Key(std::string_view(source_).substr(function.begin, function.end - function.begin), options);
+}
+
+bool FunctionCache::Fetch(const std::string &key, std::string &entry)
+{
+    bool hit = cache_.Load(key, entry);
+    (hit ? hits_ : misses_)++;
+    return hit;
+}
+
+void FunctionCache::Store(const std::string &key, std::string_view entry)
+{
+    try
+    {
+        replaced_bytes_ += cache_.Save(key, entry);
+        stores_++;
+        bytes_ += entry.size();
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+}
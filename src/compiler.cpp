@@ -1,29 +1,94 @@
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <thread>
 
-#include "cli.hpp"
-#include "ast.hpp"
+#include "compiler.hpp"
+#include "ast_thread_pool.hpp"
+#include "ast_time_report.hpp"
+#include "server.hpp"
+#include "source_file.hpp"
 
 using ast::NodePtr;
 
-// Wrapper for ParseAST defined in YACC
-NodePtr Parse(const std::string &compile_source_path);
-
-// Output the pretty print version of what was parsed to the .printed output file.
-void PrettyPrint(const NodePtr &root, const std::string &compile_output_path);
-
-// Compile from the root of the AST and output this to the compiledOutputPath file.
-void Compile(const NodePtr &root, const std::string &compile_output_path);
+namespace
+{
+    // every setting that changes the generated assembly
+    std::string CacheOptions(const CommandLineArguments &cli_args)
+    {
+        std::string options = cli_args.compact_asm ? "compact-asm" : "";
+        if (cli_args.ir)
+        {
+            options += cli_args.dump_ir ? " ir dump-ir" : " ir";
+        }
+        return options;
+    }
+}
 
 int main(int argc, char **argv)
 {
     // Parse CLI arguments to fetch the source file to compile and the path to output to.
     // This retrives [source-file.c] and [dest-file.s], when the compiler is invoked as follows:
     // ./bin/c_compiler -S [source-file.c] -o [dest-file.s]
-    const auto [compile_source_path, compile_output_path] = ParseCommandLineArgs(argc, argv);
+    const CommandLineArguments cli_args = ParseCommandLineArgs(argc, argv);
+    // set before any thread parses: a single compile traces its parse, batch and server compiles stay quiet
+    SetParserTrace(cli_args.serve_socket.empty() && cli_args.batch_output_dir.empty());
+    if (!cli_args.serve_socket.empty())
+    {
+        return Serve(cli_args);
+    }
+    if (!cli_args.batch_output_dir.empty())
+    {
+        return CompileBatch(cli_args);
+    }
+    if (!cli_args.client_socket.empty())
+    {
+        int status = 0;
+        if (CompileOnServer(cli_args, status))
+        {
+            return status;
+        }
+        std::cerr << "No compile server answered, compiling in this process instead." << std::endl;
+    }
+    const std::string &compile_source_path = cli_args.compile_source_path;
+    const std::string &compile_output_path = cli_args.compile_output_path;
+
+    // Phases are only timed when asked for; otherwise every PhaseTimer is a no-op.
+    std::unique_ptr<ast::TimeReport> time_report;
+    if (cli_args.time_report || !cli_args.trace_path.empty())
+    {
+        time_report = std::make_unique<ast::TimeReport>();
+    }
+
+    // With -fcache, output generated earlier for the same source and options is reused as is,
+    // the printed AST as well as the assembly.
+    std::unique_ptr<CompileCache> cache = OpenCache(cli_args);
+    std::string cache_key;
+    if (cache != nullptr && FetchCached(*cache, compile_source_path, compile_output_path, cli_args, cache_key, time_report.get(),
+                                        compile_output_path + ".printed"))
+    {
+        std::cout << "Compiled to: " << compile_output_path << " (cached)" << std::endl;
+        ReportRun(cli_args, time_report.get(), cache.get());
+        return 0;
+    }
+
+    // AST nodes are bump-allocated from the arena and released together when it goes out of scope,
+    // after the root (declared below) has been destroyed.
+    ast::AstArena arena;
+    ast::ArenaScope arena_scope(arena);
 
     // Parse input and generate AST.
-    auto ast_root = Parse(compile_source_path);
+    NodePtr ast_root;
+    try
+    {
+        ast_root = Parse(compile_source_path, time_report.get());
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
 
     // Check something was actually returned by parseAST().
     if (ast_root == nullptr)
@@ -34,16 +99,19 @@ int main(int argc, char **argv)
     }
 
     // Print AST in a human-readable way. It's not assessed, but exists for your convenience.
-    PrettyPrint(ast_root, compile_output_path);
+    std::string printed = PrettyPrint(ast_root, compile_output_path, time_report.get());
 
     // Compile to RISC-V assembly, the main goal of this project.
-    Compile(ast_root, compile_output_path);
+    Compile(ast_root, cli_args, time_report.get(), cache.get(), cache_key, printed);
+
+    ReportRun(cli_args, time_report.get(), cache.get());
 }
 
-NodePtr Parse(const std::string &compile_source_path)
+NodePtr Parse(const std::string &compile_source_path, ast::TimeReport *time_report)
 {
     std::cout << "Parsing " << compile_source_path << "..." << std::endl;
 
+    ast::PhaseTimer timer(time_report, "parse", compile_source_path);
     NodePtr root = ParseAST(compile_source_path);
 
     std::cout << "AST parsing complete" << std::endl;
@@ -51,29 +119,176 @@ NodePtr Parse(const std::string &compile_source_path)
     return root;
 }
 
-void PrettyPrint(const NodePtr &root, const std::string &compile_output_path)
+std::string PrettyPrint(const NodePtr &root, const std::string &compile_output_path, ast::TimeReport *time_report)
 {
     auto output_path = compile_output_path + ".printed";
 
     std::cout << "Printing parsed AST..." << std::endl;
 
+    ast::PhaseTimer timer(time_report, "ast print", output_path);
+    std::ostringstream printed;
+    root->Print(printed);
     std::ofstream output(output_path, std::ios::trunc);
-    root->Print(output);
+    output << printed.str();
 
     std::cout << "Printed parsed AST to: " << output_path << std::endl;
+    return std::move(printed).str();
 }
 
-void Compile(const NodePtr &root, const std::string &compile_output_path)
+void Compile(const NodePtr &root, const CommandLineArguments &cli_args, ast::TimeReport *time_report,
+             CompileCache *cache, const std::string &cache_key, std::string_view printed)
 {
+    const std::string &compile_output_path = cli_args.compile_output_path;
+
     // Create a Context. This can be used to pass around information about
     // what's currently being compiled (e.g. function scope and variable names).
-    ast::Context ctx;
+    // Declarations visible to the whole file go into globals; each function body is then
+    // generated with its own Context, on the thread pool when more than one thread is allowed.
+    ast::GlobalContext globals;
+    ast::Context ctx(globals);
+    ctx.SetTimeReport(time_report);
+    ctx.SetUseIR(cli_args.ir);
+    ctx.SetDumpIR(cli_args.dump_ir);
+    unsigned n_threads = (cli_args.n_threads != 0) ? cli_args.n_threads : std::max(1u, std::thread::hardware_concurrency());
+    std::unique_ptr<ast::ThreadPool> thread_pool;
+    if (n_threads > 1)
+    {
+        thread_pool = std::make_unique<ast::ThreadPool>(n_threads - 1); // this thread helps too
+        ctx.SetThreadPool(thread_pool.get());
+    }
+    // functions that are unchanged since an earlier compile of the file are copied from the cache
+    std::unique_ptr<FunctionCache> function_cache;
+    if (cache != nullptr && !cache_key.empty())
+    {
+        function_cache = OpenFunctionCache(*cache, cli_args.compile_source_path, cli_args);
+        ctx.SetFunctionCache(function_cache.get());
+    }
 
     std::cout << "Compiling parsed AST..." << std::endl;
 
-    std::ofstream output(compile_output_path, std::ios::trunc);
+    // The whole file is generated in memory and written out with a single write.
+    ast::AsmWriter output(cli_args.compact_asm);
+    GenerateAssembly(root, ctx, output);
+    {
+        ast::PhaseTimer timer(time_report, "output write", compile_output_path);
+        output.WriteToFile(compile_output_path);
+    }
+    if (cache != nullptr)
+    {
+        StoreCached(*cache, cache_key, output.View(), printed);
+    }
+
+    std::cout << "Compiled to: " << compile_output_path << std::endl;
+}
+
+void GenerateAssembly(const NodePtr &root, ast::Context &ctx, ast::AsmWriter &output)
+{
+    {
+        ast::PhaseTimer timer(ctx.GetTimeReport(), "resolve");
+        ast::Resolver resolver(ctx);
+        root->Resolve(resolver);
+    }
     int null_reg = -1; // This is a null register, used to indicate that no register is being used.
     root->EmitRISC(output, ctx, null_reg, ast::TypeSpecifier::VOID);
+    output.Finish();
+}
 
-    std::cout << "Compiled to: " << compile_output_path << std::endl;
+std::unique_ptr<CompileCache> OpenCache(const CommandLineArguments &cli_args)
+{
+    if (cli_args.cache_dir.empty())
+    {
+        return nullptr;
+    }
+    try
+    {
+        return std::make_unique<CompileCache>(cli_args.cache_dir, cli_args.cache_max_bytes);
+    }
+    catch (const std::exception &e)
+    {
+        // the cache only saves time, so compiling goes on without it
+        std::cerr << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+bool FetchCached(CompileCache &cache, const std::string &source_path, const std::string &output_path,
+                 const CommandLineArguments &cli_args, std::string &key, ast::TimeReport *time_report,
+                 const std::string &printed_path)
+{
+    ast::PhaseTimer timer(time_report, "cache lookup", source_path);
+    try
+    {
+        // a pipe can't be read twice, so only sources that can be mapped are hashed
+        SourceFile source(source_path);
+        if (!source.IsMapped())
+        {
+            return false;
+        }
+        key = cache.Key(std::string_view(source.Data(), source.Size()), CacheOptions(cli_args));
+        return cache.Fetch(key, output_path, printed_path);
+    }
+    catch (const std::exception &)
+    {
+        // e.g. a missing source, which the parser reports
+        key.clear();
+        return false;
+    }
+}
+
+void StoreCached(CompileCache &cache, const std::string &key, std::string_view assembly, std::string_view printed)
+{
+    if (key.empty())
+    {
+        return;
+    }
+    try
+    {
+        cache.Store(key, assembly, printed);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+std::unique_ptr<FunctionCache> OpenFunctionCache(CompileCache &cache, const std::string &source_path,
+                                                 const CommandLineArguments &cli_args)
+{
+    try
+    {
+        // the parser doesn't keep the source, so the file is mapped again
+        SourceFile source(source_path);
+        if (!source.IsMapped())
+        {
+            return nullptr;
+        }
+        return std::make_unique<FunctionCache>(cache, std::string(source.Data(), source.Size()), CacheOptions(cli_args));
+    }
+    catch (const std::exception &)
+    {
+        return nullptr;
+    }
+}
+
+void ReportRun(const CommandLineArguments &cli_args, const ast::TimeReport *time_report, const CompileCache *cache)
+{
+    if (time_report != nullptr && cli_args.time_report)
+    {
+        time_report->PrintSummary(std::cerr);
+    }
+    if (time_report != nullptr && !cli_args.trace_path.empty())
+    {
+        try
+        {
+            time_report->WriteTrace(cli_args.trace_path);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << e.what() << std::endl;
+        }
+    }
+    if (cache != nullptr && cli_args.cache_stats)
+    {
+        cache->PrintStats(std::cerr);
+    }
 }
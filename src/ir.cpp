@@ -0,0 +1,459 @@
+#include "ir.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace ir
+{
+    namespace
+    {
+        constexpr std::string_view OP_NAMES[] = {
+            "const", "fconst", "copy", "phi",
+            "add", "sub", "mul", "div", "divu", "rem", "remu", "and", "or", "xor", "shl", "shr", "shru",
+            "eq", "ne", "lt", "le", "ltu", "leu",
+            "neg", "not",
+            "itof", "utof", "ftoi", "ftou", "fcvt",
+            "addr", "load", "store", "call",
+            "jump", "branch", "ret"};
+
+        static_assert(std::size(OP_NAMES) == static_cast<size_t>(Op::RET) + 1);
+
+        constexpr std::string_view TYPE_NAMES[] = {"i32", "f32", "f64"};
+        constexpr std::string_view WIDTH_NAMES[] = {"b", "w", "f", "d"};
+
+        bool IsBinary(Op op) { return op >= Op::ADD && op <= Op::SHRU; }
+        bool IsCompare(Op op) { return op >= Op::EQ && op <= Op::LEU; }
+
+        void PrintAddress(std::ostream &stream, const Address &address)
+        {
+            stream << "[";
+            if (address.base != NO_VREG)
+            {
+                stream << "v" << address.base;
+            }
+            else if (address.slot != NO_SLOT)
+            {
+                stream << "slot" << address.slot;
+            }
+            else
+            {
+                stream << address.symbol;
+            }
+            if (address.offset != 0)
+            {
+                stream << (address.offset > 0 ? "+" : "") << address.offset;
+            }
+            stream << "]";
+        }
+
+        [[noreturn]] void Fail(const Function &function, BlockId block, const Instr *instr, const std::string &message)
+        {
+            std::ostringstream text;
+            text << "IR of " << function.name << " is malformed: " << message << " in bb" << block;
+            if (instr != nullptr)
+            {
+                text << " at `";
+                Print(text, function, *instr);
+                text << "`";
+            }
+            throw std::runtime_error(text.str());
+        }
+    }
+
+    VReg Function::NewVReg(Type type)
+    {
+        vreg_types.push_back(type);
+        return vreg_types.size() - 1;
+    }
+
+    SlotId Function::NewSlot(int32_t size, int32_t align)
+    {
+        slots.push_back({size, align});
+        return slots.size() - 1;
+    }
+
+    BlockId Function::NewBlock()
+    {
+        blocks.emplace_back();
+        return blocks.size() - 1;
+    }
+
+    void Function::BuildCfg()
+    {
+        // depth-first from the entry
+        std::vector<bool> reachable(blocks.size(), false);
+        std::vector<BlockId> stack = {0};
+        reachable[0] = true;
+        while (!stack.empty())
+        {
+            BlockId block = stack.back();
+            stack.pop_back();
+            if (blocks[block].instrs.empty())
+            {
+                continue;
+            }
+            const Instr &last = blocks[block].instrs.back();
+            for (BlockId target : {last.target, last.target2})
+            {
+                if (target != NO_BLOCK && target < blocks.size() && !reachable[target])
+                {
+                    reachable[target] = true;
+                    stack.push_back(target);
+                }
+            }
+        }
+
+        std::vector<BlockId> renumbered(blocks.size(), NO_BLOCK);
+        std::vector<BlockId> original; // old number of each kept block
+        std::vector<Block> kept;
+        for (BlockId block = 0; block < blocks.size(); block++)
+        {
+            if (reachable[block])
+            {
+                renumbered[block] = kept.size();
+                original.push_back(block);
+                kept.push_back(std::move(blocks[block]));
+            }
+        }
+        blocks = std::move(kept);
+
+        // phi arguments follow the old preds, which are still in the old numbering
+        std::vector<std::vector<BlockId>> old_preds(blocks.size());
+        for (BlockId id = 0; id < blocks.size(); id++)
+        {
+            old_preds[id] = std::move(blocks[id].preds);
+            blocks[id].preds.clear();
+            blocks[id].succs.clear();
+        }
+        for (BlockId id = 0; id < blocks.size(); id++)
+        {
+            Block &block = blocks[id];
+            if (block.instrs.empty())
+            {
+                continue;
+            }
+            Instr &last = block.instrs.back();
+            for (BlockId *target : {&last.target, &last.target2})
+            {
+                if (*target == NO_BLOCK || *target >= renumbered.size())
+                {
+                    continue;
+                }
+                *target = renumbered[*target];
+                // a branch with both edges to one block still has a single successor
+                if (block.succs.empty() || block.succs.back() != *target)
+                {
+                    block.succs.push_back(*target);
+                    blocks[*target].preds.push_back(id);
+                }
+            }
+        }
+
+        for (BlockId id = 0; id < blocks.size(); id++)
+        {
+            Block &block = blocks[id];
+            for (Instr &instr : block.instrs)
+            {
+                if (instr.op != Op::PHI)
+                {
+                    break;
+                }
+                std::vector<VReg> args;
+                for (BlockId pred : block.preds)
+                {
+                    for (size_t i = 0; i < old_preds[id].size(); i++)
+                    {
+                        if (old_preds[id][i] == original[pred])
+                        {
+                            args.push_back(instr.args.at(i));
+                            break;
+                        }
+                    }
+                }
+                instr.args = std::move(args);
+            }
+        }
+    }
+
+    Width WidthOf(Type type)
+    {
+        switch (type)
+        {
+        case Type::I32:
+            return Width::WORD;
+        case Type::F32:
+            return Width::FLOAT;
+        case Type::F64:
+            return Width::DOUBLE;
+        }
+        throw std::runtime_error("WidthOf: invalid type");
+    }
+
+    void Print(std::ostream &stream, const Function &function, const Instr &instr)
+    {
+        if (instr.dst != NO_VREG)
+        {
+            stream << "v" << instr.dst << ":" << TYPE_NAMES[static_cast<int>(function.TypeOf(instr.dst))] << " = ";
+        }
+        stream << OP_NAMES[static_cast<int>(instr.op)];
+        if (instr.op == Op::LOAD || instr.op == Op::STORE)
+        {
+            stream << "." << WIDTH_NAMES[static_cast<int>(instr.width)];
+        }
+
+        switch (instr.op)
+        {
+        case Op::CONST:
+            stream << " " << instr.imm;
+            break;
+        case Op::FCONST:
+            stream << " " << instr.fimm;
+            break;
+        case Op::ADDR:
+        case Op::LOAD:
+            stream << " ";
+            PrintAddress(stream, instr.address);
+            break;
+        case Op::STORE:
+            stream << " v" << instr.a << ", ";
+            PrintAddress(stream, instr.address);
+            break;
+        case Op::CALL:
+        {
+            stream << " " << instr.callee << "(";
+            const char *separator = "";
+            for (VReg arg : instr.args)
+            {
+                stream << separator << "v" << arg;
+                separator = ", ";
+            }
+            stream << ")";
+            break;
+        }
+        case Op::PHI:
+        {
+            const char *separator = " ";
+            for (VReg arg : instr.args)
+            {
+                stream << separator << "v" << arg;
+                separator = ", ";
+            }
+            break;
+        }
+        case Op::JUMP:
+            stream << " bb" << instr.target;
+            break;
+        case Op::BRANCH:
+            stream << " v" << instr.a << ", bb" << instr.target << ", bb" << instr.target2;
+            break;
+        default:
+            if (instr.a != NO_VREG)
+            {
+                stream << " v" << instr.a;
+            }
+            if (instr.b != NO_VREG)
+            {
+                stream << ", v" << instr.b;
+            }
+            break;
+        }
+    }
+
+    void Print(std::ostream &stream, const Function &function)
+    {
+        stream << "function " << function.name << "(";
+        const char *separator = "";
+        for (VReg param : function.params)
+        {
+            stream << separator << "v" << param << ":" << TYPE_NAMES[static_cast<int>(function.TypeOf(param))];
+            separator = ", ";
+        }
+        stream << ")";
+        if (function.returns_value)
+        {
+            stream << " -> " << TYPE_NAMES[static_cast<int>(function.return_type)];
+        }
+        stream << "\n";
+        for (SlotId slot = 0; slot < function.slots.size(); slot++)
+        {
+            stream << "  slot" << slot << ": " << function.slots[slot].size << " bytes, align " << function.slots[slot].align << "\n";
+        }
+        for (BlockId block = 0; block < function.blocks.size(); block++)
+        {
+            stream << "bb" << block << ":";
+            if (!function.blocks[block].preds.empty())
+            {
+                stream << " ; preds";
+                for (BlockId pred : function.blocks[block].preds)
+                {
+                    stream << " bb" << pred;
+                }
+            }
+            stream << "\n";
+            for (const Instr &instr : function.blocks[block].instrs)
+            {
+                stream << "  ";
+                Print(stream, function, instr);
+                stream << "\n";
+            }
+        }
+    }
+
+    void Verify(const Function &function)
+    {
+        if (function.blocks.empty())
+        {
+            Fail(function, 0, nullptr, "no entry block");
+        }
+        std::vector<bool> defined(function.vreg_types.size(), false);
+        for (VReg param : function.params)
+        {
+            defined.at(param) = true;
+        }
+        for (BlockId id = 0; id < function.blocks.size(); id++)
+        {
+            for (const Instr &instr : function.blocks[id].instrs)
+            {
+                if (instr.dst == NO_VREG)
+                {
+                    continue;
+                }
+                if (instr.dst >= defined.size() || (defined[instr.dst] && function.single_definitions))
+                {
+                    Fail(function, id, &instr, "register defined twice");
+                }
+                defined[instr.dst] = true;
+            }
+        }
+
+        for (BlockId id = 0; id < function.blocks.size(); id++)
+        {
+            const Block &block = function.blocks[id];
+            if (block.instrs.empty() || !IsTerminator(block.instrs.back().op))
+            {
+                Fail(function, id, nullptr, "block doesn't end in a terminator");
+            }
+            bool phis_allowed = true;
+            for (const Instr &instr : block.instrs)
+            {
+                if (IsTerminator(instr.op) && &instr != &block.instrs.back())
+                {
+                    Fail(function, id, &instr, "terminator in the middle of a block");
+                }
+                if (instr.op == Op::PHI && (!phis_allowed || instr.args.size() != block.preds.size()))
+                {
+                    Fail(function, id, &instr, "phi after other instructions or without an argument per predecessor");
+                }
+                phis_allowed = phis_allowed && instr.op == Op::PHI;
+                ForEachUse(instr, [&](VReg vreg)
+                           {
+                               if (vreg >= defined.size() || !defined[vreg])
+                               {
+                                   Fail(function, id, &instr, "use of an undefined register");
+                               } });
+                for (BlockId target : {instr.target, instr.target2})
+                {
+                    if (target != NO_BLOCK && target >= function.blocks.size())
+                    {
+                        Fail(function, id, &instr, "branch to a missing block");
+                    }
+                }
+                if ((instr.op == Op::JUMP && instr.target == NO_BLOCK) ||
+                    (instr.op == Op::BRANCH && (instr.target == NO_BLOCK || instr.target2 == NO_BLOCK)))
+                {
+                    Fail(function, id, &instr, "branch without a target");
+                }
+                const Address &address = instr.address;
+                if ((instr.op == Op::ADDR || instr.op == Op::LOAD || instr.op == Op::STORE) &&
+                    (address.base != NO_VREG) + (address.slot != NO_SLOT) + (address.symbol != ast::SymbolId::EMPTY) != 1)
+                {
+                    Fail(function, id, &instr, "address without exactly one base");
+                }
+                if (address.base != NO_VREG && function.TypeOf(address.base) != Type::I32)
+                {
+                    Fail(function, id, &instr, "address based on a floating point register");
+                }
+                if (address.slot != NO_SLOT && address.slot >= function.slots.size())
+                {
+                    Fail(function, id, &instr, "access to a missing slot");
+                }
+
+                const Type dst_type = (instr.dst != NO_VREG) ? function.TypeOf(instr.dst) : Type::I32;
+                const Type a_type = (instr.a != NO_VREG) ? function.TypeOf(instr.a) : Type::I32;
+                bool well_typed = true;
+                if (IsBinary(instr.op))
+                {
+                    const bool integer_only = instr.op > Op::DIV;
+                    well_typed = instr.b != NO_VREG && a_type == dst_type && function.TypeOf(instr.b) == dst_type &&
+                                 !(integer_only && IsFloat(dst_type));
+                }
+                else if (IsCompare(instr.op))
+                {
+                    const bool integer_only = instr.op > Op::LE;
+                    well_typed = instr.b != NO_VREG && dst_type == Type::I32 && function.TypeOf(instr.b) == a_type &&
+                                 !(integer_only && IsFloat(a_type));
+                }
+                else
+                {
+                    switch (instr.op)
+                    {
+                    case Op::CONST:
+                    case Op::ADDR:
+                        well_typed = dst_type == Type::I32;
+                        break;
+                    case Op::FCONST:
+                        well_typed = IsFloat(dst_type);
+                        break;
+                    case Op::COPY:
+                        well_typed = a_type == dst_type;
+                        break;
+                    case Op::PHI:
+                        for (VReg arg : instr.args)
+                        {
+                            well_typed = well_typed && function.TypeOf(arg) == dst_type;
+                        }
+                        break;
+                    case Op::NEG:
+                        well_typed = a_type == dst_type;
+                        break;
+                    case Op::NOT:
+                        well_typed = a_type == Type::I32 && dst_type == Type::I32;
+                        break;
+                    case Op::ITOF:
+                    case Op::UTOF:
+                        well_typed = a_type == Type::I32 && IsFloat(dst_type);
+                        break;
+                    case Op::FTOI:
+                    case Op::FTOU:
+                        well_typed = IsFloat(a_type) && dst_type == Type::I32;
+                        break;
+                    case Op::FCVT:
+                        well_typed = IsFloat(a_type) && IsFloat(dst_type) && a_type != dst_type;
+                        break;
+                    case Op::LOAD:
+                        well_typed = WidthOf(dst_type) == instr.width || (instr.width == Width::BYTE && dst_type == Type::I32);
+                        break;
+                    case Op::STORE:
+                        well_typed = WidthOf(a_type) == instr.width || (instr.width == Width::BYTE && a_type == Type::I32);
+                        break;
+                    case Op::BRANCH:
+                        well_typed = a_type == Type::I32;
+                        break;
+                    case Op::RET:
+                        well_typed = (instr.a != NO_VREG) == function.returns_value &&
+                                     (instr.a == NO_VREG || a_type == function.return_type);
+                        break;
+                    default:
+                        break;
+                    }
+                }
+                if (!well_typed)
+                {
+                    Fail(function, id, &instr, "operand types don't match the operation");
+                }
+            }
+        }
+    }
+
+} // namespace ir
@@ -0,0 +1,200 @@
+#include "ir_analysis.hpp"
+
+#include <algorithm>
+
+namespace ir
+{
+    DominatorTree::DominatorTree(const Function &function)
+        : idom_(function.blocks.size(), NO_BLOCK),
+          children_(function.blocks.size()),
+          order_(function.blocks.size(), UINT32_MAX)
+    {
+        // postorder by an explicit depth-first search, each stack entry a block and its next successor
+        std::vector<BlockId> postorder;
+        std::vector<bool> visited(function.blocks.size(), false);
+        std::vector<std::pair<BlockId, size_t>> stack = {{0, 0}};
+        visited[0] = true;
+        while (!stack.empty())
+        {
+            auto &[block, next] = stack.back();
+            const std::vector<BlockId> &succs = function.blocks[block].succs;
+            if (next < succs.size())
+            {
+                BlockId succ = succs[next++];
+                if (!visited[succ])
+                {
+                    visited[succ] = true;
+                    stack.push_back({succ, 0});
+                }
+                continue;
+            }
+            postorder.push_back(block);
+            stack.pop_back();
+        }
+        reverse_postorder_.assign(postorder.rbegin(), postorder.rend());
+        for (uint32_t i = 0; i < reverse_postorder_.size(); i++)
+        {
+            order_[reverse_postorder_[i]] = i;
+        }
+
+        auto intersect = [this](BlockId a, BlockId b)
+        {
+            while (a != b)
+            {
+                while (order_[a] > order_[b])
+                {
+                    a = idom_[a];
+                }
+                while (order_[b] > order_[a])
+                {
+                    b = idom_[b];
+                }
+            }
+            return a;
+        };
+
+        idom_[0] = 0;
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+            for (BlockId block : reverse_postorder_)
+            {
+                if (block == 0)
+                {
+                    continue;
+                }
+                BlockId new_idom = NO_BLOCK;
+                for (BlockId pred : function.blocks[block].preds)
+                {
+                    if (idom_[pred] != NO_BLOCK)
+                    {
+                        new_idom = (new_idom == NO_BLOCK) ? pred : intersect(pred, new_idom);
+                    }
+                }
+                if (idom_[block] != new_idom)
+                {
+                    idom_[block] = new_idom;
+                    changed = true;
+                }
+            }
+        }
+
+        for (BlockId block : reverse_postorder_)
+        {
+            if (block != 0)
+            {
+                children_[idom_[block]].push_back(block);
+            }
+        }
+    }
+
+    bool DominatorTree::Dominates(BlockId dominator, BlockId block) const
+    {
+        while (block != dominator && block != 0)
+        {
+            block = idom_[block];
+        }
+        return block == dominator;
+    }
+
+    std::vector<std::vector<BlockId>> DominatorTree::Frontiers(const Function &function) const
+    {
+        std::vector<std::vector<BlockId>> frontiers(function.blocks.size());
+        for (BlockId block = 0; block < function.blocks.size(); block++)
+        {
+            const std::vector<BlockId> &preds = function.blocks[block].preds;
+            if (preds.size() < 2 || idom_[block] == NO_BLOCK)
+            {
+                continue;
+            }
+            for (BlockId runner : preds)
+            {
+                while (runner != idom_[block])
+                {
+                    std::vector<BlockId> &frontier = frontiers[runner];
+                    if (frontier.empty() || frontier.back() != block)
+                    {
+                        frontier.push_back(block);
+                    }
+                    runner = idom_[runner];
+                }
+            }
+        }
+        return frontiers;
+    }
+
+    bool RegisterSet::UnionWith(const RegisterSet &other)
+    {
+        bool grew = false;
+        for (size_t word = 0; word < words_.size(); word++)
+        {
+            uint64_t merged = words_[word] | other.words_[word];
+            grew = grew || merged != words_[word];
+            words_[word] = merged;
+        }
+        return grew;
+    }
+
+    Liveness ComputeLiveness(const Function &function)
+    {
+        const size_t block_count = function.blocks.size();
+        const size_t vreg_count = function.vreg_types.size();
+
+        // upward-exposed uses and definitions of each block, phis aside
+        std::vector<RegisterSet> uses(block_count, RegisterSet(vreg_count));
+        std::vector<RegisterSet> defs(block_count, RegisterSet(vreg_count));
+        // phi arguments each block passes along its outgoing edges
+        std::vector<RegisterSet> phi_uses(block_count, RegisterSet(vreg_count));
+        for (BlockId id = 0; id < block_count; id++)
+        {
+            const Block &block = function.blocks[id];
+            for (auto instr = block.instrs.rbegin(); instr != block.instrs.rend(); ++instr)
+            {
+                if (instr->dst != NO_VREG)
+                {
+                    defs[id].Insert(instr->dst);
+                    uses[id].Erase(instr->dst);
+                }
+                if (instr->op == Op::PHI)
+                {
+                    for (size_t i = 0; i < instr->args.size(); i++)
+                    {
+                        phi_uses[block.preds[i]].Insert(instr->args[i]);
+                    }
+                    continue;
+                }
+                ForEachUse(*instr, [&](VReg vreg)
+                           { uses[id].Insert(vreg); });
+            }
+        }
+
+        Liveness liveness{std::vector<RegisterSet>(block_count, RegisterSet(vreg_count)),
+                          std::vector<RegisterSet>(block_count, RegisterSet(vreg_count))};
+        std::vector<BlockId> order = DominatorTree(function).ReversePostorder();
+        std::reverse(order.begin(), order.end());
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+            for (BlockId id : order)
+            {
+                RegisterSet &out = liveness.live_out[id];
+                out.UnionWith(phi_uses[id]);
+                for (BlockId succ : function.blocks[id].succs)
+                {
+                    out.UnionWith(liveness.live_in[succ]);
+                }
+                // live_in = uses | (live_out - defs), one register at a time
+                RegisterSet in = uses[id];
+                out.ForEach([&](VReg vreg)
+                            {
+                                if (!defs[id].Contains(vreg))
+                                {
+                                    in.Insert(vreg);
+                                } });
+                changed = liveness.live_in[id].UnionWith(in) || changed;
+            }
+        }
+        return liveness;
+    }
+
+} // namespace ir
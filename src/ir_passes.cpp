@@ -0,0 +1,58 @@
+#include "ir_passes.hpp"
+
+namespace ir
+{
+    void EliminateDeadCode(Function &function)
+    {
+        // definitions of each register, several once SSA has been left
+        std::vector<std::vector<const Instr *>> definitions(function.vreg_types.size());
+        std::vector<const Instr *> worklist;
+        for (const Block &block : function.blocks)
+        {
+            for (const Instr &instr : block.instrs)
+            {
+                if (instr.dst != NO_VREG)
+                {
+                    definitions[instr.dst].push_back(&instr);
+                }
+                if (instr.op == Op::STORE || instr.op == Op::CALL || IsTerminator(instr.op))
+                {
+                    worklist.push_back(&instr);
+                }
+            }
+        }
+
+        std::vector<bool> needed(function.vreg_types.size(), false);
+        while (!worklist.empty())
+        {
+            const Instr *instr = worklist.back();
+            worklist.pop_back();
+            ForEachUse(*instr, [&](VReg vreg)
+                       {
+                           if (!needed[vreg])
+                           {
+                               needed[vreg] = true;
+                               worklist.insert(worklist.end(), definitions[vreg].begin(), definitions[vreg].end());
+                           } });
+        }
+
+        for (Block &block : function.blocks)
+        {
+            std::erase_if(block.instrs, [&](const Instr &instr)
+                          { return instr.dst != NO_VREG && instr.op != Op::CALL && !needed[instr.dst]; });
+        }
+    }
+
+    void Optimize(Function &function)
+    {
+        PromoteSlots(function);
+        Verify(function);
+        PropagateConstants(function);
+        Verify(function);
+        EliminateDeadCode(function);
+        Verify(function);
+        LeaveSsa(function);
+        Verify(function);
+    }
+
+} // namespace ir
@@ -0,0 +1,569 @@
+#include "ir_peephole.hpp"
+
+#include <bit>
+#include <string>
+#include <unordered_map>
+
+namespace ir
+{
+    using ast::Reg;
+    using ast::RegisterMask;
+
+    namespace
+    {
+        constexpr RegisterMask Bit(Reg reg) { return RegisterMask(1) << static_cast<int>(reg); }
+
+        constexpr bool FitsImmediate(int64_t value) { return value >= -2048 && value < 2048; }
+
+        bool IsBranch(MOp op) { return op >= MOp::BEQZ && op <= MOp::BGEU; }
+
+        MOp InvertBranch(MOp op)
+        {
+            switch (op)
+            {
+            case MOp::BEQZ:
+                return MOp::BNEZ;
+            case MOp::BNEZ:
+                return MOp::BEQZ;
+            case MOp::BEQ:
+                return MOp::BNE;
+            case MOp::BNE:
+                return MOp::BEQ;
+            case MOp::BLT:
+                return MOp::BGE;
+            case MOp::BGE:
+                return MOp::BLT;
+            case MOp::BLTU:
+                return MOp::BGEU;
+            default:
+                return MOp::BLTU;
+            }
+        }
+
+        bool IsCopy(MOp op) { return op == MOp::MV || op == MOp::FMV_S || op == MOp::FMV_D; }
+
+        // the copy a load of op becomes when the stored value is still in a register
+        MOp LoadCopy(MOp store, MOp load)
+        {
+            if (store == MOp::SW && load == MOp::LW)
+            {
+                return MOp::MV;
+            }
+            if (store == MOp::FSW && load == MOp::FLW)
+            {
+                return MOp::FMV_S;
+            }
+            if (store == MOp::FSD && load == MOp::FLD)
+            {
+                return MOp::FMV_D;
+            }
+            return MOp::LABEL;
+        }
+
+        // whether the float operands of op are read at the width copy moves them
+        bool ReadsWidthOf(MOp copy, MOp op)
+        {
+            switch (op)
+            {
+            case MOp::FMV_S:
+            case MOp::FNEG_S:
+            case MOp::FADD_S:
+            case MOp::FSUB_S:
+            case MOp::FMUL_S:
+            case MOp::FDIV_S:
+            case MOp::FEQ_S:
+            case MOp::FLT_S:
+            case MOp::FLE_S:
+            case MOp::FCVT_W_S:
+            case MOp::FCVT_WU_S:
+            case MOp::FCVT_D_S:
+            case MOp::FMV_X_W:
+            case MOp::FSW:
+                return copy == MOp::FMV_S;
+            case MOp::FMV_D:
+            case MOp::FNEG_D:
+            case MOp::FADD_D:
+            case MOp::FSUB_D:
+            case MOp::FMUL_D:
+            case MOp::FDIV_D:
+            case MOp::FEQ_D:
+            case MOp::FLT_D:
+            case MOp::FLE_D:
+            case MOp::FCVT_W_D:
+            case MOp::FCVT_WU_D:
+            case MOp::FCVT_S_D:
+            case MOp::FSD:
+                return copy == MOp::FMV_D;
+            default:
+                return copy == MOp::MV;
+            }
+        }
+
+        // the largest value op can leave in its destination, or 0 if unknown
+        uint32_t MaxResult(MOp op)
+        {
+            switch (op)
+            {
+            case MOp::SLT:
+            case MOp::SLTU:
+            case MOp::SLTI:
+            case MOp::SLTIU:
+            case MOp::SEQZ:
+            case MOp::SNEZ:
+            case MOp::FEQ_S:
+            case MOp::FLT_S:
+            case MOp::FLE_S:
+            case MOp::FEQ_D:
+            case MOp::FLT_D:
+            case MOp::FLE_D:
+                return 1;
+            case MOp::LBU:
+                return 0xff;
+            default:
+                return 0;
+            }
+        }
+
+        // the instruction list with some instructions removed, and where registers are live
+        class Window
+        {
+        private:
+            std::vector<MachineInstr> &instrs_;
+            std::vector<bool> removed_;
+            std::vector<RegisterMask> live_after_;
+
+            // Backwards dataflow over the instructions: one sweep from the end, then another from each
+            // jump to a label whose liveness grew, for as long as it changes something. Sweeping the
+            // whole list again instead would take as many sweeps as loops or joins are nested deep.
+            // Rewrites only ever shorten live ranges, so the result stays safe to use, if
+            // conservative, until the list is compacted.
+            void ComputeLiveness()
+            {
+                constexpr size_t NO_TARGET = SIZE_MAX;
+                std::unordered_map<std::string_view, size_t> labels;
+                for (size_t i = 0; i < instrs_.size(); i++)
+                {
+                    if (instrs_[i].op == MOp::LABEL)
+                    {
+                        labels[instrs_[i].symbol] = i;
+                    }
+                }
+                // where each jump goes, and the jumps to each label
+                std::vector<size_t> targets(instrs_.size(), NO_TARGET);
+                std::vector<std::vector<size_t>> jumps(instrs_.size());
+                for (size_t i = 0; i < instrs_.size(); i++)
+                {
+                    if (instrs_[i].op != MOp::J && !IsBranch(instrs_[i].op))
+                    {
+                        continue;
+                    }
+                    auto it = labels.find(instrs_[i].symbol);
+                    if (it != labels.end())
+                    {
+                        targets[i] = it->second;
+                        jumps[it->second].push_back(i);
+                    }
+                }
+
+                std::vector<RegisterMask> live_before(instrs_.size(), 0);
+                live_after_.assign(instrs_.size(), 0);
+                auto live_at_target = [&](size_t i)
+                {
+                    return (targets[i] != NO_TARGET) ? live_before[targets[i]] : ~RegisterMask(0);
+                };
+                std::vector<size_t> worklist;
+                auto sweep = [&](size_t from, bool whole)
+                {
+                    for (size_t i = from + 1; i-- > 0;)
+                    {
+                        const MachineInstr &instr = instrs_[i];
+                        const RegisterMask next = (i + 1 < instrs_.size()) ? live_before[i + 1] : ~RegisterMask(0);
+                        RegisterMask after = 0;
+                        if (instr.op == MOp::J)
+                        {
+                            after = live_at_target(i);
+                        }
+                        else if (IsBranch(instr.op))
+                        {
+                            after = live_at_target(i) | next;
+                        }
+                        else if (instr.op != MOp::RET)
+                        {
+                            after = next;
+                        }
+                        const RegisterMask before = Uses(instr) | (after & ~Defs(instr));
+                        live_after_[i] = after;
+                        if (before == live_before[i])
+                        {
+                            if (!whole)
+                            {
+                                return;
+                            }
+                            continue;
+                        }
+                        live_before[i] = before;
+                        if (instr.op == MOp::LABEL)
+                        {
+                            worklist.insert(worklist.end(), jumps[i].begin(), jumps[i].end());
+                        }
+                    }
+                };
+                if (!instrs_.empty())
+                {
+                    sweep(instrs_.size() - 1, true);
+                }
+                while (!worklist.empty())
+                {
+                    const size_t i = worklist.back();
+                    worklist.pop_back();
+                    sweep(i, false);
+                }
+            }
+
+        public:
+            explicit Window(std::vector<MachineInstr> &instrs) : instrs_(instrs), removed_(instrs.size(), false)
+            {
+                ComputeLiveness();
+            }
+
+            MachineInstr &operator[](size_t i) { return instrs_[i]; }
+            size_t Size() const { return instrs_.size(); }
+
+            // the instruction after i that is still there, or Size()
+            size_t Next(size_t i) const
+            {
+                do
+                {
+                    i++;
+                } while (i < instrs_.size() && removed_[i]);
+                return i;
+            }
+
+            // whether nothing reads reg after instruction i before writing it
+            bool Dead(Reg reg, size_t i) const { return (live_after_[i] & Bit(reg)) == 0; }
+
+            // whether the label follows i, with only labels in between
+            bool LabelFollows(size_t i, std::string_view label) const
+            {
+                for (size_t k = Next(i); k < instrs_.size() && instrs_[k].op == MOp::LABEL; k = Next(k))
+                {
+                    if (instrs_[k].symbol == label)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void Remove(size_t i) { removed_[i] = true; }
+
+            void Compact()
+            {
+                size_t kept = 0;
+                for (size_t i = 0; i < instrs_.size(); i++)
+                {
+                    if (removed_[i])
+                    {
+                        continue;
+                    }
+                    if (kept != i)
+                    {
+                        instrs_[kept] = std::move(instrs_[i]);
+                    }
+                    kept++;
+                }
+                instrs_.resize(kept);
+            }
+        };
+
+        // ---- rules: each tries to rewrite the instructions starting at i ----
+
+        bool SelfMove(Window &window, size_t i)
+        {
+            if (!IsCopy(window[i].op) || window[i].rd != window[i].rs1)
+            {
+                return false;
+            }
+            window.Remove(i);
+            return true;
+        }
+
+        bool JumpToNext(Window &window, size_t i)
+        {
+            if (window[i].op != MOp::J || !window.LabelFollows(i, window[i].symbol))
+            {
+                return false;
+            }
+            window.Remove(i);
+            return true;
+        }
+
+        bool BranchOverJump(Window &window, size_t i)
+        {
+            const size_t j = window.Next(i);
+            if (!IsBranch(window[i].op) || j == window.Size() || window[j].op != MOp::J || !window.LabelFollows(j, window[i].symbol))
+            {
+                return false;
+            }
+            window[i].op = InvertBranch(window[i].op);
+            window[i].symbol = window[j].symbol;
+            window.Remove(j);
+            return true;
+        }
+
+        bool StoreToLoad(Window &window, size_t i)
+        {
+            const size_t j = window.Next(i);
+            if (j == window.Size())
+            {
+                return false;
+            }
+            const MachineInstr &store = window[i];
+            MachineInstr &load = window[j];
+            const MOp copy = LoadCopy(store.op, load.op);
+            if (copy == MOp::LABEL || store.rs1 != load.rs1 || store.imm != load.imm || store.reloc != load.reloc || store.symbol != load.symbol)
+            {
+                return false;
+            }
+            if (load.rd == store.rs2)
+            {
+                window.Remove(j);
+                return true;
+            }
+            load = {.op = copy, .rd = load.rd, .rs1 = store.rs2};
+            return true;
+        }
+
+        bool RedundantMask(Window &window, size_t i)
+        {
+            const size_t j = window.Next(i);
+            if (j == window.Size())
+            {
+                return false;
+            }
+            const uint32_t max = MaxResult(window[i].op);
+            MachineInstr &mask = window[j];
+            if (max == 0 || mask.op != MOp::ANDI || mask.reloc != Reloc::NONE || mask.rs1 != window[i].rd || (max & ~static_cast<uint32_t>(mask.imm)) != 0)
+            {
+                return false;
+            }
+            if (mask.rd == mask.rs1)
+            {
+                window.Remove(j);
+                return true;
+            }
+            mask = {.op = MOp::MV, .rd = mask.rd, .rs1 = mask.rs1};
+            return true;
+        }
+
+        // li t, imm; op d, s, t -> opi d, s, imm, for power_of_two either the products or the rest
+        bool FoldImmediate(Window &window, size_t i, bool power_of_two)
+        {
+            const size_t j = window.Next(i);
+            if (window[i].op != MOp::LI || window[i].reloc != Reloc::NONE || j == window.Size())
+            {
+                return false;
+            }
+            const Reg t = window[i].rd;
+            const int64_t imm = window[i].imm;
+            MachineInstr &instr = window[j];
+            if ((instr.rs1 == t) == (instr.rs2 == t) || (instr.rd != t && !window.Dead(t, j)))
+            {
+                return false;
+            }
+            const bool t_second = instr.rs2 == t;
+            const Reg other = t_second ? instr.rs1 : instr.rs2;
+
+            MOp op = MOp::LABEL;
+            int64_t folded = imm;
+            switch (instr.op)
+            {
+            case MOp::ADD:
+                op = MOp::ADDI;
+                break;
+            case MOp::SUB:
+                op = t_second ? MOp::ADDI : MOp::LABEL;
+                folded = -imm;
+                break;
+            case MOp::AND:
+                op = MOp::ANDI;
+                break;
+            case MOp::OR:
+                op = MOp::ORI;
+                break;
+            case MOp::XOR:
+                op = MOp::XORI;
+                break;
+            case MOp::SLL:
+                op = (t_second && imm >= 0 && imm < 32) ? MOp::SLLI : MOp::LABEL;
+                break;
+            case MOp::SRA:
+                op = (t_second && imm >= 0 && imm < 32) ? MOp::SRAI : MOp::LABEL;
+                break;
+            case MOp::SRL:
+                op = (t_second && imm >= 0 && imm < 32) ? MOp::SRLI : MOp::LABEL;
+                break;
+            case MOp::SLT:
+                op = t_second ? MOp::SLTI : MOp::LABEL;
+                break;
+            case MOp::SLTU:
+                op = t_second ? MOp::SLTIU : MOp::LABEL;
+                break;
+            case MOp::MUL:
+                if (imm > 0 && std::has_single_bit(static_cast<uint32_t>(imm)))
+                {
+                    op = MOp::SLLI;
+                    folded = std::countr_zero(static_cast<uint32_t>(imm));
+                }
+                break;
+            default:
+                break;
+            }
+            if (op == MOp::LABEL || (instr.op == MOp::MUL) != power_of_two || !FitsImmediate(folded))
+            {
+                return false;
+            }
+            instr = {.op = op, .rd = instr.rd, .rs1 = other, .imm = static_cast<int32_t>(folded)};
+            window.Remove(i);
+            return true;
+        }
+
+        bool ImmediateOperand(Window &window, size_t i) { return FoldImmediate(window, i, false); }
+
+        bool PowerOfTwoProduct(Window &window, size_t i) { return FoldImmediate(window, i, true); }
+
+        bool ZeroStore(Window &window, size_t i)
+        {
+            const size_t j = window.Next(i);
+            if (window[i].op != MOp::LI || window[i].reloc != Reloc::NONE || window[i].imm != 0 || j == window.Size())
+            {
+                return false;
+            }
+            const Reg t = window[i].rd;
+            MachineInstr &store = window[j];
+            if ((store.op != MOp::SB && store.op != MOp::SW) || store.rs2 != t || store.rs1 == t || !window.Dead(t, j))
+            {
+                return false;
+            }
+            store.rs2 = Reg::ZERO;
+            window.Remove(i);
+            return true;
+        }
+
+        bool CopyIntoDef(Window &window, size_t i)
+        {
+            const size_t j = window.Next(i);
+            if (j == window.Size())
+            {
+                return false;
+            }
+            MachineInstr &def = window[i];
+            const MachineInstr &copy = window[j];
+            const RegisterMask defs = Defs(def);
+            if (!IsCopy(copy.op) || def.op == MOp::CALL || defs != Bit(copy.rs1) || copy.rd == Reg::ZERO || !window.Dead(copy.rs1, j))
+            {
+                return false;
+            }
+            def.rd = copy.rd;
+            window.Remove(j);
+            return true;
+        }
+
+        bool CopyForward(Window &window, size_t i)
+        {
+            const size_t j = window.Next(i);
+            if (!IsCopy(window[i].op) || j == window.Size())
+            {
+                return false;
+            }
+            const Reg t = window[i].rd;
+            const Reg s = window[i].rs1;
+            MachineInstr &instr = window[j];
+            if (instr.op == MOp::CALL || instr.op == MOp::RET || (Uses(instr) & Bit(t)) == 0 || !ReadsWidthOf(window[i].op, instr.op))
+            {
+                return false;
+            }
+            if (instr.rd != t && !window.Dead(t, j))
+            {
+                return false;
+            }
+            if (instr.rs1 == t)
+            {
+                instr.rs1 = s;
+            }
+            if (instr.rs2 == t)
+            {
+                instr.rs2 = s;
+            }
+            window.Remove(i);
+            return true;
+        }
+
+        struct Rule
+        {
+            std::string_view name;
+            bool (*apply)(Window &window, size_t i);
+        };
+
+        // DO NOT REORDER: indexed by PeepholeRule
+        constexpr Rule RULES[] = {
+            {"self move", SelfMove},
+            {"jump to next", JumpToNext},
+            {"branch over jump", BranchOverJump},
+            {"store to load", StoreToLoad},
+            {"redundant mask", RedundantMask},
+            {"immediate operand", ImmediateOperand},
+            {"power of two product", PowerOfTwoProduct},
+            {"zero store", ZeroStore},
+            {"copy into def", CopyIntoDef},
+            {"copy forward", CopyForward},
+        };
+
+        static_assert(std::size(RULES) == static_cast<size_t>(PeepholeRule::COUNT));
+    }
+
+    std::string_view PeepholeRuleName(PeepholeRule rule)
+    {
+        return RULES[static_cast<size_t>(rule)].name;
+    }
+
+    PeepholeCounts Peephole(std::vector<MachineInstr> &instrs)
+    {
+        PeepholeCounts counts{};
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+            Window window(instrs);
+            for (size_t i = 0; i < window.Size(); i = window.Next(i))
+            {
+                for (size_t rule = 0; rule < std::size(RULES); rule++)
+                {
+                    if (RULES[rule].apply(window, i))
+                    {
+                        counts[rule]++;
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+            window.Compact();
+        }
+        return counts;
+    }
+
+    void ReportPeephole(ast::TimeReport *report, const PeepholeCounts &counts)
+    {
+        if (report == nullptr)
+        {
+            return;
+        }
+        for (size_t rule = 0; rule < counts.size(); rule++)
+        {
+            if (counts[rule] != 0)
+            {
+                report->Count("peephole: " + std::string(RULES[rule].name), counts[rule]);
+            }
+        }
+    }
+
+} // namespace ir
@@ -0,0 +1,208 @@
+#include "ir_regalloc.hpp"
+
+#include <algorithm>
+
+#include "ast_context.hpp"
+#include "ir_analysis.hpp"
+
+namespace ir
+{
+    using ast::Reg;
+    using ast::RegisterMask;
+
+    namespace
+    {
+        constexpr Reg INT_TEMPORARIES[] = {Reg::T3, Reg::T4, Reg::T5};
+        constexpr Reg FLOAT_TEMPORARIES[] = {Reg::FT3, Reg::FT4, Reg::FT5, Reg::FT6, Reg::FT7, Reg::FT8, Reg::FT9, Reg::FT10, Reg::FT11};
+        constexpr Reg INT_CALLEE_SAVED[] = {Reg::S1, Reg::S2, Reg::S3, Reg::S4, Reg::S5, Reg::S6, Reg::S7, Reg::S8, Reg::S9, Reg::S10, Reg::S11};
+        constexpr Reg FLOAT_CALLEE_SAVED[] = {Reg::FS0, Reg::FS1, Reg::FS2, Reg::FS3, Reg::FS4, Reg::FS5, Reg::FS6, Reg::FS7, Reg::FS8, Reg::FS9, Reg::FS10, Reg::FS11};
+
+        constexpr RegisterMask Bit(Reg reg) { return RegisterMask(1) << static_cast<int>(reg); }
+
+        // Positions number the instructions in block order: instruction i reads its operands at 2i
+        // and writes its result at 2i + 1, so a result may take the register of an operand it ends.
+        struct Interval
+        {
+            VReg vreg;
+            uint32_t start = UINT32_MAX;
+            uint32_t end = 0;
+            bool crosses_call = false;       // live both before and after some call
+            bool argument_registers = true;  // false if setting up a call or receiving the parameters would overwrite them
+        };
+
+        // the intervals of the registers that are ever defined or used, in order of their start
+        std::vector<Interval> BuildIntervals(const Function &function)
+        {
+            std::vector<Interval> intervals(function.vreg_types.size());
+            for (VReg vreg = 0; vreg < intervals.size(); vreg++)
+            {
+                intervals[vreg].vreg = vreg;
+            }
+            auto extend = [&](VReg vreg, uint32_t position)
+            {
+                intervals[vreg].start = std::min(intervals[vreg].start, position);
+                intervals[vreg].end = std::max(intervals[vreg].end, position);
+            };
+
+            // parameters are all defined together, before the first instruction
+            for (VReg param : function.params)
+            {
+                extend(param, 0);
+                intervals[param].argument_registers = false;
+            }
+
+            const Liveness liveness = ComputeLiveness(function);
+            std::vector<uint32_t> calls; // positions at which each call reads its arguments
+            uint32_t index = 0;
+            for (BlockId id = 0; id < function.blocks.size(); id++)
+            {
+                const uint32_t first = index;
+                for (const Instr &instr : function.blocks[id].instrs)
+                {
+                    ForEachUse(instr, [&](VReg vreg)
+                               { extend(vreg, 2 * index); });
+                    if (instr.dst != NO_VREG)
+                    {
+                        extend(instr.dst, 2 * index + 1);
+                    }
+                    if (instr.op == Op::CALL)
+                    {
+                        calls.push_back(2 * index);
+                    }
+                    index++;
+                }
+                const uint32_t last = index - 1;
+                liveness.live_in[id].ForEach([&](VReg vreg)
+                                             { extend(vreg, 2 * first); });
+                liveness.live_out[id].ForEach([&](VReg vreg)
+                                              { extend(vreg, 2 * last + 1); });
+            }
+
+            std::erase_if(intervals, [](const Interval &interval)
+                          { return interval.start == UINT32_MAX; });
+            for (Interval &interval : intervals)
+            {
+                // the first call that reads its arguments once the interval is live: results start at odd
+                // positions, after their instruction read, but parameters and values live into a block
+                // are already live when its first instruction reads
+                auto after = std::lower_bound(calls.begin(), calls.end(), interval.start);
+                interval.crosses_call = after != calls.end() && *after + 1 < interval.end;
+                // the first call that still writes its result at or after the start
+                auto touching = std::lower_bound(calls.begin(), calls.end(), interval.start > 0 ? interval.start - 1 : 0);
+                if (touching != calls.end() && *touching <= interval.end)
+                {
+                    interval.argument_registers = false;
+                }
+            }
+            std::stable_sort(intervals.begin(), intervals.end(), [](const Interval &lhs, const Interval &rhs)
+                             { return lhs.start < rhs.start; });
+            return intervals;
+        }
+
+        // registers an interval may take, in order of preference: the ones nobody has to save first
+        std::vector<Reg> Candidates(const Interval &interval, Type type)
+        {
+            std::vector<Reg> candidates;
+            if (!interval.crosses_call)
+            {
+                if (IsFloat(type))
+                {
+                    candidates.assign(std::begin(FLOAT_TEMPORARIES), std::end(FLOAT_TEMPORARIES));
+                }
+                else
+                {
+                    candidates.assign(std::begin(INT_TEMPORARIES), std::end(INT_TEMPORARIES));
+                }
+                if (interval.argument_registers)
+                {
+                    const auto &arguments = IsFloat(type) ? ast::FLOAT_ARGUMENT_REGISTERS : ast::INT_ARGUMENT_REGISTERS;
+                    candidates.insert(candidates.end(), arguments.begin(), arguments.end());
+                }
+            }
+            if (IsFloat(type))
+            {
+                candidates.insert(candidates.end(), std::begin(FLOAT_CALLEE_SAVED), std::end(FLOAT_CALLEE_SAVED));
+            }
+            else
+            {
+                candidates.insert(candidates.end(), std::begin(INT_CALLEE_SAVED), std::end(INT_CALLEE_SAVED));
+            }
+            return candidates;
+        }
+    }
+
+    Allocation AllocateRegisters(const Function &function)
+    {
+        Allocation allocation{std::vector<Reg>(function.vreg_types.size(), Reg::ZERO), {}};
+        RegisterMask taken = 0;
+        std::vector<const Interval *> active;
+
+        const std::vector<Interval> intervals = BuildIntervals(function);
+        for (const Interval &current : intervals)
+        {
+            std::erase_if(active, [&](const Interval *interval)
+                          {
+                              if (interval->end >= current.start)
+                              {
+                                  return false;
+                              }
+                              taken &= ~Bit(allocation.regs[interval->vreg]);
+                              return true; });
+
+            const std::vector<Reg> candidates = Candidates(current, function.TypeOf(current.vreg));
+            auto free = std::find_if(candidates.begin(), candidates.end(), [&](Reg reg)
+                                     { return (taken & Bit(reg)) == 0; });
+            if (free != candidates.end())
+            {
+                allocation.regs[current.vreg] = *free;
+                taken |= Bit(*free);
+                active.push_back(&current);
+                continue;
+            }
+
+            // out of registers: spill whichever of this interval and the active ones it could take
+            // the register of lives the longest
+            RegisterMask allowed = 0;
+            for (Reg reg : candidates)
+            {
+                allowed |= Bit(reg);
+            }
+            auto victim = active.end();
+            for (auto interval = active.begin(); interval != active.end(); ++interval)
+            {
+                if ((allowed & Bit(allocation.regs[(*interval)->vreg])) != 0 && (victim == active.end() || (*interval)->end > (*victim)->end))
+                {
+                    victim = interval;
+                }
+            }
+            if (victim != active.end() && (*victim)->end > current.end)
+            {
+                allocation.regs[current.vreg] = allocation.regs[(*victim)->vreg];
+                allocation.regs[(*victim)->vreg] = Reg::ZERO;
+                *victim = &current;
+            }
+        }
+
+        RegisterMask used = 0;
+        for (Reg reg : allocation.regs)
+        {
+            used |= (reg != Reg::ZERO) ? Bit(reg) : 0;
+        }
+        for (Reg reg : INT_CALLEE_SAVED)
+        {
+            if (used & Bit(reg))
+            {
+                allocation.callee_saved.push_back(reg);
+            }
+        }
+        for (Reg reg : FLOAT_CALLEE_SAVED)
+        {
+            if (used & Bit(reg))
+            {
+                allocation.callee_saved.push_back(reg);
+            }
+        }
+        return allocation;
+    }
+
+} // namespace ir
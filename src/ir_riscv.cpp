@@ -0,0 +1,951 @@
+#include "ir_riscv.hpp"
+
+#include <stdexcept>
+
+#include "ir_peephole.hpp"
+#include "ir_regalloc.hpp"
+
+namespace ir
+{
+    using ast::Reg;
+
+    namespace
+    {
+        enum class Format : uint8_t
+        {
+            LABEL,
+            RD_IMM,      // li rd, imm / lui rd, %hi(symbol)
+            RD_RS1,      // mv rd, rs1
+            RD_RS1_RTZ,  // fcvt.w.s rd, rs1, rtz
+            RD_RS1_RS2,  // add rd, rs1, rs2
+            RD_RS1_IMM,  // addi rd, rs1, imm
+            LOAD,        // lw rd, imm(rs1)
+            STORE,       // sw rs2, imm(rs1)
+            RS1_LABEL,   // beqz rs1, symbol
+            RS1_RS2_LABEL,
+            LABEL_ONLY,  // j symbol / call symbol
+            NONE,
+        };
+
+        struct MOpInfo
+        {
+            std::string_view mnemonic;
+            Format format;
+        };
+
+        constexpr MOpInfo MOP_INFO[] = {
+            {"", Format::LABEL},
+
+            {"li", Format::RD_IMM},
+            {"lui", Format::RD_IMM},
+            {"mv", Format::RD_RS1},
+            {"neg", Format::RD_RS1},
+            {"not", Format::RD_RS1},
+            {"seqz", Format::RD_RS1},
+            {"snez", Format::RD_RS1},
+
+            {"add", Format::RD_RS1_RS2},
+            {"sub", Format::RD_RS1_RS2},
+            {"mul", Format::RD_RS1_RS2},
+            {"div", Format::RD_RS1_RS2},
+            {"divu", Format::RD_RS1_RS2},
+            {"rem", Format::RD_RS1_RS2},
+            {"remu", Format::RD_RS1_RS2},
+            {"and", Format::RD_RS1_RS2},
+            {"or", Format::RD_RS1_RS2},
+            {"xor", Format::RD_RS1_RS2},
+            {"sll", Format::RD_RS1_RS2},
+            {"sra", Format::RD_RS1_RS2},
+            {"srl", Format::RD_RS1_RS2},
+            {"slt", Format::RD_RS1_RS2},
+            {"sltu", Format::RD_RS1_RS2},
+
+            {"addi", Format::RD_RS1_IMM},
+            {"andi", Format::RD_RS1_IMM},
+            {"ori", Format::RD_RS1_IMM},
+            {"xori", Format::RD_RS1_IMM},
+            {"slli", Format::RD_RS1_IMM},
+            {"srai", Format::RD_RS1_IMM},
+            {"srli", Format::RD_RS1_IMM},
+            {"slti", Format::RD_RS1_IMM},
+            {"sltiu", Format::RD_RS1_IMM},
+
+            {"lbu", Format::LOAD},
+            {"lw", Format::LOAD},
+            {"flw", Format::LOAD},
+            {"fld", Format::LOAD},
+            {"sb", Format::STORE},
+            {"sw", Format::STORE},
+            {"fsw", Format::STORE},
+            {"fsd", Format::STORE},
+
+            {"fmv.s", Format::RD_RS1},
+            {"fmv.d", Format::RD_RS1},
+            {"fneg.s", Format::RD_RS1},
+            {"fneg.d", Format::RD_RS1},
+            {"fmv.x.w", Format::RD_RS1},
+            {"fmv.w.x", Format::RD_RS1},
+            {"fadd.s", Format::RD_RS1_RS2},
+            {"fsub.s", Format::RD_RS1_RS2},
+            {"fmul.s", Format::RD_RS1_RS2},
+            {"fdiv.s", Format::RD_RS1_RS2},
+            {"fadd.d", Format::RD_RS1_RS2},
+            {"fsub.d", Format::RD_RS1_RS2},
+            {"fmul.d", Format::RD_RS1_RS2},
+            {"fdiv.d", Format::RD_RS1_RS2},
+            {"feq.s", Format::RD_RS1_RS2},
+            {"flt.s", Format::RD_RS1_RS2},
+            {"fle.s", Format::RD_RS1_RS2},
+            {"feq.d", Format::RD_RS1_RS2},
+            {"flt.d", Format::RD_RS1_RS2},
+            {"fle.d", Format::RD_RS1_RS2},
+            {"fcvt.s.w", Format::RD_RS1},
+            {"fcvt.s.wu", Format::RD_RS1},
+            {"fcvt.d.w", Format::RD_RS1},
+            {"fcvt.d.wu", Format::RD_RS1},
+            {"fcvt.w.s", Format::RD_RS1_RTZ},
+            {"fcvt.wu.s", Format::RD_RS1_RTZ},
+            {"fcvt.w.d", Format::RD_RS1_RTZ},
+            {"fcvt.wu.d", Format::RD_RS1_RTZ},
+            {"fcvt.s.d", Format::RD_RS1},
+            {"fcvt.d.s", Format::RD_RS1},
+
+            {"beqz", Format::RS1_LABEL},
+            {"bnez", Format::RS1_LABEL},
+            {"beq", Format::RS1_RS2_LABEL},
+            {"bne", Format::RS1_RS2_LABEL},
+            {"blt", Format::RS1_RS2_LABEL},
+            {"bge", Format::RS1_RS2_LABEL},
+            {"bltu", Format::RS1_RS2_LABEL},
+            {"bgeu", Format::RS1_RS2_LABEL},
+            {"j", Format::LABEL_ONLY},
+            {"call", Format::LABEL_ONLY},
+            {"ret", Format::NONE},
+        };
+
+        static_assert(std::size(MOP_INFO) == static_cast<size_t>(MOp::RET) + 1);
+
+        constexpr int32_t FRAME_ALIGNMENT = 16;
+        constexpr int32_t RA_OFFSET = -4; // from s0, as the frame pointer is the caller's sp
+        constexpr int32_t S0_OFFSET = -8;
+
+        constexpr bool FitsImmediate(int32_t value) { return value >= -2048 && value < 2048; }
+        constexpr int32_t AlignDown(int32_t value, int32_t align) { return -((-value + align - 1) / align * align); }
+        constexpr int32_t AlignUp(int32_t value, int32_t align) { return (value + align - 1) / align * align; }
+
+        void PrintImmediate(ast::AsmWriter &stream, const MachineInstr &instr)
+        {
+            if (instr.reloc == Reloc::NONE)
+            {
+                stream << instr.imm;
+                return;
+            }
+            stream << (instr.reloc == Reloc::HI ? "%hi(" : "%lo(") << instr.symbol;
+            if (instr.imm > 0)
+            {
+                stream << "+";
+            }
+            if (instr.imm != 0)
+            {
+                stream << instr.imm;
+            }
+            stream << ")";
+        }
+
+        // where an argument is passed: in reg, in reg and reg_high (a double in integer registers),
+        // at stack_offset from the sp of the call, or in reg (low word) and at stack_offset (high word)
+        struct ArgumentLocation
+        {
+            Reg reg = Reg::ZERO;
+            Reg reg_high = Reg::ZERO;
+            int32_t stack_offset = -1;
+        };
+
+        // the standard calling convention: floating point values go in fa0-fa7, then in integer
+        // registers like integers, then on the stack
+        std::vector<ArgumentLocation> AssignArguments(const std::vector<Type> &types, int32_t &stack_size)
+        {
+            std::vector<ArgumentLocation> locations;
+            size_t next_int = 0;
+            size_t next_float = 0;
+            stack_size = 0;
+            for (Type type : types)
+            {
+                ArgumentLocation location;
+                if (IsFloat(type) && next_float < ast::FLOAT_ARGUMENT_REGISTERS.size())
+                {
+                    location.reg = ast::FLOAT_ARGUMENT_REGISTERS[next_float++];
+                }
+                else if (type == Type::F64)
+                {
+                    if (next_int + 1 < ast::INT_ARGUMENT_REGISTERS.size())
+                    {
+                        location.reg = ast::INT_ARGUMENT_REGISTERS[next_int++];
+                        location.reg_high = ast::INT_ARGUMENT_REGISTERS[next_int++];
+                    }
+                    else if (next_int < ast::INT_ARGUMENT_REGISTERS.size())
+                    {
+                        location.reg = ast::INT_ARGUMENT_REGISTERS[next_int++];
+                        location.stack_offset = stack_size;
+                        stack_size += ast::WORD_SIZE;
+                    }
+                    else
+                    {
+                        stack_size = AlignUp(stack_size, 8);
+                        location.stack_offset = stack_size;
+                        stack_size += 8;
+                    }
+                }
+                else if (next_int < ast::INT_ARGUMENT_REGISTERS.size())
+                {
+                    location.reg = ast::INT_ARGUMENT_REGISTERS[next_int++];
+                }
+                else
+                {
+                    location.stack_offset = stack_size;
+                    stack_size += ast::WORD_SIZE;
+                }
+                locations.push_back(location);
+            }
+            stack_size = AlignUp(stack_size, FRAME_ALIGNMENT);
+            return locations;
+        }
+
+        MOp LoadOp(Width width)
+        {
+            constexpr MOp OPS[] = {MOp::LBU, MOp::LW, MOp::FLW, MOp::FLD};
+            return OPS[static_cast<int>(width)];
+        }
+
+        MOp StoreOp(Width width)
+        {
+            constexpr MOp OPS[] = {MOp::SB, MOp::SW, MOp::FSW, MOp::FSD};
+            return OPS[static_cast<int>(width)];
+        }
+
+        // scratch register i (0 to 2) of the class of type
+        Reg Scratch(Type type, int i)
+        {
+            constexpr Reg INT_SCRATCH[] = {Reg::T0, Reg::T1, Reg::T2};
+            constexpr Reg FLOAT_SCRATCH[] = {Reg::FT0, Reg::FT1, Reg::FT2};
+            return IsFloat(type) ? FLOAT_SCRATCH[i] : INT_SCRATCH[i];
+        }
+
+        // instruction of an IR operation on operands of type, or LABEL if it takes more than one
+        MOp SimpleOp(Op op, Type type)
+        {
+            if (type == Type::I32)
+            {
+                switch (op)
+                {
+                case Op::ADD:
+                    return MOp::ADD;
+                case Op::SUB:
+                    return MOp::SUB;
+                case Op::MUL:
+                    return MOp::MUL;
+                case Op::DIV:
+                    return MOp::DIV;
+                case Op::DIVU:
+                    return MOp::DIVU;
+                case Op::REM:
+                    return MOp::REM;
+                case Op::REMU:
+                    return MOp::REMU;
+                case Op::AND:
+                    return MOp::AND;
+                case Op::OR:
+                    return MOp::OR;
+                case Op::XOR:
+                    return MOp::XOR;
+                case Op::SHL:
+                    return MOp::SLL;
+                case Op::SHR:
+                    return MOp::SRA;
+                case Op::SHRU:
+                    return MOp::SRL;
+                case Op::LT:
+                    return MOp::SLT;
+                case Op::LTU:
+                    return MOp::SLTU;
+                case Op::NEG:
+                    return MOp::NEG;
+                case Op::NOT:
+                    return MOp::NOT;
+                default:
+                    return MOp::LABEL;
+                }
+            }
+            const bool is_double = type == Type::F64;
+            switch (op)
+            {
+            case Op::ADD:
+                return is_double ? MOp::FADD_D : MOp::FADD_S;
+            case Op::SUB:
+                return is_double ? MOp::FSUB_D : MOp::FSUB_S;
+            case Op::MUL:
+                return is_double ? MOp::FMUL_D : MOp::FMUL_S;
+            case Op::DIV:
+                return is_double ? MOp::FDIV_D : MOp::FDIV_S;
+            case Op::EQ:
+                return is_double ? MOp::FEQ_D : MOp::FEQ_S;
+            case Op::LT:
+                return is_double ? MOp::FLT_D : MOp::FLT_S;
+            case Op::LE:
+                return is_double ? MOp::FLE_D : MOp::FLE_S;
+            case Op::NEG:
+                return is_double ? MOp::FNEG_D : MOp::FNEG_S;
+            default:
+                return MOp::LABEL;
+            }
+        }
+
+        // conversion from a value of type from to one of type to
+        MOp ConvertOp(Op op, Type from, Type to)
+        {
+            switch (op)
+            {
+            case Op::ITOF:
+                return (to == Type::F64) ? MOp::FCVT_D_W : MOp::FCVT_S_W;
+            case Op::UTOF:
+                return (to == Type::F64) ? MOp::FCVT_D_WU : MOp::FCVT_S_WU;
+            case Op::FTOI:
+                return (from == Type::F64) ? MOp::FCVT_W_D : MOp::FCVT_W_S;
+            case Op::FTOU:
+                return (from == Type::F64) ? MOp::FCVT_WU_D : MOp::FCVT_WU_S;
+            case Op::FCVT:
+                return (to == Type::F64) ? MOp::FCVT_D_S : MOp::FCVT_S_D;
+            default:
+                throw std::runtime_error("ConvertOp: not a conversion");
+            }
+        }
+
+        class InstructionSelector
+        {
+        private:
+            const Function &function_;
+            ast::Context &context_;
+            std::vector<MachineInstr> out_;
+            Allocation allocation_;
+            std::vector<int32_t> saved_offsets_; // of allocation_.callee_saved, from s0
+            std::vector<int32_t> slot_offsets_;  // from s0
+            std::vector<int32_t> vreg_offsets_;  // of the spilled registers
+            int32_t bitcast_offset_ = 0; // 8 bytes for moving doubles between register files
+            int32_t frame_size_ = 0;
+            std::vector<std::string> block_labels_;
+            std::string epilogue_label_;
+
+            void Add(MachineInstr instr) { out_.push_back(std::move(instr)); }
+
+            void LayOutFrame()
+            {
+                allocation_ = AllocateRegisters(function_);
+                int32_t offset = S0_OFFSET;
+                for (Reg reg : allocation_.callee_saved)
+                {
+                    // the callee saves the whole of a float register, which may hold a double
+                    int32_t size = ast::IsFloatRegister(reg) ? 8 : ast::WORD_SIZE;
+                    offset = AlignDown(offset - size, size);
+                    saved_offsets_.push_back(offset);
+                }
+                for (const Slot &slot : function_.slots)
+                {
+                    offset = AlignDown(offset - slot.size, std::max(slot.align, 1));
+                    slot_offsets_.push_back(offset);
+                }
+                // allocated registers, and those the optimizations left without a definition, take no space
+                std::vector<bool> defined(function_.vreg_types.size(), false);
+                for (VReg param : function_.params)
+                {
+                    defined[param] = true;
+                }
+                for (const Block &block : function_.blocks)
+                {
+                    for (const Instr &instr : block.instrs)
+                    {
+                        if (instr.dst != NO_VREG)
+                        {
+                            defined[instr.dst] = true;
+                        }
+                    }
+                }
+                for (VReg vreg = 0; vreg < function_.vreg_types.size(); vreg++)
+                {
+                    if (!defined[vreg] || allocation_.regs[vreg] != Reg::ZERO)
+                    {
+                        vreg_offsets_.push_back(0);
+                        continue;
+                    }
+                    const Type type = function_.TypeOf(vreg);
+                    int32_t size = (type == Type::F64) ? 8 : ast::WORD_SIZE;
+                    offset = AlignDown(offset - size, size);
+                    vreg_offsets_.push_back(offset);
+                }
+                offset = AlignDown(offset - 8, 8);
+                bitcast_offset_ = offset;
+
+                int32_t outgoing = 0;
+                for (const Block &block : function_.blocks)
+                {
+                    for (const Instr &instr : block.instrs)
+                    {
+                        if (instr.op == Op::CALL)
+                        {
+                            int32_t stack_size;
+                            AssignArguments(ArgumentTypes(instr), stack_size);
+                            outgoing = std::max(outgoing, stack_size);
+                        }
+                    }
+                }
+                frame_size_ = AlignUp(-offset + outgoing, FRAME_ALIGNMENT);
+            }
+
+            std::vector<Type> ArgumentTypes(const Instr &call) const
+            {
+                std::vector<Type> types;
+                for (VReg arg : call.args)
+                {
+                    types.push_back(function_.TypeOf(arg));
+                }
+                return types;
+            }
+
+            // rd = rs + imm
+            void AddImmediate(Reg rd, Reg rs, int32_t imm)
+            {
+                if (FitsImmediate(imm))
+                {
+                    if (imm != 0 || rd != rs)
+                    {
+                        Add({.op = MOp::ADDI, .rd = rd, .rs1 = rs, .imm = imm});
+                    }
+                    return;
+                }
+                Add({.op = MOp::LI, .rd = Reg::T6, .imm = imm});
+                Add({.op = MOp::ADD, .rd = rd, .rs1 = rs, .rs2 = Reg::T6});
+            }
+
+            // a load into or store from reg at offset(base), through t6 if the offset is out of range
+            void Memory(MOp op, Reg reg, Reg base, int32_t offset)
+            {
+                if (!FitsImmediate(offset))
+                {
+                    AddImmediate(Reg::T6, base, offset);
+                    base = Reg::T6;
+                    offset = 0;
+                }
+                if (MOP_INFO[static_cast<int>(op)].format == Format::STORE)
+                {
+                    Add({.op = op, .rs1 = base, .rs2 = reg, .imm = offset});
+                }
+                else
+                {
+                    Add({.op = op, .rd = reg, .rs1 = base, .imm = offset});
+                }
+            }
+
+            void Memory(MOp op, Reg reg, const Address &address, Reg base_scratch)
+            {
+                if (address.slot != NO_SLOT)
+                {
+                    Memory(op, reg, Reg::S0, slot_offsets_[address.slot] + address.offset);
+                }
+                else if (address.base != NO_VREG)
+                {
+                    Memory(op, reg, Use(address.base, base_scratch), address.offset);
+                }
+                else
+                {
+                    std::string symbol(ast::Spelling(address.symbol));
+                    Add({.op = MOp::LUI, .rd = Reg::T6, .imm = address.offset, .reloc = Reloc::HI, .symbol = symbol});
+                    MachineInstr access = {.op = op, .rs1 = Reg::T6, .imm = address.offset, .reloc = Reloc::LO, .symbol = symbol};
+                    (MOP_INFO[static_cast<int>(op)].format == Format::STORE ? access.rs2 : access.rd) = reg;
+                    Add(std::move(access));
+                }
+            }
+
+            // ---- virtual registers
+            // the register holding vreg, loaded into scratch if it was spilled
+            Reg Use(VReg vreg, Reg scratch)
+            {
+                if (allocation_.regs[vreg] != Reg::ZERO)
+                {
+                    return allocation_.regs[vreg];
+                }
+                Memory(LoadOp(WidthOf(function_.TypeOf(vreg))), scratch, Reg::S0, vreg_offsets_[vreg]);
+                return scratch;
+            }
+
+            // the register to compute vreg into, then passed to Def
+            Reg Target(VReg vreg, Reg scratch)
+            {
+                return (allocation_.regs[vreg] != Reg::ZERO) ? allocation_.regs[vreg] : scratch;
+            }
+
+            void Def(VReg vreg, Reg reg)
+            {
+                if (allocation_.regs[vreg] != Reg::ZERO)
+                {
+                    Move(allocation_.regs[vreg], reg, function_.TypeOf(vreg));
+                    return;
+                }
+                Memory(StoreOp(WidthOf(function_.TypeOf(vreg))), reg, Reg::S0, vreg_offsets_[vreg]);
+            }
+
+            void Move(Reg rd, Reg rs, Type type)
+            {
+                if (rd == rs)
+                {
+                    return;
+                }
+                MOp op = (type == Type::I32) ? MOp::MV : (type == Type::F32) ? MOp::FMV_S
+                                                                              : MOp::FMV_D;
+                Add({.op = op, .rd = rd, .rs1 = rs});
+            }
+
+            // ---- frame
+            void Prologue()
+            {
+                AddImmediate(Reg::SP, Reg::SP, -frame_size_);
+                Memory(MOp::SW, Reg::RA, Reg::SP, frame_size_ + RA_OFFSET);
+                Memory(MOp::SW, Reg::S0, Reg::SP, frame_size_ + S0_OFFSET);
+                AddImmediate(Reg::S0, Reg::SP, frame_size_);
+                for (size_t i = 0; i < allocation_.callee_saved.size(); i++)
+                {
+                    const Reg reg = allocation_.callee_saved[i];
+                    Memory(ast::IsFloatRegister(reg) ? MOp::FSD : MOp::SW, reg, Reg::S0, saved_offsets_[i]);
+                }
+
+                int32_t stack_size;
+                std::vector<Type> types;
+                for (VReg param : function_.params)
+                {
+                    types.push_back(function_.TypeOf(param));
+                }
+                std::vector<ArgumentLocation> locations = AssignArguments(types, stack_size);
+                for (size_t i = 0; i < function_.params.size(); i++)
+                {
+                    ReceiveArgument(function_.params[i], locations[i]);
+                }
+            }
+
+            // incoming stack arguments are at the sp of the caller, which s0 is
+            void ReceiveArgument(VReg param, const ArgumentLocation &location)
+            {
+                const Type type = function_.TypeOf(param);
+                const Reg rd = Target(param, Scratch(type, 0));
+                if (location.reg == Reg::ZERO)
+                {
+                    Memory(LoadOp(WidthOf(type)), rd, Reg::S0, location.stack_offset);
+                    Def(param, rd);
+                }
+                else if (ast::IsFloatRegister(location.reg) == IsFloat(type))
+                {
+                    Def(param, location.reg);
+                }
+                else if (type == Type::F32)
+                {
+                    Add({.op = MOp::FMV_W_X, .rd = rd, .rs1 = location.reg});
+                    Def(param, rd);
+                }
+                else
+                {
+                    Memory(MOp::SW, location.reg, Reg::S0, bitcast_offset_);
+                    if (location.reg_high != Reg::ZERO)
+                    {
+                        Memory(MOp::SW, location.reg_high, Reg::S0, bitcast_offset_ + ast::WORD_SIZE);
+                    }
+                    else
+                    {
+                        Memory(MOp::LW, Reg::T0, Reg::S0, location.stack_offset);
+                        Memory(MOp::SW, Reg::T0, Reg::S0, bitcast_offset_ + ast::WORD_SIZE);
+                    }
+                    Memory(MOp::FLD, rd, Reg::S0, bitcast_offset_);
+                    Def(param, rd);
+                }
+            }
+
+            void PassArgument(VReg arg, const ArgumentLocation &location)
+            {
+                const Type type = function_.TypeOf(arg);
+                if (location.reg == Reg::ZERO)
+                {
+                    Memory(StoreOp(WidthOf(type)), Use(arg, Scratch(type, 0)), Reg::SP, location.stack_offset);
+                }
+                else if (ast::IsFloatRegister(location.reg) == IsFloat(type))
+                {
+                    Move(location.reg, Use(arg, location.reg), type);
+                }
+                else if (type == Type::F32)
+                {
+                    Add({.op = MOp::FMV_X_W, .rd = location.reg, .rs1 = Use(arg, Reg::FT0)});
+                }
+                else
+                {
+                    Memory(MOp::FSD, Use(arg, Reg::FT0), Reg::S0, bitcast_offset_);
+                    Memory(MOp::LW, location.reg, Reg::S0, bitcast_offset_);
+                    if (location.reg_high != Reg::ZERO)
+                    {
+                        Memory(MOp::LW, location.reg_high, Reg::S0, bitcast_offset_ + ast::WORD_SIZE);
+                    }
+                    else
+                    {
+                        Memory(MOp::LW, Reg::T0, Reg::S0, bitcast_offset_ + ast::WORD_SIZE);
+                        Memory(MOp::SW, Reg::T0, Reg::SP, location.stack_offset);
+                    }
+                }
+            }
+
+            void Epilogue()
+            {
+                Add({.op = MOp::LABEL, .symbol = epilogue_label_});
+                for (size_t i = 0; i < allocation_.callee_saved.size(); i++)
+                {
+                    const Reg reg = allocation_.callee_saved[i];
+                    Memory(ast::IsFloatRegister(reg) ? MOp::FLD : MOp::LW, reg, Reg::S0, saved_offsets_[i]);
+                }
+                Add({.op = MOp::LW, .rd = Reg::RA, .rs1 = Reg::S0, .imm = RA_OFFSET});
+                Add({.op = MOp::MV, .rd = Reg::SP, .rs1 = Reg::S0});
+                Add({.op = MOp::LW, .rd = Reg::S0, .rs1 = Reg::SP, .imm = S0_OFFSET});
+                Add({.op = MOp::RET});
+            }
+
+            // ---- instructions
+            void SelectCompare(const Instr &instr)
+            {
+                const Type type = function_.TypeOf(instr.a);
+                Reg a = Use(instr.a, Scratch(type, 0));
+                Reg b = Use(instr.b, Scratch(type, 1));
+                Reg rd = Target(instr.dst, Reg::T2);
+                if (IsFloat(type))
+                {
+                    // a != b is !(a == b)
+                    Add({.op = SimpleOp(instr.op == Op::NE ? Op::EQ : instr.op, type), .rd = rd, .rs1 = a, .rs2 = b});
+                    if (instr.op == Op::NE)
+                    {
+                        Add({.op = MOp::XORI, .rd = rd, .rs1 = rd, .imm = 1});
+                    }
+                }
+                else if (instr.op == Op::EQ || instr.op == Op::NE)
+                {
+                    Add({.op = MOp::SUB, .rd = rd, .rs1 = a, .rs2 = b});
+                    Add({.op = instr.op == Op::EQ ? MOp::SEQZ : MOp::SNEZ, .rd = rd, .rs1 = rd});
+                }
+                else if (instr.op == Op::LE || instr.op == Op::LEU)
+                {
+                    // a <= b is !(b < a)
+                    Add({.op = instr.op == Op::LE ? MOp::SLT : MOp::SLTU, .rd = rd, .rs1 = b, .rs2 = a});
+                    Add({.op = MOp::XORI, .rd = rd, .rs1 = rd, .imm = 1});
+                }
+                else
+                {
+                    Add({.op = SimpleOp(instr.op, type), .rd = rd, .rs1 = a, .rs2 = b});
+                }
+                Def(instr.dst, rd);
+            }
+
+            void SelectCall(const Instr &instr)
+            {
+                int32_t stack_size;
+                std::vector<ArgumentLocation> locations = AssignArguments(ArgumentTypes(instr), stack_size);
+                for (size_t i = 0; i < instr.args.size(); i++)
+                {
+                    PassArgument(instr.args[i], locations[i]);
+                }
+                Add({.op = MOp::CALL, .symbol = std::string(ast::Spelling(instr.callee))});
+                if (instr.dst != NO_VREG)
+                {
+                    Def(instr.dst, IsFloat(function_.TypeOf(instr.dst)) ? Reg::FA0 : Reg::A0);
+                }
+            }
+
+            void Select(const Instr &instr)
+            {
+                const Type type = (instr.dst != NO_VREG) ? function_.TypeOf(instr.dst) : Type::I32;
+                switch (instr.op)
+                {
+                case Op::CONST:
+                {
+                    Reg rd = Target(instr.dst, Reg::T2);
+                    Add({.op = MOp::LI, .rd = rd, .imm = instr.imm});
+                    Def(instr.dst, rd);
+                    break;
+                }
+                case Op::FCONST:
+                {
+                    std::string label = context_.AddFloatLiteralConstant(instr.fimm, type == Type::F64 ? ast::TypeSpecifier::DOUBLE : ast::TypeSpecifier::FLOAT);
+                    Reg rd = Target(instr.dst, Reg::FT2);
+                    Add({.op = MOp::LUI, .rd = Reg::T6, .reloc = Reloc::HI, .symbol = label});
+                    Add({.op = LoadOp(WidthOf(type)), .rd = rd, .rs1 = Reg::T6, .reloc = Reloc::LO, .symbol = label});
+                    Def(instr.dst, rd);
+                    break;
+                }
+                case Op::COPY:
+                {
+                    Reg a = Use(instr.a, Scratch(type, 0));
+                    Reg rd = Target(instr.dst, Scratch(type, 2));
+                    Move(rd, a, type);
+                    Def(instr.dst, rd);
+                    break;
+                }
+                case Op::EQ:
+                case Op::NE:
+                case Op::LT:
+                case Op::LE:
+                case Op::LTU:
+                case Op::LEU:
+                    SelectCompare(instr);
+                    break;
+                case Op::NEG:
+                case Op::NOT:
+                {
+                    Reg a = Use(instr.a, Scratch(type, 0));
+                    Reg rd = Target(instr.dst, Scratch(type, 2));
+                    Add({.op = SimpleOp(instr.op, type), .rd = rd, .rs1 = a});
+                    Def(instr.dst, rd);
+                    break;
+                }
+                case Op::ITOF:
+                case Op::UTOF:
+                case Op::FTOI:
+                case Op::FTOU:
+                case Op::FCVT:
+                {
+                    const Type from = function_.TypeOf(instr.a);
+                    Reg a = Use(instr.a, Scratch(from, 0));
+                    Reg rd = Target(instr.dst, Scratch(type, 2));
+                    Add({.op = ConvertOp(instr.op, from, type), .rd = rd, .rs1 = a});
+                    Def(instr.dst, rd);
+                    break;
+                }
+                case Op::ADDR:
+                {
+                    Reg rd = Target(instr.dst, Reg::T2);
+                    const Address &address = instr.address;
+                    if (address.slot != NO_SLOT)
+                    {
+                        AddImmediate(rd, Reg::S0, slot_offsets_[address.slot] + address.offset);
+                    }
+                    else if (address.base != NO_VREG)
+                    {
+                        AddImmediate(rd, Use(address.base, Reg::T1), address.offset);
+                    }
+                    else
+                    {
+                        std::string symbol(ast::Spelling(address.symbol));
+                        Add({.op = MOp::LUI, .rd = rd, .imm = address.offset, .reloc = Reloc::HI, .symbol = symbol});
+                        Add({.op = MOp::ADDI, .rd = rd, .rs1 = rd, .imm = address.offset, .reloc = Reloc::LO, .symbol = symbol});
+                    }
+                    Def(instr.dst, rd);
+                    break;
+                }
+                case Op::LOAD:
+                {
+                    Reg rd = Target(instr.dst, Scratch(type, 2));
+                    Memory(LoadOp(instr.width), rd, instr.address, Reg::T1);
+                    Def(instr.dst, rd);
+                    break;
+                }
+                case Op::STORE:
+                    Memory(StoreOp(instr.width), Use(instr.a, Scratch(function_.TypeOf(instr.a), 0)), instr.address, Reg::T1);
+                    break;
+                case Op::CALL:
+                    SelectCall(instr);
+                    break;
+                case Op::JUMP:
+                    Add({.op = MOp::J, .symbol = block_labels_[instr.target]});
+                    break;
+                case Op::BRANCH:
+                    Add({.op = MOp::BNEZ, .rs1 = Use(instr.a, Reg::T0), .symbol = block_labels_[instr.target]});
+                    Add({.op = MOp::J, .symbol = block_labels_[instr.target2]});
+                    break;
+                case Op::PHI:
+                    throw std::runtime_error("SelectInstructions: phi left in " + std::string(ast::Spelling(function_.name)));
+                case Op::RET:
+                    if (instr.a != NO_VREG)
+                    {
+                        const Type return_type = function_.TypeOf(instr.a);
+                        Reg result = IsFloat(return_type) ? Reg::FA0 : Reg::A0;
+                        Move(result, Use(instr.a, result), return_type);
+                    }
+                    Add({.op = MOp::J, .symbol = epilogue_label_});
+                    break;
+                default:
+                {
+                    // the remaining operations are binary
+                    Reg a = Use(instr.a, Scratch(type, 0));
+                    Reg b = Use(instr.b, Scratch(type, 1));
+                    Reg rd = Target(instr.dst, Scratch(type, 2));
+                    Add({.op = SimpleOp(instr.op, type), .rd = rd, .rs1 = a, .rs2 = b});
+                    Def(instr.dst, rd);
+                    break;
+                }
+                }
+            }
+
+        public:
+            InstructionSelector(const Function &function, ast::Context &context) : function_(function), context_(context) {}
+
+            std::vector<MachineInstr> Run()
+            {
+                LayOutFrame();
+                for (size_t i = 0; i < function_.blocks.size(); i++)
+                {
+                    block_labels_.push_back(context_.GenerateUniqueLabel("bb"));
+                }
+                epilogue_label_ = context_.GenerateUniqueLabel("epilogue");
+
+                Prologue();
+                for (BlockId id = 0; id < function_.blocks.size(); id++)
+                {
+                    Add({.op = MOp::LABEL, .symbol = block_labels_[id]});
+                    for (const Instr &instr : function_.blocks[id].instrs)
+                    {
+                        Select(instr);
+                    }
+                }
+                Epilogue();
+                return std::move(out_);
+            }
+        };
+    }
+
+    void Print(ast::AsmWriter &stream, const MachineInstr &instr)
+    {
+        const MOpInfo &info = MOP_INFO[static_cast<int>(instr.op)];
+        if (info.format == Format::LABEL)
+        {
+            stream << instr.symbol << ":\n";
+            return;
+        }
+        stream << info.mnemonic;
+        switch (info.format)
+        {
+        case Format::RD_IMM:
+            stream << " " << instr.rd << ", ";
+            PrintImmediate(stream, instr);
+            break;
+        case Format::RD_RS1:
+            stream << " " << instr.rd << ", " << instr.rs1;
+            break;
+        case Format::RD_RS1_RTZ:
+            stream << " " << instr.rd << ", " << instr.rs1 << ", rtz";
+            break;
+        case Format::RD_RS1_RS2:
+            stream << " " << instr.rd << ", " << instr.rs1 << ", " << instr.rs2;
+            break;
+        case Format::RD_RS1_IMM:
+            stream << " " << instr.rd << ", " << instr.rs1 << ", ";
+            PrintImmediate(stream, instr);
+            break;
+        case Format::LOAD:
+            stream << " " << instr.rd << ", ";
+            PrintImmediate(stream, instr);
+            stream << "(" << instr.rs1 << ")";
+            break;
+        case Format::STORE:
+            stream << " " << instr.rs2 << ", ";
+            PrintImmediate(stream, instr);
+            stream << "(" << instr.rs1 << ")";
+            break;
+        case Format::RS1_LABEL:
+            stream << " " << instr.rs1 << ", " << instr.symbol;
+            break;
+        case Format::RS1_RS2_LABEL:
+            stream << " " << instr.rs1 << ", " << instr.rs2 << ", " << instr.symbol;
+            break;
+        case Format::LABEL_ONLY:
+            stream << " " << instr.symbol;
+            break;
+        default:
+            break;
+        }
+        stream << "\n";
+    }
+
+    ast::RegisterMask Uses(const MachineInstr &instr)
+    {
+        auto bit = [](Reg reg)
+        { return ast::RegisterMask(1) << static_cast<int>(reg); };
+        ast::RegisterMask uses = 0;
+        switch (MOP_INFO[static_cast<int>(instr.op)].format)
+        {
+        case Format::RD_RS1:
+        case Format::RD_RS1_RTZ:
+        case Format::RD_RS1_IMM:
+        case Format::LOAD:
+        case Format::RS1_LABEL:
+            uses = bit(instr.rs1);
+            break;
+        case Format::RD_RS1_RS2:
+        case Format::STORE:
+        case Format::RS1_RS2_LABEL:
+            uses = bit(instr.rs1) | bit(instr.rs2);
+            break;
+        default:
+            break;
+        }
+        if (instr.op == MOp::CALL)
+        {
+            for (size_t i = 0; i < ast::INT_ARGUMENT_REGISTERS.size(); i++)
+            {
+                uses |= bit(ast::INT_ARGUMENT_REGISTERS[i]) | bit(ast::FLOAT_ARGUMENT_REGISTERS[i]);
+            }
+            uses |= bit(Reg::SP);
+        }
+        else if (instr.op == MOp::RET)
+        {
+            // the return value and whatever the caller expects to find unchanged
+            uses = ~Defs({.op = MOp::CALL}) | bit(Reg::RA) | bit(Reg::A0) | bit(Reg::A1) | bit(Reg::FA0) | bit(Reg::FA1);
+        }
+        return uses & ~bit(Reg::ZERO);
+    }
+
+    ast::RegisterMask Defs(const MachineInstr &instr)
+    {
+        auto bit = [](Reg reg)
+        { return ast::RegisterMask(1) << static_cast<int>(reg); };
+        switch (MOP_INFO[static_cast<int>(instr.op)].format)
+        {
+        case Format::RD_IMM:
+        case Format::RD_RS1:
+        case Format::RD_RS1_RTZ:
+        case Format::RD_RS1_RS2:
+        case Format::RD_RS1_IMM:
+        case Format::LOAD:
+            return bit(instr.rd) & ~bit(Reg::ZERO);
+        default:
+            break;
+        }
+        if (instr.op != MOp::CALL)
+        {
+            return 0;
+        }
+        ast::RegisterMask callee_saved = bit(Reg::ZERO) | bit(Reg::SP) | bit(Reg::GP) | bit(Reg::TP);
+        for (int reg = static_cast<int>(Reg::S0); reg <= static_cast<int>(Reg::FS11); reg++)
+        {
+            callee_saved |= bit(static_cast<Reg>(reg));
+        }
+        return ~callee_saved;
+    }
+
+    std::vector<MachineInstr> SelectInstructions(const Function &function, ast::Context &context)
+    {
+        return InstructionSelector(function, context).Run();
+    }
+
+    void EmitFunction(ast::AsmWriter &stream, const Function &function, ast::Context &context)
+    {
+        std::vector<MachineInstr> instrs = SelectInstructions(function, context);
+        PeepholeCounts counts = Peephole(instrs);
+        ReportPeephole(context.GetTimeReport(), counts);
+        stream.Section(".text");
+        stream.Global(ast::Spelling(function.name));
+        stream << function.name << ":" << "\n";
+        for (const MachineInstr &instr : instrs)
+        {
+            Print(stream, instr);
+        }
+    }
+
+} // namespace ir
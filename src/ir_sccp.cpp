@@ -0,0 +1,410 @@
+#include "ir_passes.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace ir
+{
+    namespace
+    {
+        // UNDEFINED until a definition is seen to run, VARYING once it can hold two values
+        enum class Level : uint8_t
+        {
+            UNDEFINED,
+            CONSTANT,
+            VARYING
+        };
+
+        struct Value
+        {
+            Level level = Level::UNDEFINED;
+            int32_t i = 0; // of I32 constants
+            double f = 0;  // of F32 and F64 constants
+
+            static Value Integer(uint32_t value) { return {Level::CONSTANT, static_cast<int32_t>(value), 0}; }
+            static Value Floating(double value) { return {Level::CONSTANT, 0, value}; }
+            static Value Varying() { return {Level::VARYING, 0, 0}; }
+        };
+
+        // the same constant, telling 0.0 from -0.0
+        bool operator==(const Value &lhs, const Value &rhs)
+        {
+            return lhs.level == rhs.level && lhs.i == rhs.i && std::memcmp(&lhs.f, &rhs.f, sizeof(double)) == 0;
+        }
+
+        Value Meet(const Value &lhs, const Value &rhs)
+        {
+            if (lhs.level == Level::UNDEFINED)
+            {
+                return rhs;
+            }
+            if (rhs.level == Level::UNDEFINED || lhs == rhs)
+            {
+                return lhs;
+            }
+            return Value::Varying();
+        }
+
+        // a float result as the target computes it, or VARYING for NaNs, whose payload may differ
+        Value Floating(double value, Type type)
+        {
+            if (std::isnan(value))
+            {
+                return Value::Varying();
+            }
+            return Value::Floating(type == Type::F32 ? static_cast<double>(static_cast<float>(value)) : value);
+        }
+
+        Value FoldFloat(Op op, Type type, double a, double b)
+        {
+            const bool single = type == Type::F32;
+            switch (op)
+            {
+            case Op::ADD:
+                return Floating(single ? static_cast<float>(a) + static_cast<float>(b) : a + b, type);
+            case Op::SUB:
+                return Floating(single ? static_cast<float>(a) - static_cast<float>(b) : a - b, type);
+            case Op::MUL:
+                return Floating(single ? static_cast<float>(a) * static_cast<float>(b) : a * b, type);
+            case Op::DIV:
+                return Floating(single ? static_cast<float>(a) / static_cast<float>(b) : a / b, type);
+            case Op::EQ:
+                return Value::Integer(a == b);
+            case Op::NE:
+                return Value::Integer(a != b);
+            case Op::LT:
+                return Value::Integer(a < b);
+            case Op::LE:
+                return Value::Integer(a <= b);
+            case Op::NEG:
+                return Floating(-a, type);
+            default:
+                return Value::Varying();
+            }
+        }
+
+        Value FoldInteger(Op op, int32_t a, int32_t b)
+        {
+            const uint32_t ua = a;
+            const uint32_t ub = b;
+            switch (op)
+            {
+            case Op::ADD:
+                return Value::Integer(ua + ub);
+            case Op::SUB:
+                return Value::Integer(ua - ub);
+            case Op::MUL:
+                return Value::Integer(ua * ub);
+            case Op::DIV:
+            case Op::REM:
+                if (b == 0 || (a == INT32_MIN && b == -1))
+                {
+                    return Value::Varying();
+                }
+                return Value::Integer(op == Op::DIV ? a / b : a % b);
+            case Op::DIVU:
+            case Op::REMU:
+                if (ub == 0)
+                {
+                    return Value::Varying();
+                }
+                return Value::Integer(op == Op::DIVU ? ua / ub : ua % ub);
+            case Op::AND:
+                return Value::Integer(ua & ub);
+            case Op::OR:
+                return Value::Integer(ua | ub);
+            case Op::XOR:
+                return Value::Integer(ua ^ ub);
+            // the shifts use the low five bits of the amount, as sll, sra and srl do
+            case Op::SHL:
+                return Value::Integer(ua << (ub & 31));
+            case Op::SHR:
+                return Value::Integer(static_cast<uint32_t>(a >> (ub & 31)));
+            case Op::SHRU:
+                return Value::Integer(ua >> (ub & 31));
+            case Op::EQ:
+                return Value::Integer(a == b);
+            case Op::NE:
+                return Value::Integer(a != b);
+            case Op::LT:
+                return Value::Integer(a < b);
+            case Op::LE:
+                return Value::Integer(a <= b);
+            case Op::LTU:
+                return Value::Integer(ua < ub);
+            case Op::LEU:
+                return Value::Integer(ua <= ub);
+            case Op::NEG:
+                return Value::Integer(0u - ua);
+            case Op::NOT:
+                return Value::Integer(~ua);
+            default:
+                return Value::Varying();
+            }
+        }
+
+        // value of a conversion; float to integer only when the truncated value is in range
+        Value FoldConversion(Op op, Type to, const Value &a)
+        {
+            switch (op)
+            {
+            case Op::ITOF:
+                return Floating(to == Type::F32 ? static_cast<double>(static_cast<float>(a.i)) : static_cast<double>(a.i), to);
+            case Op::UTOF:
+            {
+                const uint32_t value = a.i;
+                return Floating(to == Type::F32 ? static_cast<double>(static_cast<float>(value)) : static_cast<double>(value), to);
+            }
+            case Op::FTOI:
+                if (!(a.f > -2147483649.0 && a.f < 2147483648.0))
+                {
+                    return Value::Varying();
+                }
+                return Value::Integer(static_cast<int32_t>(a.f));
+            case Op::FTOU:
+                if (!(a.f > -1.0 && a.f < 4294967296.0))
+                {
+                    return Value::Varying();
+                }
+                return Value::Integer(static_cast<uint32_t>(a.f));
+            case Op::FCVT:
+                return Floating(a.f, to);
+            default:
+                return Value::Varying();
+            }
+        }
+
+        class Propagation
+        {
+        private:
+            Function &function_;
+            std::vector<Value> values_; // indexed by VReg
+            std::vector<std::vector<std::pair<BlockId, uint32_t>>> users_; // instructions using each register
+            std::vector<bool> reached_;                          // blocks with an executable incoming edge
+            std::vector<std::vector<bool>> executable_;          // of each block's incoming edges, as preds
+            std::vector<std::pair<BlockId, BlockId>> edge_work_; // from, to
+            std::vector<VReg> value_work_;
+
+            const Value &Of(VReg vreg) const { return values_[vreg]; }
+
+            void Set(VReg vreg, const Value &value)
+            {
+                Value merged = Meet(values_[vreg], value);
+                if (!(merged == values_[vreg]))
+                {
+                    values_[vreg] = merged;
+                    value_work_.push_back(vreg);
+                }
+            }
+
+            Value Evaluate(const Instr &instr) const
+            {
+                switch (instr.op)
+                {
+                case Op::CONST:
+                    return Value::Integer(instr.imm);
+                case Op::FCONST:
+                    return Value::Floating(instr.fimm);
+                case Op::ADDR:
+                case Op::LOAD:
+                case Op::CALL:
+                    return Value::Varying();
+                default:
+                    break;
+                }
+
+                const Value &a = Of(instr.a);
+                const Value b = (instr.b != NO_VREG) ? Of(instr.b) : Value::Integer(0);
+                if (a.level == Level::VARYING || b.level == Level::VARYING)
+                {
+                    return Value::Varying();
+                }
+                if (a.level == Level::UNDEFINED || b.level == Level::UNDEFINED)
+                {
+                    return {};
+                }
+                const Type type = function_.TypeOf(instr.dst);
+                const Type operand_type = function_.TypeOf(instr.a);
+                if (instr.op == Op::COPY)
+                {
+                    return a;
+                }
+                if (instr.op >= Op::ITOF && instr.op <= Op::FCVT)
+                {
+                    return FoldConversion(instr.op, type, a);
+                }
+                if (IsFloat(operand_type))
+                {
+                    return FoldFloat(instr.op, operand_type, a.f, b.f);
+                }
+                return FoldInteger(instr.op, a.i, b.i);
+            }
+
+            void MarkEdge(BlockId from, BlockId to)
+            {
+                edge_work_.push_back({from, to});
+            }
+
+            void Visit(BlockId id, uint32_t index)
+            {
+                const Block &block = function_.blocks[id];
+                const Instr &instr = block.instrs[index];
+                switch (instr.op)
+                {
+                case Op::PHI:
+                {
+                    Value value;
+                    for (size_t i = 0; i < instr.args.size(); i++)
+                    {
+                        if (executable_[id][i])
+                        {
+                            value = Meet(value, Of(instr.args[i]));
+                        }
+                    }
+                    Set(instr.dst, value);
+                    break;
+                }
+                case Op::JUMP:
+                    MarkEdge(id, instr.target);
+                    break;
+                case Op::BRANCH:
+                {
+                    const Value &condition = Of(instr.a);
+                    if (condition.level == Level::VARYING || (condition.level == Level::CONSTANT && condition.i != 0))
+                    {
+                        MarkEdge(id, instr.target);
+                    }
+                    if (condition.level == Level::VARYING || (condition.level == Level::CONSTANT && condition.i == 0))
+                    {
+                        MarkEdge(id, instr.target2);
+                    }
+                    break;
+                }
+                case Op::RET:
+                case Op::STORE:
+                    break;
+                default:
+                    if (instr.dst != NO_VREG)
+                    {
+                        Set(instr.dst, Evaluate(instr));
+                    }
+                    break;
+                }
+            }
+
+            void Solve()
+            {
+                reached_[0] = true;
+                for (uint32_t index = 0; index < function_.blocks[0].instrs.size(); index++)
+                {
+                    Visit(0, index);
+                }
+                while (!edge_work_.empty() || !value_work_.empty())
+                {
+                    while (!edge_work_.empty())
+                    {
+                        auto [from, to] = edge_work_.back();
+                        edge_work_.pop_back();
+                        const std::vector<BlockId> &preds = function_.blocks[to].preds;
+                        const size_t edge = std::find(preds.begin(), preds.end(), from) - preds.begin();
+                        if (executable_[to][edge])
+                        {
+                            continue;
+                        }
+                        executable_[to][edge] = true;
+                        const std::vector<Instr> &instrs = function_.blocks[to].instrs;
+                        const bool first = !reached_[to];
+                        reached_[to] = true;
+                        for (uint32_t index = 0; index < instrs.size() && (first || instrs[index].op == Op::PHI); index++)
+                        {
+                            Visit(to, index);
+                        }
+                    }
+                    while (!value_work_.empty())
+                    {
+                        VReg vreg = value_work_.back();
+                        value_work_.pop_back();
+                        for (auto [block, index] : users_[vreg])
+                        {
+                            if (reached_[block])
+                            {
+                                Visit(block, index);
+                            }
+                        }
+                    }
+                }
+            }
+
+            // constants in place of the instructions computing them, jumps in place of decided branches
+            void Rewrite()
+            {
+                for (BlockId id = 0; id < function_.blocks.size(); id++)
+                {
+                    if (!reached_[id])
+                    {
+                        continue;
+                    }
+                    std::vector<Instr> phis, constants, rest;
+                    for (Instr &instr : function_.blocks[id].instrs)
+                    {
+                        const bool constant = instr.dst != NO_VREG && instr.op != Op::CALL && Of(instr.dst).level == Level::CONSTANT;
+                        if (constant && instr.op != Op::CONST && instr.op != Op::FCONST)
+                        {
+                            const Value &value = Of(instr.dst);
+                            const bool floating = IsFloat(function_.TypeOf(instr.dst));
+                            (instr.op == Op::PHI ? constants : rest).push_back({.op = floating ? Op::FCONST : Op::CONST, .dst = instr.dst, .imm = value.i, .fimm = value.f});
+                            continue;
+                        }
+                        if (instr.op == Op::BRANCH && Of(instr.a).level == Level::CONSTANT)
+                        {
+                            instr = {.op = Op::JUMP, .target = Of(instr.a).i != 0 ? instr.target : instr.target2};
+                        }
+                        (instr.op == Op::PHI ? phis : rest).push_back(std::move(instr));
+                    }
+                    phis.insert(phis.end(), constants.begin(), constants.end());
+                    phis.insert(phis.end(), rest.begin(), rest.end());
+                    function_.blocks[id].instrs = std::move(phis);
+                }
+                function_.BuildCfg();
+            }
+
+        public:
+            explicit Propagation(Function &function)
+                : function_(function),
+                  values_(function.vreg_types.size()),
+                  users_(function.vreg_types.size()),
+                  reached_(function.blocks.size(), false),
+                  executable_(function.blocks.size())
+            {
+                for (VReg param : function.params)
+                {
+                    values_[param] = Value::Varying();
+                }
+                for (BlockId id = 0; id < function.blocks.size(); id++)
+                {
+                    executable_[id].assign(function.blocks[id].preds.size(), false);
+                    const std::vector<Instr> &instrs = function.blocks[id].instrs;
+                    for (uint32_t index = 0; index < instrs.size(); index++)
+                    {
+                        ForEachUse(instrs[index], [&](VReg vreg)
+                                   { users_[vreg].push_back({id, index}); });
+                    }
+                }
+            }
+
+            void Run()
+            {
+                Solve();
+                Rewrite();
+            }
+        };
+    }
+
+    void PropagateConstants(Function &function)
+    {
+        Propagation(function).Run();
+    }
+
+} // namespace ir
@@ -0,0 +1,581 @@
+#include "ir_passes.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <unordered_set>
+
+#include "ir_analysis.hpp"
+
+namespace ir
+{
+    namespace
+    {
+        constexpr uint32_t NOT_PROMOTED = UINT32_MAX;
+
+        Type TypeOf(Width width)
+        {
+            switch (width)
+            {
+            case Width::FLOAT:
+                return Type::F32;
+            case Width::DOUBLE:
+                return Type::F64;
+            default:
+                return Type::I32;
+            }
+        }
+
+        // width of every access to each slot, or nullopt for slots that are accessed partially, at
+        // several widths, through their address, or not at all
+        std::vector<std::optional<Width>> PromotableSlots(const Function &function)
+        {
+            std::vector<std::optional<Width>> widths(function.slots.size());
+            std::vector<bool> excluded(function.slots.size(), false);
+            for (const Block &block : function.blocks)
+            {
+                for (const Instr &instr : block.instrs)
+                {
+                    const SlotId slot = instr.address.slot;
+                    if (slot == NO_SLOT)
+                    {
+                        continue;
+                    }
+                    const bool whole = (instr.op == Op::LOAD || instr.op == Op::STORE) && instr.address.offset == 0;
+                    if (!whole || (widths[slot] && *widths[slot] != instr.width))
+                    {
+                        excluded[slot] = true;
+                    }
+                    widths[slot] = instr.width;
+                }
+            }
+            for (SlotId slot = 0; slot < widths.size(); slot++)
+            {
+                if (excluded[slot])
+                {
+                    widths[slot].reset();
+                }
+            }
+            return widths;
+        }
+
+        // rewrites every use through replacement, which maps a register to the one it stands for
+        void ReplaceUses(Function &function, const std::vector<VReg> &replacement)
+        {
+            auto resolve = [&](VReg vreg)
+            {
+                while (vreg < replacement.size() && replacement[vreg] != NO_VREG)
+                {
+                    vreg = replacement[vreg];
+                }
+                return vreg;
+            };
+            for (Block &block : function.blocks)
+            {
+                for (Instr &instr : block.instrs)
+                {
+                    ForEachUse(instr, [&](VReg &vreg)
+                               { vreg = resolve(vreg); });
+                }
+            }
+        }
+
+        // Removes the phis whose arguments are all one register or the phi itself, which promotion
+        // leaves at joins of paths that didn't store to the variable.
+        void RemoveTrivialPhis(Function &function)
+        {
+            std::vector<VReg> replacement(function.vreg_types.size(), NO_VREG);
+            for (bool changed = true; changed;)
+            {
+                changed = false;
+                for (Block &block : function.blocks)
+                {
+                    auto phis_end = std::find_if(block.instrs.begin(), block.instrs.end(), [](const Instr &instr)
+                                                 { return instr.op != Op::PHI; });
+                    for (auto phi = block.instrs.begin(); phi != phis_end; ++phi)
+                    {
+                        VReg same = NO_VREG;
+                        bool trivial = true;
+                        for (VReg arg : phi->args)
+                        {
+                            while (replacement[arg] != NO_VREG)
+                            {
+                                arg = replacement[arg];
+                            }
+                            if (arg == phi->dst || arg == same)
+                            {
+                                continue;
+                            }
+                            trivial = trivial && same == NO_VREG;
+                            same = arg;
+                        }
+                        if (trivial && same != NO_VREG && replacement[phi->dst] == NO_VREG)
+                        {
+                            replacement[phi->dst] = same;
+                            changed = true;
+                        }
+                    }
+                }
+            }
+            for (Block &block : function.blocks)
+            {
+                std::erase_if(block.instrs, [&](const Instr &instr)
+                              { return instr.op == Op::PHI && replacement[instr.dst] != NO_VREG; });
+            }
+            ReplaceUses(function, replacement);
+        }
+
+        // Splits the edges from blocks with several successors to blocks with phis, so that the
+        // copies replacing a phi run only on the edge they belong to.
+        void SplitCriticalEdges(Function &function)
+        {
+            const BlockId block_count = function.blocks.size();
+            for (BlockId id = 0; id < block_count; id++)
+            {
+                if (function.blocks[id].instrs.front().op != Op::PHI || function.blocks[id].preds.size() < 2)
+                {
+                    continue;
+                }
+                for (size_t i = 0; i < function.blocks[id].preds.size(); i++)
+                {
+                    const BlockId pred = function.blocks[id].preds[i];
+                    if (function.blocks[pred].succs.size() < 2)
+                    {
+                        continue;
+                    }
+                    const BlockId middle = function.NewBlock();
+                    function.blocks[middle].instrs.push_back({.op = Op::JUMP, .target = id});
+                    function.blocks[middle].preds = {pred};
+                    function.blocks[middle].succs = {id};
+                    Instr &branch = function.blocks[pred].instrs.back();
+                    for (BlockId *target : {&branch.target, &branch.target2})
+                    {
+                        if (*target == id)
+                        {
+                            *target = middle;
+                        }
+                    }
+                    std::replace(function.blocks[pred].succs.begin(), function.blocks[pred].succs.end(), id, middle);
+                    function.blocks[id].preds[i] = middle;
+                }
+            }
+        }
+
+        // Chaitin-style interference between registers related by copies: each definition
+        // interferes with everything live after it, except the source of a copy it is defined by.
+        class CopyInterference
+        {
+        private:
+            std::vector<std::unordered_set<VReg>> edges_; // only of registers that take part in copies
+
+        public:
+            explicit CopyInterference(const Function &function) : edges_(function.vreg_types.size())
+            {
+                std::vector<bool> candidate(function.vreg_types.size(), false);
+                for (const Block &block : function.blocks)
+                {
+                    for (const Instr &instr : block.instrs)
+                    {
+                        if (instr.op == Op::COPY)
+                        {
+                            candidate[instr.dst] = true;
+                            candidate[instr.a] = true;
+                        }
+                    }
+                }
+                auto interfere = [&](VReg a, VReg b)
+                {
+                    if (a != b && (candidate[a] || candidate[b]) && function.TypeOf(a) == function.TypeOf(b))
+                    {
+                        edges_[a].insert(b);
+                        edges_[b].insert(a);
+                    }
+                };
+
+                Liveness liveness = ComputeLiveness(function);
+                for (BlockId id = 0; id < function.blocks.size(); id++)
+                {
+                    RegisterSet live = liveness.live_out[id];
+                    const std::vector<Instr> &instrs = function.blocks[id].instrs;
+                    for (auto instr = instrs.rbegin(); instr != instrs.rend(); ++instr)
+                    {
+                        if (instr->dst != NO_VREG)
+                        {
+                            const VReg source = (instr->op == Op::COPY) ? instr->a : NO_VREG;
+                            live.ForEach([&](VReg vreg)
+                                         {
+                                             if (vreg != source)
+                                             {
+                                                 interfere(instr->dst, vreg);
+                                             } });
+                            live.Erase(instr->dst);
+                        }
+                        ForEachUse(*instr, [&](VReg vreg)
+                                   { live.Insert(vreg); });
+                    }
+                }
+                // parameters are all defined on entry, together
+                for (VReg param : function.params)
+                {
+                    for (VReg other : function.params)
+                    {
+                        interfere(param, other);
+                    }
+                    liveness.live_in[0].ForEach([&](VReg vreg)
+                                                { interfere(param, vreg); });
+                }
+            }
+
+            bool Interfere(VReg a, VReg b) const { return edges_[a].count(b) != 0; }
+
+            // b joins a, taking its interferences along
+            void Merge(VReg a, VReg b)
+            {
+                for (VReg neighbour : edges_[b])
+                {
+                    edges_[neighbour].erase(b);
+                    edges_[neighbour].insert(a);
+                    edges_[a].insert(neighbour);
+                }
+                edges_[b].clear();
+            }
+        };
+
+        // Merges both sides of every copy whose live ranges don't overlap into one register, in
+        // program order, and deletes the copies that become moves of a register to itself.
+        void CoalesceCopies(Function &function)
+        {
+            CopyInterference interference(function);
+            std::vector<VReg> representative(function.vreg_types.size());
+            for (VReg vreg = 0; vreg < representative.size(); vreg++)
+            {
+                representative[vreg] = vreg;
+            }
+            auto find = [&](VReg vreg)
+            {
+                while (representative[vreg] != vreg)
+                {
+                    representative[vreg] = representative[representative[vreg]];
+                    vreg = representative[vreg];
+                }
+                return vreg;
+            };
+
+            for (const Block &block : function.blocks)
+            {
+                for (const Instr &instr : block.instrs)
+                {
+                    if (instr.op != Op::COPY)
+                    {
+                        continue;
+                    }
+                    const VReg dst = find(instr.dst);
+                    const VReg src = find(instr.a);
+                    if (dst != src && !interference.Interfere(dst, src))
+                    {
+                        interference.Merge(dst, src);
+                        representative[src] = dst;
+                    }
+                }
+            }
+
+            for (VReg &param : function.params)
+            {
+                param = find(param);
+            }
+            for (Block &block : function.blocks)
+            {
+                for (Instr &instr : block.instrs)
+                {
+                    if (instr.dst != NO_VREG)
+                    {
+                        instr.dst = find(instr.dst);
+                    }
+                    ForEachUse(instr, [&](VReg &vreg)
+                               { vreg = find(vreg); });
+                }
+                std::erase_if(block.instrs, [](const Instr &instr)
+                              { return instr.op == Op::COPY && instr.dst == instr.a; });
+            }
+        }
+    }
+
+    void PromoteSlots(Function &function)
+    {
+        const std::vector<std::optional<Width>> widths = PromotableSlots(function);
+        std::vector<uint32_t> variable_of(function.slots.size(), NOT_PROMOTED);
+        std::vector<Width> variable_widths;
+        for (SlotId slot = 0; slot < widths.size(); slot++)
+        {
+            if (widths[slot])
+            {
+                variable_of[slot] = variable_widths.size();
+                variable_widths.push_back(*widths[slot]);
+            }
+        }
+        if (variable_widths.empty())
+        {
+            return;
+        }
+        auto promoted = [&](const Instr &instr)
+        {
+            return instr.address.slot != NO_SLOT && variable_of[instr.address.slot] != NOT_PROMOTED;
+        };
+
+        // phis at the iterated dominance frontier of the blocks storing to each variable, where the
+        // variable is live. Without the liveness check, nested joins like those of a && (b && (...))
+        // would get a phi for every variable stored inside them, quadratically many.
+        const DominatorTree tree(function);
+        const std::vector<std::vector<BlockId>> frontiers = tree.Frontiers(function);
+        std::vector<std::vector<BlockId>> stores(variable_widths.size());
+        std::vector<std::vector<BlockId>> loads(variable_widths.size()); // blocks reading the variable before storing it
+        std::vector<BlockId> stored_in(variable_widths.size(), NO_BLOCK);
+        for (BlockId id = 0; id < function.blocks.size(); id++)
+        {
+            for (const Instr &instr : function.blocks[id].instrs)
+            {
+                if (!promoted(instr))
+                {
+                    continue;
+                }
+                const uint32_t variable = variable_of[instr.address.slot];
+                std::vector<BlockId> &blocks = (instr.op == Op::STORE) ? stores[variable] : loads[variable];
+                if (instr.op == Op::LOAD && stored_in[variable] == id)
+                {
+                    continue;
+                }
+                if (instr.op == Op::STORE)
+                {
+                    stored_in[variable] = id;
+                }
+                if (blocks.empty() || blocks.back() != id)
+                {
+                    blocks.push_back(id);
+                }
+            }
+        }
+        std::vector<std::vector<uint32_t>> phi_variables(function.blocks.size()); // of the phis leading each block
+        std::vector<uint32_t> has_phi(function.blocks.size(), NOT_PROMOTED);
+        std::vector<uint32_t> queued(function.blocks.size(), NOT_PROMOTED);
+        std::vector<uint32_t> stores_to(function.blocks.size(), NOT_PROMOTED);
+        std::vector<uint32_t> live_in(function.blocks.size(), NOT_PROMOTED);
+        for (uint32_t variable = 0; variable < variable_widths.size(); variable++)
+        {
+            // live on entry to the blocks reading it first, and back from there up to the stores
+            std::vector<BlockId> worklist = loads[variable];
+            for (BlockId block : stores[variable])
+            {
+                stores_to[block] = variable;
+            }
+            for (BlockId block : worklist)
+            {
+                live_in[block] = variable;
+            }
+            while (!worklist.empty())
+            {
+                BlockId block = worklist.back();
+                worklist.pop_back();
+                for (BlockId pred : function.blocks[block].preds)
+                {
+                    if (live_in[pred] != variable && stores_to[pred] != variable)
+                    {
+                        live_in[pred] = variable;
+                        worklist.push_back(pred);
+                    }
+                }
+            }
+
+            worklist = stores[variable];
+            for (BlockId block : worklist)
+            {
+                queued[block] = variable;
+            }
+            while (!worklist.empty())
+            {
+                BlockId block = worklist.back();
+                worklist.pop_back();
+                for (BlockId frontier : frontiers[block])
+                {
+                    if (has_phi[frontier] == variable || live_in[frontier] != variable)
+                    {
+                        continue;
+                    }
+                    has_phi[frontier] = variable;
+                    phi_variables[frontier].push_back(variable);
+                    if (queued[frontier] != variable)
+                    {
+                        queued[frontier] = variable;
+                        worklist.push_back(frontier);
+                    }
+                }
+            }
+        }
+        for (BlockId id = 0; id < function.blocks.size(); id++)
+        {
+            std::vector<Instr> phis;
+            for (uint32_t variable : phi_variables[id])
+            {
+                const VReg dst = function.NewVReg(TypeOf(variable_widths[variable]));
+                phis.push_back({.op = Op::PHI, .dst = dst, .args = std::vector<VReg>(function.blocks[id].preds.size(), NO_VREG)});
+            }
+            function.blocks[id].instrs.insert(function.blocks[id].instrs.begin(), phis.begin(), phis.end());
+        }
+
+        // renaming, in a preorder walk of the dominator tree: a load takes the value of the
+        // dominating store, or a zero where the variable is read before any store
+        std::vector<VReg> replacement(function.vreg_types.size(), NO_VREG);
+        std::vector<std::vector<VReg>> values(variable_widths.size());
+        std::vector<Instr> zeros; // defining the values of variables read uninitialised
+        std::vector<VReg> zero_of(variable_widths.size(), NO_VREG);
+        auto current = [&](uint32_t variable)
+        {
+            if (!values[variable].empty())
+            {
+                return values[variable].back();
+            }
+            if (zero_of[variable] == NO_VREG)
+            {
+                const Type type = TypeOf(variable_widths[variable]);
+                zero_of[variable] = function.NewVReg(type);
+                zeros.push_back({.op = IsFloat(type) ? Op::FCONST : Op::CONST, .dst = zero_of[variable]});
+            }
+            return zero_of[variable];
+        };
+
+        // each entry is a block and whether its subtree is done, popping the values it pushed
+        std::vector<std::pair<BlockId, bool>> walk = {{0, false}};
+        std::vector<std::vector<uint32_t>> pushed(function.blocks.size());
+        while (!walk.empty())
+        {
+            auto [id, done] = walk.back();
+            walk.pop_back();
+            if (done)
+            {
+                for (uint32_t variable : pushed[id])
+                {
+                    values[variable].pop_back();
+                }
+                continue;
+            }
+            walk.push_back({id, true});
+
+            std::vector<Instr> instrs;
+            size_t phi_index = 0;
+            for (Instr &instr : function.blocks[id].instrs)
+            {
+                if (instr.op == Op::PHI)
+                {
+                    const uint32_t variable = phi_variables[id][phi_index++];
+                    values[variable].push_back(instr.dst);
+                    pushed[id].push_back(variable);
+                    instrs.push_back(std::move(instr));
+                    continue;
+                }
+                ForEachUse(instr, [&](VReg &vreg)
+                           {
+                               if (vreg < replacement.size() && replacement[vreg] != NO_VREG)
+                               {
+                                   vreg = replacement[vreg];
+                               } });
+                if (!promoted(instr))
+                {
+                    instrs.push_back(std::move(instr));
+                    continue;
+                }
+                const uint32_t variable = variable_of[instr.address.slot];
+                if (instr.op == Op::LOAD)
+                {
+                    replacement[instr.dst] = current(variable);
+                    continue;
+                }
+                VReg value = instr.a;
+                if (instr.width == Width::BYTE)
+                {
+                    const VReg mask = function.NewVReg(Type::I32);
+                    value = function.NewVReg(Type::I32);
+                    instrs.push_back({.op = Op::CONST, .dst = mask, .imm = 0xff});
+                    instrs.push_back({.op = Op::AND, .dst = value, .a = instr.a, .b = mask});
+                }
+                values[variable].push_back(value);
+                pushed[id].push_back(variable);
+            }
+            function.blocks[id].instrs = std::move(instrs);
+
+            for (BlockId succ : function.blocks[id].succs)
+            {
+                Block &block = function.blocks[succ];
+                const size_t edge = std::find(block.preds.begin(), block.preds.end(), id) - block.preds.begin();
+                for (size_t i = 0; i < phi_variables[succ].size(); i++)
+                {
+                    block.instrs[i].args[edge] = current(phi_variables[succ][i]);
+                }
+            }
+            for (auto child = tree.Children(id).rbegin(); child != tree.Children(id).rend(); ++child)
+            {
+                walk.push_back({*child, false});
+            }
+        }
+        std::vector<Instr> &entry = function.blocks[0].instrs;
+        entry.insert(entry.begin() + phi_variables[0].size(), zeros.begin(), zeros.end());
+
+        // the promoted slots are gone from the frame
+        std::vector<SlotId> renumbered(function.slots.size(), NO_SLOT);
+        std::vector<Slot> kept;
+        for (SlotId slot = 0; slot < function.slots.size(); slot++)
+        {
+            if (variable_of[slot] == NOT_PROMOTED)
+            {
+                renumbered[slot] = kept.size();
+                kept.push_back(function.slots[slot]);
+            }
+        }
+        function.slots = std::move(kept);
+        for (Block &block : function.blocks)
+        {
+            for (Instr &instr : block.instrs)
+            {
+                if (instr.address.slot != NO_SLOT)
+                {
+                    instr.address.slot = renumbered[instr.address.slot];
+                }
+            }
+        }
+
+        RemoveTrivialPhis(function);
+    }
+
+    void LeaveSsa(Function &function)
+    {
+        SplitCriticalEdges(function);
+
+        // Each phi becomes a copy from a fresh register that the predecessors copy its arguments
+        // into just before their jump. Only copies of fresh registers run side by side, so the
+        // order among them doesn't matter.
+        for (BlockId id = 0; id < function.blocks.size(); id++)
+        {
+            std::vector<std::pair<BlockId, Instr>> copies; // inserted once the phis are gone, as a block may be its own pred
+            for (Instr &phi : function.blocks[id].instrs)
+            {
+                if (phi.op != Op::PHI)
+                {
+                    break;
+                }
+                const VReg incoming = function.NewVReg(function.TypeOf(phi.dst));
+                for (size_t i = 0; i < phi.args.size(); i++)
+                {
+                    copies.push_back({function.blocks[id].preds[i], {.op = Op::COPY, .dst = incoming, .a = phi.args[i]}});
+                }
+                phi = {.op = Op::COPY, .dst = phi.dst, .a = incoming};
+            }
+            for (auto &[pred, copy] : copies)
+            {
+                std::vector<Instr> &instrs = function.blocks[pred].instrs;
+                instrs.insert(instrs.end() - 1, std::move(copy));
+            }
+        }
+        function.single_definitions = false;
+        function.BuildCfg();
+
+        CoalesceCopies(function);
+    }
+
+} // namespace ir
@@ -7,20 +7,91 @@
 %debug
 %code requires{
     #include "ast.hpp"
+    #include "source_file.hpp"
+    #include <algorithm>
+    #include <memory>
 
 	using namespace ast;
 
-	extern int yylineno;
-	extern char* yytext;
-	extern Node* g_root;
-	extern FILE* yyin;
+	#ifndef YY_TYPEDEF_YY_SCANNER_T
+	#define YY_TYPEDEF_YY_SCANNER_T
+	typedef void* yyscan_t;
+	#endif
+
+	// State of one parse, reached from the scanner through yyextra. Nothing is shared between
+	// parses, so several files can be parsed at once on different threads.
+	struct ParseState {
+		yyscan_t scanner = nullptr;
+		Node* root = nullptr;  // set once the whole translation unit has been reduced
+		std::string error;     // message of the syntax error that ended the parse
+		size_t offset = 0;     // bytes scanned so far; locations are byte offsets into the source
+		// the parser stacks once they outgrow the ones yyparse starts with, freed with the parse
+		std::shared_ptr<void> states, values, locations;
+	};
+
+	int yylex_init_extra(ParseState* extra, yyscan_t* scanner);
+	int yylex_destroy(yyscan_t scanner);
+	void yyset_in(FILE* in, yyscan_t scanner);
+	ParseState* yyget_extra(yyscan_t scanner);
+	char* yyget_text(yyscan_t scanner);
+	int yyget_lineno(yyscan_t scanner);
+	void ScanBuffer(char *buffer, size_t size, yyscan_t scanner);
 
-	int yylex(void);
-	void yyerror(const char*);
-	int yylex_destroy(void);
+}
+
+%code provides{
+	int yylex(YYSTYPE* yylval_param, YYLTYPE* yylloc_param, yyscan_t scanner);
+	void yyerror(YYLTYPE* location, yyscan_t scanner, const char*);
+}
 
+%code{
+	// a rule spans its first to its last symbol; an empty rule is an empty span where it was reduced
+	#define YYLLOC_DEFAULT(Current, Rhs, N)                                       \
+		do {                                                                      \
+			if (N) {                                                              \
+				(Current).begin = YYRHSLOC(Rhs, 1).begin;                         \
+				(Current).end = YYRHSLOC(Rhs, N).end;                             \
+			} else {                                                              \
+				(Current).begin = (Current).end = YYRHSLOC(Rhs, 0).end;           \
+			}                                                                     \
+		} while (0)
+
+	// Bison only grows its stacks itself when the location type is its own, so deep nesting would
+	// stop at the initial depth. They are grown here instead, up to YYMAXDEPTH; on failure the stack
+	// size is left alone, which makes yyparse give up.
+	#define yyoverflow(Message, States, StatesBytes, Values, ValuesBytes, Locations, LocationsBytes, StackSize) \
+		GrowStacks(*yyget_extra(scanner), Message, States, Values, Locations, \
+		           (StatesBytes) / sizeof(**(States)), StackSize, YYMAXDEPTH)
+
+	template <typename State, typename Value, typename Location, typename Size>
+	void GrowStacks(ParseState &state, const char *message, State **states, Value **values, Location **locations,
+	                size_t size, Size *stack_size, long max_depth)
+	{
+		if (*stack_size >= max_depth) {
+			state.error = std::string("Error: ") + message;
+			return;
+		}
+		*stack_size = std::min<Size>(2 * *stack_size, max_depth);
+		std::shared_ptr<State[]> grown_states(new State[*stack_size]);
+		std::shared_ptr<Value[]> grown_values(new Value[*stack_size]);
+		std::shared_ptr<Location[]> grown_locations(new Location[*stack_size]);
+		std::copy(*states, *states + size, grown_states.get());
+		std::copy(*values, *values + size, grown_values.get());
+		std::copy(*locations, *locations + size, grown_locations.get());
+		*states = grown_states.get();
+		*values = grown_values.get();
+		*locations = grown_locations.get();
+		// replaces (and frees) the previous stacks, which are no longer used
+		state.states = grown_states;
+		state.values = grown_values;
+		state.locations = grown_locations;
+	}
 }
 
+%define api.pure full
+%define api.location.type {SourceSpan}
+%locations
+%param {yyscan_t scanner}
 %define parse.error detailed
 %define parse.lac full
 
@@ -29,7 +100,8 @@
   NodeList*			  node_list;
   int          		number_int;
   double       		number_float;
-  std::string*		string; // identifier
+  std::string*		string; // assignment operator
+  SymbolId		    symbol; // interned identifier or literal
   TypeSpecifier 	type_specifier;
   yytokentype  		token;
 }
@@ -55,7 +127,7 @@
 %type <string> assignment_operator
 %type <number_int> INT_CONSTANT pointer
 %type <number_float> FLOAT_CONSTANT
-%type <string> IDENTIFIER CHAR_LITERAL STRING_LITERAL
+%type <symbol> IDENTIFIER CHAR_LITERAL STRING_LITERAL
 %type <type_specifier> type_specifier declaration_specifiers
 
 %nonassoc NOELSE
@@ -67,7 +139,7 @@
 %%
 
 ROOT
-	: translation_unit { g_root = new TranslationUnit(NodePtr($1)); }
+	: translation_unit { yyget_extra(scanner)->root = new TranslationUnit(NodePtr($1)); }
 
 translation_unit
 	: external_declaration { $$ = new NodeList(NodePtr($1)); }
@@ -84,10 +156,10 @@ external_declaration
 
 function_definition
 	: declaration_specifiers declarator compound_statement {
-		$$ = new FunctionDefinition($1, NodePtr($2), NodePtr($3));
+		$$ = new FunctionDefinition($1, NodePtr($2), NodePtr($3), @$, @3);
 	}
 	| declarator compound_statement {
-		$$ = new FunctionDefinition(TypeSpecifier::INT, NodePtr($1), NodePtr($2));
+		$$ = new FunctionDefinition(TypeSpecifier::INT, NodePtr($1), NodePtr($2), @$, @2);
 	}
 	;
 
@@ -143,9 +215,9 @@ enum_declaration
     ;
 
 enum_specifier
-    : ENUM IDENTIFIER '{' enumerator_list '}' { $$ = new EnumDeclaration(*$2, NodePtr($4)); delete $2; }
-    | ENUM '{' enumerator_list '}' { $$ = new EnumDeclaration("", NodePtr($3)); }
-    | ENUM IDENTIFIER { $$ = new EnumDeclaration(*$2, nullptr); delete $2; }
+    : ENUM IDENTIFIER '{' enumerator_list '}' { $$ = new EnumDeclaration($2, NodePtr($4)); }
+    | ENUM '{' enumerator_list '}' { $$ = new EnumDeclaration(SymbolId::EMPTY, NodePtr($3)); }
+    | ENUM IDENTIFIER { $$ = new EnumDeclaration($2, nullptr); }
     ;
 
 enumerator_list
@@ -154,8 +226,8 @@ enumerator_list
     ;
 
 enumerator
-    : IDENTIFIER { $$ = new Enumerator(std::move(*$1), nullptr); delete $1; }
-    | IDENTIFIER '=' conditional_expression { $$ = new Enumerator(std::move(*$1), NodePtr($3)); delete $1; }
+    : IDENTIFIER { $$ = new Enumerator($1, nullptr); }
+    | IDENTIFIER '=' conditional_expression { $$ = new Enumerator($1, NodePtr($3)); }
     ;
 
 declarator
@@ -165,8 +237,7 @@ declarator
 
 direct_declarator
 	: IDENTIFIER {
-		$$ = new Identifier(std::move(*$1));
-		delete $1;
+		$$ = new Identifier($1);
 	}
 	| direct_declarator '(' ')' {
 		$$ = new DirectDeclarator(NodePtr($1), nullptr);
@@ -271,24 +342,21 @@ jump_statement
 
 primary_expression
 	: IDENTIFIER {
-		$$ = new Identifier(std::move(*$1));
-		delete $1;
+		$$ = new Identifier($1);
 	}
 	| INT_CONSTANT {
-		std::string raw_str = yytext;
+		std::string raw_str = yyget_text(scanner);
 		$$ = new IntConstant($1, raw_str);
 	}
     | FLOAT_CONSTANT {
-		std::string raw_str = yytext;
+		std::string raw_str = yyget_text(scanner);
         $$ = new FloatConstant($1, raw_str);
     }
 	| CHAR_LITERAL {
-		$$ = new CharLiteral(*$1);
-		delete $1;
+		$$ = new CharLiteral($1);
 	}
 	| STRING_LITERAL {
-		$$ = new StringLiteral(*$1);
-		delete $1;
+		$$ = new StringLiteral($1);
 	}
 	| '(' expression ')' {$$ = $2;}
 	;
@@ -450,29 +518,48 @@ expression
 
 %%
 
-void yyerror (const char *s)
+#include <sstream>
+#include <stdexcept>
+
+#include "source_file.hpp"
+
+void yyerror (YYLTYPE *location, yyscan_t scanner, const char *s)
 {
-  std::cerr << "Error: " << s << " at line " << yylineno;
-  std::cerr << " near '" << yytext << "'" << std::endl;
-  std::exit(1);
+  (void)location;
+  // recorded rather than printed, so that a bad file ends its parse and not the process
+  std::ostringstream message;
+  message << "Error: " << s << " at line " << yyget_lineno(scanner);
+  message << " near '" << yyget_text(scanner) << "'";
+  yyget_extra(scanner)->error = message.str();
 }
 
-Node* g_root;
-
 NodePtr ParseAST(std::string file_name)
 {
-  yyin = fopen(file_name.c_str(), "r");
-  if (yyin == nullptr) {
-    std::cerr << "Couldn't open input file: " << file_name << std::endl;
-    std::exit(1);
+  // regular files are lexed straight from a mapping of the file, anything else is streamed
+  SourceFile source(file_name);
+
+  ParseState state;
+  if (yylex_init_extra(&state, &state.scanner) != 0) {
+    throw std::runtime_error("Couldn't create a scanner for " + file_name);
+  }
+  if (source.IsMapped()) {
+    ScanBuffer(source.Data(), source.Size(), state.scanner);
+  } else {
+    yyset_in(source.Stream(), state.scanner);
   }
 
-  g_root = nullptr;
-  yydebug = 1;
-  yyparse();
+  int status = yyparse(state.scanner);
 
-  fclose(yyin);
-  yylex_destroy();
+  yylex_destroy(state.scanner);
+
+  if (status != 0) {
+    throw std::runtime_error(state.error.empty() ? "Error: parsing failed" : state.error);
+  }
 
-  return NodePtr(g_root);
+  return NodePtr(state.root);
+}
+
+void SetParserTrace(bool trace)
+{
+  yydebug = trace;
 }
@@ -0,0 +1,432 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+#include "server.hpp"
+#include "compiler.hpp"
+#include "ast_thread_pool.hpp"
+
+using ast::NodePtr;
+
+namespace
+{
+    // A message is a sequence of fields, each a "<name> <length>\n" header followed by length bytes
+    // of value, closed by an "end 0\n" field. Values may hold any byte, so paths and diagnostics
+    // need no escaping.
+    //   request:  source, output, compact-asm, ir, dump-ir ("0" or "1")
+    //   response: status (exit code of the equivalent -S/-o run), diagnostics
+    using Message = std::vector<std::pair<std::string, std::string>>;
+
+    const size_t MAX_FIELD_SIZE = 64 << 20;
+
+    // set from the signal handler, read by every connection thread
+    std::atomic<bool> stop_requested = false;
+    static_assert(std::atomic<bool>::is_always_lock_free, "stop_requested is set from a signal handler");
+
+    void RequestStop(int)
+    {
+        stop_requested = true;
+    }
+
+    const std::string *FindField(const Message &message, std::string_view name)
+    {
+        for (const auto &[field, value] : message)
+        {
+            if (field == name)
+            {
+                return &value;
+            }
+        }
+        return nullptr;
+    }
+
+    void SendMessage(int fd, const Message &message)
+    {
+        std::string data;
+        for (const auto &[field, value] : message)
+        {
+            data.append(field).append(" ").append(std::to_string(value.size())).append("\n").append(value);
+        }
+        data.append("end 0\n");
+
+        const char *cursor = data.data();
+        size_t remaining = data.size();
+        while (remaining > 0)
+        {
+            // MSG_NOSIGNAL: a client that hung up must not kill the server with SIGPIPE
+            ssize_t sent = send(fd, cursor, remaining, MSG_NOSIGNAL);
+            if (sent < 0)
+            {
+                if (errno == EINTR && !stop_requested)
+                {
+                    continue;
+                }
+                throw std::runtime_error(std::string("Couldn't send message: ") + std::strerror(errno));
+            }
+            cursor += sent;
+            remaining -= sent;
+        }
+    }
+
+    // Buffered reader of the messages arriving on a socket.
+    class MessageReader
+    {
+    private:
+        int fd_;
+        std::string buffer_;
+        size_t position_ = 0;
+
+        // false at end of stream
+        bool Fill()
+        {
+            if (position_ == buffer_.size())
+            {
+                buffer_.clear();
+                position_ = 0;
+            }
+            char chunk[16384];
+            while (true)
+            {
+                ssize_t received = recv(fd_, chunk, sizeof(chunk), 0);
+                if (received < 0)
+                {
+                    if (errno == EINTR && !stop_requested)
+                    {
+                        continue;
+                    }
+                    throw std::runtime_error(std::string("Couldn't receive message: ") + std::strerror(errno));
+                }
+                buffer_.append(chunk, received);
+                return received > 0;
+            }
+        }
+
+        bool ReadLine(std::string &line)
+        {
+            size_t end;
+            while ((end = buffer_.find('\n', position_)) == std::string::npos)
+            {
+                if (buffer_.size() - position_ > 4096 || !Fill())
+                {
+                    return false;
+                }
+            }
+            line.assign(buffer_, position_, end - position_);
+            position_ = end + 1;
+            return true;
+        }
+
+        bool ReadBytes(size_t n, std::string &bytes)
+        {
+            while (buffer_.size() - position_ < n)
+            {
+                if (!Fill())
+                {
+                    return false;
+                }
+            }
+            bytes.assign(buffer_, position_, n);
+            position_ += n;
+            return true;
+        }
+
+    public:
+        explicit MessageReader(int fd) : fd_(fd) {}
+
+        // false if the peer closed the connection between messages
+        bool Read(Message &message)
+        {
+            message.clear();
+            std::string header;
+            while (true)
+            {
+                if (!ReadLine(header))
+                {
+                    if (message.empty() && position_ == buffer_.size())
+                    {
+                        return false;
+                    }
+                    throw std::runtime_error("Malformed message: truncated header");
+                }
+                size_t space = header.find(' ');
+                if (space == std::string::npos)
+                {
+                    throw std::runtime_error("Malformed message: " + header);
+                }
+                std::string name = header.substr(0, space);
+                char *end = nullptr;
+                unsigned long long length = std::strtoull(header.c_str() + space + 1, &end, 10);
+                if (end == header.c_str() + space + 1 || *end != '\0' || length > MAX_FIELD_SIZE)
+                {
+                    throw std::runtime_error("Malformed message: " + header);
+                }
+                if (name == "end")
+                {
+                    return true;
+                }
+                std::string value;
+                if (!ReadBytes(length, value))
+                {
+                    throw std::runtime_error("Malformed message: truncated field " + name);
+                }
+                message.emplace_back(std::move(name), std::move(value));
+            }
+        }
+    };
+
+    sockaddr_un SocketAddress(const std::string &path)
+    {
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path))
+        {
+            throw std::runtime_error("Socket path is too long: " + path);
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return address;
+    }
+
+    // State kept warm between requests. Every connection is served on its own thread, and all of them
+    // share the thread pool for function bodies.
+    struct Server
+    {
+        ast::ThreadPool thread_pool;
+
+        std::mutex mutex;
+        std::condition_variable all_closed;
+        std::set<int> connections; // open client sockets, guarded by mutex
+
+        explicit Server(unsigned n_threads) : thread_pool(n_threads - 1) {}
+
+        // Same work and exit codes as a -S/-o run, with diagnostics collected instead of printed.
+        Message Compile(const Message &request, ast::AstArena &arena)
+        {
+            const std::string *source = FindField(request, "source");
+            const std::string *output_path = FindField(request, "output");
+            const std::string *compact_asm = FindField(request, "compact-asm");
+            const std::string *ir = FindField(request, "ir");
+            const std::string *dump_ir = FindField(request, "dump-ir");
+            if (source == nullptr || output_path == nullptr)
+            {
+                return {{"status", "2"}, {"diagnostics", "Request without a source or output path.\n"}};
+            }
+
+            std::ostringstream diagnostics;
+            int status = 0;
+            arena.Reset();
+            {
+                ast::ArenaScope arena_scope(arena);
+                // identifiers and string literals only live as long as the request
+                auto symbols = std::make_unique<ast::SymbolTable>();
+                ast::SymbolScope symbol_scope(*symbols);
+                try
+                {
+                    NodePtr root = ParseAST(*source);
+                    if (root == nullptr)
+                    {
+                        diagnostics << "The root of the AST is a null pointer. ";
+                        diagnostics << "Likely the root was never initialised correctly during parsing.\n";
+                        status = 3;
+                    }
+                    else
+                    {
+                        ast::GlobalContext globals;
+                        ast::Context ctx(globals);
+                        ctx.SetDiagnostics(diagnostics);
+                        ctx.SetUseIR(ir != nullptr && *ir == "1");
+                        ctx.SetDumpIR(dump_ir != nullptr && *dump_ir == "1");
+                        if (thread_pool.Size() > 0)
+                        {
+                            ctx.SetThreadPool(&thread_pool);
+                        }
+                        ast::AsmWriter output(compact_asm != nullptr && *compact_asm == "1");
+                        GenerateAssembly(root, ctx, output);
+                        output.WriteToFile(*output_path);
+                    }
+                }
+                catch (const std::exception &e)
+                {
+                    diagnostics << e.what() << "\n";
+                    status = 1;
+                }
+            }
+            return {{"status", std::to_string(status)}, {"diagnostics", diagnostics.str()}};
+        }
+
+        // a connection may carry any number of requests, answered in order
+        void HandleConnection(int fd)
+        {
+            ast::AstArena arena; // reset, not freed, after every request
+            MessageReader reader(fd);
+            Message request;
+            while (!stop_requested && reader.Read(request))
+            {
+                SendMessage(fd, Compile(request, arena));
+            }
+        }
+
+        void Open(int fd)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                connections.insert(fd);
+            }
+            std::thread([this, fd]
+                        {
+                            try
+                            {
+                                HandleConnection(fd);
+                            }
+                            catch (const std::exception &e)
+                            {
+                                std::cerr << e.what() << std::endl;
+                            }
+                            // closed under the lock, so that accept can't reuse the descriptor before it is erased
+                            std::lock_guard<std::mutex> lock(mutex);
+                            connections.erase(fd);
+                            close(fd);
+                            all_closed.notify_all(); })
+                .detach();
+        }
+
+        // Ends every connection once its current request is answered.
+        void CloseAll()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (int fd : connections)
+            {
+                shutdown(fd, SHUT_RD);
+            }
+            all_closed.wait(lock, [this]
+                            { return connections.empty(); });
+        }
+    };
+}
+
+int Serve(const CommandLineArguments &cli_args)
+{
+    const std::string &path = cli_args.serve_socket;
+
+    // no SA_RESTART, so that a blocked accept returns and the socket file is removed on the way out
+    struct sigaction action = {};
+    action.sa_handler = RequestStop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    int listener = -1;
+    try
+    {
+        sockaddr_un address = SocketAddress(path);
+
+        // a socket left behind by a server that was killed is replaced; anything else is not touched
+        struct stat info;
+        if (lstat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode))
+        {
+            unlink(path.c_str());
+        }
+
+        listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0 || bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 ||
+            listen(listener, SOMAXCONN) < 0)
+        {
+            throw std::runtime_error("Couldn't listen on " + path + ": " + std::strerror(errno));
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        if (listener >= 0)
+        {
+            close(listener);
+        }
+        return 1;
+    }
+
+    unsigned n_threads = (cli_args.n_threads != 0) ? cli_args.n_threads : std::max(1u, std::thread::hardware_concurrency());
+    Server server(n_threads);
+    std::cout << "Serving on " << path << " with " << n_threads << " threads" << std::endl;
+
+    while (!stop_requested)
+    {
+        int fd = accept(listener, nullptr, nullptr);
+        if (fd < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+            {
+                continue;
+            }
+            std::cerr << "Couldn't accept connection: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        server.Open(fd);
+    }
+
+    close(listener);
+    server.CloseAll();
+    unlink(path.c_str());
+    return 0;
+}
+
+bool CompileOnServer(const CommandLineArguments &cli_args, int &status)
+{
+    int fd = -1;
+    try
+    {
+        sockaddr_un address = SocketAddress(cli_args.client_socket);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+        {
+            throw std::runtime_error("Couldn't connect to " + cli_args.client_socket + ": " + std::strerror(errno));
+        }
+
+        // the server does not share our working directory
+        Message request = {
+            {"source", std::filesystem::absolute(cli_args.compile_source_path).string()},
+            {"output", std::filesystem::absolute(cli_args.compile_output_path).string()},
+            {"compact-asm", cli_args.compact_asm ? "1" : "0"},
+            {"ir", cli_args.ir ? "1" : "0"},
+            {"dump-ir", cli_args.dump_ir ? "1" : "0"},
+        };
+        SendMessage(fd, request);
+
+        Message response;
+        MessageReader reader(fd);
+        const std::string *response_status = nullptr;
+        if (!reader.Read(response) || (response_status = FindField(response, "status")) == nullptr)
+        {
+            throw std::runtime_error("The server closed the connection without answering");
+        }
+        close(fd);
+
+        if (const std::string *diagnostics = FindField(response, "diagnostics"))
+        {
+            std::cerr << *diagnostics;
+        }
+        status = std::atoi(response_status->c_str());
+        return true;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return false;
+    }
+}
@@ -0,0 +1,65 @@
+#include "source_file.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SourceFile::SourceFile(const std::string &path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Couldn't open input file: " + path);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+    {
+        size_ = info.st_size;
+        mapped_length_ = size_ + 2;
+
+        // Reserve zeroed memory covering the terminating NULs, then map the file over its start. The
+        // file mapping reads as zero past end of file within its last page, and the reservation
+        // supplies the NULs when the file ends exactly on a page boundary.
+        void *reserved = mmap(nullptr, mapped_length_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (reserved != MAP_FAILED)
+        {
+            void *mapped = mmap(reserved, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0);
+            if (mapped != MAP_FAILED)
+            {
+                madvise(mapped, size_, MADV_SEQUENTIAL);
+                data_ = static_cast<char *>(mapped);
+                close(fd);
+                return;
+            }
+            munmap(reserved, mapped_length_);
+        }
+        size_ = 0;
+        mapped_length_ = 0;
+    }
+
+    // not mappable: fall back to streaming
+    stream_ = fdopen(fd, "r");
+    if (stream_ == nullptr)
+    {
+        int error = errno;
+        close(fd);
+        throw std::runtime_error("Couldn't open input file: " + path + ": " + std::strerror(error));
+    }
+}
+
+SourceFile::~SourceFile()
+{
+    if (data_ != nullptr)
+    {
+        munmap(data_, mapped_length_);
+    }
+    if (stream_ != nullptr)
+    {
+        fclose(stream_);
+    }
+}